@@ -42,6 +42,19 @@ public:
         return parseRecursive(bytes, position, "root");
     }
 
+    // Static factory method to parse directly from a binary blob (skips the hex round-trip).
+    // bytesConsumed (optional) reports where parsing stopped, so callers can detect truncated or garbled data.
+    static std::unique_ptr<ArcadeKeyValues> ParseFromBinary(const void* data, size_t size, size_t* bytesConsumed = nullptr) {
+        const uint8_t* begin = static_cast<const uint8_t*>(data);
+        std::vector<uint8_t> bytes(begin, begin + size);
+        size_t position = 0;
+        auto kv = parseRecursive(bytes, position, "root");
+        if (bytesConsumed) {
+            *bytesConsumed = position;
+        }
+        return kv;
+    }
+
     // Core accessor methods (Valve-style API)
     const char* GetName() const {
         return name.c_str();
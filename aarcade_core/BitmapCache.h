@@ -0,0 +1,180 @@
+#ifndef BITMAP_CACHE_H
+#define BITMAP_CACHE_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <cstring>
+#include <windows.h>
+
+/**
+ * BitmapCache - In-memory LRU of decoded cache images
+ *
+ * ImageLoader puts the pixels of every image it writes to the disk cache here, keyed by
+ * the same hash as the cache file. They are kept as uncompressed 32-bit BMP files, which
+ * the views' file system (see CacheFileSystem) serves in place of the cached PNG, so a
+ * recently seen image reaches the page without being read from disk or inflated again.
+ *
+ * Images are dropped least recently used first once the total size passes the budget.
+ * Entries are shared with the buffers handed to Ultralight, so evicting one that is
+ * still being read is safe. All methods are thread-safe.
+ */
+class BitmapCache {
+public:
+    typedef std::shared_ptr<const std::vector<uint8_t>> Image;
+
+    struct Stats {
+        int64_t hits;        // get() calls that found the image
+        int64_t misses;      // get() calls that did not
+        int64_t evictions;   // Images dropped for the budget
+        int64_t entries;
+        int64_t bytes;
+        int64_t budgetBytes;
+    };
+
+private:
+    struct Entry {
+        Image image;
+        std::list<std::string>::iterator position;  // In recency_
+    };
+
+    std::map<std::string, Entry> entries_;  // Hash -> BMP data
+    std::list<std::string> recency_;        // Most recently used first
+    int64_t totalBytes_;
+    int64_t budgetBytes_;  // 0 disables the cache
+    int64_t hits_;
+    int64_t misses_;
+    int64_t evictions_;
+    std::mutex mutex_;
+
+    static const size_t HEADER_SIZE = 54;  // BITMAPFILEHEADER + BITMAPINFOHEADER
+
+    static void debugOutput(const std::string& message) {
+        std::string debugMsg = "[BitmapCache] " + message;
+        OutputDebugStringA((debugMsg + "\n").c_str());
+    }
+
+    static void writeLE(uint8_t* out, uint32_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        out[2] = static_cast<uint8_t>(value >> 16);
+        out[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    // A top-down 32-bit BMP of BGRA pixels (the images are opaque, so alpha is left unused)
+    static std::vector<uint8_t> makeBMP(const uint8_t* pixels, int width, int height, size_t rowBytes) {
+        size_t pixelBytes = static_cast<size_t>(width) * height * 4;
+        std::vector<uint8_t> bmp(HEADER_SIZE + pixelBytes, 0);
+        uint8_t* header = bmp.data();
+
+        header[0] = 'B';
+        header[1] = 'M';
+        writeLE(header + 2, static_cast<uint32_t>(bmp.size()));
+        writeLE(header + 10, static_cast<uint32_t>(HEADER_SIZE));
+        writeLE(header + 14, 40);  // BITMAPINFOHEADER size
+        writeLE(header + 18, static_cast<uint32_t>(width));
+        writeLE(header + 22, static_cast<uint32_t>(-height));  // Negative height: rows run top to bottom
+        header[26] = 1;   // Planes
+        header[28] = 32;  // Bits per pixel (BI_RGB compression is 0)
+        writeLE(header + 34, static_cast<uint32_t>(pixelBytes));
+
+        size_t outRowBytes = static_cast<size_t>(width) * 4;
+        for (int row = 0; row < height; row++) {
+            memcpy(bmp.data() + HEADER_SIZE + row * outRowBytes, pixels + row * rowBytes, outRowBytes);
+        }
+        return bmp;
+    }
+
+    // Drop least recently used images until the cache fits the budget (caller holds mutex_)
+    void evict() {
+        while (totalBytes_ > budgetBytes_ && !recency_.empty()) {
+            auto it = entries_.find(recency_.back());
+            totalBytes_ -= static_cast<int64_t>(it->second.image->size());
+            entries_.erase(it);
+            recency_.pop_back();
+            evictions_++;
+        }
+    }
+
+public:
+    explicit BitmapCache(int64_t budgetBytes)
+        : totalBytes_(0), budgetBytes_(budgetBytes), hits_(0), misses_(0), evictions_(0) {}
+
+    BitmapCache(const BitmapCache&) = delete;
+    BitmapCache& operator=(const BitmapCache&) = delete;
+
+    // Store BGRA pixels (rowBytes apart) under a cache hash, replacing any earlier image
+    void put(const std::string& hash, const uint8_t* pixels, int width, int height, size_t rowBytes) {
+        int64_t size = static_cast<int64_t>(HEADER_SIZE) + static_cast<int64_t>(width) * height * 4;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (width <= 0 || height <= 0 || size > budgetBytes_) {
+                return;
+            }
+        }
+
+        // Build the BMP outside the lock
+        Image image = std::make_shared<const std::vector<uint8_t>>(makeBMP(pixels, width, height, rowBytes));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(hash);
+        if (it != entries_.end()) {
+            totalBytes_ -= static_cast<int64_t>(it->second.image->size());
+            recency_.erase(it->second.position);
+            entries_.erase(it);
+        }
+
+        recency_.push_front(hash);
+        entries_[hash] = { image, recency_.begin() };
+        totalBytes_ += static_cast<int64_t>(image->size());
+        evict();
+    }
+
+    // The BMP for a hash, or null. Counts as a hit or a miss.
+    Image get(const std::string& hash) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(hash);
+        if (it == entries_.end()) {
+            misses_++;
+            return Image();
+        }
+
+        hits_++;
+        recency_.splice(recency_.begin(), recency_, it->second.position);
+        return it->second.image;
+    }
+
+    // Whether a hash is cached, without touching its recency or the metrics
+    bool contains(const std::string& hash) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.find(hash) != entries_.end();
+    }
+
+    void remove(const std::string& hash) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(hash);
+        if (it != entries_.end()) {
+            totalBytes_ -= static_cast<int64_t>(it->second.image->size());
+            recency_.erase(it->second.position);
+            entries_.erase(it);
+        }
+    }
+
+    void setBudget(int64_t budgetBytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        budgetBytes_ = budgetBytes;
+        evict();
+        debugOutput("Budget set to " + std::to_string(budgetBytes) + " bytes");
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return { hits_, misses_, evictions_, static_cast<int64_t>(entries_.size()), totalBytes_, budgetBytes_ };
+    }
+};
+
+#endif // BITMAP_CACHE_H
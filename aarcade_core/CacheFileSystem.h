@@ -0,0 +1,102 @@
+#ifndef CACHE_FILE_SYSTEM_H
+#define CACHE_FILE_SYSTEM_H
+
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <windows.h>
+#include <Ultralight/Ultralight.h>
+#include <Ultralight/platform/FileSystem.h>
+#include <AppCore/Platform.h>
+#include "BitmapCache.h"
+
+using namespace ultralight;
+
+/**
+ * CacheFileSystem - Ultralight file system that serves cache images from memory
+ *
+ * Wraps AppCore's platform file system. A request for a PNG in the image cache directory
+ * whose hash is in the BitmapCache is answered with the decoded BMP held there, so the
+ * page skips the disk read and the PNG decode. Everything else, including cache images
+ * that are not in memory, is read from disk as before.
+ *
+ * Must be installed with Platform::set_file_system() before App::Create().
+ */
+class CacheFileSystem : public FileSystem {
+private:
+    FileSystem* platformFileSystem_;  // Owned by AppCore
+    BitmapCache* bitmapCache_;        // Owned by MainApp
+    std::string cachePrefix_;         // Cache directory as it appears in file URLs, e.g. "cache/urls/"
+
+    // "./cache\urls\3f/a2/x.png" -> "cache/urls/3f/a2/x.png" (lowercase)
+    static std::string normalize(const std::string& path) {
+        std::string normalized = path;
+        std::replace(normalized.begin(), normalized.end(), '\\', '/');
+        while (normalized.compare(0, 2, "./") == 0) {
+            normalized.erase(0, 2);
+        }
+        std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                       [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        return normalized;
+    }
+
+    // Cache hash of a cache image path, or "" for any other file
+    std::string hashFor(const String& filePath) const {
+        std::string path = normalize(filePath.utf8().data());
+        if (path.compare(0, cachePrefix_.length(), cachePrefix_) != 0 || path.length() < 4 ||
+            path.compare(path.length() - 4, 4, ".png") != 0) {
+            return "";
+        }
+
+        size_t nameStart = path.find_last_of('/') + 1;
+        return path.substr(nameStart, path.length() - 4 - nameStart);
+    }
+
+    static void releaseImage(void* userData, void* data) {
+        delete static_cast<BitmapCache::Image*>(userData);
+    }
+
+public:
+    CacheFileSystem(const std::string& baseDir, const std::string& cacheDirectory, BitmapCache* bitmapCache)
+        : platformFileSystem_(GetPlatformFileSystem(baseDir.c_str())), bitmapCache_(bitmapCache) {
+        cachePrefix_ = normalize(cacheDirectory);
+        if (!cachePrefix_.empty() && cachePrefix_.back() != '/') {
+            cachePrefix_ += '/';
+        }
+    }
+
+    virtual bool FileExists(const String& file_path) override {
+        std::string hash = hashFor(file_path);
+        if (!hash.empty() && bitmapCache_->contains(hash)) {
+            return true;
+        }
+        return platformFileSystem_->FileExists(file_path);
+    }
+
+    virtual String GetFileMimeType(const String& file_path) override {
+        std::string hash = hashFor(file_path);
+        if (!hash.empty() && bitmapCache_->contains(hash)) {
+            return "image/bmp";
+        }
+        return platformFileSystem_->GetFileMimeType(file_path);
+    }
+
+    virtual String GetFileCharset(const String& file_path) override {
+        return platformFileSystem_->GetFileCharset(file_path);
+    }
+
+    virtual RefPtr<Buffer> OpenFile(const String& file_path) override {
+        std::string hash = hashFor(file_path);
+        if (!hash.empty()) {
+            BitmapCache::Image image = bitmapCache_->get(hash);
+            if (image) {
+                // The buffer keeps the image alive even if the cache evicts it meanwhile
+                BitmapCache::Image* owner = new BitmapCache::Image(image);
+                return Buffer::Create(const_cast<uint8_t*>(image->data()), image->size(), owner, releaseImage);
+            }
+        }
+        return platformFileSystem_->OpenFile(file_path);
+    }
+};
+
+#endif // CACHE_FILE_SYSTEM_H
@@ -0,0 +1,606 @@
+#ifndef CLEANUP_RULES_H
+#define CLEANUP_RULES_H
+
+#include "ArcadeKeyValues.h"
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+
+/**
+ * Cleanup rules - A small rule language for bulk cleanups, run by Library::dbtRunCleanupRules
+ *
+ * One rule per line (or separated by ';'), '#' starts a comment:
+ *
+ *   instances where count(objects) == 0 -> delete
+ *   items where len(local.description) > 4096 -> truncate(local.description, 4096)
+ *   items where exists(local.legacy) and not exists(local.app) -> remove(local.legacy)
+ *
+ * Paths are dotted key names below the table section (root -> "item", "instance", ...).
+ * Expressions: path, number, "string", count(path), len(path), exists(path),
+ *              ==, !=, <, <=, >, >=, contains, and, or, not, parentheses.
+ * Actions:     delete | remove(path) | truncate(path, n) | set(path, value), comma separated.
+ *
+ * Rules are compiled once into closures; they hold no mutable state, so the parallel
+ * scan threads evaluate the same compiled rules concurrently.
+ */
+
+// Value produced by a rule expression. Compared as numbers when both sides are numeric.
+struct CleanupValue {
+    std::string text;
+    double number;
+    bool numeric;
+
+    CleanupValue() : number(0.0), numeric(false) {}
+
+    static CleanupValue fromNumber(double value) {
+        CleanupValue result;
+        result.number = value;
+        result.numeric = true;
+        if (value == static_cast<double>(static_cast<long long>(value))) {
+            result.text = std::to_string(static_cast<long long>(value));
+        }
+        else {
+            result.text = std::to_string(value);
+        }
+        return result;
+    }
+
+    static CleanupValue fromText(const std::string& value) {
+        CleanupValue result;
+        result.text = value;
+        if (!value.empty()) {
+            char* end = nullptr;
+            result.number = std::strtod(value.c_str(), &end);
+            result.numeric = (end && *end == '\0');
+        }
+        return result;
+    }
+
+    bool truthy() const {
+        return numeric ? number != 0.0 : !text.empty();
+    }
+};
+
+typedef std::function<CleanupValue(ArcadeKeyValues*)> CleanupExpression;
+typedef std::function<bool(ArcadeKeyValues*)> CleanupAction;  // Returns true if the section changed
+
+/**
+ * CleanupRule - One compiled rule
+ */
+struct CleanupRule {
+    std::string text;        // Source text, for reports
+    std::string tableName;
+    bool deletesEntry;
+    CleanupExpression predicate;
+    std::vector<CleanupAction> actions;  // Empty when deletesEntry
+
+    bool matches(ArcadeKeyValues* section) const {
+        return predicate(section).truthy();
+    }
+
+    // Apply every action in order; true if anything changed
+    bool apply(ArcadeKeyValues* section) const {
+        bool changed = false;
+        for (const auto& action : actions) {
+            changed = action(section) || changed;
+        }
+        return changed;
+    }
+};
+
+// Follow a dotted path below a section, null if any key is missing
+inline ArcadeKeyValues* cleanupFindPath(ArcadeKeyValues* section, const std::vector<std::string>& keys) {
+    ArcadeKeyValues* node = section;
+    for (const auto& key : keys) {
+        if (!node) {
+            return nullptr;
+        }
+        node = node->FindKey(key.c_str());
+    }
+    return node;
+}
+
+// Scalar value of a node as text (ints and floats included)
+inline std::string cleanupNodeText(ArcadeKeyValues* node) {
+    if (!node) {
+        return "";
+    }
+    switch (node->GetValueType()) {
+    case ArcadeKeyValues::TYPE_STRING: return node->GetString();
+    case ArcadeKeyValues::TYPE_INT: return std::to_string(node->GetInt());
+    case ArcadeKeyValues::TYPE_FLOAT: return std::to_string(node->GetFloat());
+    default: return "";
+    }
+}
+
+/**
+ * CleanupRuleCompiler - Recursive descent parser producing CleanupRule closures
+ */
+class CleanupRuleCompiler {
+private:
+    enum TokenType { TOKEN_IDENT, TOKEN_NUMBER, TOKEN_STRING, TOKEN_SYMBOL, TOKEN_END };
+
+    struct Token {
+        TokenType type;
+        std::string text;
+    };
+
+    std::vector<Token> tokens_;
+    size_t position_;
+    std::string error_;
+
+    bool tokenize(const std::string& source) {
+        tokens_.clear();
+        size_t i = 0;
+        while (i < source.size()) {
+            char c = source[i];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                i++;
+            }
+            else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                // Identifiers include dots so a path is a single token
+                size_t start = i;
+                while (i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_' || source[i] == '.')) {
+                    i++;
+                }
+                tokens_.push_back({ TOKEN_IDENT, source.substr(start, i - start) });
+            }
+            else if (std::isdigit(static_cast<unsigned char>(c)) || (c == '-' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1])))) {
+                size_t start = i++;
+                while (i < source.size() && (std::isdigit(static_cast<unsigned char>(source[i])) || source[i] == '.')) {
+                    i++;
+                }
+                tokens_.push_back({ TOKEN_NUMBER, source.substr(start, i - start) });
+            }
+            else if (c == '"' || c == '\'') {
+                std::string text;
+                i++;
+                while (i < source.size() && source[i] != c) {
+                    if (source[i] == '\\' && i + 1 < source.size()) {
+                        i++;
+                    }
+                    text += source[i++];
+                }
+                if (i >= source.size()) {
+                    error_ = "Unterminated string";
+                    return false;
+                }
+                i++;
+                tokens_.push_back({ TOKEN_STRING, text });
+            }
+            else {
+                static const char* symbols[] = { "->", "==", "!=", "<=", ">=", "&&", "||", "<", ">", "!", "(", ")", "," };
+                bool matched = false;
+                for (const char* symbol : symbols) {
+                    size_t length = std::strlen(symbol);
+                    if (source.compare(i, length, symbol) == 0) {
+                        tokens_.push_back({ TOKEN_SYMBOL, symbol });
+                        i += length;
+                        matched = true;
+                        break;
+                    }
+                }
+                if (!matched) {
+                    error_ = std::string("Unexpected character '") + c + "'";
+                    return false;
+                }
+            }
+        }
+        tokens_.push_back({ TOKEN_END, "" });
+        position_ = 0;
+        return true;
+    }
+
+    const Token& peek() const {
+        return tokens_[position_];
+    }
+
+    bool accept(const char* text) {
+        const Token& token = peek();
+        if (token.type != TOKEN_END && token.type != TOKEN_STRING && token.text == text) {
+            position_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool expect(const char* text) {
+        if (accept(text)) {
+            return true;
+        }
+        fail(std::string("Expected '") + text + "'");
+        return false;
+    }
+
+    void fail(const std::string& message) {
+        if (error_.empty()) {
+            const Token& token = peek();
+            error_ = message + (token.type == TOKEN_END ? " at end of rule" : " near '" + token.text + "'");
+        }
+    }
+
+    static std::vector<std::string> splitPath(const std::string& path) {
+        std::vector<std::string> keys;
+        size_t start = 0;
+        while (start <= path.size()) {
+            size_t dot = path.find('.', start);
+            if (dot == std::string::npos) {
+                dot = path.size();
+            }
+            keys.push_back(path.substr(start, dot - start));
+            start = dot + 1;
+        }
+        return keys;
+    }
+
+    bool parsePath(std::vector<std::string>& keys) {
+        const Token& token = peek();
+        if (token.type != TOKEN_IDENT) {
+            fail("Expected a field path");
+            return false;
+        }
+        keys = splitPath(token.text);
+        for (const auto& key : keys) {
+            if (key.empty()) {
+                fail("Invalid field path");
+                return false;
+            }
+        }
+        position_++;
+        return true;
+    }
+
+    // or-expression
+    CleanupExpression parseExpression() {
+        CleanupExpression left = parseAnd();
+        while (left && (accept("or") || accept("||"))) {
+            CleanupExpression right = parseAnd();
+            if (!right) {
+                return nullptr;
+            }
+            left = [left, right](ArcadeKeyValues* section) {
+                return CleanupValue::fromNumber(left(section).truthy() || right(section).truthy() ? 1 : 0);
+            };
+        }
+        return left;
+    }
+
+    CleanupExpression parseAnd() {
+        CleanupExpression left = parseNot();
+        while (left && (accept("and") || accept("&&"))) {
+            CleanupExpression right = parseNot();
+            if (!right) {
+                return nullptr;
+            }
+            left = [left, right](ArcadeKeyValues* section) {
+                return CleanupValue::fromNumber(left(section).truthy() && right(section).truthy() ? 1 : 0);
+            };
+        }
+        return left;
+    }
+
+    CleanupExpression parseNot() {
+        if (accept("not") || accept("!")) {
+            CleanupExpression operand = parseNot();
+            if (!operand) {
+                return nullptr;
+            }
+            return [operand](ArcadeKeyValues* section) {
+                return CleanupValue::fromNumber(operand(section).truthy() ? 0 : 1);
+            };
+        }
+        return parseComparison();
+    }
+
+    CleanupExpression parseComparison() {
+        CleanupExpression left = parseOperand();
+        if (!left) {
+            return nullptr;
+        }
+
+        static const char* operators[] = { "==", "!=", "<=", ">=", "<", ">", "contains" };
+        for (const char* op : operators) {
+            if (!accept(op)) {
+                continue;
+            }
+            CleanupExpression right = parseOperand();
+            if (!right) {
+                return nullptr;
+            }
+
+            std::string name = op;
+            if (name == "contains") {
+                return [left, right](ArcadeKeyValues* section) {
+                    return CleanupValue::fromNumber(left(section).text.find(right(section).text) != std::string::npos ? 1 : 0);
+                };
+            }
+            return [left, right, name](ArcadeKeyValues* section) {
+                CleanupValue a = left(section);
+                CleanupValue b = right(section);
+                int order = (a.numeric && b.numeric)
+                    ? (a.number < b.number ? -1 : (a.number > b.number ? 1 : 0))
+                    : a.text.compare(b.text);
+                bool result = (name == "==") ? order == 0
+                    : (name == "!=") ? order != 0
+                    : (name == "<") ? order < 0
+                    : (name == "<=") ? order <= 0
+                    : (name == ">") ? order > 0
+                    : order >= 0;
+                return CleanupValue::fromNumber(result ? 1 : 0);
+            };
+        }
+        return left;
+    }
+
+    CleanupExpression parseOperand() {
+        if (accept("(")) {
+            CleanupExpression inner = parseExpression();
+            if (!inner || !expect(")")) {
+                return nullptr;
+            }
+            return inner;
+        }
+
+        const Token token = peek();
+        if (token.type == TOKEN_NUMBER) {
+            position_++;
+            CleanupValue value = CleanupValue::fromText(token.text);
+            return [value](ArcadeKeyValues*) { return value; };
+        }
+        if (token.type == TOKEN_STRING) {
+            position_++;
+            CleanupValue value = CleanupValue::fromText(token.text);
+            return [value](ArcadeKeyValues*) { return value; };
+        }
+        if (token.type != TOKEN_IDENT) {
+            fail("Expected a value");
+            return nullptr;
+        }
+
+        // Functions take a single path
+        if (tokens_[position_ + 1].text == "(" && (token.text == "count" || token.text == "len" || token.text == "exists")) {
+            position_ += 2;
+            std::vector<std::string> keys;
+            if (!parsePath(keys) || !expect(")")) {
+                return nullptr;
+            }
+            if (token.text == "count") {
+                return [keys](ArcadeKeyValues* section) {
+                    ArcadeKeyValues* node = cleanupFindPath(section, keys);
+                    return CleanupValue::fromNumber(node ? node->GetChildCount() : 0);
+                };
+            }
+            if (token.text == "len") {
+                return [keys](ArcadeKeyValues* section) {
+                    return CleanupValue::fromNumber(static_cast<double>(cleanupNodeText(cleanupFindPath(section, keys)).size()));
+                };
+            }
+            return [keys](ArcadeKeyValues* section) {
+                return CleanupValue::fromNumber(cleanupFindPath(section, keys) ? 1 : 0);
+            };
+        }
+
+        std::vector<std::string> keys;
+        if (!parsePath(keys)) {
+            return nullptr;
+        }
+        return [keys](ArcadeKeyValues* section) {
+            return CleanupValue::fromText(cleanupNodeText(cleanupFindPath(section, keys)));
+        };
+    }
+
+    CleanupAction parseAction() {
+        const Token token = peek();
+        if (token.type != TOKEN_IDENT) {
+            fail("Expected an action");
+            return nullptr;
+        }
+        position_++;
+
+        if (!expect("(")) {
+            return nullptr;
+        }
+        std::vector<std::string> keys;
+        if (!parsePath(keys)) {
+            return nullptr;
+        }
+        std::string leaf = keys.back();
+        std::vector<std::string> parentKeys(keys.begin(), keys.end() - 1);
+
+        if (token.text == "remove") {
+            if (!expect(")")) {
+                return nullptr;
+            }
+            return [parentKeys, leaf](ArcadeKeyValues* section) {
+                ArcadeKeyValues* parent = cleanupFindPath(section, parentKeys);
+                return parent ? parent->RemoveKey(leaf.c_str()) : false;
+            };
+        }
+
+        if (!expect(",")) {
+            return nullptr;
+        }
+        const Token argument = peek();
+        if (argument.type != TOKEN_NUMBER && argument.type != TOKEN_STRING) {
+            fail("Expected a number or string");
+            return nullptr;
+        }
+        position_++;
+        if (!expect(")")) {
+            return nullptr;
+        }
+
+        if (token.text == "truncate") {
+            if (argument.type != TOKEN_NUMBER || std::atoi(argument.text.c_str()) < 0) {
+                error_ = "truncate() needs a length";
+                return nullptr;
+            }
+            size_t maxLength = static_cast<size_t>(std::atoi(argument.text.c_str()));
+            return [parentKeys, leaf, maxLength](ArcadeKeyValues* section) {
+                ArcadeKeyValues* parent = cleanupFindPath(section, parentKeys);
+                ArcadeKeyValues* node = parent ? parent->FindKey(leaf.c_str()) : nullptr;
+                if (!node || node->GetValueType() != ArcadeKeyValues::TYPE_STRING) {
+                    return false;
+                }
+                std::string value = node->GetString();
+                if (value.length() <= maxLength) {
+                    return false;
+                }
+                parent->SetString(leaf.c_str(), value.substr(0, maxLength).c_str());
+                return true;
+            };
+        }
+
+        if (token.text == "set") {
+            bool isNumber = argument.type == TOKEN_NUMBER;
+            std::string text = argument.text;
+            return [parentKeys, leaf, isNumber, text](ArcadeKeyValues* section) {
+                // Create missing parent sections
+                ArcadeKeyValues* parent = section;
+                for (const auto& key : parentKeys) {
+                    parent = parent->FindKey(key.c_str(), true);
+                }
+                ArcadeKeyValues* node = parent->FindKey(leaf.c_str());
+                if (node && cleanupNodeText(node) == text) {
+                    return false;
+                }
+                if (isNumber && text.find('.') == std::string::npos) {
+                    parent->SetInt(leaf.c_str(), std::atoi(text.c_str()));
+                }
+                else if (isNumber) {
+                    parent->SetFloat(leaf.c_str(), static_cast<float>(std::atof(text.c_str())));
+                }
+                else {
+                    parent->SetString(leaf.c_str(), text.c_str());
+                }
+                return true;
+            };
+        }
+
+        error_ = "Unknown action '" + token.text + "'";
+        return nullptr;
+    }
+
+    bool compileRule(const std::string& text, const std::vector<std::string>& tableNames, CleanupRule& rule) {
+        if (!tokenize(text)) {
+            return false;
+        }
+
+        const Token& table = peek();
+        if (table.type != TOKEN_IDENT || std::find(tableNames.begin(), tableNames.end(), table.text) == tableNames.end()) {
+            fail("Expected a table name");
+            return false;
+        }
+        rule.text = text;
+        rule.tableName = table.text;
+        position_++;
+
+        if (!expect("where")) {
+            return false;
+        }
+        rule.predicate = parseExpression();
+        if (!rule.predicate || !expect("->")) {
+            return false;
+        }
+
+        rule.deletesEntry = accept("delete");
+        if (!rule.deletesEntry) {
+            do {
+                CleanupAction action = parseAction();
+                if (!action) {
+                    return false;
+                }
+                rule.actions.push_back(action);
+            } while (accept(","));
+        }
+
+        if (peek().type != TOKEN_END) {
+            fail("Unexpected text");
+            return false;
+        }
+        return true;
+    }
+
+public:
+    CleanupRuleCompiler() : position_(0) {}
+
+    // Compile every rule in source; on failure error names the offending line
+    bool compile(const std::string& source, const std::vector<std::string>& tableNames, std::vector<CleanupRule>& rules, std::string& error) {
+        rules.clear();
+
+        int lineNumber = 0;
+        size_t lineStart = 0;
+        while (lineStart <= source.size()) {
+            size_t lineEnd = source.find('\n', lineStart);
+            if (lineEnd == std::string::npos) {
+                lineEnd = source.size();
+            }
+            std::string line = source.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+            lineNumber++;
+
+            // Strip comments (a '#' outside quotes)
+            char quote = 0;
+            for (size_t i = 0; i < line.size(); i++) {
+                if (quote) {
+                    if (line[i] == '\\') i++;
+                    else if (line[i] == quote) quote = 0;
+                }
+                else if (line[i] == '"' || line[i] == '\'') {
+                    quote = line[i];
+                }
+                else if (line[i] == '#') {
+                    line.resize(i);
+                    break;
+                }
+            }
+
+            // ';' separates several rules on one line (outside quotes)
+            std::vector<std::string> statements(1);
+            quote = 0;
+            for (size_t i = 0; i < line.size(); i++) {
+                char c = line[i];
+                if (quote) {
+                    if (c == '\\' && i + 1 < line.size()) statements.back() += line[i++];
+                    else if (c == quote) quote = 0;
+                }
+                else if (c == '"' || c == '\'') {
+                    quote = c;
+                }
+                else if (c == ';') {
+                    statements.emplace_back();
+                    continue;
+                }
+                statements.back() += line[i];
+            }
+
+            for (auto& statement : statements) {
+                size_t first = statement.find_first_not_of(" \t\r");
+                if (first == std::string::npos) {
+                    continue;
+                }
+                statement = statement.substr(first, statement.find_last_not_of(" \t\r") - first + 1);
+
+                CleanupRule rule;
+                error_.clear();
+                if (!compileRule(statement, tableNames, rule)) {
+                    error = "Line " + std::to_string(lineNumber) + ": " + error_;
+                    return false;
+                }
+                rules.push_back(rule);
+            }
+        }
+
+        if (rules.empty()) {
+            error = "No rules given";
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif // CLEANUP_RULES_H
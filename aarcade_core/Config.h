@@ -9,6 +9,14 @@
 class ArcadeConfig {
 private:
     std::string databasePath_;
+    bool lazyInstanceMigration_;
+    int imageLoaderViews_;
+    int nativeDecodeThreads_;
+    int imageCacheBudgetMB_;
+    std::string imageCacheEviction_;
+    std::string imageCacheLayout_;
+    std::string imageCompletionDelivery_;
+    int imageMemoryCacheMB_;
 
     void debugOutput(const std::string& message) {
         std::string debugMsg = "[ArcadeConfig] " + message + "\n";
@@ -23,7 +31,10 @@ private:
     }
 
 public:
-    ArcadeConfig() : databasePath_("database.db") {} // Default value
+    ArcadeConfig() : databasePath_("database.db"), lazyInstanceMigration_(false), imageLoaderViews_(4), nativeDecodeThreads_(2),
+        imageCacheBudgetMB_(2048), imageCacheEviction_("lru"),
+        imageCacheLayout_("v2"), imageCompletionDelivery_("push"),
+        imageMemoryCacheMB_(256) {} // Default values
 
     bool loadFromFile(const std::string& filename = "config.ini") {
         // Get the full path to help with debugging
@@ -70,6 +81,38 @@ public:
                 databasePath_ = value;
                 debugOutput("Set database_path = " + databasePath_);
             }
+            else if (key == "lazy_instance_migration") {
+                lazyInstanceMigration_ = (value == "1" || value == "true");
+                debugOutput("Set lazy_instance_migration = " + value);
+            }
+            else if (key == "image_loader_views") {
+                imageLoaderViews_ = atoi(value.c_str());
+                debugOutput("Set image_loader_views = " + value);
+            }
+            else if (key == "native_decode_threads") {
+                nativeDecodeThreads_ = atoi(value.c_str());
+                debugOutput("Set native_decode_threads = " + value);
+            }
+            else if (key == "image_cache_budget_mb") {
+                imageCacheBudgetMB_ = atoi(value.c_str());
+                debugOutput("Set image_cache_budget_mb = " + value);
+            }
+            else if (key == "image_cache_eviction") {
+                imageCacheEviction_ = value;
+                debugOutput("Set image_cache_eviction = " + imageCacheEviction_);
+            }
+            else if (key == "image_cache_layout") {
+                imageCacheLayout_ = value;
+                debugOutput("Set image_cache_layout = " + imageCacheLayout_);
+            }
+            else if (key == "image_completion_delivery") {
+                imageCompletionDelivery_ = value;
+                debugOutput("Set image_completion_delivery = " + imageCompletionDelivery_);
+            }
+            else if (key == "image_memory_cache_mb") {
+                imageMemoryCacheMB_ = atoi(value.c_str());
+                debugOutput("Set image_memory_cache_mb = " + std::to_string(imageMemoryCacheMB_));
+            }
         }
 
         file.close();
@@ -92,6 +135,26 @@ public:
         file << "# Can be relative to the executable or an absolute path\n";
         file << "database_path = database.db\n";
         file << "\n";
+        file << "# Upgrade old instance generations when they are read, writing the result back\n";
+        file << "lazy_instance_migration = false\n";
+        file << "\n";
+        file << "# Image Cache\n";
+        file << "# Number of offscreen views rendering images into the cache in parallel (1-16)\n";
+        file << "image_loader_views = 4\n";
+        file << "# Threads decoding local image files and encoding rendered PNGs off the UI thread\n";
+        file << "# (0 renders local files in the views too and writes PNGs on the UI thread)\n";
+        file << "native_decode_threads = 2\n";
+        file << "# Size the image cache may grow to before old images are evicted (0 for no limit)\n";
+        file << "image_cache_budget_mb = 2048\n";
+        file << "# Evict the least recently used (lru) or least often used (lfu) images first\n";
+        file << "image_cache_eviction = lru\n";
+        file << "# Cache file layout: v2 (64-bit hash, 256 x 256 folders) or kodi (CRC32, 16 folders)\n";
+        file << "image_cache_layout = v2\n";
+        file << "# How finished images reach the page: push (as soon as they complete) or poll (every 50 ms)\n";
+        file << "image_completion_delivery = push\n";
+        file << "# Memory for decoded images served to the page without a PNG decode, in MB (0 disables it)\n";
+        file << "image_memory_cache_mb = 256\n";
+        file << "\n";
         file << "# Additional configuration options will be added here in the future\n";
 
         file.close();
@@ -103,10 +166,46 @@ public:
         return databasePath_;
     }
 
+    bool getLazyInstanceMigration() const {
+        return lazyInstanceMigration_;
+    }
+
+    int getImageLoaderViews() const {
+        return imageLoaderViews_;
+    }
+
+    int getNativeDecodeThreads() const {
+        return nativeDecodeThreads_;
+    }
+
+    int getImageCacheBudgetMB() const {
+        return imageCacheBudgetMB_;
+    }
+
+    const std::string& getImageCacheEviction() const {
+        return imageCacheEviction_;
+    }
+
+    const std::string& getImageCacheLayout() const {
+        return imageCacheLayout_;
+    }
+
+    const std::string& getImageCompletionDelivery() const {
+        return imageCompletionDelivery_;
+    }
+
+    int getImageMemoryCacheMB() const {
+        return imageMemoryCacheMB_;
+    }
+
     // Setters (for future use)
     void setDatabasePath(const std::string& path) {
         databasePath_ = path;
     }
+
+    void setLazyInstanceMigration(bool enabled) {
+        lazyInstanceMigration_ = enabled;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,327 @@
+#ifndef FIELD_SKETCHES_H
+#define FIELD_SKETCHES_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+/**
+ * Approximate per-field statistics for tables too large to count exactly.
+ *
+ * Every sketch has a fixed memory footprint, can be merged with another sketch of
+ * the same kind (so each scan thread keeps its own and they are combined at the end)
+ * and serializes to a compact blob stored in the field_statistics table.
+ */
+
+// 64-bit FNV-1a followed by a splitmix finalizer so low and high bits are both well mixed
+inline uint64_t sketchHash(const std::string& value) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : value) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+/**
+ * HyperLogLog - Distinct value count, ~1.6% standard error with 4096 registers
+ */
+class HyperLogLog {
+public:
+    static const int precision = 12;
+    static const int registerCount = 1 << precision;
+
+private:
+    std::vector<uint8_t> registers_;
+
+public:
+    HyperLogLog() : registers_(registerCount, 0) {}
+
+    void add(const std::string& value) {
+        uint64_t hash = sketchHash(value);
+        uint32_t index = static_cast<uint32_t>(hash >> (64 - precision));
+        uint64_t rest = (hash << precision) | (1ULL << (precision - 1));  // Sentinel bit bounds the rank
+
+        uint8_t rank = 1;
+        while (!(rest & 0x8000000000000000ULL)) {
+            rank++;
+            rest <<= 1;
+        }
+        registers_[index] = std::max(registers_[index], rank);
+    }
+
+    void merge(const HyperLogLog& other) {
+        for (int i = 0; i < registerCount; i++) {
+            registers_[i] = std::max(registers_[i], other.registers_[i]);
+        }
+    }
+
+    double estimate() const {
+        double sum = 0.0;
+        int zeroRegisters = 0;
+        for (uint8_t r : registers_) {
+            sum += std::ldexp(1.0, -r);
+            if (r == 0) {
+                zeroRegisters++;
+            }
+        }
+
+        const double m = registerCount;
+        double raw = (0.7213 / (1.0 + 1.079 / m)) * m * m / sum;
+
+        // Small range correction (linear counting)
+        if (raw <= 2.5 * m && zeroRegisters > 0) {
+            return m * std::log(m / zeroRegisters);
+        }
+        return raw;
+    }
+
+    const std::vector<uint8_t>& getRegisters() const { return registers_; }
+
+    void setRegisters(const uint8_t* data) {
+        std::memcpy(registers_.data(), data, registerCount);
+    }
+};
+
+/**
+ * MisraGriesTopK - Most frequent values. Counts are lower bounds, off by at most total / (k + 1).
+ */
+class MisraGriesTopK {
+public:
+    static const size_t maxValueLength = 64;  // Longer values are truncated before counting
+
+private:
+    size_t k_;
+    std::map<std::string, int64_t> counters_;
+
+    // Keep only the k largest counters, subtracting the (k+1)-th from all of them
+    void prune() {
+        if (counters_.size() <= k_) {
+            return;
+        }
+
+        std::vector<int64_t> counts;
+        counts.reserve(counters_.size());
+        for (const auto& counter : counters_) {
+            counts.push_back(counter.second);
+        }
+        std::nth_element(counts.begin(), counts.begin() + k_, counts.end(), std::greater<int64_t>());
+        int64_t threshold = counts[k_];
+
+        for (auto it = counters_.begin(); it != counters_.end();) {
+            it->second -= threshold;
+            if (it->second <= 0) {
+                it = counters_.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+public:
+    MisraGriesTopK(size_t k = 32) : k_(k) {}
+
+    void add(const std::string& value) {
+        std::string key = value.size() > maxValueLength ? value.substr(0, maxValueLength) : value;
+
+        auto it = counters_.find(key);
+        if (it != counters_.end()) {
+            it->second++;
+            return;
+        }
+        if (counters_.size() < k_) {
+            counters_[key] = 1;
+            return;
+        }
+
+        // Table full: decrement everything, dropping counters that reach zero
+        for (auto counter = counters_.begin(); counter != counters_.end();) {
+            if (--counter->second == 0) {
+                counter = counters_.erase(counter);
+            }
+            else {
+                ++counter;
+            }
+        }
+    }
+
+    void merge(const MisraGriesTopK& other) {
+        for (const auto& counter : other.counters_) {
+            counters_[counter.first] += counter.second;
+        }
+        prune();
+    }
+
+    void set(const std::string& value, int64_t count) {
+        counters_[value] = count;
+    }
+
+    // Values sorted by descending count
+    std::vector<std::pair<std::string, int64_t>> top() const {
+        std::vector<std::pair<std::string, int64_t>> sorted(counters_.begin(), counters_.end());
+        std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, int64_t>& a, const std::pair<std::string, int64_t>& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        return sorted;
+    }
+};
+
+/**
+ * LengthHistogram - Value lengths in power-of-two buckets: 0, 1, 2-3, 4-7, ..., 32768+
+ */
+class LengthHistogram {
+public:
+    static const int bucketCount = 17;
+
+private:
+    std::vector<int64_t> buckets_;
+
+public:
+    LengthHistogram() : buckets_(bucketCount, 0) {}
+
+    static int bucketFor(size_t length) {
+        int bucket = 0;
+        while (length > 0 && bucket < bucketCount - 1) {
+            length >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    // Smallest length that falls in a bucket
+    static int64_t bucketStart(int bucket) {
+        return bucket == 0 ? 0 : (1LL << (bucket - 1));
+    }
+
+    void add(size_t length) {
+        buckets_[bucketFor(length)]++;
+    }
+
+    void merge(const LengthHistogram& other) {
+        for (int i = 0; i < bucketCount; i++) {
+            buckets_[i] += other.buckets_[i];
+        }
+    }
+
+    const std::vector<int64_t>& getBuckets() const { return buckets_; }
+    std::vector<int64_t>& getBuckets() { return buckets_; }
+};
+
+/**
+ * FieldSketch - All sketches kept for one KV path
+ */
+struct FieldSketch {
+    int64_t count;       // Values seen
+    size_t maxLength;
+    HyperLogLog distinct;
+    MisraGriesTopK topValues;
+    LengthHistogram lengths;
+
+    FieldSketch() : count(0), maxLength(0) {}
+
+    void add(const std::string& value) {
+        count++;
+        maxLength = std::max(maxLength, value.size());
+        distinct.add(value);
+        topValues.add(value);
+        lengths.add(value.size());
+    }
+
+    void merge(const FieldSketch& other) {
+        count += other.count;
+        maxLength = std::max(maxLength, other.maxLength);
+        distinct.merge(other.distinct);
+        topValues.merge(other.topValues);
+        lengths.merge(other.lengths);
+    }
+
+    // Layout: version, count, maxLength, HLL registers, length buckets, top value count, (length, bytes, count)...
+    std::vector<uint8_t> serialize() const {
+        std::vector<uint8_t> blob;
+        auto append = [&blob](const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            blob.insert(blob.end(), bytes, bytes + size);
+        };
+
+        uint8_t version = 1;
+        int64_t maxLen = static_cast<int64_t>(maxLength);
+        append(&version, sizeof(version));
+        append(&count, sizeof(count));
+        append(&maxLen, sizeof(maxLen));
+        append(distinct.getRegisters().data(), HyperLogLog::registerCount);
+        append(lengths.getBuckets().data(), sizeof(int64_t) * LengthHistogram::bucketCount);
+
+        std::vector<std::pair<std::string, int64_t>> top = topValues.top();
+        uint16_t topCount = static_cast<uint16_t>(top.size());
+        append(&topCount, sizeof(topCount));
+        for (const auto& value : top) {
+            uint16_t length = static_cast<uint16_t>(value.first.size());
+            append(&length, sizeof(length));
+            append(value.first.data(), length);
+            append(&value.second, sizeof(value.second));
+        }
+        return blob;
+    }
+
+    bool deserialize(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        size_t position = 0;
+        auto read = [&](void* target, size_t length) {
+            if (position + length > size) {
+                return false;
+            }
+            std::memcpy(target, bytes + position, length);
+            position += length;
+            return true;
+        };
+
+        uint8_t version = 0;
+        int64_t maxLen = 0;
+        if (!read(&version, sizeof(version)) || version != 1 ||
+            !read(&count, sizeof(count)) || !read(&maxLen, sizeof(maxLen))) {
+            return false;
+        }
+        maxLength = static_cast<size_t>(maxLen);
+
+        if (position + HyperLogLog::registerCount > size) {
+            return false;
+        }
+        distinct.setRegisters(bytes + position);
+        position += HyperLogLog::registerCount;
+
+        if (!read(lengths.getBuckets().data(), sizeof(int64_t) * LengthHistogram::bucketCount)) {
+            return false;
+        }
+
+        uint16_t topCount = 0;
+        if (!read(&topCount, sizeof(topCount))) {
+            return false;
+        }
+        for (uint16_t i = 0; i < topCount; i++) {
+            uint16_t length = 0;
+            int64_t valueCount = 0;
+            if (!read(&length, sizeof(length)) || position + length > size) {
+                return false;
+            }
+            std::string value(reinterpret_cast<const char*>(bytes + position), length);
+            position += length;
+            if (!read(&valueCount, sizeof(valueCount))) {
+                return false;
+            }
+            topValues.set(value, valueCount);
+        }
+        return true;
+    }
+};
+
+#endif // FIELD_SKETCHES_H
@@ -0,0 +1,199 @@
+#ifndef HEALTH_CHECKS_H
+#define HEALTH_CHECKS_H
+
+#include "ArcadeKeyValues.h"
+#include <string>
+#include <vector>
+#include <set>
+#include <memory>
+
+/**
+ * HealthFinding - One problem found by a health check, stored in the health_findings table
+ */
+struct HealthFinding {
+    std::string tableName;
+    std::string id;
+    std::string check;   // Check name, e.g. "largeBlob"
+    std::string detail;  // Check specific, e.g. title, list of keys, id found in the blob
+    int sizeBytes;
+    int count;           // Check specific, e.g. number of unexpected keys
+};
+
+/**
+ * HealthScanRow - A decoded entry handed to every check during a health scan
+ */
+struct HealthScanRow {
+    std::string tableName;
+    std::string id;
+    int sizeBytes;
+    bool parsed;                  // false if the blob could not be decoded
+    std::string parseError;
+    ArcadeKeyValues* section;     // root -> first subkey ("item", "instance", ...), null if not parsed
+};
+
+/**
+ * HealthCheck - Visitor run over each entry by Library::dbtRunHealthScan
+ *
+ * The scan reads and decodes every row once and hands it to each check in turn.
+ * To add a check, derive from this class and add it to createDefaultHealthChecks().
+ */
+class HealthCheck {
+public:
+    virtual ~HealthCheck() {}
+    virtual const char* name() const = 0;
+    virtual void visit(const HealthScanRow& row, std::vector<HealthFinding>& findings) = 0;
+
+protected:
+    void addFinding(const HealthScanRow& row, std::vector<HealthFinding>& findings, const std::string& detail, int count) {
+        findings.push_back({ row.tableName, row.id, name(), detail, row.sizeBytes, count });
+    }
+};
+
+// Blobs at or above a size threshold (same as dbtFindLargeEntriesInTable)
+class LargeBlobCheck : public HealthCheck {
+private:
+    int minSizeBytes_;
+
+public:
+    LargeBlobCheck(int minSizeBytes) : minSizeBytes_(minSizeBytes) {}
+
+    const char* name() const override { return "largeBlob"; }
+
+    void visit(const HealthScanRow& row, std::vector<HealthFinding>& findings) override {
+        if (row.sizeBytes < minSizeBytes_) {
+            return;
+        }
+
+        // Title from the "local" subsection when present, otherwise from the table section
+        std::string title = row.id;
+        if (row.section) {
+            ArcadeKeyValues* dataSection = row.section->FindKey("local");
+            if (!dataSection) {
+                dataSection = row.section;
+            }
+            std::string extractedTitle = dataSection->GetString("title", "");
+            if (!extractedTitle.empty()) {
+                title = extractedTitle;
+            }
+        }
+        addFinding(row, findings, title, 0);
+    }
+};
+
+// Blobs the KeyValues parser could not make sense of
+class UnparsableCheck : public HealthCheck {
+public:
+    const char* name() const override { return "unparsable"; }
+
+    void visit(const HealthScanRow& row, std::vector<HealthFinding>& findings) override {
+        if (!row.parsed) {
+            addFinding(row, findings, row.parseError, 0);
+        }
+    }
+};
+
+// Instances with root keys other than the expected set (same as dbtFindAnomalousInstances)
+class UnexpectedRootKeysCheck : public HealthCheck {
+private:
+    std::set<std::string> expectedKeys_;
+
+public:
+    UnexpectedRootKeysCheck() : expectedKeys_({ "generation", "info", "objects", "overrides", "legacy" }) {}
+
+    const char* name() const override { return "unexpectedRootKeys"; }
+
+    void visit(const HealthScanRow& row, std::vector<HealthFinding>& findings) override {
+        if (row.tableName != "instances" || !row.section) {
+            return;
+        }
+
+        std::string keys;
+        int keyCount = 0;
+        for (ArcadeKeyValues* child = row.section->GetFirstSubKey(); child; child = child->GetNextKey()) {
+            const char* keyName = child->GetName();
+            if (keyName && keyName[0] != '\0' && expectedKeys_.find(keyName) == expectedKeys_.end()) {
+                keys += (keyCount > 0 ? ", " : "") + std::string(keyName);
+                keyCount++;
+            }
+        }
+
+        if (keyCount > 0) {
+            addFinding(row, findings, keys, keyCount);
+        }
+    }
+};
+
+// Instances with no "objects" key or an empty one (same as dbtFindEmptyInstances)
+class EmptyObjectsCheck : public HealthCheck {
+public:
+    const char* name() const override { return "emptyObjects"; }
+
+    void visit(const HealthScanRow& row, std::vector<HealthFinding>& findings) override {
+        if (row.tableName != "instances" || !row.section) {
+            return;
+        }
+
+        ArcadeKeyValues* objectsSection = row.section->FindKey("objects");
+        if (!objectsSection) {
+            addFinding(row, findings, "missing", 0);
+        }
+        else if (objectsSection->GetChildCount() == 0) {
+            addFinding(row, findings, "empty", 0);
+        }
+    }
+};
+
+// Id stored inside the blob: info/id for items and apps, info/local/id for instances
+inline std::string healthCheckBlobId(ArcadeKeyValues* section) {
+    ArcadeKeyValues* info = section ? section->FindKey("info") : nullptr;
+    if (!info) {
+        return "";
+    }
+
+    std::string id = info->GetString("id", "");
+    if (id.empty()) {
+        ArcadeKeyValues* local = info->FindKey("local");
+        if (local) {
+            id = local->GetString("id", "");
+        }
+    }
+    return id;
+}
+
+// Entries without an id inside the blob
+class MissingInfoIdCheck : public HealthCheck {
+public:
+    const char* name() const override { return "missingInfoId"; }
+
+    void visit(const HealthScanRow& row, std::vector<HealthFinding>& findings) override {
+        if (row.section && healthCheckBlobId(row.section).empty()) {
+            addFinding(row, findings, row.section->FindKey("info") ? "info has no id" : "no info section", 0);
+        }
+    }
+};
+
+// Entries whose blob id differs from the row id
+class IdMismatchCheck : public HealthCheck {
+public:
+    const char* name() const override { return "idMismatch"; }
+
+    void visit(const HealthScanRow& row, std::vector<HealthFinding>& findings) override {
+        std::string blobId = healthCheckBlobId(row.section);
+        if (!blobId.empty() && blobId != row.id) {
+            addFinding(row, findings, blobId, 0);
+        }
+    }
+};
+
+inline std::vector<std::unique_ptr<HealthCheck>> createDefaultHealthChecks(int largeBlobBytes) {
+    std::vector<std::unique_ptr<HealthCheck>> checks;
+    checks.push_back(std::make_unique<LargeBlobCheck>(largeBlobBytes));
+    checks.push_back(std::make_unique<UnparsableCheck>());
+    checks.push_back(std::make_unique<UnexpectedRootKeysCheck>());
+    checks.push_back(std::make_unique<EmptyObjectsCheck>());
+    checks.push_back(std::make_unique<MissingInfoIdCheck>());
+    checks.push_back(std::make_unique<IdMismatchCheck>());
+    return checks;
+}
+
+#endif // HEALTH_CHECKS_H
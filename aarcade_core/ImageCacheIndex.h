@@ -0,0 +1,794 @@
+#ifndef IMAGE_CACHE_INDEX_H
+#define IMAGE_CACHE_INDEX_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <windows.h>
+#include "sqlite/sqlite3.h"
+
+/**
+ * ImageCacheIndex - Manifest of the image cache with a size budget
+ *
+ * Every cached PNG has a row in "<cache dir>\index.db" (hash, url, size, width, height,
+ * last_access, hits, status). The rows are loaded into memory, so cache lookups never
+ * touch the filesystem; access times and hit counts are updated in memory and written
+ * back by a sweeper thread, which also evicts files once the cache grows past its budget.
+ *
+ * The sweeper loads the index and reconciles it with the files on disk when it starts:
+ * files without a row are added, rows without a file are dropped. Until that is done
+ * lookup() answers LOOKUP_UNKNOWN and the caller checks the file itself.
+ *
+ * Eviction removes the least recently used files (or the least often used with
+ * POLICY_LFU, oldest first among equals) until the cache is back under 90% of the budget.
+ *
+ * Two layouts share the directory, told apart by the length of the hash:
+ *   LAYOUT_KODI  "<h>\<8 hex CRC32>.png"            (16 folders, Kodi compatible)
+ *   LAYOUT_V2    "<hh>\<hh>\<16 hex FNV-1a 64>.png" (256 x 256 folders)
+ * With a migration set, the sweeper moves Kodi-layout files whose URL it knows to their
+ * v2 path in the background. It is the only thread that moves them; until it has, lookups
+ * are answered from the Kodi path.
+ *
+ * URLs that failed to load are kept in a "failures" table (hash, url, failures, last_error,
+ * next_retry). Each failure doubles the time before the URL is tried again, from one minute
+ * up to a day; until then isBackedOff() tells the loader to refuse it. A successful add()
+ * clears the record.
+ */
+class ImageCacheIndex {
+public:
+    enum Status {
+        STATUS_READY = 1
+    };
+
+    enum Policy {
+        POLICY_LRU,
+        POLICY_LFU
+    };
+
+    enum Layout {
+        LAYOUT_KODI,
+        LAYOUT_V2
+    };
+
+    enum LookupResult {
+        LOOKUP_MISS,
+        LOOKUP_HIT,
+        LOOKUP_UNKNOWN  // Index not loaded yet
+    };
+
+    struct Entry {
+        std::string url;
+        int64_t size;
+        int width;
+        int height;
+        int64_t lastAccess;  // Unix time
+        int64_t hits;
+        int status;
+        bool dirty;  // Changed since the last flush
+    };
+
+    struct Failure {
+        std::string url;
+        int failures;
+        std::string lastError;
+        int64_t nextRetry;  // Unix time
+        bool dirty;
+    };
+
+private:
+    std::string cacheBasePath_;
+    sqlite3* db_;  // Only used on the sweeper thread
+
+    std::map<std::string, Entry> entries_;  // Hash -> entry
+    std::set<std::string> removed_;         // Hashes to delete from the index on the next flush
+    std::map<std::string, Failure> failures_;  // Hash -> failure record
+    std::set<std::string> clearedFailures_;    // Hashes to delete from the failures table on the next flush
+    bool clearAllFailures_;                    // Empty the failures table on the next flush
+    int64_t totalBytes_;
+    int64_t budgetBytes_;  // 0 for no limit
+    Policy policy_;
+    bool loaded_;
+
+    std::function<std::string(const std::string&)> migrationHashFor_;  // URL -> v2 hash, empty for none
+    bool migrationDone_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_;
+    std::thread sweeper_;
+
+    static const int SWEEP_INTERVAL_SECONDS = 30;
+    static const int FAILURE_BACKOFF_SECONDS = 60;          // After the first failure
+    static const int FAILURE_BACKOFF_MAX_SECONDS = 86400;   // Cap on the doubling
+
+    static void debugOutput(const std::string& message) {
+        std::string debugMsg = "[ImageCacheIndex] " + message;
+        OutputDebugStringA((debugMsg + "\n").c_str());
+    }
+
+    static int64_t now() {
+        return static_cast<int64_t>(time(nullptr));
+    }
+
+    std::string filePathFor(const std::string& hash) const {
+        return cacheBasePath_ + "\\" + relativePathFor(hash);
+    }
+
+    // Collect "<hash>.png" files in the layout folders below the cache directory. Leftover
+    // "<hash>.png.partial" files from a crashed write are deleted; one still being written is
+    // open without delete sharing, so DeleteFileA leaves it alone.
+    static void collectFiles(const std::string& directory, int depth,
+                             std::map<std::string, std::pair<int64_t, int64_t>>& files, int& partialsDeleted) {
+        WIN32_FIND_DATAA findData;
+        HANDLE find = FindFirstFileA((directory + "\\*").c_str(), &findData);
+        if (find == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        do {
+            std::string name = findData.cFileName;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                if (depth < 2) {
+                    collectFiles(directory + "\\" + name, depth + 1, files, partialsDeleted);
+                }
+                continue;
+            }
+            if (depth > 0 && name.length() > 8 && name.compare(name.length() - 8, 8, ".partial") == 0) {
+                if (DeleteFileA((directory + "\\" + name).c_str())) {
+                    partialsDeleted++;
+                }
+                continue;
+            }
+            if (depth == 0 || name.length() <= 4 || name.compare(name.length() - 4, 4, ".png") != 0) {
+                continue;
+            }
+
+            ULARGE_INTEGER size;
+            size.LowPart = findData.nFileSizeLow;
+            size.HighPart = findData.nFileSizeHigh;
+            ULARGE_INTEGER written;
+            written.LowPart = findData.ftLastWriteTime.dwLowDateTime;
+            written.HighPart = findData.ftLastWriteTime.dwHighDateTime;
+            int64_t writtenUnix = static_cast<int64_t>((written.QuadPart - 116444736000000000ULL) / 10000000ULL);
+            files[name.substr(0, name.length() - 4)] = { static_cast<int64_t>(size.QuadPart), writtenUnix };
+        } while (FindNextFileA(find, &findData));
+        FindClose(find);
+    }
+
+    // Width and height from the IHDR chunk, 0 x 0 if the file is not a PNG
+    static void readPngSize(const std::string& path, int& width, int& height) {
+        width = 0;
+        height = 0;
+
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        unsigned char header[24];
+        DWORD read = 0;
+        if (ReadFile(file, header, sizeof(header), &read, nullptr) && read == sizeof(header) &&
+            header[0] == 0x89 && header[1] == 'P' && header[2] == 'N' && header[3] == 'G') {
+            width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+            height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+        }
+        CloseHandle(file);
+    }
+
+    bool openDatabase() {
+        std::string path = cacheBasePath_ + "\\index.db";
+        if (sqlite3_open(path.c_str(), &db_) != SQLITE_OK) {
+            debugOutput("ERROR: Failed to open " + path + ": " + sqlite3_errmsg(db_));
+            sqlite3_close(db_);
+            db_ = nullptr;
+            return false;
+        }
+        sqlite3_busy_timeout(db_, 5000);
+
+        const char* schema =
+            "CREATE TABLE IF NOT EXISTS images ("
+            "hash TEXT PRIMARY KEY, url TEXT, size INTEGER, width INTEGER, height INTEGER, "
+            "last_access INTEGER, hits INTEGER, status INTEGER);"
+            "CREATE TABLE IF NOT EXISTS failures ("
+            "hash TEXT PRIMARY KEY, url TEXT, failures INTEGER, last_error TEXT, next_retry INTEGER);";
+        char* errMsg = nullptr;
+        if (sqlite3_exec(db_, schema, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+            debugOutput("ERROR: Failed to create the index tables: " + std::string(errMsg ? errMsg : "unknown"));
+            sqlite3_free(errMsg);
+            sqlite3_close(db_);
+            db_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    // Read the index rows, then match them against the files on disk
+    void loadAndReconcile() {
+        std::map<std::string, Entry> loaded;
+        sqlite3_stmt* stmt = nullptr;
+        if (db_ && sqlite3_prepare_v2(db_, "SELECT hash, url, size, width, height, last_access, hits, status FROM images;",
+                                      -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* hash = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const char* url = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+                if (!hash) {
+                    continue;
+                }
+                Entry entry;
+                entry.url = url ? url : "";
+                entry.size = sqlite3_column_int64(stmt, 2);
+                entry.width = sqlite3_column_int(stmt, 3);
+                entry.height = sqlite3_column_int(stmt, 4);
+                entry.lastAccess = sqlite3_column_int64(stmt, 5);
+                entry.hits = sqlite3_column_int64(stmt, 6);
+                entry.status = sqlite3_column_int(stmt, 7);
+                entry.dirty = false;
+                loaded[hash] = entry;
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        std::map<std::string, Failure> loadedFailures;
+        if (db_ && sqlite3_prepare_v2(db_, "SELECT hash, url, failures, last_error, next_retry FROM failures;",
+                                      -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* hash = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const char* url = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+                const char* lastError = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+                if (!hash) {
+                    continue;
+                }
+                Failure failure;
+                failure.url = url ? url : "";
+                failure.failures = sqlite3_column_int(stmt, 2);
+                failure.lastError = lastError ? lastError : "";
+                failure.nextRetry = sqlite3_column_int64(stmt, 4);
+                failure.dirty = false;
+                loadedFailures[hash] = failure;
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        // Walk both layouts
+        std::map<std::string, std::pair<int64_t, int64_t>> files;  // Hash -> (size, last write as unix time)
+        int partialsDeleted = 0;
+        collectFiles(cacheBasePath_, 0, files, partialsDeleted);
+
+        int added = 0;
+        int dropped = 0;
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Rows without a file are gone from the cache
+        for (auto& row : loaded) {
+            auto file = files.find(row.first);
+            if (file == files.end()) {
+                if (entries_.find(row.first) == entries_.end()) {
+                    removed_.insert(row.first);
+                    dropped++;
+                }
+                continue;
+            }
+            if (row.second.size != file->second.first) {
+                row.second.size = file->second.first;
+                row.second.dirty = true;
+            }
+            // Lookups made before the index was loaded win
+            if (entries_.find(row.first) == entries_.end()) {
+                entries_[row.first] = row.second;
+            }
+        }
+
+        // Files without a row were cached before the index existed (or by a crashed session)
+        for (const auto& file : files) {
+            if (entries_.find(file.first) != entries_.end()) {
+                continue;
+            }
+            Entry entry;
+            entry.size = file.second.first;
+            readPngSize(filePathFor(file.first), entry.width, entry.height);
+            entry.lastAccess = file.second.second;
+            entry.hits = 0;
+            entry.status = STATUS_READY;
+            entry.dirty = true;
+            entries_[file.first] = entry;
+            added++;
+        }
+
+        totalBytes_ = 0;
+        for (const auto& entry : entries_) {
+            totalBytes_ += entry.second.size;
+        }
+
+        // Failures recorded or cleared before the index was loaded win
+        if (!clearAllFailures_) {
+            for (const auto& failure : loadedFailures) {
+                if (failures_.find(failure.first) == failures_.end() &&
+                    clearedFailures_.find(failure.first) == clearedFailures_.end()) {
+                    failures_[failure.first] = failure.second;
+                }
+            }
+        }
+        loaded_ = true;
+
+        debugOutput("Loaded " + std::to_string(entries_.size()) + " images (" + std::to_string(totalBytes_) +
+                    " bytes) and " + std::to_string(failures_.size()) + " failing URLs; added " + std::to_string(added) +
+                    " unindexed files, dropped " + std::to_string(dropped) + " missing ones, deleted " +
+                    std::to_string(partialsDeleted) + " partial writes");
+    }
+
+    // Write changed rows and deletions in one transaction
+    void flush() {
+        std::vector<std::pair<std::string, Entry>> changed;
+        std::vector<std::string> deleted;
+        std::vector<std::pair<std::string, Failure>> changedFailures;
+        std::vector<std::string> deletedFailures;
+        bool clearAllFailures = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& entry : entries_) {
+                if (entry.second.dirty) {
+                    changed.push_back(entry);
+                    entry.second.dirty = false;
+                }
+            }
+            deleted.assign(removed_.begin(), removed_.end());
+            removed_.clear();
+
+            for (auto& failure : failures_) {
+                if (failure.second.dirty) {
+                    changedFailures.push_back(failure);
+                    failure.second.dirty = false;
+                }
+            }
+            deletedFailures.assign(clearedFailures_.begin(), clearedFailures_.end());
+            clearedFailures_.clear();
+            clearAllFailures = clearAllFailures_ && loaded_;  // Loading still has to see the flag
+            if (clearAllFailures) {
+                clearAllFailures_ = false;
+            }
+        }
+
+        if (!db_ || (changed.empty() && deleted.empty() && changedFailures.empty() && deletedFailures.empty() &&
+                     !clearAllFailures)) {
+            return;
+        }
+
+        sqlite3_stmt* upsertStmt = nullptr;
+        sqlite3_stmt* deleteStmt = nullptr;
+
+        // === BEGIN TRANSACTION ===
+        sqlite3_exec(db_, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+
+        if (clearAllFailures) {
+            sqlite3_exec(db_, "DELETE FROM failures;", nullptr, nullptr, nullptr);
+        }
+
+        if (sqlite3_prepare_v2(db_, "INSERT OR REPLACE INTO failures (hash, url, failures, last_error, next_retry) "
+                                    "VALUES (?, ?, ?, ?, ?);", -1, &upsertStmt, nullptr) == SQLITE_OK) {
+            for (const auto& failure : changedFailures) {
+                sqlite3_bind_text(upsertStmt, 1, failure.first.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(upsertStmt, 2, failure.second.url.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(upsertStmt, 3, failure.second.failures);
+                sqlite3_bind_text(upsertStmt, 4, failure.second.lastError.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int64(upsertStmt, 5, failure.second.nextRetry);
+                sqlite3_step(upsertStmt);
+                sqlite3_reset(upsertStmt);
+            }
+            sqlite3_finalize(upsertStmt);
+            upsertStmt = nullptr;
+        }
+
+        if (sqlite3_prepare_v2(db_, "DELETE FROM failures WHERE hash = ?;", -1, &deleteStmt, nullptr) == SQLITE_OK) {
+            for (const std::string& hash : deletedFailures) {
+                sqlite3_bind_text(deleteStmt, 1, hash.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_step(deleteStmt);
+                sqlite3_reset(deleteStmt);
+            }
+            sqlite3_finalize(deleteStmt);
+            deleteStmt = nullptr;
+        }
+
+        if (sqlite3_prepare_v2(db_, "INSERT OR REPLACE INTO images (hash, url, size, width, height, last_access, hits, status) "
+                                    "VALUES (?, ?, ?, ?, ?, ?, ?, ?);", -1, &upsertStmt, nullptr) == SQLITE_OK) {
+            for (const auto& entry : changed) {
+                sqlite3_bind_text(upsertStmt, 1, entry.first.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(upsertStmt, 2, entry.second.url.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int64(upsertStmt, 3, entry.second.size);
+                sqlite3_bind_int(upsertStmt, 4, entry.second.width);
+                sqlite3_bind_int(upsertStmt, 5, entry.second.height);
+                sqlite3_bind_int64(upsertStmt, 6, entry.second.lastAccess);
+                sqlite3_bind_int64(upsertStmt, 7, entry.second.hits);
+                sqlite3_bind_int(upsertStmt, 8, entry.second.status);
+                sqlite3_step(upsertStmt);
+                sqlite3_reset(upsertStmt);
+            }
+            sqlite3_finalize(upsertStmt);
+        }
+
+        if (sqlite3_prepare_v2(db_, "DELETE FROM images WHERE hash = ?;", -1, &deleteStmt, nullptr) == SQLITE_OK) {
+            for (const std::string& hash : deleted) {
+                sqlite3_bind_text(deleteStmt, 1, hash.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_step(deleteStmt);
+                sqlite3_reset(deleteStmt);
+            }
+            sqlite3_finalize(deleteStmt);
+        }
+
+        sqlite3_exec(db_, "COMMIT;", nullptr, nullptr, nullptr);
+        // === COMMIT TRANSACTION ===
+    }
+
+    // Delete files until the cache is under 90% of the budget
+    void evictIfNeeded() {
+        std::vector<std::string> victims;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (budgetBytes_ <= 0 || totalBytes_ <= budgetBytes_) {
+                return;
+            }
+
+            std::vector<std::pair<std::pair<int64_t, int64_t>, std::string>> order;  // ((key, last access), hash)
+            order.reserve(entries_.size());
+            for (const auto& entry : entries_) {
+                int64_t key = policy_ == POLICY_LFU ? entry.second.hits : entry.second.lastAccess;
+                order.push_back({ { key, entry.second.lastAccess }, entry.first });
+            }
+            std::sort(order.begin(), order.end());
+
+            int64_t target = budgetBytes_ / 10 * 9;
+            for (const auto& candidate : order) {
+                if (totalBytes_ <= target) {
+                    break;
+                }
+                auto it = entries_.find(candidate.second);
+                totalBytes_ -= it->second.size;
+                entries_.erase(it);
+                removed_.insert(candidate.second);
+                victims.push_back(candidate.second);
+            }
+        }
+
+        for (const std::string& hash : victims) {
+            DeleteFileA(filePathFor(hash).c_str());
+        }
+        debugOutput("Evicted " + std::to_string(victims.size()) + " images");
+    }
+
+    // Move one image to a new hash (and so a new path), keeping its stats. Sweeper thread only:
+    // lookups serve the old path until this has run. False if the old hash is not cached or the
+    // file could not be moved.
+    bool migrateEntry(const std::string& oldHash, const std::string& newHash) {
+        Entry entry;
+        bool replaced = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(oldHash);
+            if (it == entries_.end()) {
+                return false;
+            }
+            entry = it->second;
+            replaced = entries_.find(newHash) != entries_.end();
+        }
+
+        // Rendered again in the new layout meanwhile: that file wins and the old one just goes
+        std::string oldPath = filePathFor(oldHash);
+        if (replaced) {
+            if (!DeleteFileA(oldPath.c_str()) && GetLastError() != ERROR_FILE_NOT_FOUND) {
+                return false;
+            }
+        } else {
+            std::string newPath = filePathFor(newHash);
+            createFoldersFor(newPath);
+            if (!MoveFileExA(oldPath.c_str(), newPath.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+                return false;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto old = entries_.find(oldHash);
+        if (old != entries_.end()) {
+            entry = old->second;  // Accesses counted since the copy above
+            entries_.erase(old);
+            removed_.insert(oldHash);
+        }
+        auto existing = entries_.find(newHash);
+        if (existing != entries_.end()) {
+            if (replaced) {
+                totalBytes_ -= entry.size;  // Only the new-layout file is left
+                return true;
+            }
+            totalBytes_ -= existing->second.size;  // Written during the move, then replaced by the moved file
+        }
+        entry.dirty = true;  // A new row
+        entries_[newHash] = entry;
+        removed_.erase(newHash);
+        return true;
+    }
+
+    // Move Kodi-layout files to their v2 path. Files cached before the index existed have no
+    // URL to hash and stay where they are until they are evicted.
+    void migrateKodiEntries() {
+        std::vector<std::pair<std::string, std::string>> pending;  // (hash, url)
+        std::function<std::string(const std::string&)> hashFor;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!migrationHashFor_ || migrationDone_) {
+                return;
+            }
+            hashFor = migrationHashFor_;
+            for (const auto& entry : entries_) {
+                if (entry.first.length() == 8 && !entry.second.url.empty()) {
+                    pending.push_back({ entry.first, entry.second.url });
+                }
+            }
+        }
+
+        int moved = 0;
+        for (const auto& entry : pending) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_) {
+                    return;
+                }
+            }
+            if (migrateEntry(entry.first, hashFor(entry.second))) {
+                moved++;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        migrationDone_ = true;
+        debugOutput("Moved " + std::to_string(moved) + " of " + std::to_string(pending.size()) +
+                    " Kodi-layout images to the v2 layout");
+    }
+
+    void sweeperLoop() {
+        openDatabase();
+        loadAndReconcile();
+
+        while (true) {
+            migrateKodiEntries();
+            evictIfNeeded();
+            flush();
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stopping_) {
+                break;
+            }
+            wake_.wait_for(lock, std::chrono::seconds(SWEEP_INTERVAL_SECONDS));
+            if (stopping_) {
+                lock.unlock();
+                flush();
+                break;
+            }
+        }
+
+        if (db_) {
+            sqlite3_close(db_);
+            db_ = nullptr;
+        }
+    }
+
+public:
+    ImageCacheIndex(const std::string& cacheBasePath, int64_t budgetBytes, Policy policy)
+        : cacheBasePath_(cacheBasePath), db_(nullptr), clearAllFailures_(false), totalBytes_(0), budgetBytes_(budgetBytes),
+          policy_(policy), loaded_(false), migrationDone_(false), stopping_(false) {
+        sweeper_ = std::thread(&ImageCacheIndex::sweeperLoop, this);
+    }
+
+    // Writes pending access times before returning
+    ~ImageCacheIndex() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        sweeper_.join();
+    }
+
+    ImageCacheIndex(const ImageCacheIndex&) = delete;
+    ImageCacheIndex& operator=(const ImageCacheIndex&) = delete;
+
+    static Policy policyFromName(const std::string& name) {
+        return name == "lfu" ? POLICY_LFU : POLICY_LRU;
+    }
+
+    static Layout layoutFromName(const std::string& name) {
+        return name == "kodi" ? LAYOUT_KODI : LAYOUT_V2;
+    }
+
+    // Path of a cached image below the cache directory; the hash length gives the layout
+    static std::string relativePathFor(const std::string& hash) {
+        if (hash.length() == 16) {
+            return hash.substr(0, 2) + "\\" + hash.substr(2, 2) + "\\" + hash + ".png";
+        }
+        return hash.substr(0, 1) + "\\" + hash + ".png";
+    }
+
+    // Create the layout folders above a cache file (one level for Kodi, two for v2; existing ones are skipped).
+    // Only called where a file is about to be written, never on lookups.
+    static void createFoldersFor(const std::string& filePath) {
+        std::string folder = filePath.substr(0, filePath.find_last_of('\\'));
+        if (GetFileAttributesA(folder.c_str()) != INVALID_FILE_ATTRIBUTES) {
+            return;
+        }
+        CreateDirectoryA(folder.substr(0, folder.find_last_of('\\')).c_str(), NULL);
+        CreateDirectoryA(folder.c_str(), NULL);
+    }
+
+    // Have the sweeper move Kodi-layout files to the v2 layout, hashing their URL with hashFor
+    void setMigration(std::function<std::string(const std::string&)> hashFor) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            migrationHashFor_ = hashFor;
+            migrationDone_ = false;
+        }
+        wake_.notify_all();
+    }
+
+    void setBudget(int64_t budgetBytes, Policy policy) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            budgetBytes_ = budgetBytes;
+            policy_ = policy;
+        }
+        wake_.notify_all();
+    }
+
+    // Look a hash up in memory, counting it as an access when it is cached
+    LookupResult lookup(const std::string& hash) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(hash);
+        if (it == entries_.end()) {
+            return loaded_ ? LOOKUP_MISS : LOOKUP_UNKNOWN;
+        }
+        it->second.lastAccess = now();
+        it->second.hits++;
+        it->second.dirty = true;
+        return LOOKUP_HIT;
+    }
+
+    // Record a file written to the cache. An existing entry keeps its stats; width and height
+    // of 0 mean unknown.
+    void add(const std::string& hash, const std::string& url, const std::string& filePath, int width, int height) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(hash);
+            if (it != entries_.end() && width == 0 && height == 0) {
+                return;  // A cache hit, already counted by lookup()
+            }
+        }
+
+        WIN32_FILE_ATTRIBUTE_DATA fileInfo;
+        if (!GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &fileInfo)) {
+            return;
+        }
+        ULARGE_INTEGER size;
+        size.LowPart = fileInfo.nFileSizeLow;
+        size.HighPart = fileInfo.nFileSizeHigh;
+
+        bool overBudget = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(hash);
+            if (it == entries_.end()) {
+                Entry entry;
+                entry.hits = 0;
+                it = entries_.insert({ hash, entry }).first;
+            } else {
+                totalBytes_ -= it->second.size;
+            }
+
+            it->second.url = url;
+            it->second.size = static_cast<int64_t>(size.QuadPart);
+            it->second.width = width;
+            it->second.height = height;
+            it->second.lastAccess = now();
+            it->second.status = STATUS_READY;
+            it->second.dirty = true;
+            removed_.erase(hash);
+
+            // The URL works now
+            if (failures_.erase(hash) > 0) {
+                clearedFailures_.insert(hash);
+            }
+
+            totalBytes_ += it->second.size;
+            overBudget = budgetBytes_ > 0 && totalBytes_ > budgetBytes_;
+        }
+
+        if (overBudget) {
+            wake_.notify_all();
+        }
+    }
+
+    // Record a failed load and push the next retry out: 1 minute after the first failure,
+    // doubling each time up to a day. Returns the number of failures so far.
+    int recordFailure(const std::string& hash, const std::string& url, const std::string& error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = failures_.find(hash);
+        if (it == failures_.end()) {
+            Failure failure;
+            failure.failures = 0;
+            it = failures_.insert({ hash, failure }).first;
+        }
+
+        it->second.url = url;
+        it->second.failures++;
+        it->second.lastError = error;
+        int64_t backoff = FAILURE_BACKOFF_SECONDS;
+        for (int i = 1; i < it->second.failures && backoff < FAILURE_BACKOFF_MAX_SECONDS; i++) {
+            backoff *= 2;
+        }
+        it->second.nextRetry = now() + (std::min)(backoff, static_cast<int64_t>(FAILURE_BACKOFF_MAX_SECONDS));
+        it->second.dirty = true;
+        clearedFailures_.erase(hash);
+        return it->second.failures;
+    }
+
+    // True while a failed URL waits for its next retry; fills in the failure record if asked
+    bool isBackedOff(const std::string& hash, Failure* failure = nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = failures_.find(hash);
+        if (it == failures_.end() || it->second.nextRetry <= now()) {
+            return false;
+        }
+        if (failure) {
+            *failure = it->second;
+        }
+        return true;
+    }
+
+    // Forget the failures of these hashes, or of every URL when hashes is empty, so they are
+    // tried again at once. Returns the number of records cleared.
+    int clearFailures(const std::vector<std::string>& hashes) {
+        int cleared = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (hashes.empty()) {
+                cleared = static_cast<int>(failures_.size());
+                failures_.clear();
+                clearedFailures_.clear();
+                clearAllFailures_ = true;
+            } else {
+                for (const std::string& hash : hashes) {
+                    if (failures_.erase(hash) > 0) {
+                        cleared++;
+                    }
+                    clearedFailures_.insert(hash);
+                }
+            }
+        }
+        wake_.notify_all();
+        return cleared;
+    }
+
+    size_t failureCount() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return failures_.size();
+    }
+
+    int64_t totalBytes() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return totalBytes_;
+    }
+
+    size_t entryCount() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+};
+
+#endif // IMAGE_CACHE_INDEX_H
@@ -7,10 +7,10 @@ void ImageLoader::OnDOMReady(ultralight::View* caller, uint64_t frame_id,
     std::string urlStr(url.utf8().data());
     debugOutput("OnDOMReady - URL: " + urlStr + ", main_frame: " + (is_main_frame ? "true" : "false"));
 
-    // DOM is ready, now set up the JS bridge
+    // DOM is ready, now set up the JS bridge (the page reports its view index back with each image)
     if (is_main_frame && jsBridge_) {
         debugOutput("DOM ready, setting up JS bridge");
-        jsBridge_->setupImageLoaderBridge(caller);
+        jsBridge_->setupImageLoaderBridge(caller, indexOfView(caller));
     }
 }
 
@@ -23,7 +23,7 @@ void ImageLoader::OnFinishLoading(ultralight::View* caller, uint64_t frame_id,
         debugOutput("Image loader HTML finished loading");
         // Manually call onImageLoaderReady since JS timing is unreliable
         debugOutput("Calling onImageLoaderReady directly");
-        onImageLoaderReady();
+        onImageLoaderReady(caller);
     }
 }
 
@@ -44,6 +44,47 @@ void ImageLoader::OnFailLoading(ultralight::View* caller, uint64_t frame_id,
 
     if (is_main_frame) {
         debugOutput("ERROR: Failed to load image-loader.html (main frame)");
-        isInitialized_ = false;
+        int viewIndex = indexOfView(caller);
+        if (viewIndex >= 0) {
+            views_[viewIndex].isInitialized = false;
+        }
     }
 }
+
+// Completion dispatch
+void ImageLoader::setCompletionDispatcher(std::function<void()> dispatcher) {
+    completionDispatcher_ = dispatcher;
+    if (completionWindow_) {
+        return;
+    }
+
+    WNDCLASSA windowClass = {};
+    windowClass.lpfnWndProc = completionWindowProc;
+    windowClass.hInstance = GetModuleHandleA(NULL);
+    windowClass.lpszClassName = "AArcadeImageCompletions";
+    RegisterClassA(&windowClass);  // Fails harmlessly if already registered
+
+    completionWindow_ = CreateWindowExA(0, windowClass.lpszClassName, "", 0, 0, 0, 0, 0,
+                                        HWND_MESSAGE, NULL, windowClass.hInstance, NULL);
+    if (!completionWindow_) {
+        debugOutput("ERROR: Failed to create completion window, completions must be polled");
+        return;
+    }
+    SetWindowLongPtrA(completionWindow_, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+    debugOutput("Completions are pushed to the main thread");
+}
+
+LRESULT CALLBACK ImageLoader::completionWindowProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam) {
+    if (message == WM_IMAGE_COMPLETIONS) {
+        ImageLoader* loader = reinterpret_cast<ImageLoader*>(GetWindowLongPtrA(hwnd, GWLP_USERDATA));
+        if (loader) {
+            if (loader->completionDispatcher_) {
+                loader->completionDispatcher_();
+            } else {
+                loader->processCompletions();
+            }
+        }
+        return 0;
+    }
+    return DefWindowProcA(hwnd, message, wParam, lParam);
+}
@@ -10,14 +10,25 @@
 #include <algorithm>
 #include <map>
 #include <vector>
+#include <chrono>
 #include <Ultralight/Ultralight.h>
 #include <AppCore/AppCore.h>
+#include "NativeImageDecoder.h"
+#include "ImageCacheIndex.h"
+#include "BitmapCache.h"
 
 using namespace ultralight;
 
 // Forward declaration
 class JSBridge;
 
+// Scheduling priority of an image request (lower runs first)
+enum ImagePriority {
+    IMAGE_PRIORITY_VISIBLE = 0,   // On screen now
+    IMAGE_PRIORITY_NEAR = 1,      // Within a screen of the viewport
+    IMAGE_PRIORITY_PREFETCH = 2   // Everything else
+};
+
 // Result structure for image loading
 struct ImageLoadResult {
     bool success;
@@ -28,53 +39,131 @@ struct ImageLoadResult {
     int rectWidth;
     int rectHeight;
     std::function<void(const ImageLoadResult&)> callback;  // Store callback with result
+    bool cancelled;  // Job was cancelled before it started (success is false)
+};
+
+// Delivery statistics for image completions (enqueue on any thread to callback on the main thread)
+struct ImageCompletionStats {
+    int64_t delivered;       // Completions handed to their callbacks
+    int64_t batches;         // processCompletions calls that delivered at least one
+    double totalLatencyMs;   // Sum of enqueue-to-callback times
+    double maxLatencyMs;     // Longest enqueue-to-callback time
 };
 
 /**
  * ImageLoader - Ultralight view-based image renderer
  *
- * This class manages a dedicated 512x512 Ultralight view for rendering images to cache.
- * It loads image-loader.html and communicates via JS bridge to load images on-demand.
+ * This class manages a pool of 512x512 Ultralight views for rendering images to cache.
+ * Each view loads image-loader.html and communicates via JS bridge to load images on-demand.
  *
  * Architecture:
- * - Single offscreen View (512x512)
+ * - Pool of offscreen Views (512x512), each with at most one image in flight
+ * - Queued jobs are run by priority (visible, near, prefetch), then in request order;
+ *   jobs that have not started can be reprioritized or cancelled
  * - Loads images through HTML/JS (no direct HTTP)
+ * - Local files are decoded natively on worker threads instead (see NativeImageDecoder),
+ *   falling back to the views for formats it cannot read
+ * - Rendered images are PNG-encoded on the same worker threads, freeing the view at once
  * - Renders and saves to cache when JS notifies image is loaded
- * - Uses Kodi-style CRC32 hashing for cache paths
- * - No threading (Ultralight handles async)
+ * - Cache paths use a 64-bit FNV-1a hash in 256 x 256 folders, or Kodi-style CRC32 hashing
+ *   in 16 folders when the Kodi layout is configured
+ * - Cache lookups are answered from an in-memory index with a size budget (see ImageCacheIndex)
+ * - URLs that failed to load are refused with exponential backoff, also kept by the index
+ * - The pixels of images it writes are also kept in a BitmapCache, which the views' file system
+ *   serves in place of the PNG (see CacheFileSystem)
+ * - Views are only touched on the main thread (Ultralight handles async)
+ * - With a completion dispatcher set, the first completion queued posts a message to the main
+ *   thread, which delivers everything queued by then in one batch (no polling needed)
  */
 class ImageLoader : public LoadListener {
 private:
     RefPtr<Renderer> renderer_;
-    RefPtr<View> view_;
     JSBridge* jsBridge_;  // Weak pointer, owned by MainApp
 
     std::string cacheBasePath_;
-    bool isInitialized_;
-    bool isImageReady_;
-    bool isProcessing_;  // Track if currently processing a job
 
-    std::string currentUrl_;
-    std::function<void(const ImageLoadResult&)> currentCallback_;
+    // Manifest of the cache directory, replaced when the directory changes
+    std::unique_ptr<ImageCacheIndex> cacheIndex_;
+    int64_t cacheBudgetBytes_;
+    ImageCacheIndex::Policy cachePolicy_;
+    ImageCacheIndex::Layout cacheLayout_;
+
+    // One offscreen view and the job it is working on
+    struct LoaderView {
+        RefPtr<View> view;
+        bool isInitialized;
+        bool isImageReady;
+        bool isProcessing;  // Track if this view is processing a job
+
+        std::string currentUrl;
+
+        // Current image rect (set by JS)
+        int currentRectX;
+        int currentRectY;
+        int currentRectWidth;
+        int currentRectHeight;
+
+        LoaderView() : isInitialized(false), isImageReady(false), isProcessing(false),
+            currentRectX(0), currentRectY(0), currentRectWidth(0), currentRectHeight(0) {}
+    };
+
+    std::vector<LoaderView> views_;
 
-    // Current image rect (set by JS)
-    int currentRectX_;
-    int currentRectY_;
-    int currentRectWidth_;
-    int currentRectHeight_;
+    // One caller waiting for a job; requestId is the handle cancel() takes
+    struct JobCallback {
+        uint64_t requestId;
+        std::function<void(const ImageLoadResult&)> callback;
+    };
 
     // Queue for pending load requests
     struct LoadJob {
         std::string url;
-        std::string hash;  // CRC32 hash of the URL
-        std::vector<std::function<void(const ImageLoadResult&)>> callbacks;  // Multiple callbacks for same URL
+        std::string hash;  // Cache key of the URL (see cacheKeyFor)
+        std::vector<JobCallback> callbacks;  // Multiple callbacks for same URL
+        int priority;     // ImagePriority, the most urgent of its requests
+        bool dispatched;  // Handed to a view or decode thread (can no longer be cancelled)
+    };
+
+    // Heap entry for a queued job. A job is pushed again when its priority changes, so
+    // entries that no longer match their job are skipped when popped.
+    struct QueuedJob {
+        int priority;
+        uint64_t sequence;
+        std::string hash;
+
+        // std::priority_queue pops the largest, so "less" means runs later
+        bool operator<(const QueuedJob& other) const {
+            if (priority != other.priority) return priority > other.priority;
+            return sequence > other.sequence;
+        }
     };
 
-    std::queue<std::string> jobQueue_;  // Queue of hashes to process
-    std::map<std::string, LoadJob> jobMap_;  // Hash -> Job data
-    std::queue<ImageLoadResult> completionQueue_;
+    std::priority_queue<QueuedJob> jobQueue_;  // Hashes to process, most urgent first
+    uint64_t jobSequence_;  // Request order for jobs of equal priority
+    uint64_t nextRequestId_;  // Handles returned by loadAndCacheImage(s), under queueMutex_
+    std::map<std::string, LoadJob> jobMap_;  // Hash -> Job data (queued and in flight)
     std::mutex queueMutex_;
+
+    // Completions waiting for the main thread, with the time they were queued
+    struct PendingCompletion {
+        ImageLoadResult result;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+    std::queue<PendingCompletion> completionQueue_;
     std::mutex completionMutex_;
+    bool completionDispatchPending_;  // A dispatch message is posted and not handled yet
+    HWND completionWindow_;  // Message-only window that receives dispatches on the main thread
+    std::function<void()> completionDispatcher_;  // Runs processCompletions (see setCompletionDispatcher)
+    ImageCompletionStats completionStats_;  // Main thread only
+
+    static const UINT WM_IMAGE_COMPLETIONS = WM_APP + 1;
+    static LRESULT CALLBACK completionWindowProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+
+    BitmapCache* bitmapCache_;  // Weak pointer, owned by MainApp (may be null)
+
+    // Declared last so its threads stop before the queues they complete into go away
+    std::unique_ptr<NativeImageDecoder> nativeDecoder_;
 
     void debugOutput(const std::string& message) {
         std::string debugMsg = "[ImageLoader] " + message;
@@ -159,26 +248,55 @@ private:
         return std::string(hash);
     }
 
-    // Get cache file path using Kodi-style directory structure
-    std::string getCacheFilePath(const std::string& url) {
-        std::string normalized = normalizeUrl(url);
-        std::string hash = calculateKodiHash(normalized);
+    // 64-bit FNV-1a of the normalized URL as 16 hex characters (arcadeHud.js computes the same)
+    std::string calculateHash64(const std::string& normalizedUrl) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (char c : normalizedUrl) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3ULL;
+        }
 
-        // Create subfolder based on first character of hash (like Kodi)
-        std::string subfolder = hash.substr(0, 1);
-        std::string cachePath = cacheBasePath_ + "\\" + subfolder;
+        char hex[17];
+        sprintf_s(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+        return std::string(hex);
+    }
 
-        // Ensure directory exists
-        CreateDirectoryA(cachePath.c_str(), NULL);
+    // Cache key of a URL in the configured layout; also the key of the job map
+    std::string cacheKeyFor(const std::string& url) {
+        std::string normalized = normalizeUrl(url);
+        return cacheLayout_ == ImageCacheIndex::LAYOUT_KODI ? calculateKodiHash(normalized) : calculateHash64(normalized);
+    }
 
+    // Get cache file path in the configured layout. No side effects: the folders are created by
+    // whoever writes the file (ImageCacheIndex::createFoldersFor, NativeImageDecoder::writeFileDurably).
+    std::string getCacheFilePath(const std::string& url) {
         // ImageLoader always saves as PNG
-        return cachePath + "\\" + hash + ".png";
+        return cacheBasePath_ + "\\" + ImageCacheIndex::relativePathFor(cacheKeyFor(url));
     }
 
     // Check if cached file exists
     std::string getCachedFilePath(const std::string& url) {
         std::string filePath = getCacheFilePath(url);
 
+        // The index knows once it has been reconciled with the directory
+        if (cacheIndex_) {
+            std::string key = cacheKeyFor(url);
+            ImageCacheIndex::LookupResult lookup = cacheIndex_->lookup(key);
+            if (lookup == ImageCacheIndex::LOOKUP_HIT) {
+                return filePath;
+            }
+            if (lookup == ImageCacheIndex::LOOKUP_MISS) {
+                // Not migrated yet: serve the Kodi-layout file where it is. Only the sweeper moves it.
+                if (cacheLayout_ != ImageCacheIndex::LAYOUT_KODI) {
+                    std::string kodiHash = calculateKodiHash(normalizeUrl(url));
+                    if (cacheIndex_->lookup(kodiHash) == ImageCacheIndex::LOOKUP_HIT) {
+                        return cacheBasePath_ + "\\" + ImageCacheIndex::relativePathFor(kodiHash);
+                    }
+                }
+                return "";
+            }
+        }
+
         WIN32_FILE_ATTRIBUTE_DATA fileInfo;
         if (GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &fileInfo) != 0) {
             return filePath;
@@ -187,109 +305,204 @@ private:
         return "";
     }
 
-    // Process the next job in queue
-    void processNextJob() {
-        std::string hash;
-        LoadJob job;
-
-        {
-            std::lock_guard<std::mutex> lock(queueMutex_);
-
-            // Don't process if already processing a job
-            if (isProcessing_) {
-                debugOutput("Already processing a job, skipping");
-                return;
+    // Index of the view, or -1 if it is not one of ours
+    int indexOfView(View* view) const {
+        for (size_t i = 0; i < views_.size(); i++) {
+            if (views_[i].view.get() == view) {
+                return static_cast<int>(i);
             }
+        }
+        return -1;
+    }
 
-            if (jobQueue_.empty()) {
-                debugOutput("No more jobs in queue");
-                return;
-            }
+    // Move a queued job up the heap (caller holds queueMutex_)
+    void raisePriority(LoadJob& job, int priority) {
+        job.priority = priority;
+        if (!job.dispatched) {
+            jobQueue_.push({ priority, jobSequence_++, job.hash });
+        }
+    }
 
-            // Get next hash from queue
-            hash = jobQueue_.front();
-            jobQueue_.pop();
+    // Remove a job from the map and queue a completion for each of its callbacks
+    void completeJob(const std::string& url, bool success, const std::string& filePath,
+                     int rectX, int rectY, int rectWidth, int rectHeight) {
+        std::string hash = cacheKeyFor(url);
 
-            // Look up job data
+        LoadJob job;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
             auto it = jobMap_.find(hash);
-            if (it == jobMap_.end()) {
-                debugOutput("ERROR: Hash not found in job map: " + hash);
-                return;
+            if (it != jobMap_.end()) {
+                job = it->second;
+                jobMap_.erase(it);  // Remove from map
             }
+        }
 
-            job = it->second;
-            isProcessing_ = true;  // Mark as processing
+        // Queue one completion for each callback
+        std::vector<ImageLoadResult> results;
+        for (size_t i = 0; i < job.callbacks.size(); ++i) {
+            results.push_back({ success, filePath, url, rectX, rectY, rectWidth, rectHeight, job.callbacks[i].callback, false });
         }
+        queueCompletions(results);
 
-        debugOutput("Processing job for URL: " + job.url + " (hash: " + job.hash + ")");
+        // Newly written files join the index (cache hits are already in it, legacy-layout ones under their Kodi hash)
+        if (success && !filePath.empty() && cacheIndex_ && filePath == getCacheFilePath(url)) {
+            cacheIndex_->add(hash, url, filePath, rectWidth, rectHeight);
+        }
+    }
 
-        // Check cache first
-        std::string cachedPath = getCachedFilePath(job.url);
-        if (!cachedPath.empty()) {
-            debugOutput("Image already cached: " + cachedPath);
+    // Queue completions for the main thread. The first one queued since the last dispatch
+    // posts a message to the completion window, so a burst is delivered in one batch.
+    void queueCompletions(const std::vector<ImageLoadResult>& results) {
+        if (results.empty()) {
+            return;
+        }
 
-            // Queue completions for all callbacks
-            {
-                std::lock_guard<std::mutex> lock(completionMutex_);
-                for (size_t i = 0; i < job.callbacks.size(); ++i) {
-                    completionQueue_.push({ true, cachedPath, job.url, 0, 0, 0, 0, job.callbacks[i] });
-                }
+        {
+            std::lock_guard<std::mutex> lock(completionMutex_);
+            auto now = std::chrono::steady_clock::now();
+            for (const auto& result : results) {
+                completionQueue_.push({ result, now });
             }
+        }
+        requestDispatch();
+    }
 
-            // Remove from job map
-            {
-                std::lock_guard<std::mutex> lock(queueMutex_);
-                jobMap_.erase(job.hash);
-                isProcessing_ = false;
+    // Post one dispatch message to the completion window unless one is already pending.
+    // processCompletions then runs on the main thread and also hands queued jobs to idle views.
+    void requestDispatch() {
+        bool post = false;
+        {
+            std::lock_guard<std::mutex> lock(completionMutex_);
+            if (completionWindow_ && !completionDispatchPending_) {
+                completionDispatchPending_ = true;
+                post = true;
             }
-            processNextJob();
-            return;
         }
 
-        // Not cached, need to load and render
-        currentUrl_ = job.url;
-        isImageReady_ = false;
+        if (post && !PostMessageA(completionWindow_, WM_IMAGE_COMPLETIONS, 0, 0)) {
+            debugOutput("ERROR: Failed to post completion dispatch");
+            std::lock_guard<std::mutex> lock(completionMutex_);
+            completionDispatchPending_ = false;
+        }
+    }
+
+    // Called on a worker thread when a local file has been decoded or a rendered image encoded
+    void onNativeDecoded(const NativeImageDecoder::Result& result) {
+        if (!result.fallback) {
+            // Back off like a view failure, so a file that cannot be written is not retried at once
+            if (!result.success && cacheIndex_) {
+                int failures = cacheIndex_->recordFailure(cacheKeyFor(result.url), result.url,
+                                                          "Native decode failed: " + result.error);
+                debugOutput("Recorded failure " + std::to_string(failures) + " for " + result.url);
+            }
+            completeJob(result.url, result.success, result.success ? result.outputPath : "",
+                        result.rectX, result.rectY, result.rectWidth, result.rectHeight);
+            return;
+        }
 
-        // Call JS to load the image
-        loadImageInView(job.url);
+        // Let the views try it. This is a decode thread, so the main thread is woken to dispatch
+        // it (in poll mode the next processImageCompletions call does)
+        debugOutput("Native decode unavailable, queueing for a view: " + result.url);
+        std::string hash = cacheKeyFor(result.url);
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            auto it = jobMap_.find(hash);
+            if (it != jobMap_.end()) {
+                it->second.dispatched = false;
+                jobQueue_.push({ it->second.priority, jobSequence_++, hash });
+                queued = true;
+            }
+        }
+        if (queued) {
+            requestDispatch();
+        }
     }
 
-    // Call JavaScript to load image in the view
-    void loadImageInView(const std::string& url) {
-        if (!view_ || !isInitialized_) {
-            debugOutput("ERROR: View not initialized!");
+    // Hand queued jobs to every idle view
+    void processNextJobs() {
+        for (size_t i = 0; i < views_.size(); i++) {
+            processNextJob(i);
+        }
+    }
 
-            // Get hash and job data
-            std::string normalized = normalizeUrl(url);
-            std::string hash = calculateKodiHash(normalized);
+    // Process the next job in queue on one view
+    void processNextJob(size_t viewIndex) {
+        LoaderView& loader = views_[viewIndex];
 
+        while (true) {
             LoadJob job;
+
             {
                 std::lock_guard<std::mutex> lock(queueMutex_);
-                auto it = jobMap_.find(hash);
-                if (it != jobMap_.end()) {
-                    job = it->second;
-                    jobMap_.erase(it);
+
+                // Don't process if this view is not ready or already has a job
+                if (!loader.isInitialized || loader.isProcessing) {
+                    return;
                 }
-                isProcessing_ = false;
-            }
 
-            // Queue failure for all callbacks
-            {
-                std::lock_guard<std::mutex> lock(completionMutex_);
-                for (size_t i = 0; i < job.callbacks.size(); ++i) {
-                    completionQueue_.push({ false, "", url, 0, 0, 0, 0, job.callbacks[i] });
+                if (jobQueue_.empty()) {
+                    return;
                 }
+
+                // Get the most urgent hash from the queue
+                QueuedJob next = jobQueue_.top();
+                jobQueue_.pop();
+
+                // Skip entries left behind by cancellation, reprioritization or an earlier dispatch
+                auto it = jobMap_.find(next.hash);
+                if (it == jobMap_.end() || it->second.dispatched || it->second.priority != next.priority) {
+                    continue;
+                }
+
+                it->second.dispatched = true;
+                job = it->second;
+                loader.isProcessing = true;  // Mark as processing
             }
 
-            processNextJob();
-            return;
+            debugOutput("View " + std::to_string(viewIndex) + " processing job for URL: " + job.url + " (hash: " + job.hash + ")");
+
+            // Check cache first
+            std::string cachedPath = getCachedFilePath(job.url);
+            if (!cachedPath.empty()) {
+                debugOutput("Image already cached: " + cachedPath);
+                completeJob(job.url, true, cachedPath, 0, 0, 0, 0);
+
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                loader.isProcessing = false;
+                continue;
+            }
+
+            // Not cached, need to load and render
+            loader.currentUrl = job.url;
+            loader.isImageReady = false;
+
+            // Call JS to load the image
+            if (loadImageInView(viewIndex, job.url)) {
+                return;
+            }
+
+            // The view could not take the job; fail it and try the next one
+            completeJob(job.url, false, "", 0, 0, 0, 0);
+
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            loader.isProcessing = false;
+        }
+    }
+
+    // Call JavaScript to load image in the view
+    bool loadImageInView(size_t viewIndex, const std::string& url) {
+        LoaderView& loader = views_[viewIndex];
+        if (!loader.view || !loader.isInitialized) {
+            debugOutput("ERROR: View " + std::to_string(viewIndex) + " not initialized!");
+            return false;
         }
 
         debugOutput("Calling JS to load image: " + url);
 
         // Acquire JS context
-        auto scoped_context = view_->LockJSContext();
+        auto scoped_context = loader.view->LockJSContext();
         JSContextRef ctx = (*scoped_context);
         JSObjectRef globalObj = JSContextGetGlobalObject(ctx);
 
@@ -298,141 +511,134 @@ private:
         JSValueRef loadImageFunc = JSObjectGetProperty(ctx, globalObj, funcName, nullptr);
         JSStringRelease(funcName);
 
-        if (JSValueIsObject(ctx, loadImageFunc)) {
-            // Create URL argument
-            JSStringRef urlStr = JSStringCreateWithUTF8CString(url.c_str());
-            JSValueRef urlArg = JSValueMakeString(ctx, urlStr);
-            JSStringRelease(urlStr);
-
-            // Call the function
-            JSValueRef args[] = { urlArg };
-            JSObjectCallAsFunction(ctx, (JSObjectRef)loadImageFunc, nullptr, 1, args, nullptr);
-
-            debugOutput("JS function called successfully");
-        } else {
+        if (!JSValueIsObject(ctx, loadImageFunc)) {
             debugOutput("ERROR: loadImageUrl function not found!");
+            return false;
+        }
 
-            // Get hash and job data
-            std::string normalized = normalizeUrl(url);
-            std::string hash = calculateKodiHash(normalized);
-
-            LoadJob job;
-            {
-                std::lock_guard<std::mutex> lock(queueMutex_);
-                auto it = jobMap_.find(hash);
-                if (it != jobMap_.end()) {
-                    job = it->second;
-                    jobMap_.erase(it);
-                }
-                isProcessing_ = false;
-            }
+        // Create URL argument
+        JSStringRef urlStr = JSStringCreateWithUTF8CString(url.c_str());
+        JSValueRef urlArg = JSValueMakeString(ctx, urlStr);
+        JSStringRelease(urlStr);
 
-            // Queue failure for all callbacks
-            {
-                std::lock_guard<std::mutex> lock(completionMutex_);
-                for (size_t i = 0; i < job.callbacks.size(); ++i) {
-                    completionQueue_.push({ false, "", url, 0, 0, 0, 0, job.callbacks[i] });
-                }
-            }
+        // Call the function
+        JSValueRef args[] = { urlArg };
+        JSObjectCallAsFunction(ctx, (JSObjectRef)loadImageFunc, nullptr, 1, args, nullptr);
 
-            processNextJob();
-        }
+        debugOutput("JS function called successfully");
+        return true;
     }
 
-    // Render and save the current image
-    void renderAndSave() {
-        debugOutput("Rendering image...");
+    // Render and save the current image of one view
+    void renderAndSave(size_t viewIndex) {
+        LoaderView& loader = views_[viewIndex];
+        debugOutput("Rendering image on view " + std::to_string(viewIndex) + "...");
 
-        // Render the view
+        // Render the views
         renderer_->RefreshDisplay(0);
         renderer_->Render();
 
         // Get the rendered bitmap
-        BitmapSurface* bitmap_surface = (BitmapSurface*)view_->surface();
+        BitmapSurface* bitmap_surface = (BitmapSurface*)loader.view->surface();
         RefPtr<Bitmap> bitmap = bitmap_surface->bitmap();
 
         // Crop the bitmap to the actual image rect
-        RefPtr<Bitmap> croppedBitmap;
-        if (currentRectWidth_ > 0 && currentRectHeight_ > 0) {
+        int x = 0;
+        int y = 0;
+        int width = (int)bitmap->width();
+        int height = (int)bitmap->height();
+        if (loader.currentRectWidth > 0 && loader.currentRectHeight > 0) {
             // Ensure rect is within bounds
-            int x = (std::max)(0, currentRectX_);
-            int y = (std::max)(0, currentRectY_);
-            int width = (std::min)(currentRectWidth_, (int)bitmap->width() - x);
-            int height = (std::min)(currentRectHeight_, (int)bitmap->height() - y);
+            x = (std::max)(0, loader.currentRectX);
+            y = (std::max)(0, loader.currentRectY);
+            width = (std::min)(loader.currentRectWidth, (int)bitmap->width() - x);
+            height = (std::min)(loader.currentRectHeight, (int)bitmap->height() - y);
 
             debugOutput("Cropping bitmap from (" + std::to_string(x) + ", " + std::to_string(y) + ") " +
                        "size " + std::to_string(width) + "x" + std::to_string(height));
+        } else {
+            // No valid rect, save the full bitmap
+            debugOutput("Warning: Invalid rect, saving full bitmap");
+        }
 
-            // Create a new bitmap with the cropped size
-            croppedBitmap = Bitmap::Create(width, height, BitmapFormat::BGRA8_UNORM_SRGB);
+        // Get output path
+        std::string outputPath = getCacheFilePath(loader.currentUrl);
+
+        uint32_t bytes_per_pixel = 4; // BGRA8
+        uint32_t src_row_bytes = bitmap->row_bytes();
+
+        if (nativeDecoder_) {
+            // Copy the pixels out and let an encode thread write the PNG; the view is free as soon
+            // as the copy is done, and the job completes once the file is on disk
+            NativeImageDecoder::Task task;
+            task.url = loader.currentUrl;
+            task.outputPath = outputPath;
+            task.width = width;
+            task.height = height;
+            task.rectX = loader.currentRectX;
+            task.rectY = loader.currentRectY;
+            task.pixels = nativeDecoder_->acquireBuffer(static_cast<size_t>(width) * height * bytes_per_pixel);
 
-            // Copy the pixel data
             uint8_t* src_pixels = (uint8_t*)bitmap->LockPixels();
-            uint8_t* dst_pixels = (uint8_t*)croppedBitmap->LockPixels();
-
-            uint32_t src_row_bytes = bitmap->row_bytes();
-            uint32_t dst_row_bytes = croppedBitmap->row_bytes();
-            uint32_t bytes_per_pixel = 4; // BGRA8
-
             for (int row = 0; row < height; row++) {
                 uint8_t* src_row = src_pixels + ((y + row) * src_row_bytes) + (x * bytes_per_pixel);
-                uint8_t* dst_row = dst_pixels + (row * dst_row_bytes);
-                memcpy(dst_row, src_row, width * bytes_per_pixel);
+                memcpy(task.pixels.data() + static_cast<size_t>(row) * width * bytes_per_pixel, src_row, width * bytes_per_pixel);
             }
-
-            croppedBitmap->UnlockPixels();
             bitmap->UnlockPixels();
-        } else {
-            // No valid rect, save the full bitmap
-            debugOutput("Warning: Invalid rect, saving full bitmap");
-            croppedBitmap = bitmap;
-        }
-
-        // Get output path
-        std::string outputPath = getCacheFilePath(currentUrl_);
 
-        // Save to file
-        croppedBitmap->WritePNG(outputPath.c_str());
+            nativeDecoder_->submit(std::move(task));
+            debugOutput("Image rendered, queued for encoding: " + outputPath);
+        } else {
+            RefPtr<Bitmap> croppedBitmap = bitmap;
+            if (loader.currentRectWidth > 0 && loader.currentRectHeight > 0) {
+                // Create a new bitmap with the cropped size
+                croppedBitmap = Bitmap::Create(width, height, BitmapFormat::BGRA8_UNORM_SRGB);
+
+                // Copy the pixel data
+                uint8_t* src_pixels = (uint8_t*)bitmap->LockPixels();
+                uint8_t* dst_pixels = (uint8_t*)croppedBitmap->LockPixels();
+                uint32_t dst_row_bytes = croppedBitmap->row_bytes();
+
+                for (int row = 0; row < height; row++) {
+                    uint8_t* src_row = src_pixels + ((y + row) * src_row_bytes) + (x * bytes_per_pixel);
+                    uint8_t* dst_row = dst_pixels + (row * dst_row_bytes);
+                    memcpy(dst_row, src_row, width * bytes_per_pixel);
+                }
 
-        debugOutput("Image rendered and saved: " + outputPath);
+                croppedBitmap->UnlockPixels();
+                bitmap->UnlockPixels();
+            }
 
-        // Get hash for current URL
-        std::string normalized = normalizeUrl(currentUrl_);
-        std::string hash = calculateKodiHash(normalized);
+            // Save to file
+            ImageCacheIndex::createFoldersFor(outputPath);
+            croppedBitmap->WritePNG(outputPath.c_str());
 
-        // Queue completion for all callbacks waiting for this image
-        LoadJob job;
-        {
-            std::lock_guard<std::mutex> lock(queueMutex_);
-            auto it = jobMap_.find(hash);
-            if (it != jobMap_.end()) {
-                job = it->second;
-                jobMap_.erase(it);  // Remove from map
+            if (bitmapCache_) {
+                bitmapCache_->put(cacheKeyFor(loader.currentUrl), (const uint8_t*)croppedBitmap->LockPixels(),
+                                  width, height, croppedBitmap->row_bytes());
+                croppedBitmap->UnlockPixels();
             }
-        }
 
-        {
-            std::lock_guard<std::mutex> lock(completionMutex_);
-            // Queue one completion for each callback
-            for (size_t i = 0; i < job.callbacks.size(); ++i) {
-                completionQueue_.push({ true, outputPath, currentUrl_,
-                                       currentRectX_, currentRectY_, currentRectWidth_, currentRectHeight_,
-                                       job.callbacks[i] });
-            }
+            debugOutput("Image rendered and saved: " + outputPath);
+
+            // Queue completion for all callbacks waiting for this image
+            completeJob(loader.currentUrl, true, outputPath,
+                        loader.currentRectX, loader.currentRectY, loader.currentRectWidth, loader.currentRectHeight);
         }
 
         // Mark as not processing and process next job
         {
             std::lock_guard<std::mutex> lock(queueMutex_);
-            isProcessing_ = false;
+            loader.isProcessing = false;
         }
-        processNextJob();
+        processNextJob(viewIndex);
     }
 
 public:
-    ImageLoader(RefPtr<Renderer> renderer, JSBridge* jsBridge)
-        : renderer_(renderer), jsBridge_(jsBridge), isInitialized_(false), isImageReady_(false), isProcessing_(false),
-          currentRectX_(0), currentRectY_(0), currentRectWidth_(0), currentRectHeight_(0) {
+    ImageLoader(RefPtr<Renderer> renderer, JSBridge* jsBridge, int viewCount = 4, int nativeDecodeThreads = 2)
+        : renderer_(renderer), jsBridge_(jsBridge), cacheBudgetBytes_(0), cachePolicy_(ImageCacheIndex::POLICY_LRU),
+          cacheLayout_(ImageCacheIndex::LAYOUT_KODI), jobSequence_(0), nextRequestId_(1), completionDispatchPending_(false),
+          completionWindow_(NULL), completionStats_(), bitmapCache_(nullptr) {
 
         debugOutput("Initializing ImageLoader...");
 
@@ -442,53 +648,150 @@ public:
         // Ensure cache directory exists
         CreateDirectoryA(".\\cache", NULL);
         CreateDirectoryA(cacheBasePath_.c_str(), NULL);
+        cacheIndex_ = std::make_unique<ImageCacheIndex>(cacheBasePath_, cacheBudgetBytes_, cachePolicy_);
+
+        // Create the 512x512 offscreen views
+        viewCount = (std::max)(1, (std::min)(viewCount, 16));
+        views_.resize(viewCount);
 
-        // Create 512x512 offscreen view
         ViewConfig view_config;
         view_config.initial_device_scale = 1.0;
         view_config.is_accelerated = false;
 
-        view_ = renderer_->CreateView(512, 512, view_config, nullptr);
-        view_->set_load_listener(this);
-
         // Load the image-loader.html file with cache-busting parameter and force reload
         // (relative to filesystem base path set in App)
-        std::string loadUrl = "file:///assets/image-loader.html?v=3";
-        debugOutput("Loading HTML from: " + loadUrl);
-        view_->LoadURL(loadUrl.c_str());
+        std::string loadUrl = "file:///assets/image-loader.html?v=4";
+        debugOutput("Loading HTML into " + std::to_string(viewCount) + " views from: " + loadUrl);
+
+        for (LoaderView& loader : views_) {
+            loader.view = renderer_->CreateView(512, 512, view_config, nullptr);
+            loader.view->set_load_listener(this);
+            loader.view->LoadURL(loadUrl.c_str());
+
+            // Force reload to bypass cache
+            loader.view->Reload();
+        }
 
-        // Force reload to bypass cache
-        debugOutput("Forcing reload to bypass cache");
-        view_->Reload();
+        // Worker threads for local files (0 sends everything through the views)
+        if (nativeDecodeThreads > 0) {
+            nativeDecoder_ = std::make_unique<NativeImageDecoder>((std::min)(nativeDecodeThreads, 16),
+                [this](const NativeImageDecoder::Result& result) { onNativeDecoded(result); },
+                [this](const std::string& url, const std::vector<uint8_t>& pixels, int width, int height) {
+                    if (bitmapCache_) {
+                        bitmapCache_->put(cacheKeyFor(url), pixels.data(), width, height, static_cast<size_t>(width) * 4);
+                    }
+                });
+        }
     }
 
     virtual ~ImageLoader() {
-        view_ = nullptr;
+        nativeDecoder_.reset();
+        if (completionWindow_) {
+            DestroyWindow(completionWindow_);  // Undelivered dispatch messages go with it
+        }
+        cacheIndex_.reset();
+        views_.clear();
         debugOutput("ImageLoader destroyed");
     }
 
     // Set custom cache directory
     void setCacheDirectory(const std::string& path) {
+        bool changed = path != cacheBasePath_;
         cacheBasePath_ = path;
         CreateDirectoryA(cacheBasePath_.c_str(), NULL);
+        if (changed) {
+            cacheIndex_ = std::make_unique<ImageCacheIndex>(cacheBasePath_, cacheBudgetBytes_, cachePolicy_);
+            setCacheLayout(cacheLayout_);
+        }
         debugOutput("Cache directory set to: " + cacheBasePath_);
     }
 
-    // Get the view (for JS bridge setup)
-    View* getView() const {
-        return view_.get();
+    // Cache layout for new images. Must be set before images are requested; switching to v2
+    // moves Kodi-layout images over in the background.
+    void setCacheLayout(ImageCacheIndex::Layout layout) {
+        cacheLayout_ = layout;
+        if (cacheIndex_ && layout == ImageCacheIndex::LAYOUT_V2) {
+            cacheIndex_->setMigration([this](const std::string& url) { return calculateHash64(normalizeUrl(url)); });
+        }
+        debugOutput(std::string("Cache layout set to ") + (layout == ImageCacheIndex::LAYOUT_KODI ? "kodi" : "v2"));
+    }
+
+    // Byte budget of the cache directory (0 for no limit) and which files to evict first
+    void setCacheBudget(int64_t budgetBytes, ImageCacheIndex::Policy policy) {
+        cacheBudgetBytes_ = budgetBytes;
+        cachePolicy_ = policy;
+        if (cacheIndex_) {
+            cacheIndex_->setBudget(budgetBytes, policy);
+        }
+        debugOutput("Cache budget set to " + std::to_string(budgetBytes) + " bytes (" +
+                    (policy == ImageCacheIndex::POLICY_LFU ? "lfu" : "lru") + ")");
+    }
+
+    // Keep the pixels of written images in memory. Must be set before images are requested.
+    void setBitmapCache(BitmapCache* bitmapCache) {
+        bitmapCache_ = bitmapCache;
+    }
+
+    BitmapCache* getBitmapCache() const {
+        return bitmapCache_;
+    }
+
+    // Deliver completions as they are queued instead of waiting for processCompletions to be
+    // polled. The dispatcher runs on the main thread and must call processCompletions (with
+    // whatever JS context its callbacks need locked). Must be called on the main thread before
+    // images are requested. Defined in ImageLoader.cpp.
+    void setCompletionDispatcher(std::function<void()> dispatcher);
+
+    // True when completions are pushed; otherwise processCompletions must be polled
+    bool isPushingCompletions() const {
+        return completionWindow_ != NULL;
+    }
+
+    const ImageCompletionStats& getCompletionStats() const {
+        return completionStats_;
+    }
+
+    // Get the views (for JS bridge setup)
+    size_t getViewCount() const {
+        return views_.size();
+    }
+
+    View* getView(size_t index) const {
+        return index < views_.size() ? views_[index].view.get() : nullptr;
+    }
+
+    // New handle for cancel(); requests made with the same handle are cancelled together
+    uint64_t newRequestId() {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        return nextRequestId_++;
     }
 
-    // Load and cache an image URL
-    void loadAndCacheImage(const std::string& url, std::function<void(const ImageLoadResult&)> callback) {
-        debugOutput("Request to load image: " + url);
+    // Load and cache an image URL. Returns the request's handle for cancel() (requestId when given).
+    uint64_t loadAndCacheImage(const std::string& url, std::function<void(const ImageLoadResult&)> callback,
+                               int priority = IMAGE_PRIORITY_VISIBLE, uint64_t requestId = 0) {
+        debugOutput("Request to load image: " + url + " (priority: " + std::to_string(priority) + ")");
+
+        if (requestId == 0) {
+            requestId = newRequestId();
+        }
 
         // Calculate hash for deduplication
-        std::string normalized = normalizeUrl(url);
-        std::string hash = calculateKodiHash(normalized);
+        std::string hash = cacheKeyFor(url);
+
+        // URLs that keep failing are refused until their next retry
+        ImageCacheIndex::Failure failure;
+        if (cacheIndex_ && cacheIndex_->isBackedOff(hash, &failure)) {
+            debugOutput("Image backed off after " + std::to_string(failure.failures) + " failures (" +
+                        failure.lastError + "): " + url);
+            queueCompletions({ { false, "", url, 0, 0, 0, 0, callback, false } });
+            return requestId;
+        }
+
+        // Local files skip the views when they can be decoded natively
+        std::string localPath = nativeDecoder_ ? NativeImageDecoder::localPathFor(url) : "";
 
         bool shouldProcess = false;
-        bool isNewJob = false;
+        bool shouldDecode = false;
         {
             std::lock_guard<std::mutex> lock(queueMutex_);
 
@@ -497,117 +800,270 @@ public:
             if (it != jobMap_.end()) {
                 // URL already queued - just add callback
                 debugOutput("Image already queued, adding callback (hash: " + hash + ")");
-                it->second.callbacks.push_back(callback);
+                it->second.callbacks.push_back({ requestId, callback });
+                if (priority < it->second.priority) {
+                    raisePriority(it->second, priority);
+                }
             } else {
                 // New URL - create job entry
                 LoadJob job;
                 job.url = url;
                 job.hash = hash;
-                job.callbacks.push_back(callback);
+                job.callbacks.push_back({ requestId, callback });
+                job.priority = priority;
+                job.dispatched = !localPath.empty();  // Decode threads take it straight away
 
                 jobMap_[hash] = job;
-                jobQueue_.push(hash);
-                isNewJob = true;
-
-                debugOutput("New image queued (hash: " + hash + ", queue size: " + std::to_string(jobQueue_.size()) + ")");
-
-                // If this is the first job and we're initialized, start processing
-                if (jobQueue_.size() == 1 && isInitialized_ && !isProcessing_) {
+                if (!localPath.empty()) {
+                    shouldDecode = true;
+                    debugOutput("New local image for native decode (hash: " + hash + ")");
+                } else {
+                    jobQueue_.push({ priority, jobSequence_++, hash });
                     shouldProcess = true;
+                    debugOutput("New image queued (hash: " + hash + ", queue size: " + std::to_string(jobQueue_.size()) + ")");
                 }
             }
         }
 
-        // Call processNextJob AFTER releasing the lock
+        if (shouldDecode) {
+            std::string cachedPath = getCachedFilePath(url);
+            if (!cachedPath.empty()) {
+                debugOutput("Image already cached: " + cachedPath);
+                completeJob(url, true, cachedPath, 0, 0, 0, 0);
+            } else {
+                nativeDecoder_->submit({ url, localPath, getCacheFilePath(url) });
+            }
+        }
+
+        // Call processNextJobs AFTER releasing the lock (idle views pick the job up)
         if (shouldProcess) {
-            processNextJob();
+            processNextJobs();
+        }
+        return requestId;
+    }
+
+    // Load and cache a batch of URLs. Cache hits are found in one pass over the index and
+    // delivered together; the rest are queued like loadAndCacheImage. The callback gets the
+    // position of the URL in urls with each result. Returns one handle for every URL of the batch.
+    uint64_t loadAndCacheImages(const std::vector<std::string>& urls,
+                                std::function<void(size_t, const ImageLoadResult&)> callback,
+                                int priority = IMAGE_PRIORITY_VISIBLE) {
+        uint64_t requestId = newRequestId();
+
+        std::vector<ImageLoadResult> hits;
+        std::vector<size_t> misses;
+        for (size_t i = 0; i < urls.size(); i++) {
+            std::string cachedPath = getCachedFilePath(urls[i]);
+            if (!cachedPath.empty()) {
+                hits.push_back({ true, cachedPath, urls[i], 0, 0, 0, 0,
+                                 [callback, i](const ImageLoadResult& result) { callback(i, result); }, false });
+            } else {
+                misses.push_back(i);
+            }
+        }
+        queueCompletions(hits);
+
+        debugOutput("Batch of " + std::to_string(urls.size()) + " images: " + std::to_string(hits.size()) +
+                    " cached, " + std::to_string(misses.size()) + " to load (priority: " + std::to_string(priority) + ")");
+
+        // Backed-off URLs are refused here too
+        for (size_t i : misses) {
+            loadAndCacheImage(urls[i], [callback, i](const ImageLoadResult& result) { callback(i, result); }, priority, requestId);
+        }
+        return requestId;
+    }
+
+    // Move queued jobs for these URLs to a new priority. URLs that are not queued, or already
+    // running, are ignored. Returns the number of jobs changed.
+    int reprioritize(const std::vector<std::string>& urls, int priority) {
+        int changed = 0;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            for (const auto& url : urls) {
+                auto it = jobMap_.find(cacheKeyFor(url));
+                if (it == jobMap_.end() || it->second.dispatched || it->second.priority == priority) {
+                    continue;
+                }
+                it->second.priority = priority;
+                jobQueue_.push({ priority, jobSequence_++, it->first });
+                changed++;
+            }
+        }
+
+        if (changed > 0) {
+            debugOutput("Reprioritized " + std::to_string(changed) + " jobs to priority " + std::to_string(priority));
+        }
+        return changed;
+    }
+
+    // Forget the failures of these URLs (every URL when urls is empty), so they are tried again
+    // at once. Returns the number of failure records cleared.
+    int clearFailures(const std::vector<std::string>& urls) {
+        if (!cacheIndex_) {
+            return 0;
+        }
+
+        std::vector<std::string> hashes;
+        for (const auto& url : urls) {
+            hashes.push_back(cacheKeyFor(url));
+        }
+        int cleared = cacheIndex_->clearFailures(hashes);
+        debugOutput("Cleared " + std::to_string(cleared) + " image failure records");
+        return cleared;
+    }
+
+    // Cancel the callbacks that request requestId registered for these URLs; each completes with
+    // cancelled set. Other callers waiting on the same URL are unaffected. A job left without
+    // callbacks is dropped if it has not started (a running one still fills the cache).
+    // Returns the number of callbacks cancelled.
+    int cancel(const std::vector<std::string>& urls, uint64_t requestId) {
+        std::vector<ImageLoadResult> results;
+        int jobsDropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            for (const auto& url : urls) {
+                auto it = jobMap_.find(cacheKeyFor(url));
+                if (it == jobMap_.end()) {
+                    continue;
+                }
+
+                std::vector<JobCallback>& callbacks = it->second.callbacks;
+                for (auto callback = callbacks.begin(); callback != callbacks.end(); ) {
+                    if (callback->requestId != requestId) {
+                        ++callback;
+                        continue;
+                    }
+                    results.push_back({ false, "", it->second.url, 0, 0, 0, 0, callback->callback, true });
+                    callback = callbacks.erase(callback);
+                }
+
+                if (callbacks.empty() && !it->second.dispatched) {
+                    jobMap_.erase(it);  // Its heap entries are skipped when popped
+                    jobsDropped++;
+                }
+            }
         }
+
+        if (!results.empty()) {
+            queueCompletions(results);
+            debugOutput("Cancelled " + std::to_string(results.size()) + " requests, dropped " +
+                        std::to_string(jobsDropped) + " queued jobs");
+        }
+        return static_cast<int>(results.size());
     }
 
-    // Called from JS bridge when image is loaded and ready
-    void onImageLoaded(bool success, const std::string& url, int rectX, int rectY, int rectWidth, int rectHeight) {
-        debugOutput("onImageLoaded called: " + url + " (success: " + (success ? "true" : "false") + ")");
+    // Called from JS bridge when an image is loaded and ready. viewIndex is -1 when the page
+    // did not report it, in which case the view is found by its URL (a URL is only ever in
+    // flight on one view).
+    void onImageLoaded(int viewIndex, bool success, const std::string& url, int rectX, int rectY, int rectWidth, int rectHeight) {
+        debugOutput("onImageLoaded called: " + url + " (view: " + std::to_string(viewIndex) + ", success: " + (success ? "true" : "false") + ")");
         debugOutput("Image rect: (" + std::to_string(rectX) + ", " + std::to_string(rectY) + ", " +
                    std::to_string(rectWidth) + "x" + std::to_string(rectHeight) + ")");
 
-        if (url != currentUrl_) {
-            debugOutput("WARNING: URL mismatch! Expected: " + currentUrl_ + ", Got: " + url);
+        if (viewIndex < 0 || viewIndex >= static_cast<int>(views_.size())) {
+            viewIndex = -1;
+            for (size_t i = 0; i < views_.size(); i++) {
+                if (views_[i].isProcessing && views_[i].currentUrl == url) {
+                    viewIndex = static_cast<int>(i);
+                    break;
+                }
+            }
+            if (viewIndex < 0) {
+                debugOutput("WARNING: No view is loading " + url);
+                completeJob(url, false, "", 0, 0, 0, 0);
+                return;
+            }
+        }
+
+        LoaderView& loader = views_[viewIndex];
+        if (url != loader.currentUrl) {
+            debugOutput("WARNING: URL mismatch! Expected: " + loader.currentUrl + ", Got: " + url);
         }
 
         if (success) {
             // Store rect coordinates
-            currentRectX_ = rectX;
-            currentRectY_ = rectY;
-            currentRectWidth_ = rectWidth;
-            currentRectHeight_ = rectHeight;
+            loader.currentRectX = rectX;
+            loader.currentRectY = rectY;
+            loader.currentRectWidth = rectWidth;
+            loader.currentRectHeight = rectHeight;
 
-            isImageReady_ = true;
-            renderAndSave();
+            loader.isImageReady = true;
+            renderAndSave(viewIndex);
         } else {
             debugOutput("Image load failed");
 
-            // Get hash and job data
-            std::string normalized = normalizeUrl(url);
-            std::string hash = calculateKodiHash(normalized);
-
-            LoadJob job;
-            {
-                std::lock_guard<std::mutex> lock(queueMutex_);
-                auto it = jobMap_.find(hash);
-                if (it != jobMap_.end()) {
-                    job = it->second;
-                    jobMap_.erase(it);  // Remove from map
-                }
+            // Back off before trying this URL again
+            if (cacheIndex_) {
+                int failures = cacheIndex_->recordFailure(cacheKeyFor(url), url, "Failed to load in the image loader view");
+                debugOutput("Recorded failure " + std::to_string(failures) + " for " + url);
             }
 
             // Queue failure completion for all callbacks
-            {
-                std::lock_guard<std::mutex> lock(completionMutex_);
-                for (size_t i = 0; i < job.callbacks.size(); ++i) {
-                    completionQueue_.push({ false, "", url, 0, 0, 0, 0, job.callbacks[i] });
-                }
-            }
+            completeJob(url, false, "", 0, 0, 0, 0);
 
             // Mark as not processing and process next job
             {
                 std::lock_guard<std::mutex> lock(queueMutex_);
-                isProcessing_ = false;
+                loader.isProcessing = false;
             }
-            processNextJob();
+            processNextJob(viewIndex);
         }
     }
 
-    // Called from JS bridge when image loader HTML is ready
-    void onImageLoaderReady() {
-        debugOutput("Image loader HTML ready");
-        isInitialized_ = true;
-
-        // Start processing queued jobs if any
-        bool hasJobs = false;
-        {
-            std::lock_guard<std::mutex> lock(queueMutex_);
-            hasJobs = !jobQueue_.empty();
+    // Called when the image loader HTML of one view is ready
+    void onImageLoaderReady(View* view) {
+        int viewIndex = indexOfView(view);
+        if (viewIndex < 0) {
+            debugOutput("ERROR: Ready notification from an unknown view");
+            return;
         }
 
-        // Call processNextJob AFTER releasing the lock
-        if (hasJobs) {
-            processNextJob();
-        }
+        debugOutput("Image loader HTML ready on view " + std::to_string(viewIndex));
+        views_[viewIndex].isInitialized = true;
+
+        // Start processing queued jobs if any
+        processNextJob(viewIndex);
     }
 
     // Process completed renders - MUST be called from main thread
     void processCompletions() {
-        std::lock_guard<std::mutex> lock(completionMutex_);
+        // Take the whole queue; callbacks may queue more (e.g. a cache hit), which the next dispatch delivers
+        std::queue<PendingCompletion> completions;
+        {
+            std::lock_guard<std::mutex> lock(completionMutex_);
+            completions.swap(completionQueue_);
+            completionDispatchPending_ = false;
+        }
+
+        if (!completions.empty()) {
+            size_t count = completions.size();
+            double batchMaxMs = 0.0;
 
-        while (!completionQueue_.empty()) {
-            ImageLoadResult result = completionQueue_.front();
-            completionQueue_.pop();
+            while (!completions.empty()) {
+                PendingCompletion& completion = completions.front();
 
-            // Call the callback stored in the result
-            if (result.callback) {
-                result.callback(result);
+                double latencyMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - completion.queuedAt).count();
+                completionStats_.delivered++;
+                completionStats_.totalLatencyMs += latencyMs;
+                completionStats_.maxLatencyMs = (std::max)(completionStats_.maxLatencyMs, latencyMs);
+                batchMaxMs = (std::max)(batchMaxMs, latencyMs);
+
+                // Call the callback stored in the result
+                if (completion.result.callback) {
+                    completion.result.callback(completion.result);
+                }
+                completions.pop();
             }
+
+            completionStats_.batches++;
+            debugOutput("Delivered " + std::to_string(count) + " completions (latency up to " +
+                        std::to_string(static_cast<int>(batchMaxMs)) + " ms, average " +
+                        std::to_string(static_cast<int>(completionStats_.totalLatencyMs / completionStats_.delivered)) + " ms overall)");
         }
+
+        // Dispatch local files the decode threads handed back to the views
+        processNextJobs();
     }
 
     // LoadListener implementation (defined in ImageLoader.cpp)
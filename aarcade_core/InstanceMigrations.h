@@ -0,0 +1,103 @@
+#ifndef INSTANCE_MIGRATIONS_H
+#define INSTANCE_MIGRATIONS_H
+
+#include "ArcadeKeyValues.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+
+/**
+ * InstanceMigration - Upgrades an instance from one generation to the next
+ *
+ * Instances record their format in the "generation" key of the instance section (next to
+ * "info", "objects" and "overrides"). Each migration turns generation N into N + 1 by
+ * editing that section; the migrator bumps the generation key afterwards. Migrations run concurrently on the scan workers,
+ * so apply() must not keep state between calls.
+ *
+ * To add one, derive from this class and add it to createInstanceMigrations().
+ */
+class InstanceMigration {
+public:
+    virtual ~InstanceMigration() {}
+    virtual int fromGeneration() const = 0;
+    virtual const char* name() const = 0;
+    virtual bool apply(ArcadeKeyValues* instance, std::string& error) const = 0;
+};
+
+// Registered migrations, one per source generation. None are registered yet: the target
+// shape of each generation has to be settled before a transform is written for it.
+inline std::vector<std::unique_ptr<InstanceMigration>> createInstanceMigrations() {
+    std::vector<std::unique_ptr<InstanceMigration>> migrations;
+    return migrations;
+}
+
+/**
+ * InstanceMigrator - Chains the registered migrations up to the newest generation
+ */
+class InstanceMigrator {
+private:
+    std::map<int, std::unique_ptr<InstanceMigration>> migrations_;  // By source generation
+
+public:
+    InstanceMigrator() {
+        for (auto& migration : createInstanceMigrations()) {
+            add(std::move(migration));
+        }
+    }
+
+    void add(std::unique_ptr<InstanceMigration> migration) {
+        int from = migration->fromGeneration();
+        migrations_[from] = std::move(migration);
+    }
+
+    // One past the newest registered migration, -1 when there are none
+    int targetGeneration() const {
+        return migrations_.empty() ? -1 : migrations_.rbegin()->first + 1;
+    }
+
+    // -1 if the instance has no generation key
+    static int generationOf(ArcadeKeyValues* instance) {
+        ArcadeKeyValues* generationKey = instance ? instance->FindKey("generation") : nullptr;
+        return generationKey ? generationKey->GetInt(nullptr, 0) : -1;
+    }
+
+    // Instances without a generation are left alone; there is no known starting point for them
+    bool needsUpgrade(ArcadeKeyValues* instance) const {
+        int generation = generationOf(instance);
+        return generation >= 0 && generation < targetGeneration();
+    }
+
+    // Upgrade in place to the target generation. Returns the number of steps applied, or -1 on
+    // error (the tree may be partly changed and must not be written back).
+    int upgrade(ArcadeKeyValues* instance, std::string& error) const {
+        int generation = generationOf(instance);
+        int steps = 0;
+        while (generation >= 0 && generation < targetGeneration()) {
+            auto it = migrations_.find(generation);
+            if (it == migrations_.end()) {
+                error = "No migration from generation " + std::to_string(generation);
+                return -1;
+            }
+            if (!it->second->apply(instance, error)) {
+                error = std::string(it->second->name()) + ": " + error;
+                return -1;
+            }
+            generation++;
+            instance->SetInt("generation", generation);
+            steps++;
+        }
+        return steps;
+    }
+
+    // (source generation, name) of every registered migration
+    std::vector<std::pair<int, std::string>> list() const {
+        std::vector<std::pair<int, std::string>> migrations;
+        for (const auto& migration : migrations_) {
+            migrations.push_back({ migration.first, migration.second->name() });
+        }
+        return migrations;
+    }
+};
+
+#endif // INSTANCE_MIGRATIONS_H
@@ -240,777 +240,3745 @@ JSValueRef dbtMergeDatabaseCallback(JSContextRef ctx, JSObjectRef function, JSOb
     return JSValueMakeNull(ctx);
 }
 
-JSBridge::JSBridge(SQLiteManager* dbManager, ArcadeConfig* config, Library* library)
-    : dbManager_(dbManager), config_(config), library_(library), renderer_(nullptr), app_(nullptr), imageLoader_(nullptr) {
-    // Set this as the global instance
-    setInstance(this);
-
-    // ImageLoader will be set by MainApp after initialization
+JSValueRef dbtDiffDatabasesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtDiffDatabases(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Get current working directory for debug output
-    char currentDir[MAX_PATH];
-    GetCurrentDirectoryA(MAX_PATH, currentDir);
-    std::string debugMsg = "[JSBridge] Current working directory: " + std::string(currentDir) + "\n";
-    OutputDebugStringA(debugMsg.c_str());
+JSValueRef dbtGetNextDiffResultsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtGetNextDiffResults(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
 }
 
-JSBridge::~JSBridge() {
-    // Clear the global instance
-    if (g_jsBridgeInstance == this) {
-        g_jsBridgeInstance = nullptr;
+JSValueRef dbtCloseDiffCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtCloseDiff(ctx, function, thisObject, argumentCount, arguments, exception);
     }
+    return JSValueMakeNull(ctx);
+}
 
-    // ImageLoader is owned by MainApp, no cleanup needed here
+JSValueRef jobStartCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->jobStart(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
 }
 
-void JSBridge::setApp(RefPtr<App> app) {
-    if (app) {
-        app_ = app;
-        if (!renderer_) {
-            renderer_ = app->renderer();
-            OutputDebugStringA("[JSBridge] Renderer obtained from App\n");
-        }
+JSValueRef jobPauseCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->jobPause(ctx, function, thisObject, argumentCount, arguments, exception);
     }
+    return JSValueMakeNull(ctx);
 }
 
-void JSBridge::setImageLoader(ImageLoader* imageLoader) {
-    imageLoader_ = imageLoader;
-    OutputDebugStringA("[JSBridge] ImageLoader reference set\n");
+JSValueRef jobResumeCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->jobResume(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
 }
 
-void JSBridge::setupJavaScriptBridge(View* view, uint64_t frame_id, bool is_main_frame, const String& url) {
-    if (!is_main_frame) return;
+JSValueRef jobCancelCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->jobCancel(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // NOTE: ImageLoader is now initialized in MainApp after renderer is ready
-    // It uses its own dedicated view for rendering images to cache
+JSValueRef jobGetStatusCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->jobGetStatus(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Acquire the JS execution context for the current page
-    auto scoped_context = view->LockJSContext();
-    JSContextRef ctx = (*scoped_context);
+JSValueRef jobListCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->jobList(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Get the global JavaScript object (aka 'window')
-    JSObjectRef globalObj = JSContextGetGlobalObject(ctx);
+JSValueRef dbtStartOnlineCompactionCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtStartOnlineCompaction(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Create the 'aapi' object
-    JSObjectRef aapiObj = JSObjectMake(ctx, nullptr, nullptr);
+JSValueRef dbtGetOnlineCompactionStatusCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtGetOnlineCompactionStatus(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Register debug methods
-    JSStringRef methodName = JSStringCreateWithUTF8CString("debugTesterJoint");
-    JSObjectRef methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, debugTesterJointCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtFinishOnlineCompactionCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtFinishOnlineCompaction(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    methodName = JSStringCreateWithUTF8CString("debugGetFirstItemAsJSObject");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, debugGetFirstItemAsJSObjectCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtCancelOnlineCompactionCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtCancelOnlineCompaction(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Register entry browsing methods
-    methodName = JSStringCreateWithUTF8CString("getFirstEntry");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getFirstEntryCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtSetAutoVacuumModeCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtSetAutoVacuumMode(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    methodName = JSStringCreateWithUTF8CString("getNextEntry");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getNextEntryCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtIncrementalVacuumCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtIncrementalVacuum(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    methodName = JSStringCreateWithUTF8CString("getFirstEntries");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getFirstEntriesCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtAnalyzeStorageCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtAnalyzeStorage(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    methodName = JSStringCreateWithUTF8CString("getNextEntries");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getNextEntriesCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtGetHealthFindingsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtGetHealthFindings(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Register search methods
-    methodName = JSStringCreateWithUTF8CString("getFirstSearchResults");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getFirstSearchResultsCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtGetHealthScanSummaryCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtGetHealthScanSummary(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    methodName = JSStringCreateWithUTF8CString("getNextSearchResults");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getNextSearchResultsCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtComputeFieldStatisticsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtComputeFieldStatistics(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Register image caching methods
-    methodName = JSStringCreateWithUTF8CString("getCacheImage");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getCacheImageCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtGetFieldStatisticsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtGetFieldStatistics(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    methodName = JSStringCreateWithUTF8CString("processImageCompletions");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, processImageCompletionsCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtFindDuplicatesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtFindDuplicates(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Register utility method
-    methodName = JSStringCreateWithUTF8CString("getSupportedEntryTypes");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getSupportedEntryTypesCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtCollapseDuplicatesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtCollapseDuplicates(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Register schema construction
-    methodName = JSStringCreateWithUTF8CString("constructSchema");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, constructSchemaCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtCheckReferencesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtCheckReferences(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Register application control methods
-    methodName = JSStringCreateWithUTF8CString("quitApplication");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, quitApplicationCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtGetReferenceFindingsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtGetReferenceFindings(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    // Register database tools methods
-    methodName = JSStringCreateWithUTF8CString("dbtFindLargeEntriesInTable");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFindLargeEntriesInTableCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtFixDanglingReferencesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtFixDanglingReferences(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    methodName = JSStringCreateWithUTF8CString("dbtTrimTextFields");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtTrimTextFieldsCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+JSValueRef dbtPurgeUnreferencedCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtPurgeUnreferenced(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
 
-    methodName = JSStringCreateWithUTF8CString("dbtGetDatabaseStats");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetDatabaseStatsCallback);
+JSValueRef dbtRunCleanupRulesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtRunCleanupRules(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef dbtReplaceInFieldsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtReplaceInFields(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef dbtGetInstanceGenerationsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtGetInstanceGenerations(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef dbtMigrateInstancesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtMigrateInstances(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef dbtSetLazyMigrationCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtSetLazyMigration(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef jobUndoCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->jobUndo(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef dbtListUndoJournalsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtListUndoJournals(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef dbtUndoJournalCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtUndoJournal(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef dbtDeleteUndoJournalCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->dbtDeleteUndoJournal(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef getImageCacheLayoutCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->getImageCacheLayout(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef reprioritizeImagesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->reprioritizeImages(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef getImageCompletionStatsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->getImageCompletionStats(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef getImageMemoryCacheStatsCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->getImageMemoryCacheStats(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef clearImageFailuresCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->clearImageFailures(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSValueRef getCacheImagesCallback(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    JSBridge* bridge = JSBridge::getInstance();
+    if (bridge) {
+        return bridge->getCacheImages(ctx, function, thisObject, argumentCount, arguments, exception);
+    }
+    return JSValueMakeNull(ctx);
+}
+
+JSBridge::JSBridge(SQLiteManager* dbManager, ArcadeConfig* config, Library* library)
+    : dbManager_(dbManager), config_(config), library_(library), jobManager_(nullptr), lazyMigrationJobId_(-1), renderer_(nullptr), app_(nullptr), imageLoader_(nullptr) {
+    // Set this as the global instance
+    setInstance(this);
+
+    // ImageLoader will be set by MainApp after initialization
+
+    // Get current working directory for debug output
+    char currentDir[MAX_PATH];
+    GetCurrentDirectoryA(MAX_PATH, currentDir);
+    std::string debugMsg = "[JSBridge] Current working directory: " + std::string(currentDir) + "\n";
+    OutputDebugStringA(debugMsg.c_str());
+}
+
+JSBridge::~JSBridge() {
+    // Clear the global instance
+    if (g_jsBridgeInstance == this) {
+        g_jsBridgeInstance = nullptr;
+    }
+
+    // ImageLoader is owned by MainApp, no cleanup needed here
+}
+
+void JSBridge::setApp(RefPtr<App> app) {
+    if (app) {
+        app_ = app;
+        if (!renderer_) {
+            renderer_ = app->renderer();
+            OutputDebugStringA("[JSBridge] Renderer obtained from App\n");
+        }
+    }
+}
+
+void JSBridge::setImageLoader(ImageLoader* imageLoader) {
+    imageLoader_ = imageLoader;
+    OutputDebugStringA("[JSBridge] ImageLoader reference set\n");
+}
+
+void JSBridge::setJobManager(JobManager* jobManager) {
+    jobManager_ = jobManager;
+    OutputDebugStringA("[JSBridge] JobManager reference set\n");
+}
+
+void JSBridge::queueLazyMigration() {
+    if (!jobManager_) {
+        return;
+    }
+
+    // One write-back job at a time; ids collected meanwhile go with the next one
+    if (lazyMigrationJobId_ > 0) {
+        std::string status = jobManager_->getJobStatus(lazyMigrationJobId_, false).status;
+        if (status == "queued" || status == "running" || status == "paused") {
+            return;
+        }
+    }
+
+    std::vector<std::string> ids = library_->takePendingInstanceUpgrades();
+    if (ids.empty()) {
+        return;
+    }
+
+    JobManager::JobParams params;
+    params.entryIds = ids;
+    lazyMigrationJobId_ = jobManager_->startJob("migrateInstances", params);
+    OutputDebugStringA(("[JSBridge] Queued write-back of " + std::to_string(ids.size()) + " instances upgraded on read\n").c_str());
+}
+
+void JSBridge::setupJavaScriptBridge(View* view, uint64_t frame_id, bool is_main_frame, const String& url) {
+    if (!is_main_frame) return;
+
+    // NOTE: ImageLoader is now initialized in MainApp after renderer is ready
+    // It uses its own dedicated view for rendering images to cache
+
+    // Acquire the JS execution context for the current page
+    auto scoped_context = view->LockJSContext();
+    JSContextRef ctx = (*scoped_context);
+
+    // Get the global JavaScript object (aka 'window')
+    JSObjectRef globalObj = JSContextGetGlobalObject(ctx);
+
+    // Create the 'aapi' object
+    JSObjectRef aapiObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Register debug methods
+    JSStringRef methodName = JSStringCreateWithUTF8CString("debugTesterJoint");
+    JSObjectRef methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, debugTesterJointCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("debugGetFirstItemAsJSObject");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, debugGetFirstItemAsJSObjectCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    // Register entry browsing methods
+    methodName = JSStringCreateWithUTF8CString("getFirstEntry");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getFirstEntryCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("getNextEntry");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getNextEntryCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("getFirstEntries");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getFirstEntriesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("getNextEntries");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getNextEntriesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    // Register search methods
+    methodName = JSStringCreateWithUTF8CString("getFirstSearchResults");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getFirstSearchResultsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("getNextSearchResults");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getNextSearchResultsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    // Register image caching methods
+    methodName = JSStringCreateWithUTF8CString("getCacheImage");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getCacheImageCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("processImageCompletions");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, processImageCompletionsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    // Register utility method
+    methodName = JSStringCreateWithUTF8CString("getSupportedEntryTypes");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getSupportedEntryTypesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    // Register schema construction
+    methodName = JSStringCreateWithUTF8CString("constructSchema");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, constructSchemaCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    // Register application control methods
+    methodName = JSStringCreateWithUTF8CString("quitApplication");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, quitApplicationCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    // Register database tools methods
+    methodName = JSStringCreateWithUTF8CString("dbtFindLargeEntriesInTable");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFindLargeEntriesInTableCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtTrimTextFields");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtTrimTextFieldsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetDatabaseStats");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetDatabaseStatsCallback);
     JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
     JSStringRelease(methodName);
 
-    methodName = JSStringCreateWithUTF8CString("dbtCompactDatabase");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtCompactDatabaseCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+    methodName = JSStringCreateWithUTF8CString("dbtCompactDatabase");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtCompactDatabaseCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtFindAnomalousInstances");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFindAnomalousInstancesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetInstanceKeyValues");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetInstanceKeyValuesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetEntryKeyValues");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetEntryKeyValuesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtRemoveAnomalousKeys");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtRemoveAnomalousKeysCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtFindEmptyInstances");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFindEmptyInstancesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtPurgeEmptyInstances");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtPurgeEmptyInstancesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtMergeDatabase");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtMergeDatabaseCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtDiffDatabases");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtDiffDatabasesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetNextDiffResults");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetNextDiffResultsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtCloseDiff");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtCloseDiffCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("jobStart");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, jobStartCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("jobPause");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, jobPauseCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("jobResume");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, jobResumeCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("jobCancel");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, jobCancelCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("jobGetStatus");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, jobGetStatusCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("jobList");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, jobListCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtStartOnlineCompaction");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtStartOnlineCompactionCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetOnlineCompactionStatus");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetOnlineCompactionStatusCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtFinishOnlineCompaction");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFinishOnlineCompactionCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtCancelOnlineCompaction");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtCancelOnlineCompactionCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtSetAutoVacuumMode");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtSetAutoVacuumModeCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtIncrementalVacuum");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtIncrementalVacuumCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtAnalyzeStorage");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtAnalyzeStorageCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetHealthFindings");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetHealthFindingsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetHealthScanSummary");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetHealthScanSummaryCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtComputeFieldStatistics");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtComputeFieldStatisticsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetFieldStatistics");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetFieldStatisticsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtFindDuplicates");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFindDuplicatesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtCollapseDuplicates");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtCollapseDuplicatesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtCheckReferences");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtCheckReferencesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetReferenceFindings");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetReferenceFindingsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtFixDanglingReferences");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFixDanglingReferencesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtPurgeUnreferenced");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtPurgeUnreferencedCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtRunCleanupRules");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtRunCleanupRulesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtReplaceInFields");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtReplaceInFieldsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtGetInstanceGenerations");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetInstanceGenerationsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtMigrateInstances");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtMigrateInstancesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtSetLazyMigration");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtSetLazyMigrationCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("jobUndo");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, jobUndoCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtListUndoJournals");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtListUndoJournalsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtUndoJournal");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtUndoJournalCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("dbtDeleteUndoJournal");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtDeleteUndoJournalCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("getImageCacheLayout");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getImageCacheLayoutCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("reprioritizeImages");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, reprioritizeImagesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("getImageCompletionStats");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getImageCompletionStatsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("getImageMemoryCacheStats");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getImageMemoryCacheStatsCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("clearImageFailures");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, clearImageFailuresCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    methodName = JSStringCreateWithUTF8CString("getCacheImages");
+    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, getCacheImagesCallback);
+    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
+    JSStringRelease(methodName);
+
+    // Add the aapi object to the global object
+    JSStringRef aapiName = JSStringCreateWithUTF8CString("aapi");
+    JSObjectSetProperty(ctx, globalObj, aapiName, aapiObj, 0, 0);
+    JSStringRelease(aapiName);
+
+    // Debug output to confirm registration
+    OutputDebugStringA("[JSBridge] JavaScript bridge registered with image caching support:\n");
+    OutputDebugStringA("[JSBridge]   - aapi.debugTesterJoint\n");
+    OutputDebugStringA("[JSBridge]   - aapi.debugGetFirstItemAsJSObject\n");
+    OutputDebugStringA("[JSBridge]   - aapi.getFirstEntry\n");
+    OutputDebugStringA("[JSBridge]   - aapi.getNextEntry\n");
+    OutputDebugStringA("[JSBridge]   - aapi.getFirstEntries\n");
+    OutputDebugStringA("[JSBridge]   - aapi.getNextEntries\n");
+    OutputDebugStringA("[JSBridge]   - aapi.getFirstSearchResults\n");
+    OutputDebugStringA("[JSBridge]   - aapi.getNextSearchResults\n");
+    OutputDebugStringA("[JSBridge]   - aapi.getCacheImage\n");
+    OutputDebugStringA("[JSBridge]   - aapi.processImageCompletions\n");
+    OutputDebugStringA("[JSBridge]   - aapi.getSupportedEntryTypes\n");
+    OutputDebugStringA("[JSBridge]   - aapi.constructSchema\n");
+    OutputDebugStringA("[JSBridge]   - aapi.dbtFindLargeEntriesInTable\n");
+    OutputDebugStringA("[JSBridge]   - aapi.dbtTrimTextFields\n");
+    OutputDebugStringA("[JSBridge]   - aapi.dbtGetDatabaseStats\n");
+    OutputDebugStringA("[JSBridge]   - aapi.dbtCompactDatabase\n");
+}
+
+// Helper function to convert Windows path to file:// URL
+std::string JSBridge::convertToFileUrl(const std::string& filePath) {
+    std::string fileUrl = "file:///";
+
+    for (char c : filePath) {
+        if (c == '\\') {
+            fileUrl += '/';
+        }
+        else {
+            fileUrl += c;
+        }
+    }
+
+    return fileUrl;
+}
+
+// Helper function to read an image priority: "visible", "near", "prefetch" or an ImagePriority
+// number. "cancel" reads as -1. Anything else is visible.
+static int jsValueToImagePriority(JSContextRef ctx, JSValueRef value, JSValueRef* exception) {
+    if (JSValueIsNumber(ctx, value)) {
+        int priority = static_cast<int>(JSValueToNumber(ctx, value, exception));
+        return (std::max)(static_cast<int>(IMAGE_PRIORITY_VISIBLE), (std::min)(priority, static_cast<int>(IMAGE_PRIORITY_PREFETCH)));
+    }
+    if (!JSValueIsString(ctx, value)) {
+        return IMAGE_PRIORITY_VISIBLE;
+    }
+
+    JSStringRef nameStr = JSValueToStringCopy(ctx, value, exception);
+    size_t nameLength = JSStringGetMaximumUTF8CStringSize(nameStr);
+    char* nameBuffer = new char[nameLength];
+    JSStringGetUTF8CString(nameStr, nameBuffer, nameLength);
+    std::string name(nameBuffer);
+    delete[] nameBuffer;
+    JSStringRelease(nameStr);
+
+    if (name == "near") return IMAGE_PRIORITY_NEAR;
+    if (name == "prefetch") return IMAGE_PRIORITY_PREFETCH;
+    if (name == "cancel") return -1;
+    return IMAGE_PRIORITY_VISIBLE;
+}
+
+JSValueRef JSBridge::getCacheImage(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getCacheImage called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] getCacheImage: Missing URL parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get URL from first argument
+    JSStringRef urlStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!urlStr) {
+        OutputDebugStringA("[JSBridge] getCacheImage: Invalid URL parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t urlLength = JSStringGetMaximumUTF8CStringSize(urlStr);
+    char* urlBuffer = new char[urlLength];
+    JSStringGetUTF8CString(urlStr, urlBuffer, urlLength);
+    std::string url(urlBuffer);
+    delete[] urlBuffer;
+    JSStringRelease(urlStr);
+
+    // Optional second argument: scheduling priority (defaults to visible)
+    int priority = IMAGE_PRIORITY_VISIBLE;
+    if (argumentCount >= 2) {
+        priority = (std::max)(jsValueToImagePriority(ctx, arguments[1], exception), static_cast<int>(IMAGE_PRIORITY_VISIBLE));
+    }
+
+    OutputDebugStringA(("[JSBridge] getCacheImage: Processing URL '" + url + "' (priority " + std::to_string(priority) + ")\n").c_str());
+
+    // Create a simple Promise-like object
+    JSObjectRef promiseObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Create then method that stores callbacks
+    JSStringRef thenStr = JSStringCreateWithUTF8CString("then");
+    JSObjectRef thenFunc = JSObjectMakeFunctionWithCallback(ctx, thenStr,
+        [](JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+            size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) -> JSValueRef {
+
+                if (argumentCount < 1) return JSValueMakeUndefined(ctx);
+
+                // Get the promise object (stored as 'this')
+                JSObjectRef promiseObj = thisObject;
+
+                // Store the resolve callback
+                JSStringRef resolveKey = JSStringCreateWithUTF8CString("_resolve");
+                JSObjectSetProperty(ctx, promiseObj, resolveKey, arguments[0], 0, 0);
+                JSStringRelease(resolveKey);
+
+                // Store reject callback if provided
+                if (argumentCount >= 2) {
+                    JSStringRef rejectKey = JSStringCreateWithUTF8CString("_reject");
+                    JSObjectSetProperty(ctx, promiseObj, rejectKey, arguments[1], 0, 0);
+                    JSStringRelease(rejectKey);
+                }
+
+                return promiseObj;
+        });
+
+    JSObjectSetProperty(ctx, promiseObj, thenStr, thenFunc, 0, 0);
+    JSStringRelease(thenStr);
+
+    // Create catch method for error handling
+    JSStringRef catchStr = JSStringCreateWithUTF8CString("catch");
+    JSObjectRef catchFunc = JSObjectMakeFunctionWithCallback(ctx, catchStr,
+        [](JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+            size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) -> JSValueRef {
+
+                if (argumentCount < 1) return JSValueMakeUndefined(ctx);
+
+                // Store the reject callback
+                JSStringRef rejectKey = JSStringCreateWithUTF8CString("_reject");
+                JSObjectSetProperty(ctx, thisObject, rejectKey, arguments[0], 0, 0);
+                JSStringRelease(rejectKey);
+
+                return thisObject;
+        });
+
+    JSObjectSetProperty(ctx, promiseObj, catchStr, catchFunc, 0, 0);
+    JSStringRelease(catchStr);
+
+    // Protect the promise object from garbage collection
+    JSValueProtect(ctx, promiseObj);
+
+    // Start the image loading process via Library
+    uint64_t requestId = library_->cacheImage(url, [this, ctx, promiseObj](const ImageLoadResult& result) {
+        if (result.success) {
+            // Convert to file:// URL
+            std::string fileUrl = convertToFileUrl(result.filePath);
+            OutputDebugStringA(("[JSBridge] Image cached successfully: " + fileUrl + "\n").c_str());
+
+            // Get the resolve callback
+            JSStringRef resolveKey = JSStringCreateWithUTF8CString("_resolve");
+            JSValueRef resolveFunc = JSObjectGetProperty(ctx, promiseObj, resolveKey, nullptr);
+            JSStringRelease(resolveKey);
+
+            if (JSValueIsObject(ctx, resolveFunc)) {
+                // Create result object with filePath
+                JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+                // Set filePath property
+                JSStringRef filePathKey = JSStringCreateWithUTF8CString("filePath");
+                JSStringRef filePathStr = JSStringCreateWithUTF8CString(fileUrl.c_str());
+                JSValueRef filePathValue = JSValueMakeString(ctx, filePathStr);
+                JSObjectSetProperty(ctx, resultObj, filePathKey, filePathValue, 0, 0);
+                JSStringRelease(filePathKey);
+                JSStringRelease(filePathStr);
+
+                // Call the resolve function with the result object
+                JSValueRef args[] = { resultObj };
+                JSObjectCallAsFunction(ctx, (JSObjectRef)resolveFunc, nullptr, 1, args, nullptr);
+            }
+        }
+        else {
+            OutputDebugStringA(result.cancelled ? "[JSBridge] Image loading cancelled\n" : "[JSBridge] Image loading failed\n");
+
+            // Get the reject callback
+            JSStringRef rejectKey = JSStringCreateWithUTF8CString("_reject");
+            JSValueRef rejectFunc = JSObjectGetProperty(ctx, promiseObj, rejectKey, nullptr);
+            JSStringRelease(rejectKey);
+
+            if (JSValueIsObject(ctx, rejectFunc)) {
+                // Call the reject function with error message
+                JSStringRef errorStr = JSStringCreateWithUTF8CString(result.cancelled ? "Cancelled" : "Failed to load image");
+                JSValueRef errorValue = JSValueMakeString(ctx, errorStr);
+                JSStringRelease(errorStr);
+
+                JSValueRef args[] = { errorValue };
+                JSObjectCallAsFunction(ctx, (JSObjectRef)rejectFunc, nullptr, 1, args, nullptr);
+            }
+        }
+
+        // Unprotect the promise object
+        JSValueUnprotect(ctx, promiseObj);
+        }, priority);
+
+    // Handle for reprioritizeImages([url], "cancel", requestId), which cancels only this request
+    JSStringRef requestIdKey = JSStringCreateWithUTF8CString("requestId");
+    JSObjectSetProperty(ctx, promiseObj, requestIdKey, JSValueMakeNumber(ctx, static_cast<double>(requestId)), 0, nullptr);
+    JSStringRelease(requestIdKey);
+
+    return promiseObj;
+}
+
+JSValueRef JSBridge::processImageCompletions(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    // Process any pending completions from the worker thread via Library
+    library_->processImageCompletions();
+    return JSValueMakeUndefined(ctx);
+}
+
+JSValueRef JSBridge::debugTesterJoint(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] debugTesterJoint called from JavaScript\n");
+    OutputDebugStringA("=== SQLite Database Analysis Started ===\n");
+
+    std::string versionMsg = "SQLite Version: " + dbManager_->getVersion();
+    OutputDebugStringA((versionMsg + "\n").c_str());
+
+    std::string dbPathMsg = "Database Path: " + config_->getDatabasePath();
+    OutputDebugStringA((dbPathMsg + "\n").c_str());
+
+    bool success = true;
+
+    // Open or create database using config path
+    if (!dbManager_->openDatabase(config_->getDatabasePath())) {
+        OutputDebugStringA("[JSBridge] Failed to open database!\n");
+        success = false;
+    }
+
+    if (success) {
+        // Get general database information
+        if (!dbManager_->getDatabaseInfo()) {
+            OutputDebugStringA("[JSBridge] Failed to get database info!\n");
+            success = false;
+        }
+
+        // List all tables in the database
+        if (!dbManager_->listTables()) {
+            OutputDebugStringA("[JSBridge] Failed to list tables!\n");
+            success = false;
+        }
+
+        OutputDebugStringA("[JSBridge] Database analysis complete. Check output above for details.\n");
+    }
+
+    if (success) {
+        OutputDebugStringA("=== SQLite Database Analysis Completed Successfully ===\n");
+    }
+    else {
+        OutputDebugStringA("=== SQLite Database Analysis Failed ===\n");
+    }
+
+    // Return success status to JavaScript
+    return JSValueMakeBoolean(ctx, success);
+}
+
+JSObjectRef JSBridge::arcadeKeyValuesToJSObject(JSContextRef ctx, const ArcadeKeyValues* kv) {
+    if (!kv) {
+        return JSObjectMake(ctx, nullptr, nullptr);
+    }
+
+    JSObjectRef jsObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Add all children as properties (no metadata)
+    const auto& children = kv->GetChildren();
+    for (const auto& pair : children) {
+        const std::string& childName = pair.first;
+        const std::unique_ptr<ArcadeKeyValues>& child = pair.second;
+
+        JSStringRef childKey = JSStringCreateWithUTF8CString(childName.c_str());
+
+        // If the child has its own children, recursively convert to JSObject
+        if (child->GetChildCount() > 0) {
+            JSObjectRef childObj = arcadeKeyValuesToJSObject(ctx, child.get());
+            JSObjectSetProperty(ctx, jsObj, childKey, childObj, 0, 0);
+        }
+        else {
+            // If it's a leaf node, add its value directly
+            const char* childStringVal = child->GetString();
+            if (childStringVal && strlen(childStringVal) > 0) {
+                JSStringRef childValueStr = JSStringCreateWithUTF8CString(childStringVal);
+                JSValueRef childValueJS = JSValueMakeString(ctx, childValueStr);
+                JSObjectSetProperty(ctx, jsObj, childKey, childValueJS, 0, 0);
+                JSStringRelease(childValueStr);
+            }
+            else {
+                int childIntVal = child->GetInt();
+                if (childIntVal != 0) {
+                    JSValueRef childValueJS = JSValueMakeNumber(ctx, childIntVal);
+                    JSObjectSetProperty(ctx, jsObj, childKey, childValueJS, 0, 0);
+                }
+                else {
+                    float childFloatVal = child->GetFloat();
+                    if (childFloatVal != 0.0f) {
+                        JSValueRef childValueJS = JSValueMakeNumber(ctx, childFloatVal);
+                        JSObjectSetProperty(ctx, jsObj, childKey, childValueJS, 0, 0);
+                    }
+                }
+            }
+        }
+
+        JSStringRelease(childKey);
+    }
+
+    return jsObj;
+}
+
+JSObjectRef JSBridge::entryDataToJSObject(JSContextRef ctx, const std::string& entryId, const std::string& hexData) {
+    if (entryId.empty() || hexData.empty()) {
+        return JSValueToObject(ctx, JSValueMakeNull(ctx), nullptr);
+    }
+
+    // Parse the hex data using ArcadeKeyValues
+    try {
+        auto keyValues = ArcadeKeyValues::ParseFromHex(hexData);
+        if (!keyValues) {
+            return JSValueToObject(ctx, JSValueMakeNull(ctx), nullptr);
+        }
+
+        // For items table, try to navigate to item.local path for backwards compatibility
+        ArcadeKeyValues* itemSection = keyValues->GetFirstSubKey();
+        if (itemSection) {
+            ArcadeKeyValues* localSection = itemSection->FindKey("local");
+            if (localSection) {
+                return arcadeKeyValuesToJSObject(ctx, localSection);
+            }
+        }
+
+        // For other tables or if item.local doesn't exist, return the entire parsed structure
+        return arcadeKeyValuesToJSObject(ctx, keyValues.get());
+
+    }
+    catch (const std::exception& e) {
+        std::string errorMsg = "[JSBridge] Exception parsing KeyValues: " + std::string(e.what());
+        OutputDebugStringA((errorMsg + "\n").c_str());
+        return JSValueToObject(ctx, JSValueMakeNull(ctx), nullptr);
+    }
+}
+
+JSObjectRef JSBridge::createJSArray(JSContextRef ctx, const std::vector<std::pair<std::string, std::string>>& entries) {
+    JSObjectRef arrayObj = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (unsigned int i = 0; i < entries.size(); i++) {
+        JSObjectRef entryObj = entryDataToJSObject(ctx, entries[i].first, entries[i].second);
+        JSValueRef entryValue = static_cast<JSValueRef>(entryObj);
+        JSObjectSetPropertyAtIndex(ctx, arrayObj, i, entryValue, nullptr);
+    }
+
+    return arrayObj;
+}
+
+JSObjectRef JSBridge::createStringArray(JSContextRef ctx, const std::vector<std::string>& strings) {
+    JSObjectRef arrayObj = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (unsigned int i = 0; i < strings.size(); i++) {
+        JSStringRef stringValue = JSStringCreateWithUTF8CString(strings[i].c_str());
+        JSValueRef jsStringValue = JSValueMakeString(ctx, stringValue);
+        JSObjectSetPropertyAtIndex(ctx, arrayObj, i, jsStringValue, nullptr);
+        JSStringRelease(stringValue);
+    }
+
+    return arrayObj;
+}
+
+JSValueRef JSBridge::getSupportedEntryTypes(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getSupportedEntryTypes called from JavaScript\n");
+
+    // Get supported types from Library
+    std::vector<std::string> supportedTypes = library_->getSupportedEntryTypes();
+
+    // Convert to JavaScript array
+    return createStringArray(ctx, supportedTypes);
+}
+
+JSValueRef JSBridge::constructSchema(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] constructSchema called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] constructSchema: Missing entryType parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get entry type from first argument
+    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!entryTypeStr) {
+        OutputDebugStringA("[JSBridge] constructSchema: Invalid entry type parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
+    char* entryTypeBuffer = new char[entryTypeLength];
+    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
+    std::string entryType = entryTypeBuffer;
+    delete[] entryTypeBuffer;
+    JSStringRelease(entryTypeStr);
+
+    // Optional second argument forces a rebuild of the schema catalog
+    bool rebuild = false;
+    if (argumentCount >= 2) {
+        rebuild = JSValueToBoolean(ctx, arguments[1]);
+    }
+
+    // Optional sampleSize argument: analyze a random sample instead of the whole table
+    int sampleSize = 0;
+    if (argumentCount >= 3) {
+        sampleSize = static_cast<int>(JSValueToNumber(ctx, arguments[2], exception));
+    }
+    Library::SampleInfo sampleInfo;
+
+    // Get schema from Library (served from the schema catalog)
+    std::vector<Library::SchemaField> schema = library_->constructSchema(entryType, rebuild, sampleSize, &sampleInfo);
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < schema.size(); i++) {
+        const auto& field = schema[i];
+
+        // Create object for this field
+        JSObjectRef fieldObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set path property
+        JSStringRef pathKey = JSStringCreateWithUTF8CString("path");
+        JSStringRef pathValue = JSStringCreateWithUTF8CString(field.path.c_str());
+        JSObjectSetProperty(ctx, fieldObj, pathKey, JSValueMakeString(ctx, pathValue), 0, nullptr);
+        JSStringRelease(pathKey);
+        JSStringRelease(pathValue);
+
+        // Set valueType property
+        JSStringRef valueTypeKey = JSStringCreateWithUTF8CString("valueType");
+        JSStringRef valueTypeValue = JSStringCreateWithUTF8CString(field.valueType.c_str());
+        JSObjectSetProperty(ctx, fieldObj, valueTypeKey, JSValueMakeString(ctx, valueTypeValue), 0, nullptr);
+        JSStringRelease(valueTypeKey);
+        JSStringRelease(valueTypeValue);
+
+        // Set occurrences property
+        JSStringRef occurrencesKey = JSStringCreateWithUTF8CString("occurrences");
+        JSObjectSetProperty(ctx, fieldObj, occurrencesKey, JSValueMakeNumber(ctx, static_cast<double>(field.occurrences)), 0, nullptr);
+        JSStringRelease(occurrencesKey);
+
+        // Set frequency property
+        JSStringRef frequencyKey = JSStringCreateWithUTF8CString("frequency");
+        JSObjectSetProperty(ctx, fieldObj, frequencyKey, JSValueMakeNumber(ctx, field.frequency), 0, nullptr);
+        JSStringRelease(frequencyKey);
+
+        // Set firstSeen property
+        JSStringRef firstSeenKey = JSStringCreateWithUTF8CString("firstSeen");
+        JSObjectSetProperty(ctx, fieldObj, firstSeenKey, JSValueMakeNumber(ctx, static_cast<double>(field.firstSeen)), 0, nullptr);
+        JSStringRelease(firstSeenKey);
+
+        // Set lastSeen property
+        JSStringRef lastSeenKey = JSStringCreateWithUTF8CString("lastSeen");
+        JSObjectSetProperty(ctx, fieldObj, lastSeenKey, JSValueMakeNumber(ctx, static_cast<double>(field.lastSeen)), 0, nullptr);
+        JSStringRelease(lastSeenKey);
+
+        // Add to results array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, fieldObj, nullptr);
+    }
+
+    // Sampled calls return the results together with the sample coverage
+    if (sampleSize > 0) {
+        return sampledResultToJSObject(ctx, resultsArray, sampleInfo);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::quitApplication(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] quitApplication called from JavaScript\n");
+
+    if (app_) {
+        app_->Quit();
+        OutputDebugStringA("[JSBridge] Application quit requested\n");
+        return JSValueMakeBoolean(ctx, true);
+    }
+    else {
+        OutputDebugStringA("[JSBridge] ERROR: App instance not available\n");
+        return JSValueMakeBoolean(ctx, false);
+    }
+}
+
+JSValueRef JSBridge::getFirstEntry(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getFirstEntry called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] getFirstEntry: Missing entry type parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get entry type from first argument
+    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!entryTypeStr) {
+        OutputDebugStringA("[JSBridge] getFirstEntry: Invalid entry type parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
+    char* entryTypeBuffer = new char[entryTypeLength];
+    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
+    std::string entryType(entryTypeBuffer);
+    delete[] entryTypeBuffer;
+    JSStringRelease(entryTypeStr);
+
+    // Get the first entry via Library
+    std::pair<std::string, std::string> entry = library_->getFirstEntry(entryType);
+    queueLazyMigration();
+
+    return entryDataToJSObject(ctx, entry.first, entry.second);
+}
+
+JSValueRef JSBridge::getNextSearchResults(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getNextSearchResults called from JavaScript\n");
+
+    // Get count from first argument (optional, default to 50)
+    int count = 50;
+    if (argumentCount >= 1) {
+        double countDouble = JSValueToNumber(ctx, arguments[0], exception);
+        count = static_cast<int>(countDouble);
+        if (count <= 0 || count > 1000) {
+            count = 50; // Reset to default if invalid
+        }
+    }
+
+    // Get the next search results via Library
+    std::vector<std::pair<std::string, std::string>> results = library_->getNextSearchResults(count);
+    queueLazyMigration();
+
+    return createJSArray(ctx, results);
+}
+
+JSValueRef JSBridge::debugGetFirstItemAsJSObject(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] debugGetFirstItemAsJSObject called from JavaScript (legacy method)\n");
+
+    // Get the first item from the database via Library (legacy method)
+    std::pair<std::string, std::string> itemResult = library_->getFirstItem();
+
+    return entryDataToJSObject(ctx, itemResult.first, itemResult.second);
+}
+
+JSValueRef JSBridge::getNextEntry(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getNextEntry called from JavaScript\n");
+
+    // Get the next entry via Library (no parameters needed)
+    std::pair<std::string, std::string> entry = library_->getNextEntry();
+    queueLazyMigration();
+
+    return entryDataToJSObject(ctx, entry.first, entry.second);
+}
+
+JSValueRef JSBridge::getFirstEntries(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getFirstEntries called from JavaScript\n");
+
+    if (argumentCount < 2) {
+        OutputDebugStringA("[JSBridge] getFirstEntries: Missing parameters (entryType, count)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get entry type from first argument
+    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!entryTypeStr) {
+        OutputDebugStringA("[JSBridge] getFirstEntries: Invalid entry type parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
+    char* entryTypeBuffer = new char[entryTypeLength];
+    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
+    std::string entryType(entryTypeBuffer);
+    delete[] entryTypeBuffer;
+    JSStringRelease(entryTypeStr);
+
+    // Get count from second argument
+    double countDouble = JSValueToNumber(ctx, arguments[1], exception);
+    int count = static_cast<int>(countDouble);
+
+    if (count <= 0 || count > 1000) { // Reasonable limit
+        OutputDebugStringA("[JSBridge] getFirstEntries: Invalid count parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get the first entries via Library
+    std::vector<std::pair<std::string, std::string>> entries = library_->getFirstEntries(entryType, count);
+    queueLazyMigration();
+
+    return createJSArray(ctx, entries);
+}
+
+JSValueRef JSBridge::getNextEntries(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getNextEntries called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] getNextEntries: Missing count parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get count from first argument
+    double countDouble = JSValueToNumber(ctx, arguments[0], exception);
+    int count = static_cast<int>(countDouble);
+
+    if (count <= 0 || count > 1000) { // Reasonable limit
+        OutputDebugStringA("[JSBridge] getNextEntries: Invalid count parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get the next entries via Library
+    std::vector<std::pair<std::string, std::string>> entries = library_->getNextEntries(count);
+    queueLazyMigration();
+
+    return createJSArray(ctx, entries);
+}
+
+JSValueRef JSBridge::getFirstSearchResults(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getFirstSearchResults called from JavaScript\n");
+
+    if (argumentCount < 2) {
+        OutputDebugStringA("[JSBridge] getFirstSearchResults: Missing parameters (entryType, searchTerm)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get entry type from first argument
+    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!entryTypeStr) {
+        OutputDebugStringA("[JSBridge] getFirstSearchResults: Invalid entry type parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
+    char* entryTypeBuffer = new char[entryTypeLength];
+    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
+    std::string entryType(entryTypeBuffer);
+    delete[] entryTypeBuffer;
+    JSStringRelease(entryTypeStr);
+
+    // Get search term from second argument
+    JSStringRef searchTermStr = JSValueToStringCopy(ctx, arguments[1], exception);
+    if (!searchTermStr) {
+        OutputDebugStringA("[JSBridge] getFirstSearchResults: Invalid search term parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t searchTermLength = JSStringGetMaximumUTF8CStringSize(searchTermStr);
+    char* searchTermBuffer = new char[searchTermLength];
+    JSStringGetUTF8CString(searchTermStr, searchTermBuffer, searchTermLength);
+    std::string searchTerm(searchTermBuffer);
+    delete[] searchTermBuffer;
+    JSStringRelease(searchTermStr);
+
+    // Get count from third argument (optional, default to 50)
+    int count = 50;
+    if (argumentCount >= 3) {
+        double countDouble = JSValueToNumber(ctx, arguments[2], exception);
+        count = static_cast<int>(countDouble);
+        if (count <= 0 || count > 1000) {
+            count = 50; // Reset to default if invalid
+        }
+    }
+
+    // Get the first search results via Library
+    std::vector<std::pair<std::string, std::string>> results = library_->getFirstSearchResults(entryType, searchTerm, count);
+    queueLazyMigration();
+
+    return createJSArray(ctx, results);
+}
+
+JSValueRef JSBridge::dbtFindLargeEntriesInTable(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtFindLargeEntriesInTable called from JavaScript\n");
+
+    if (argumentCount < 2) {
+        OutputDebugStringA("[JSBridge] dbtFindLargeEntriesInTable: Missing parameters (tableName, minSizeBytes)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get table name from first argument
+    JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!tableNameStr) {
+        OutputDebugStringA("[JSBridge] dbtFindLargeEntriesInTable: Invalid table name parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
+    char* tableNameBuffer = new char[tableNameLength];
+    JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
+    std::string tableName(tableNameBuffer);
+    delete[] tableNameBuffer;
+    JSStringRelease(tableNameStr);
+
+    // Get minimum size from second argument
+    double minSizeBytesDouble = JSValueToNumber(ctx, arguments[1], exception);
+    int minSizeBytes = static_cast<int>(minSizeBytesDouble);
+
+    if (minSizeBytes <= 0) {
+        OutputDebugStringA("[JSBridge] dbtFindLargeEntriesInTable: Invalid minSizeBytes parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    OutputDebugStringA(("[JSBridge] Searching " + tableName + " for entries over " + std::to_string(minSizeBytes) + " bytes\n").c_str());
+
+    // Optional sampleSize argument: analyze a random sample instead of the whole table
+    int sampleSize = 0;
+    if (argumentCount >= 3) {
+        sampleSize = static_cast<int>(JSValueToNumber(ctx, arguments[2], exception));
+    }
+    Library::SampleInfo sampleInfo;
+
+    // Get large entries from Library
+    std::vector<Library::LargeBlobEntry> entries = library_->dbtFindLargeEntriesInTable(tableName, minSizeBytes, sampleSize, &sampleInfo);
+
+    OutputDebugStringA(("[JSBridge] Found " + std::to_string(entries.size()) + " large entries\n").c_str());
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(entries[i].id.c_str());
+        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
+
+        // Set title property
+        JSStringRef titleKey = JSStringCreateWithUTF8CString("title");
+        JSStringRef titleValue = JSStringCreateWithUTF8CString(entries[i].title.c_str());
+        JSObjectSetProperty(ctx, entryObj, titleKey, JSValueMakeString(ctx, titleValue), 0, nullptr);
+        JSStringRelease(titleKey);
+        JSStringRelease(titleValue);
+
+        // Set sizeBytes property
+        JSStringRef sizeKey = JSStringCreateWithUTF8CString("sizeBytes");
+        JSObjectSetProperty(ctx, entryObj, sizeKey, JSValueMakeNumber(ctx, entries[i].sizeBytes), 0, nullptr);
+        JSStringRelease(sizeKey);
+
+        // Add to array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, entryObj, nullptr);
+    }
+
+    // Sampled calls return the results together with the sample coverage
+    if (sampleSize > 0) {
+        return sampledResultToJSObject(ctx, resultsArray, sampleInfo);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtTrimTextFields(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtTrimTextFields called from JavaScript\n");
+
+    if (argumentCount < 3) {
+        OutputDebugStringA("[JSBridge] dbtTrimTextFields: Missing parameters (tableName, entryIds, maxLength)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get table name from first argument
+    JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!tableNameStr) {
+        OutputDebugStringA("[JSBridge] dbtTrimTextFields: Invalid table name parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
+    char* tableNameBuffer = new char[tableNameLength];
+    JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
+    std::string tableName(tableNameBuffer);
+    delete[] tableNameBuffer;
+    JSStringRelease(tableNameStr);
+
+    // Get entryIds array from second argument
+    JSObjectRef entryIdsArray = JSValueToObject(ctx, arguments[1], exception);
+    if (!entryIdsArray) {
+        OutputDebugStringA("[JSBridge] dbtTrimTextFields: Invalid entryIds parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get array length
+    JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
+    JSValueRef lengthValue = JSObjectGetProperty(ctx, entryIdsArray, lengthProp, exception);
+    JSStringRelease(lengthProp);
+    double lengthDouble = JSValueToNumber(ctx, lengthValue, exception);
+    size_t arrayLength = static_cast<size_t>(lengthDouble);
+
+    // Extract entry IDs from array
+    std::vector<std::string> entryIds;
+    for (size_t i = 0; i < arrayLength; i++) {
+        JSValueRef idValue = JSObjectGetPropertyAtIndex(ctx, entryIdsArray, i, exception);
+        JSStringRef idStr = JSValueToStringCopy(ctx, idValue, exception);
+        if (idStr) {
+            size_t idLength = JSStringGetMaximumUTF8CStringSize(idStr);
+            char* idBuffer = new char[idLength];
+            JSStringGetUTF8CString(idStr, idBuffer, idLength);
+            entryIds.push_back(std::string(idBuffer));
+            delete[] idBuffer;
+            JSStringRelease(idStr);
+        }
+    }
+
+    // Get max length from third argument
+    double maxLengthDouble = JSValueToNumber(ctx, arguments[2], exception);
+    int maxLength = static_cast<int>(maxLengthDouble);
+
+    if (maxLength <= 0) {
+        OutputDebugStringA("[JSBridge] dbtTrimTextFields: Invalid maxLength parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    OutputDebugStringA(("[JSBridge] Trimming text fields for " + std::to_string(entryIds.size()) + " entries to max " + std::to_string(maxLength) + " chars\n").c_str());
+
+    // Call Library method
+    std::vector<Library::TrimResult> results = library_->dbtTrimTextFields(tableName, entryIds, maxLength);
+
+    OutputDebugStringA(("[JSBridge] Trim operation completed for " + std::to_string(results.size()) + " entries\n").c_str());
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < results.size(); i++) {
+        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(results[i].id.c_str());
+        JSObjectSetProperty(ctx, resultObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
+
+        // Set success property
+        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, results[i].success), 0, nullptr);
+        JSStringRelease(successKey);
+
+        // Set error property
+        JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+        JSStringRef errorValue = JSStringCreateWithUTF8CString(results[i].error.c_str());
+        JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+        JSStringRelease(errorKey);
+        JSStringRelease(errorValue);
+
+        // Add to array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtGetDatabaseStats(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtGetDatabaseStats called from JavaScript\n");
+
+    // Get database stats from Library
+    Library::DatabaseStats stats = library_->dbtGetDatabaseStats();
+
+    OutputDebugStringA(("[JSBridge] Stats received: fragmentationPercent=" + std::to_string(stats.fragmentationPercent) +
+                       ", freePages=" + std::to_string(stats.freePages) +
+                       ", pageCount=" + std::to_string(stats.pageCount) + "\n").c_str());
+
+    // Convert to JavaScript object
+    JSObjectRef statsObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set filePath property
+    JSStringRef filePathKey = JSStringCreateWithUTF8CString("filePath");
+    JSStringRef filePathValue = JSStringCreateWithUTF8CString(stats.filePath.c_str());
+    JSObjectSetProperty(ctx, statsObj, filePathKey, JSValueMakeString(ctx, filePathValue), 0, nullptr);
+    JSStringRelease(filePathKey);
+    JSStringRelease(filePathValue);
+
+    // Set fileSizeBytes property
+    JSStringRef fileSizeBytesKey = JSStringCreateWithUTF8CString("fileSizeBytes");
+    JSObjectSetProperty(ctx, statsObj, fileSizeBytesKey, JSValueMakeNumber(ctx, stats.fileSizeBytes), 0, nullptr);
+    JSStringRelease(fileSizeBytesKey);
+
+    // Set pageCount property
+    JSStringRef pageCountKey = JSStringCreateWithUTF8CString("pageCount");
+    JSObjectSetProperty(ctx, statsObj, pageCountKey, JSValueMakeNumber(ctx, stats.pageCount), 0, nullptr);
+    JSStringRelease(pageCountKey);
+
+    // Set pageSize property
+    JSStringRef pageSizeKey = JSStringCreateWithUTF8CString("pageSize");
+    JSObjectSetProperty(ctx, statsObj, pageSizeKey, JSValueMakeNumber(ctx, stats.pageSize), 0, nullptr);
+    JSStringRelease(pageSizeKey);
+
+    // Set freePages property
+    JSStringRef freePagesKey = JSStringCreateWithUTF8CString("freePages");
+    JSObjectSetProperty(ctx, statsObj, freePagesKey, JSValueMakeNumber(ctx, stats.freePages), 0, nullptr);
+    JSStringRelease(freePagesKey);
+
+    // Set fragmentationPercent property
+    JSStringRef fragmentationPercentKey = JSStringCreateWithUTF8CString("fragmentationPercent");
+    JSObjectSetProperty(ctx, statsObj, fragmentationPercentKey, JSValueMakeNumber(ctx, stats.fragmentationPercent), 0, nullptr);
+    JSStringRelease(fragmentationPercentKey);
+
+    // Set autoVacuumMode property
+    JSStringRef autoVacuumModeKey = JSStringCreateWithUTF8CString("autoVacuumMode");
+    JSStringRef autoVacuumModeValue = JSStringCreateWithUTF8CString(stats.autoVacuumMode.c_str());
+    JSObjectSetProperty(ctx, statsObj, autoVacuumModeKey, JSValueMakeString(ctx, autoVacuumModeValue), 0, nullptr);
+    JSStringRelease(autoVacuumModeKey);
+    JSStringRelease(autoVacuumModeValue);
+
+    // Set reclaimedPages property
+    JSStringRef reclaimedPagesKey = JSStringCreateWithUTF8CString("reclaimedPages");
+    JSObjectSetProperty(ctx, statsObj, reclaimedPagesKey, JSValueMakeNumber(ctx, stats.reclaimedPages), 0, nullptr);
+    JSStringRelease(reclaimedPagesKey);
+
+    // Set reclaimedBytes property
+    JSStringRef reclaimedBytesKey = JSStringCreateWithUTF8CString("reclaimedBytes");
+    JSObjectSetProperty(ctx, statsObj, reclaimedBytesKey, JSValueMakeNumber(ctx, stats.reclaimedBytes), 0, nullptr);
+    JSStringRelease(reclaimedBytesKey);
+
+    return statsObj;
+}
+
+JSValueRef JSBridge::dbtCompactDatabase(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtCompactDatabase called from JavaScript\n");
+
+    // Call Library method
+    Library::CompactResult result = library_->dbtCompactDatabase();
+
+    OutputDebugStringA(("[JSBridge] Compact result: success=" + std::string(result.success ? "true" : "false") +
+                       ", saved=" + std::to_string(result.spaceSavedBytes) + " bytes\n").c_str());
+
+    // Convert to JavaScript object
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set beforeSizeBytes property
+    JSStringRef beforeSizeBytesKey = JSStringCreateWithUTF8CString("beforeSizeBytes");
+    JSObjectSetProperty(ctx, resultObj, beforeSizeBytesKey, JSValueMakeNumber(ctx, result.beforeSizeBytes), 0, nullptr);
+    JSStringRelease(beforeSizeBytesKey);
+
+    // Set afterSizeBytes property
+    JSStringRef afterSizeBytesKey = JSStringCreateWithUTF8CString("afterSizeBytes");
+    JSObjectSetProperty(ctx, resultObj, afterSizeBytesKey, JSValueMakeNumber(ctx, result.afterSizeBytes), 0, nullptr);
+    JSStringRelease(afterSizeBytesKey);
+
+    // Set spaceSavedBytes property
+    JSStringRef spaceSavedBytesKey = JSStringCreateWithUTF8CString("spaceSavedBytes");
+    JSObjectSetProperty(ctx, resultObj, spaceSavedBytesKey, JSValueMakeNumber(ctx, result.spaceSavedBytes), 0, nullptr);
+    JSStringRelease(spaceSavedBytesKey);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtGetHealthFindings(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtGetHealthFindings called from JavaScript\n");
+
+    // Get checkName from argument 1 (optional, empty matches all)
+    std::string checkName;
+    if (argumentCount > 0) {
+        JSStringRef checkNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
+        if (checkNameStr) {
+            size_t checkNameLength = JSStringGetMaximumUTF8CStringSize(checkNameStr);
+            char* checkNameBuffer = new char[checkNameLength];
+            JSStringGetUTF8CString(checkNameStr, checkNameBuffer, checkNameLength);
+            checkName = std::string(checkNameBuffer);
+            delete[] checkNameBuffer;
+            JSStringRelease(checkNameStr);
+        }
+    }
+
+    // Get tableName from argument 2 (optional, empty matches all)
+    std::string tableName;
+    if (argumentCount > 1) {
+        JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[1], exception);
+        if (tableNameStr) {
+            size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
+            char* tableNameBuffer = new char[tableNameLength];
+            JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
+            tableName = std::string(tableNameBuffer);
+            delete[] tableNameBuffer;
+            JSStringRelease(tableNameStr);
+        }
+    }
+
+    std::vector<HealthFinding> findings = library_->dbtGetHealthFindings(checkName, tableName);
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < findings.size(); i++) {
+        const auto& finding = findings[i];
+
+        // Create object for this finding
+        JSObjectRef findingObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set tableName property
+        JSStringRef tableNameKey = JSStringCreateWithUTF8CString("tableName");
+        JSStringRef tableNameValue = JSStringCreateWithUTF8CString(finding.tableName.c_str());
+        JSObjectSetProperty(ctx, findingObj, tableNameKey, JSValueMakeString(ctx, tableNameValue), 0, nullptr);
+        JSStringRelease(tableNameKey);
+        JSStringRelease(tableNameValue);
+
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(finding.id.c_str());
+        JSObjectSetProperty(ctx, findingObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
+
+        // Set check property
+        JSStringRef checkKey = JSStringCreateWithUTF8CString("check");
+        JSStringRef checkValue = JSStringCreateWithUTF8CString(finding.check.c_str());
+        JSObjectSetProperty(ctx, findingObj, checkKey, JSValueMakeString(ctx, checkValue), 0, nullptr);
+        JSStringRelease(checkKey);
+        JSStringRelease(checkValue);
+
+        // Set detail property
+        JSStringRef detailKey = JSStringCreateWithUTF8CString("detail");
+        JSStringRef detailValue = JSStringCreateWithUTF8CString(finding.detail.c_str());
+        JSObjectSetProperty(ctx, findingObj, detailKey, JSValueMakeString(ctx, detailValue), 0, nullptr);
+        JSStringRelease(detailKey);
+        JSStringRelease(detailValue);
+
+        // Set sizeBytes property
+        JSStringRef sizeBytesKey = JSStringCreateWithUTF8CString("sizeBytes");
+        JSObjectSetProperty(ctx, findingObj, sizeBytesKey, JSValueMakeNumber(ctx, finding.sizeBytes), 0, nullptr);
+        JSStringRelease(sizeBytesKey);
+
+        // Set count property
+        JSStringRef countKey = JSStringCreateWithUTF8CString("count");
+        JSObjectSetProperty(ctx, findingObj, countKey, JSValueMakeNumber(ctx, finding.count), 0, nullptr);
+        JSStringRelease(countKey);
+
+        // Add to results array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, findingObj, nullptr);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtGetHealthScanSummary(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtGetHealthScanSummary called from JavaScript\n");
+
+    std::vector<Library::HealthScanTable> summary = library_->dbtGetHealthScanSummary();
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < summary.size(); i++) {
+        const auto& table = summary[i];
+
+        // Create object for this table
+        JSObjectRef tableObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set tableName property
+        JSStringRef tableNameKey = JSStringCreateWithUTF8CString("tableName");
+        JSStringRef tableNameValue = JSStringCreateWithUTF8CString(table.tableName.c_str());
+        JSObjectSetProperty(ctx, tableObj, tableNameKey, JSValueMakeString(ctx, tableNameValue), 0, nullptr);
+        JSStringRelease(tableNameKey);
+        JSStringRelease(tableNameValue);
+
+        // Set rowsScanned property
+        JSStringRef rowsScannedKey = JSStringCreateWithUTF8CString("rowsScanned");
+        JSObjectSetProperty(ctx, tableObj, rowsScannedKey, JSValueMakeNumber(ctx, table.rowsScanned), 0, nullptr);
+        JSStringRelease(rowsScannedKey);
+
+        // Set startedAt property
+        JSStringRef startedAtKey = JSStringCreateWithUTF8CString("startedAt");
+        JSObjectSetProperty(ctx, tableObj, startedAtKey, JSValueMakeNumber(ctx, table.startedAt), 0, nullptr);
+        JSStringRelease(startedAtKey);
+
+        // Set completedAt property
+        JSStringRef completedAtKey = JSStringCreateWithUTF8CString("completedAt");
+        JSObjectSetProperty(ctx, tableObj, completedAtKey, JSValueMakeNumber(ctx, table.completedAt), 0, nullptr);
+        JSStringRelease(completedAtKey);
+
+        // Set findingsCount property
+        JSStringRef findingsCountKey = JSStringCreateWithUTF8CString("findingsCount");
+        JSObjectSetProperty(ctx, tableObj, findingsCountKey, JSValueMakeNumber(ctx, table.findingsCount), 0, nullptr);
+        JSStringRelease(findingsCountKey);
+
+        // Add to results array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, tableObj, nullptr);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtComputeFieldStatistics(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtComputeFieldStatistics called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtComputeFieldStatistics: Missing entryType parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get entry type from first argument
+    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!entryTypeStr) {
+        OutputDebugStringA("[JSBridge] dbtComputeFieldStatistics: Invalid entry type parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
+    char* entryTypeBuffer = new char[entryTypeLength];
+    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
+    std::string entryType = entryTypeBuffer;
+    delete[] entryTypeBuffer;
+    JSStringRelease(entryTypeStr);
+
+    // Scan the table and persist fresh sketches
+    Library::FieldStatisticsResult result = library_->dbtComputeFieldStatistics(entryType);
+
+    return fieldStatisticsToJSObject(ctx, result);
+}
+
+JSValueRef JSBridge::dbtGetFieldStatistics(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtGetFieldStatistics called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtGetFieldStatistics: Missing entryType parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get entry type from first argument
+    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!entryTypeStr) {
+        OutputDebugStringA("[JSBridge] dbtGetFieldStatistics: Invalid entry type parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
+    char* entryTypeBuffer = new char[entryTypeLength];
+    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
+    std::string entryType = entryTypeBuffer;
+    delete[] entryTypeBuffer;
+    JSStringRelease(entryTypeStr);
+
+    // Load the statistics saved by the last computation
+    Library::FieldStatisticsResult result = library_->dbtGetFieldStatistics(entryType);
+
+    return fieldStatisticsToJSObject(ctx, result);
+}
+
+JSValueRef JSBridge::dbtAnalyzeStorage(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtAnalyzeStorage called from JavaScript\n");
+
+    Library::StorageAnalysis analysis = library_->dbtAnalyzeStorage();
+
+    OutputDebugStringA(("[JSBridge] Storage analysis: " + std::to_string(analysis.objects.size()) + " objects, " +
+                       std::to_string(analysis.blobHistograms.size()) + " histograms\n").c_str());
+
+    // Convert to JavaScript object
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, analysis.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(analysis.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set source property
+    JSStringRef sourceKey = JSStringCreateWithUTF8CString("source");
+    JSStringRef sourceValue = JSStringCreateWithUTF8CString(analysis.source.c_str());
+    JSObjectSetProperty(ctx, resultObj, sourceKey, JSValueMakeString(ctx, sourceValue), 0, nullptr);
+    JSStringRelease(sourceKey);
+    JSStringRelease(sourceValue);
+
+    // Set pageSize property
+    JSStringRef pageSizeKey = JSStringCreateWithUTF8CString("pageSize");
+    JSObjectSetProperty(ctx, resultObj, pageSizeKey, JSValueMakeNumber(ctx, analysis.pageSize), 0, nullptr);
+    JSStringRelease(pageSizeKey);
+
+    // Set objects property (array of per table/index stats)
+    JSObjectRef objectsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < analysis.objects.size(); i++) {
+        const auto& stats = analysis.objects[i];
+
+        // Create object for this table/index
+        JSObjectRef statsObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set name property
+        JSStringRef nameKey = JSStringCreateWithUTF8CString("name");
+        JSStringRef nameValue = JSStringCreateWithUTF8CString(stats.name.c_str());
+        JSObjectSetProperty(ctx, statsObj, nameKey, JSValueMakeString(ctx, nameValue), 0, nullptr);
+        JSStringRelease(nameKey);
+        JSStringRelease(nameValue);
+
+        // Set tableName property
+        JSStringRef tableNameKey = JSStringCreateWithUTF8CString("tableName");
+        JSStringRef tableNameValue = JSStringCreateWithUTF8CString(stats.tableName.c_str());
+        JSObjectSetProperty(ctx, statsObj, tableNameKey, JSValueMakeString(ctx, tableNameValue), 0, nullptr);
+        JSStringRelease(tableNameKey);
+        JSStringRelease(tableNameValue);
+
+        // Set type property
+        JSStringRef typeKey = JSStringCreateWithUTF8CString("type");
+        JSStringRef typeValue = JSStringCreateWithUTF8CString(stats.type.c_str());
+        JSObjectSetProperty(ctx, statsObj, typeKey, JSValueMakeString(ctx, typeValue), 0, nullptr);
+        JSStringRelease(typeKey);
+        JSStringRelease(typeValue);
+
+        // Set pages property
+        JSStringRef pagesKey = JSStringCreateWithUTF8CString("pages");
+        JSObjectSetProperty(ctx, statsObj, pagesKey, JSValueMakeNumber(ctx, stats.pages), 0, nullptr);
+        JSStringRelease(pagesKey);
+
+        // Set leafPages property
+        JSStringRef leafPagesKey = JSStringCreateWithUTF8CString("leafPages");
+        JSObjectSetProperty(ctx, statsObj, leafPagesKey, JSValueMakeNumber(ctx, stats.leafPages), 0, nullptr);
+        JSStringRelease(leafPagesKey);
+
+        // Set interiorPages property
+        JSStringRef interiorPagesKey = JSStringCreateWithUTF8CString("interiorPages");
+        JSObjectSetProperty(ctx, statsObj, interiorPagesKey, JSValueMakeNumber(ctx, stats.interiorPages), 0, nullptr);
+        JSStringRelease(interiorPagesKey);
+
+        // Set overflowPages property
+        JSStringRef overflowPagesKey = JSStringCreateWithUTF8CString("overflowPages");
+        JSObjectSetProperty(ctx, statsObj, overflowPagesKey, JSValueMakeNumber(ctx, stats.overflowPages), 0, nullptr);
+        JSStringRelease(overflowPagesKey);
+
+        // Set cells property
+        JSStringRef cellsKey = JSStringCreateWithUTF8CString("cells");
+        JSObjectSetProperty(ctx, statsObj, cellsKey, JSValueMakeNumber(ctx, stats.cells), 0, nullptr);
+        JSStringRelease(cellsKey);
+
+        // Set payloadBytes property
+        JSStringRef payloadBytesKey = JSStringCreateWithUTF8CString("payloadBytes");
+        JSObjectSetProperty(ctx, statsObj, payloadBytesKey, JSValueMakeNumber(ctx, stats.payloadBytes), 0, nullptr);
+        JSStringRelease(payloadBytesKey);
+
+        // Set unusedBytes property
+        JSStringRef unusedBytesKey = JSStringCreateWithUTF8CString("unusedBytes");
+        JSObjectSetProperty(ctx, statsObj, unusedBytesKey, JSValueMakeNumber(ctx, stats.unusedBytes), 0, nullptr);
+        JSStringRelease(unusedBytesKey);
+
+        // Set totalBytes property
+        JSStringRef totalBytesKey = JSStringCreateWithUTF8CString("totalBytes");
+        JSObjectSetProperty(ctx, statsObj, totalBytesKey, JSValueMakeNumber(ctx, stats.totalBytes), 0, nullptr);
+        JSStringRelease(totalBytesKey);
+
+        // Set averageFill property
+        JSStringRef averageFillKey = JSStringCreateWithUTF8CString("averageFill");
+        JSObjectSetProperty(ctx, statsObj, averageFillKey, JSValueMakeNumber(ctx, stats.averageFill), 0, nullptr);
+        JSStringRelease(averageFillKey);
+
+        // Add to objects array
+        JSObjectSetPropertyAtIndex(ctx, objectsArray, i, statsObj, nullptr);
+    }
+
+    JSStringRef objectsKey = JSStringCreateWithUTF8CString("objects");
+    JSObjectSetProperty(ctx, resultObj, objectsKey, objectsArray, 0, nullptr);
+    JSStringRelease(objectsKey);
+
+    // Set blobHistograms property (array, one per entry type)
+    JSObjectRef histogramsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < analysis.blobHistograms.size(); i++) {
+        const auto& histogram = analysis.blobHistograms[i];
+
+        // Create object for this entry type
+        JSObjectRef histogramObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set tableName property
+        JSStringRef tableNameKey = JSStringCreateWithUTF8CString("tableName");
+        JSStringRef tableNameValue = JSStringCreateWithUTF8CString(histogram.tableName.c_str());
+        JSObjectSetProperty(ctx, histogramObj, tableNameKey, JSValueMakeString(ctx, tableNameValue), 0, nullptr);
+        JSStringRelease(tableNameKey);
+        JSStringRelease(tableNameValue);
+
+        // Set count property
+        JSStringRef countKey = JSStringCreateWithUTF8CString("count");
+        JSObjectSetProperty(ctx, histogramObj, countKey, JSValueMakeNumber(ctx, histogram.count), 0, nullptr);
+        JSStringRelease(countKey);
+
+        // Set totalBytes property
+        JSStringRef totalBytesKey = JSStringCreateWithUTF8CString("totalBytes");
+        JSObjectSetProperty(ctx, histogramObj, totalBytesKey, JSValueMakeNumber(ctx, histogram.totalBytes), 0, nullptr);
+        JSStringRelease(totalBytesKey);
+
+        // Set p50 property
+        JSStringRef p50Key = JSStringCreateWithUTF8CString("p50");
+        JSObjectSetProperty(ctx, histogramObj, p50Key, JSValueMakeNumber(ctx, histogram.p50), 0, nullptr);
+        JSStringRelease(p50Key);
+
+        // Set p90 property
+        JSStringRef p90Key = JSStringCreateWithUTF8CString("p90");
+        JSObjectSetProperty(ctx, histogramObj, p90Key, JSValueMakeNumber(ctx, histogram.p90), 0, nullptr);
+        JSStringRelease(p90Key);
+
+        // Set p99 property
+        JSStringRef p99Key = JSStringCreateWithUTF8CString("p99");
+        JSObjectSetProperty(ctx, histogramObj, p99Key, JSValueMakeNumber(ctx, histogram.p99), 0, nullptr);
+        JSStringRelease(p99Key);
+
+        // Set max property
+        JSStringRef maxKey = JSStringCreateWithUTF8CString("max");
+        JSObjectSetProperty(ctx, histogramObj, maxKey, JSValueMakeNumber(ctx, histogram.max), 0, nullptr);
+        JSStringRelease(maxKey);
+
+        // Add to histograms array
+        JSObjectSetPropertyAtIndex(ctx, histogramsArray, i, histogramObj, nullptr);
+    }
+
+    JSStringRef blobHistogramsKey = JSStringCreateWithUTF8CString("blobHistograms");
+    JSObjectSetProperty(ctx, resultObj, blobHistogramsKey, histogramsArray, 0, nullptr);
+    JSStringRelease(blobHistogramsKey);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtStartOnlineCompaction(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtStartOnlineCompaction called from JavaScript\n");
+
+    std::string error;
+    bool success = library_->dbtStartOnlineCompaction(error);
+
+    OutputDebugStringA(("[JSBridge] Online compaction start: " + std::string(success ? "started" : error) + "\n").c_str());
+
+    // Convert to JavaScript object
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtGetOnlineCompactionStatus(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    // Called on a timer by the compact page, so no logging here
+
+    Library::OnlineCompactionStatus status = library_->dbtGetOnlineCompactionStatus();
+
+    // Convert to JavaScript object
+    JSObjectRef statusObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set running property
+    JSStringRef runningKey = JSStringCreateWithUTF8CString("running");
+    JSObjectSetProperty(ctx, statusObj, runningKey, JSValueMakeBoolean(ctx, status.running), 0, nullptr);
+    JSStringRelease(runningKey);
+
+    // Set readyToSwap property
+    JSStringRef readyToSwapKey = JSStringCreateWithUTF8CString("readyToSwap");
+    JSObjectSetProperty(ctx, statusObj, readyToSwapKey, JSValueMakeBoolean(ctx, status.readyToSwap), 0, nullptr);
+    JSStringRelease(readyToSwapKey);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, statusObj, successKey, JSValueMakeBoolean(ctx, status.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(status.error.c_str());
+    JSObjectSetProperty(ctx, statusObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set beforeSizeBytes property
+    JSStringRef beforeSizeBytesKey = JSStringCreateWithUTF8CString("beforeSizeBytes");
+    JSObjectSetProperty(ctx, statusObj, beforeSizeBytesKey, JSValueMakeNumber(ctx, status.beforeSizeBytes), 0, nullptr);
+    JSStringRelease(beforeSizeBytesKey);
+
+    // Set copySizeBytes property
+    JSStringRef copySizeBytesKey = JSStringCreateWithUTF8CString("copySizeBytes");
+    JSObjectSetProperty(ctx, statusObj, copySizeBytesKey, JSValueMakeNumber(ctx, status.copySizeBytes), 0, nullptr);
+    JSStringRelease(copySizeBytesKey);
+
+    // Set changesLogged property
+    JSStringRef changesLoggedKey = JSStringCreateWithUTF8CString("changesLogged");
+    JSObjectSetProperty(ctx, statusObj, changesLoggedKey, JSValueMakeNumber(ctx, status.changesLogged), 0, nullptr);
+    JSStringRelease(changesLoggedKey);
+
+    return statusObj;
+}
+
+JSValueRef JSBridge::dbtFinishOnlineCompaction(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtFinishOnlineCompaction called from JavaScript\n");
+
+    Library::CompactResult result;
+    result.success = false;
+    result.beforeSizeBytes = 0;
+    result.afterSizeBytes = 0;
+    result.spaceSavedBytes = 0;
+
+    // The job worker holds its own connection to the file, which has to be closed before the swap
+    if (jobManager_ && !jobManager_->releaseConnection()) {
+        result.error = "Background jobs are still active";
+    }
+    else {
+        result = library_->dbtFinishOnlineCompaction();
+    }
+
+    OutputDebugStringA(("[JSBridge] Online compaction result: success=" + std::string(result.success ? "true" : "false") +
+                       ", saved=" + std::to_string(result.spaceSavedBytes) + " bytes\n").c_str());
+
+    // Convert to JavaScript object
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set beforeSizeBytes property
+    JSStringRef beforeSizeBytesKey = JSStringCreateWithUTF8CString("beforeSizeBytes");
+    JSObjectSetProperty(ctx, resultObj, beforeSizeBytesKey, JSValueMakeNumber(ctx, result.beforeSizeBytes), 0, nullptr);
+    JSStringRelease(beforeSizeBytesKey);
+
+    // Set afterSizeBytes property
+    JSStringRef afterSizeBytesKey = JSStringCreateWithUTF8CString("afterSizeBytes");
+    JSObjectSetProperty(ctx, resultObj, afterSizeBytesKey, JSValueMakeNumber(ctx, result.afterSizeBytes), 0, nullptr);
+    JSStringRelease(afterSizeBytesKey);
+
+    // Set spaceSavedBytes property
+    JSStringRef spaceSavedBytesKey = JSStringCreateWithUTF8CString("spaceSavedBytes");
+    JSObjectSetProperty(ctx, resultObj, spaceSavedBytesKey, JSValueMakeNumber(ctx, result.spaceSavedBytes), 0, nullptr);
+    JSStringRelease(spaceSavedBytesKey);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtCancelOnlineCompaction(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtCancelOnlineCompaction called from JavaScript\n");
+
+    library_->dbtCancelOnlineCompaction();
+
+    return JSValueMakeBoolean(ctx, true);
+}
+
+JSValueRef JSBridge::dbtSetAutoVacuumMode(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtSetAutoVacuumMode called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtSetAutoVacuumMode: Missing parameter (mode)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get mode from first argument ("none", "full" or "incremental")
+    JSStringRef modeStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!modeStr) {
+        OutputDebugStringA("[JSBridge] dbtSetAutoVacuumMode: Invalid mode parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t modeLength = JSStringGetMaximumUTF8CStringSize(modeStr);
+    char* modeBuffer = new char[modeLength];
+    JSStringGetUTF8CString(modeStr, modeBuffer, modeLength);
+    std::string mode(modeBuffer);
+    delete[] modeBuffer;
+    JSStringRelease(modeStr);
+
+    Library::AutoVacuumResult result = library_->dbtSetAutoVacuumMode(mode);
+
+    // Convert to JavaScript object
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set mode property
+    JSStringRef modeKey = JSStringCreateWithUTF8CString("mode");
+    JSStringRef modeValue = JSStringCreateWithUTF8CString(result.mode.c_str());
+    JSObjectSetProperty(ctx, resultObj, modeKey, JSValueMakeString(ctx, modeValue), 0, nullptr);
+    JSStringRelease(modeKey);
+    JSStringRelease(modeValue);
+
+    // Set requiresCompaction property
+    JSStringRef requiresCompactionKey = JSStringCreateWithUTF8CString("requiresCompaction");
+    JSObjectSetProperty(ctx, resultObj, requiresCompactionKey, JSValueMakeBoolean(ctx, result.requiresCompaction), 0, nullptr);
+    JSStringRelease(requiresCompactionKey);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtIncrementalVacuum(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtIncrementalVacuum called from JavaScript\n");
+
+    // Get page budget from first argument (0 = release every free page)
+    int maxPages = 0;
+    if (argumentCount >= 1) {
+        maxPages = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
+    }
+
+    Library::IncrementalVacuumResult result = library_->dbtIncrementalVacuum(maxPages);
+
+    // Convert to JavaScript object
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set pagesReclaimed property
+    JSStringRef pagesReclaimedKey = JSStringCreateWithUTF8CString("pagesReclaimed");
+    JSObjectSetProperty(ctx, resultObj, pagesReclaimedKey, JSValueMakeNumber(ctx, result.pagesReclaimed), 0, nullptr);
+    JSStringRelease(pagesReclaimedKey);
+
+    // Set bytesReclaimed property
+    JSStringRef bytesReclaimedKey = JSStringCreateWithUTF8CString("bytesReclaimed");
+    JSObjectSetProperty(ctx, resultObj, bytesReclaimedKey, JSValueMakeNumber(ctx, result.bytesReclaimed), 0, nullptr);
+    JSStringRelease(bytesReclaimedKey);
+
+    // Set freePagesRemaining property
+    JSStringRef freePagesRemainingKey = JSStringCreateWithUTF8CString("freePagesRemaining");
+    JSObjectSetProperty(ctx, resultObj, freePagesRemainingKey, JSValueMakeNumber(ctx, result.freePagesRemaining), 0, nullptr);
+    JSStringRelease(freePagesRemainingKey);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtFindAnomalousInstances(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtFindAnomalousInstances called from JavaScript\n");
+
+    // Optional sampleSize argument: analyze a random sample instead of the whole table
+    int sampleSize = 0;
+    if (argumentCount >= 1) {
+        sampleSize = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
+    }
+    Library::SampleInfo sampleInfo;
+
+    // Call Library method
+    std::vector<Library::AnomalousInstanceEntry> entries = library_->dbtFindAnomalousInstances(sampleSize, &sampleInfo);
+
+    OutputDebugStringA(("[JSBridge] Found " + std::to_string(entries.size()) + " anomalous instances\n").c_str());
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto& entry = entries[i];
+
+        // Create object for this entry
+        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(entry.id.c_str());
+        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
+
+        // Set unexpectedKeys property (array of strings)
+        JSObjectRef unexpectedKeysArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        for (size_t j = 0; j < entry.unexpectedKeys.size(); j++) {
+            JSStringRef keyStr = JSStringCreateWithUTF8CString(entry.unexpectedKeys[j].c_str());
+            JSValueRef keyValue = JSValueMakeString(ctx, keyStr);
+            JSObjectSetPropertyAtIndex(ctx, unexpectedKeysArray, j, keyValue, nullptr);
+            JSStringRelease(keyStr);
+        }
+
+        JSStringRef unexpectedKeysKey = JSStringCreateWithUTF8CString("unexpectedKeys");
+        JSObjectSetProperty(ctx, entryObj, unexpectedKeysKey, unexpectedKeysArray, 0, nullptr);
+        JSStringRelease(unexpectedKeysKey);
+
+        // Set keyCount property
+        JSStringRef keyCountKey = JSStringCreateWithUTF8CString("keyCount");
+        JSObjectSetProperty(ctx, entryObj, keyCountKey, JSValueMakeNumber(ctx, entry.keyCount), 0, nullptr);
+        JSStringRelease(keyCountKey);
+
+        // Set generation property (integer)
+        JSStringRef generationKey = JSStringCreateWithUTF8CString("generation");
+        JSObjectSetProperty(ctx, entryObj, generationKey, JSValueMakeNumber(ctx, entry.generation), 0, nullptr);
+        JSStringRelease(generationKey);
+
+        // Set legacy property (integer)
+        JSStringRef legacyKey = JSStringCreateWithUTF8CString("legacy");
+        JSObjectSetProperty(ctx, entryObj, legacyKey, JSValueMakeNumber(ctx, entry.legacy), 0, nullptr);
+        JSStringRelease(legacyKey);
+
+        // Add to results array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, entryObj, nullptr);
+    }
+
+    // Sampled calls return the results together with the sample coverage
+    if (sampleSize > 0) {
+        return sampledResultToJSObject(ctx, resultsArray, sampleInfo);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtGetInstanceKeyValues(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtGetInstanceKeyValues called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtGetInstanceKeyValues: Missing parameter (instanceId)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get instance ID from first argument
+    JSStringRef instanceIdStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!instanceIdStr) {
+        OutputDebugStringA("[JSBridge] dbtGetInstanceKeyValues: Invalid instance ID parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t instanceIdLength = JSStringGetMaximumUTF8CStringSize(instanceIdStr);
+    char* instanceIdBuffer = new char[instanceIdLength];
+    JSStringGetUTF8CString(instanceIdStr, instanceIdBuffer, instanceIdLength);
+    std::string instanceId(instanceIdBuffer);
+    delete[] instanceIdBuffer;
+    JSStringRelease(instanceIdStr);
+
+    OutputDebugStringA(("[JSBridge] Fetching KeyValues for instance " + instanceId + "\n").c_str());
+
+    // Call Library method
+    std::string plainText = library_->dbtGetInstanceKeyValues(instanceId);
+
+    OutputDebugStringA(("[JSBridge] Retrieved KeyValues plain text (" + std::to_string(plainText.length()) + " chars)\n").c_str());
+
+    // Convert to JavaScript string
+    JSStringRef resultStr = JSStringCreateWithUTF8CString(plainText.c_str());
+    JSValueRef result = JSValueMakeString(ctx, resultStr);
+    JSStringRelease(resultStr);
+
+    return result;
+}
+
+JSValueRef JSBridge::dbtGetEntryKeyValues(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtGetEntryKeyValues called from JavaScript\n");
+
+    if (argumentCount < 2) {
+        OutputDebugStringA("[JSBridge] dbtGetEntryKeyValues: Missing parameters (tableName, entryId)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get table name from first argument
+    JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!tableNameStr) {
+        OutputDebugStringA("[JSBridge] dbtGetEntryKeyValues: Invalid table name parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
+    char* tableNameBuffer = new char[tableNameLength];
+    JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
+    std::string tableName(tableNameBuffer);
+    delete[] tableNameBuffer;
+    JSStringRelease(tableNameStr);
+
+    // Get entry ID from second argument
+    JSStringRef entryIdStr = JSValueToStringCopy(ctx, arguments[1], exception);
+    if (!entryIdStr) {
+        OutputDebugStringA("[JSBridge] dbtGetEntryKeyValues: Invalid entry ID parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t entryIdLength = JSStringGetMaximumUTF8CStringSize(entryIdStr);
+    char* entryIdBuffer = new char[entryIdLength];
+    JSStringGetUTF8CString(entryIdStr, entryIdBuffer, entryIdLength);
+    std::string entryId(entryIdBuffer);
+    delete[] entryIdBuffer;
+    JSStringRelease(entryIdStr);
+
+    OutputDebugStringA(("[JSBridge] Fetching KeyValues for entry " + entryId + " from table " + tableName + "\n").c_str());
+
+    // Call Library method
+    std::string plainText = library_->dbtGetEntryKeyValues(tableName, entryId);
+
+    OutputDebugStringA(("[JSBridge] Retrieved KeyValues plain text (" + std::to_string(plainText.length()) + " chars)\n").c_str());
+
+    // Convert to JavaScript string
+    JSStringRef resultStr = JSStringCreateWithUTF8CString(plainText.c_str());
+    JSValueRef result = JSValueMakeString(ctx, resultStr);
+    JSStringRelease(resultStr);
+
+    return result;
+}
+
+JSValueRef JSBridge::dbtRemoveAnomalousKeys(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtRemoveAnomalousKeys called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtRemoveAnomalousKeys: Missing parameter (instanceIds array)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get instance IDs array from first argument
+    JSObjectRef entryIdsArray = JSValueToObject(ctx, arguments[0], exception);
+    if (!entryIdsArray) {
+        OutputDebugStringA("[JSBridge] dbtRemoveAnomalousKeys: Invalid instanceIds array parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get array length
+    JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
+    JSValueRef lengthValue = JSObjectGetProperty(ctx, entryIdsArray, lengthProp, exception);
+    JSStringRelease(lengthProp);
+    double arrayLength = JSValueToNumber(ctx, lengthValue, exception);
+
+    // Extract instance IDs from array
+    std::vector<std::string> instanceIds;
+    for (size_t i = 0; i < arrayLength; i++) {
+        JSValueRef idValue = JSObjectGetPropertyAtIndex(ctx, entryIdsArray, i, exception);
+        JSStringRef idStr = JSValueToStringCopy(ctx, idValue, exception);
+        if (idStr) {
+            size_t idLength = JSStringGetMaximumUTF8CStringSize(idStr);
+            char* idBuffer = new char[idLength];
+            JSStringGetUTF8CString(idStr, idBuffer, idLength);
+            instanceIds.push_back(std::string(idBuffer));
+            delete[] idBuffer;
+            JSStringRelease(idStr);
+        }
+    }
+
+    OutputDebugStringA(("[JSBridge] Removing anomalous keys from " + std::to_string(instanceIds.size()) + " instances\n").c_str());
+
+    // Call Library method
+    std::vector<Library::RemoveKeysResult> results = library_->dbtRemoveAnomalousKeys(instanceIds);
+
+    OutputDebugStringA(("[JSBridge] Remove operation completed for " + std::to_string(results.size()) + " instances\n").c_str());
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+
+        // Create object for this result
+        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(result.id.c_str());
+        JSObjectSetProperty(ctx, resultObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
+
+        // Set success property
+        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+        JSStringRelease(successKey);
+
+        // Set error property
+        JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+        JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+        JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+        JSStringRelease(errorKey);
+        JSStringRelease(errorValue);
+
+        // Add to results array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtFindEmptyInstances(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtFindEmptyInstances called from JavaScript\n");
+
+    // Optional sampleSize argument: analyze a random sample instead of the whole table
+    int sampleSize = 0;
+    if (argumentCount >= 1) {
+        sampleSize = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
+    }
+    Library::SampleInfo sampleInfo;
+
+    // Call Library method
+    std::vector<Library::EmptyInstanceEntry> entries = library_->dbtFindEmptyInstances(sampleSize, &sampleInfo);
+
+    OutputDebugStringA(("[JSBridge] Found " + std::to_string(entries.size()) + " empty instances\n").c_str());
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto& entry = entries[i];
+
+        // Create object for this entry
+        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(entry.id.c_str());
+        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
+
+        // Set objectCount property
+        JSStringRef objectCountKey = JSStringCreateWithUTF8CString("objectCount");
+        JSObjectSetProperty(ctx, entryObj, objectCountKey, JSValueMakeNumber(ctx, entry.objectCount), 0, nullptr);
+        JSStringRelease(objectCountKey);
+
+        // Set hasObjectsKey property
+        JSStringRef hasObjectsKeyKey = JSStringCreateWithUTF8CString("hasObjectsKey");
+        JSObjectSetProperty(ctx, entryObj, hasObjectsKeyKey, JSValueMakeBoolean(ctx, entry.hasObjectsKey), 0, nullptr);
+        JSStringRelease(hasObjectsKeyKey);
+
+        // Add to results array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, entryObj, nullptr);
+    }
+
+    // Sampled calls return the results together with the sample coverage
+    if (sampleSize > 0) {
+        return sampledResultToJSObject(ctx, resultsArray, sampleInfo);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtPurgeEmptyInstances(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtPurgeEmptyInstances called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtPurgeEmptyInstances: Missing parameter (instanceIds array)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get instance IDs array from first argument
+    JSObjectRef entryIdsArray = JSValueToObject(ctx, arguments[0], exception);
+    if (!entryIdsArray) {
+        OutputDebugStringA("[JSBridge] dbtPurgeEmptyInstances: Invalid instanceIds array parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get array length
+    JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
+    JSValueRef lengthValue = JSObjectGetProperty(ctx, entryIdsArray, lengthProp, exception);
+    JSStringRelease(lengthProp);
+    double arrayLength = JSValueToNumber(ctx, lengthValue, exception);
+
+    // Extract instance IDs from array
+    std::vector<std::string> instanceIds;
+    for (size_t i = 0; i < arrayLength; i++) {
+        JSValueRef idValue = JSObjectGetPropertyAtIndex(ctx, entryIdsArray, i, exception);
+        JSStringRef idStr = JSValueToStringCopy(ctx, idValue, exception);
+        if (idStr) {
+            size_t idLength = JSStringGetMaximumUTF8CStringSize(idStr);
+            char* idBuffer = new char[idLength];
+            JSStringGetUTF8CString(idStr, idBuffer, idLength);
+            instanceIds.push_back(std::string(idBuffer));
+            delete[] idBuffer;
+            JSStringRelease(idStr);
+        }
+    }
+
+    OutputDebugStringA(("[JSBridge] Purging " + std::to_string(instanceIds.size()) + " instances\n").c_str());
+
+    // Call Library method
+    std::vector<Library::PurgeResult> results = library_->dbtPurgeEmptyInstances(instanceIds);
+
+    OutputDebugStringA(("[JSBridge] Purge operation completed for " + std::to_string(results.size()) + " instances\n").c_str());
+
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+
+        // Create object for this result
+        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(result.id.c_str());
+        JSObjectSetProperty(ctx, resultObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
+
+        // Set success property
+        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+        JSStringRelease(successKey);
+
+        // Set error property
+        JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+        JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+        JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+        JSStringRelease(errorKey);
+        JSStringRelease(errorValue);
+
+        // Add to results array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtMergeDatabase(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtMergeDatabase called from JavaScript\n");
+
+    if (argumentCount < 4) {
+        OutputDebugStringA("[JSBridge] dbtMergeDatabase: Missing parameters (sourcePath, tableName, skipExisting, overwriteIfLarger)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Extract sourcePath (string)
+    JSStringRef sourcePathStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!sourcePathStr) {
+        OutputDebugStringA("[JSBridge] dbtMergeDatabase: Invalid sourcePath parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+    size_t sourcePathLength = JSStringGetMaximumUTF8CStringSize(sourcePathStr);
+    char* sourcePathBuffer = new char[sourcePathLength];
+    JSStringGetUTF8CString(sourcePathStr, sourcePathBuffer, sourcePathLength);
+    std::string sourcePath(sourcePathBuffer);
+    delete[] sourcePathBuffer;
+    JSStringRelease(sourcePathStr);
+
+    // Extract tableName (string)
+    JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[1], exception);
+    if (!tableNameStr) {
+        OutputDebugStringA("[JSBridge] dbtMergeDatabase: Invalid tableName parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+    size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
+    char* tableNameBuffer = new char[tableNameLength];
+    JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
+    std::string tableName(tableNameBuffer);
+    delete[] tableNameBuffer;
+    JSStringRelease(tableNameStr);
+
+    // Extract skipExisting (boolean)
+    bool skipExisting = JSValueToBoolean(ctx, arguments[2]);
+
+    // Extract overwriteIfLarger (boolean)
+    bool overwriteIfLarger = JSValueToBoolean(ctx, arguments[3]);
+
+    OutputDebugStringA(("[JSBridge] Merging database: source=" + sourcePath + ", table=" + tableName +
+                       ", skipExisting=" + (skipExisting ? "true" : "false") +
+                       ", overwriteIfLarger=" + (overwriteIfLarger ? "true" : "false") + "\n").c_str());
+
+    // Call Library method
+    Library::MergeResult result = library_->dbtMergeDatabase(sourcePath, tableName, skipExisting, overwriteIfLarger);
+
+    OutputDebugStringA(("[JSBridge] Merge operation completed: success=" + std::string(result.success ? "true" : "false") +
+                       ", total=" + std::to_string(result.totalEntries) +
+                       ", merged=" + std::to_string(result.mergedCount) +
+                       ", skipped=" + std::to_string(result.skippedCount) +
+                       ", overwritten=" + std::to_string(result.overwrittenCount) +
+                       ", failed=" + std::to_string(result.failedCount) + "\n").c_str());
+
+    // Convert result to JavaScript object
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    methodName = JSStringCreateWithUTF8CString("dbtFindAnomalousInstances");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFindAnomalousInstancesCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
 
-    methodName = JSStringCreateWithUTF8CString("dbtGetInstanceKeyValues");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetInstanceKeyValuesCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
 
-    methodName = JSStringCreateWithUTF8CString("dbtGetEntryKeyValues");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtGetEntryKeyValuesCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+    // Set totalEntries property
+    JSStringRef totalKey = JSStringCreateWithUTF8CString("totalEntries");
+    JSObjectSetProperty(ctx, resultObj, totalKey, JSValueMakeNumber(ctx, result.totalEntries), 0, nullptr);
+    JSStringRelease(totalKey);
 
-    methodName = JSStringCreateWithUTF8CString("dbtRemoveAnomalousKeys");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtRemoveAnomalousKeysCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+    // Set mergedCount property
+    JSStringRef mergedKey = JSStringCreateWithUTF8CString("mergedCount");
+    JSObjectSetProperty(ctx, resultObj, mergedKey, JSValueMakeNumber(ctx, result.mergedCount), 0, nullptr);
+    JSStringRelease(mergedKey);
 
-    methodName = JSStringCreateWithUTF8CString("dbtFindEmptyInstances");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtFindEmptyInstancesCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+    // Set skippedCount property
+    JSStringRef skippedKey = JSStringCreateWithUTF8CString("skippedCount");
+    JSObjectSetProperty(ctx, resultObj, skippedKey, JSValueMakeNumber(ctx, result.skippedCount), 0, nullptr);
+    JSStringRelease(skippedKey);
 
-    methodName = JSStringCreateWithUTF8CString("dbtPurgeEmptyInstances");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtPurgeEmptyInstancesCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+    // Set overwrittenCount property
+    JSStringRef overwrittenKey = JSStringCreateWithUTF8CString("overwrittenCount");
+    JSObjectSetProperty(ctx, resultObj, overwrittenKey, JSValueMakeNumber(ctx, result.overwrittenCount), 0, nullptr);
+    JSStringRelease(overwrittenKey);
 
-    methodName = JSStringCreateWithUTF8CString("dbtMergeDatabase");
-    methodFunc = JSObjectMakeFunctionWithCallback(ctx, methodName, dbtMergeDatabaseCallback);
-    JSObjectSetProperty(ctx, aapiObj, methodName, methodFunc, 0, 0);
-    JSStringRelease(methodName);
+    // Set failedCount property
+    JSStringRef failedKey = JSStringCreateWithUTF8CString("failedCount");
+    JSObjectSetProperty(ctx, resultObj, failedKey, JSValueMakeNumber(ctx, result.failedCount), 0, nullptr);
+    JSStringRelease(failedKey);
 
-    // Add the aapi object to the global object
-    JSStringRef aapiName = JSStringCreateWithUTF8CString("aapi");
-    JSObjectSetProperty(ctx, globalObj, aapiName, aapiObj, 0, 0);
-    JSStringRelease(aapiName);
+    // Convert entries vector to JavaScript array
+    JSObjectRef entriesArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < result.entries.size(); i++) {
+        const auto& entry = result.entries[i];
 
-    // Debug output to confirm registration
-    OutputDebugStringA("[JSBridge] JavaScript bridge registered with image caching support:\n");
-    OutputDebugStringA("[JSBridge]   - aapi.debugTesterJoint\n");
-    OutputDebugStringA("[JSBridge]   - aapi.debugGetFirstItemAsJSObject\n");
-    OutputDebugStringA("[JSBridge]   - aapi.getFirstEntry\n");
-    OutputDebugStringA("[JSBridge]   - aapi.getNextEntry\n");
-    OutputDebugStringA("[JSBridge]   - aapi.getFirstEntries\n");
-    OutputDebugStringA("[JSBridge]   - aapi.getNextEntries\n");
-    OutputDebugStringA("[JSBridge]   - aapi.getFirstSearchResults\n");
-    OutputDebugStringA("[JSBridge]   - aapi.getNextSearchResults\n");
-    OutputDebugStringA("[JSBridge]   - aapi.getCacheImage\n");
-    OutputDebugStringA("[JSBridge]   - aapi.processImageCompletions\n");
-    OutputDebugStringA("[JSBridge]   - aapi.getSupportedEntryTypes\n");
-    OutputDebugStringA("[JSBridge]   - aapi.constructSchema\n");
-    OutputDebugStringA("[JSBridge]   - aapi.dbtFindLargeEntriesInTable\n");
-    OutputDebugStringA("[JSBridge]   - aapi.dbtTrimTextFields\n");
-    OutputDebugStringA("[JSBridge]   - aapi.dbtGetDatabaseStats\n");
-    OutputDebugStringA("[JSBridge]   - aapi.dbtCompactDatabase\n");
-}
+        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
 
-// Helper function to convert Windows path to file:// URL
-std::string JSBridge::convertToFileUrl(const std::string& filePath) {
-    std::string fileUrl = "file:///";
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(entry.id.c_str());
+        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
 
-    for (char c : filePath) {
-        if (c == '\\') {
-            fileUrl += '/';
-        }
-        else {
-            fileUrl += c;
-        }
-    }
+        // Set action property
+        JSStringRef actionKey = JSStringCreateWithUTF8CString("action");
+        JSStringRef actionValue = JSStringCreateWithUTF8CString(entry.action.c_str());
+        JSObjectSetProperty(ctx, entryObj, actionKey, JSValueMakeString(ctx, actionValue), 0, nullptr);
+        JSStringRelease(actionKey);
+        JSStringRelease(actionValue);
 
-    return fileUrl;
-}
+        // Set error property
+        JSStringRef entryErrorKey = JSStringCreateWithUTF8CString("error");
+        JSStringRef entryErrorValue = JSStringCreateWithUTF8CString(entry.error.c_str());
+        JSObjectSetProperty(ctx, entryObj, entryErrorKey, JSValueMakeString(ctx, entryErrorValue), 0, nullptr);
+        JSStringRelease(entryErrorKey);
+        JSStringRelease(entryErrorValue);
 
-JSValueRef JSBridge::getCacheImage(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] getCacheImage called from JavaScript\n");
+        // Set blobSizeBytes property
+        JSStringRef sizeKey = JSStringCreateWithUTF8CString("blobSizeBytes");
+        JSObjectSetProperty(ctx, entryObj, sizeKey, JSValueMakeNumber(ctx, entry.blobSizeBytes), 0, nullptr);
+        JSStringRelease(sizeKey);
 
-    if (argumentCount < 1) {
-        OutputDebugStringA("[JSBridge] getCacheImage: Missing URL parameter\n");
-        return JSValueMakeNull(ctx);
+        // Add to entries array
+        JSObjectSetPropertyAtIndex(ctx, entriesArray, i, entryObj, nullptr);
     }
 
-    // Get URL from first argument
-    JSStringRef urlStr = JSValueToStringCopy(ctx, arguments[0], exception);
-    if (!urlStr) {
-        OutputDebugStringA("[JSBridge] getCacheImage: Invalid URL parameter\n");
-        return JSValueMakeNull(ctx);
-    }
+    // Set entries property
+    JSStringRef entriesKey = JSStringCreateWithUTF8CString("entries");
+    JSObjectSetProperty(ctx, resultObj, entriesKey, entriesArray, 0, nullptr);
+    JSStringRelease(entriesKey);
 
-    size_t urlLength = JSStringGetMaximumUTF8CStringSize(urlStr);
-    char* urlBuffer = new char[urlLength];
-    JSStringGetUTF8CString(urlStr, urlBuffer, urlLength);
-    std::string url(urlBuffer);
-    delete[] urlBuffer;
-    JSStringRelease(urlStr);
+    return resultObj;
+}
 
-    OutputDebugStringA(("[JSBridge] getCacheImage: Processing URL '" + url + "'\n").c_str());
+// Helper function to convert a diff page to a JavaScript object
+JSObjectRef JSBridge::diffPageToJSObject(JSContextRef ctx, const Library::DiffPage& page) {
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    // Create a simple Promise-like object
-    JSObjectRef promiseObj = JSObjectMake(ctx, nullptr, nullptr);
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, page.success), 0, nullptr);
+    JSStringRelease(successKey);
 
-    // Create then method that stores callbacks
-    JSStringRef thenStr = JSStringCreateWithUTF8CString("then");
-    JSObjectRef thenFunc = JSObjectMakeFunctionWithCallback(ctx, thenStr,
-        [](JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-            size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) -> JSValueRef {
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(page.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
 
-                if (argumentCount < 1) return JSValueMakeUndefined(ctx);
+    // Set finished property
+    JSStringRef finishedKey = JSStringCreateWithUTF8CString("finished");
+    JSObjectSetProperty(ctx, resultObj, finishedKey, JSValueMakeBoolean(ctx, page.finished), 0, nullptr);
+    JSStringRelease(finishedKey);
 
-                // Get the promise object (stored as 'this')
-                JSObjectRef promiseObj = thisObject;
+    // Set currentTable property
+    JSStringRef tableKey = JSStringCreateWithUTF8CString("currentTable");
+    JSStringRef tableValue = JSStringCreateWithUTF8CString(page.currentTable.c_str());
+    JSObjectSetProperty(ctx, resultObj, tableKey, JSValueMakeString(ctx, tableValue), 0, nullptr);
+    JSStringRelease(tableKey);
+    JSStringRelease(tableValue);
 
-                // Store the resolve callback
-                JSStringRef resolveKey = JSStringCreateWithUTF8CString("_resolve");
-                JSObjectSetProperty(ctx, promiseObj, resolveKey, arguments[0], 0, 0);
-                JSStringRelease(resolveKey);
+    // Set progress properties
+    JSStringRef rowsScannedKey = JSStringCreateWithUTF8CString("rowsScanned");
+    JSObjectSetProperty(ctx, resultObj, rowsScannedKey, JSValueMakeNumber(ctx, static_cast<double>(page.rowsScanned)), 0, nullptr);
+    JSStringRelease(rowsScannedKey);
 
-                // Store reject callback if provided
-                if (argumentCount >= 2) {
-                    JSStringRef rejectKey = JSStringCreateWithUTF8CString("_reject");
-                    JSObjectSetProperty(ctx, promiseObj, rejectKey, arguments[1], 0, 0);
-                    JSStringRelease(rejectKey);
-                }
+    JSStringRef rowsTotalKey = JSStringCreateWithUTF8CString("rowsTotal");
+    JSObjectSetProperty(ctx, resultObj, rowsTotalKey, JSValueMakeNumber(ctx, static_cast<double>(page.rowsTotal)), 0, nullptr);
+    JSStringRelease(rowsTotalKey);
 
-                return promiseObj;
-        });
+    JSStringRef bytesScannedKey = JSStringCreateWithUTF8CString("bytesScanned");
+    JSObjectSetProperty(ctx, resultObj, bytesScannedKey, JSValueMakeNumber(ctx, static_cast<double>(page.bytesScanned)), 0, nullptr);
+    JSStringRelease(bytesScannedKey);
 
-    JSObjectSetProperty(ctx, promiseObj, thenStr, thenFunc, 0, 0);
-    JSStringRelease(thenStr);
+    // Set count properties
+    JSStringRef identicalKey = JSStringCreateWithUTF8CString("identicalCount");
+    JSObjectSetProperty(ctx, resultObj, identicalKey, JSValueMakeNumber(ctx, page.identicalCount), 0, nullptr);
+    JSStringRelease(identicalKey);
 
-    // Create catch method for error handling
-    JSStringRef catchStr = JSStringCreateWithUTF8CString("catch");
-    JSObjectRef catchFunc = JSObjectMakeFunctionWithCallback(ctx, catchStr,
-        [](JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-            size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) -> JSValueRef {
+    JSStringRef changedKey = JSStringCreateWithUTF8CString("changedCount");
+    JSObjectSetProperty(ctx, resultObj, changedKey, JSValueMakeNumber(ctx, page.changedCount), 0, nullptr);
+    JSStringRelease(changedKey);
 
-                if (argumentCount < 1) return JSValueMakeUndefined(ctx);
+    JSStringRef onlyInAKey = JSStringCreateWithUTF8CString("onlyInACount");
+    JSObjectSetProperty(ctx, resultObj, onlyInAKey, JSValueMakeNumber(ctx, page.onlyInACount), 0, nullptr);
+    JSStringRelease(onlyInAKey);
 
-                // Store the reject callback
-                JSStringRef rejectKey = JSStringCreateWithUTF8CString("_reject");
-                JSObjectSetProperty(ctx, thisObject, rejectKey, arguments[0], 0, 0);
-                JSStringRelease(rejectKey);
+    JSStringRef onlyInBKey = JSStringCreateWithUTF8CString("onlyInBCount");
+    JSObjectSetProperty(ctx, resultObj, onlyInBKey, JSValueMakeNumber(ctx, page.onlyInBCount), 0, nullptr);
+    JSStringRelease(onlyInBKey);
 
-                return thisObject;
-        });
+    // Convert entries vector to JavaScript array
+    JSObjectRef entriesArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < page.entries.size(); i++) {
+        const auto& entry = page.entries[i];
 
-    JSObjectSetProperty(ctx, promiseObj, catchStr, catchFunc, 0, 0);
-    JSStringRelease(catchStr);
+        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    // Protect the promise object from garbage collection
-    JSValueProtect(ctx, promiseObj);
+        // Set tableName property
+        JSStringRef entryTableKey = JSStringCreateWithUTF8CString("tableName");
+        JSStringRef entryTableValue = JSStringCreateWithUTF8CString(entry.tableName.c_str());
+        JSObjectSetProperty(ctx, entryObj, entryTableKey, JSValueMakeString(ctx, entryTableValue), 0, nullptr);
+        JSStringRelease(entryTableKey);
+        JSStringRelease(entryTableValue);
 
-    // Start the image loading process via Library
-    library_->cacheImage(url, [this, ctx, promiseObj](const ImageLoadResult& result) {
-        if (result.success) {
-            // Convert to file:// URL
-            std::string fileUrl = convertToFileUrl(result.filePath);
-            OutputDebugStringA(("[JSBridge] Image cached successfully: " + fileUrl + "\n").c_str());
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(entry.id.c_str());
+        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
 
-            // Get the resolve callback
-            JSStringRef resolveKey = JSStringCreateWithUTF8CString("_resolve");
-            JSValueRef resolveFunc = JSObjectGetProperty(ctx, promiseObj, resolveKey, nullptr);
-            JSStringRelease(resolveKey);
+        // Set status property
+        JSStringRef statusKey = JSStringCreateWithUTF8CString("status");
+        JSStringRef statusValue = JSStringCreateWithUTF8CString(entry.status.c_str());
+        JSObjectSetProperty(ctx, entryObj, statusKey, JSValueMakeString(ctx, statusValue), 0, nullptr);
+        JSStringRelease(statusKey);
+        JSStringRelease(statusValue);
+
+        // Set sizeA / sizeB properties
+        JSStringRef sizeAKey = JSStringCreateWithUTF8CString("sizeA");
+        JSObjectSetProperty(ctx, entryObj, sizeAKey, JSValueMakeNumber(ctx, entry.sizeA), 0, nullptr);
+        JSStringRelease(sizeAKey);
+
+        JSStringRef sizeBKey = JSStringCreateWithUTF8CString("sizeB");
+        JSObjectSetProperty(ctx, entryObj, sizeBKey, JSValueMakeNumber(ctx, entry.sizeB), 0, nullptr);
+        JSStringRelease(sizeBKey);
+
+        // Convert field diffs to JavaScript array
+        JSObjectRef fieldsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        for (size_t j = 0; j < entry.fields.size(); j++) {
+            const auto& field = entry.fields[j];
+
+            JSObjectRef fieldObj = JSObjectMake(ctx, nullptr, nullptr);
+
+            JSStringRef pathKey = JSStringCreateWithUTF8CString("path");
+            JSStringRef pathValue = JSStringCreateWithUTF8CString(field.path.c_str());
+            JSObjectSetProperty(ctx, fieldObj, pathKey, JSValueMakeString(ctx, pathValue), 0, nullptr);
+            JSStringRelease(pathKey);
+            JSStringRelease(pathValue);
+
+            JSStringRef changeKey = JSStringCreateWithUTF8CString("change");
+            JSStringRef changeValue = JSStringCreateWithUTF8CString(field.change.c_str());
+            JSObjectSetProperty(ctx, fieldObj, changeKey, JSValueMakeString(ctx, changeValue), 0, nullptr);
+            JSStringRelease(changeKey);
+            JSStringRelease(changeValue);
+
+            JSStringRef valueAKey = JSStringCreateWithUTF8CString("valueA");
+            JSStringRef valueAValue = JSStringCreateWithUTF8CString(field.valueA.c_str());
+            JSObjectSetProperty(ctx, fieldObj, valueAKey, JSValueMakeString(ctx, valueAValue), 0, nullptr);
+            JSStringRelease(valueAKey);
+            JSStringRelease(valueAValue);
+
+            JSStringRef valueBKey = JSStringCreateWithUTF8CString("valueB");
+            JSStringRef valueBValue = JSStringCreateWithUTF8CString(field.valueB.c_str());
+            JSObjectSetProperty(ctx, fieldObj, valueBKey, JSValueMakeString(ctx, valueBValue), 0, nullptr);
+            JSStringRelease(valueBKey);
+            JSStringRelease(valueBValue);
+
+            JSObjectSetPropertyAtIndex(ctx, fieldsArray, j, fieldObj, nullptr);
+        }
 
-            if (JSValueIsObject(ctx, resolveFunc)) {
-                // Create result object with filePath
-                JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+        // Set fields property
+        JSStringRef fieldsKey = JSStringCreateWithUTF8CString("fields");
+        JSObjectSetProperty(ctx, entryObj, fieldsKey, fieldsArray, 0, nullptr);
+        JSStringRelease(fieldsKey);
 
-                // Set filePath property
-                JSStringRef filePathKey = JSStringCreateWithUTF8CString("filePath");
-                JSStringRef filePathStr = JSStringCreateWithUTF8CString(fileUrl.c_str());
-                JSValueRef filePathValue = JSValueMakeString(ctx, filePathStr);
-                JSObjectSetProperty(ctx, resultObj, filePathKey, filePathValue, 0, 0);
-                JSStringRelease(filePathKey);
-                JSStringRelease(filePathStr);
+        // Add to entries array
+        JSObjectSetPropertyAtIndex(ctx, entriesArray, i, entryObj, nullptr);
+    }
 
-                // Call the resolve function with the result object
-                JSValueRef args[] = { resultObj };
-                JSObjectCallAsFunction(ctx, (JSObjectRef)resolveFunc, nullptr, 1, args, nullptr);
-            }
-        }
-        else {
-            OutputDebugStringA("[JSBridge] Image loading failed\n");
+    // Set entries property
+    JSStringRef entriesKey = JSStringCreateWithUTF8CString("entries");
+    JSObjectSetProperty(ctx, resultObj, entriesKey, entriesArray, 0, nullptr);
+    JSStringRelease(entriesKey);
 
-            // Get the reject callback
-            JSStringRef rejectKey = JSStringCreateWithUTF8CString("_reject");
-            JSValueRef rejectFunc = JSObjectGetProperty(ctx, promiseObj, rejectKey, nullptr);
-            JSStringRelease(rejectKey);
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtDiffDatabases(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtDiffDatabases called from JavaScript\n");
 
-            if (JSValueIsObject(ctx, rejectFunc)) {
-                // Call the reject function with error message
-                JSStringRef errorStr = JSStringCreateWithUTF8CString("Failed to load image");
-                JSValueRef errorValue = JSValueMakeString(ctx, errorStr);
-                JSStringRelease(errorStr);
+    if (argumentCount < 2) {
+        OutputDebugStringA("[JSBridge] dbtDiffDatabases: Missing parameters (pathA, pathB, [tableNames], [pageSize])\n");
+        return JSValueMakeNull(ctx);
+    }
 
-                JSValueRef args[] = { errorValue };
-                JSObjectCallAsFunction(ctx, (JSObjectRef)rejectFunc, nullptr, 1, args, nullptr);
+    // Extract pathA (string)
+    JSStringRef pathAStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!pathAStr) {
+        OutputDebugStringA("[JSBridge] dbtDiffDatabases: Invalid pathA parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+    size_t pathALength = JSStringGetMaximumUTF8CStringSize(pathAStr);
+    char* pathABuffer = new char[pathALength];
+    JSStringGetUTF8CString(pathAStr, pathABuffer, pathALength);
+    std::string pathA(pathABuffer);
+    delete[] pathABuffer;
+    JSStringRelease(pathAStr);
+
+    // Extract pathB (string)
+    JSStringRef pathBStr = JSValueToStringCopy(ctx, arguments[1], exception);
+    if (!pathBStr) {
+        OutputDebugStringA("[JSBridge] dbtDiffDatabases: Invalid pathB parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+    size_t pathBLength = JSStringGetMaximumUTF8CStringSize(pathBStr);
+    char* pathBBuffer = new char[pathBLength];
+    JSStringGetUTF8CString(pathBStr, pathBBuffer, pathBLength);
+    std::string pathB(pathBBuffer);
+    delete[] pathBBuffer;
+    JSStringRelease(pathBStr);
+
+    // Extract optional tableNames (array) - empty means all supported tables
+    std::vector<std::string> tableNames;
+    if (argumentCount > 2 && JSValueIsObject(ctx, arguments[2])) {
+        JSObjectRef tablesArray = JSValueToObject(ctx, arguments[2], exception);
+
+        JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
+        JSValueRef lengthValue = JSObjectGetProperty(ctx, tablesArray, lengthProp, exception);
+        JSStringRelease(lengthProp);
+        double arrayLength = JSValueToNumber(ctx, lengthValue, exception);
+
+        for (size_t i = 0; i < arrayLength; i++) {
+            JSValueRef tableValue = JSObjectGetPropertyAtIndex(ctx, tablesArray, i, exception);
+            JSStringRef tableStr = JSValueToStringCopy(ctx, tableValue, exception);
+            if (tableStr) {
+                size_t tableLength = JSStringGetMaximumUTF8CStringSize(tableStr);
+                char* tableBuffer = new char[tableLength];
+                JSStringGetUTF8CString(tableStr, tableBuffer, tableLength);
+                tableNames.push_back(std::string(tableBuffer));
+                delete[] tableBuffer;
+                JSStringRelease(tableStr);
             }
         }
+    }
 
-        // Unprotect the promise object
-        JSValueUnprotect(ctx, promiseObj);
-        });
+    // Extract optional pageSize (number)
+    int pageSize = 100;
+    if (argumentCount > 3) {
+        pageSize = static_cast<int>(JSValueToNumber(ctx, arguments[3], exception));
+    }
 
-    return promiseObj;
+    OutputDebugStringA(("[JSBridge] Diffing databases: A=" + pathA + ", B=" + pathB +
+                       ", tables=" + std::to_string(tableNames.size()) +
+                       ", pageSize=" + std::to_string(pageSize) + "\n").c_str());
+
+    // Call Library method
+    Library::DiffPage page = library_->dbtDiffDatabases(pathA, pathB, tableNames, pageSize);
+
+    return diffPageToJSObject(ctx, page);
 }
 
-JSValueRef JSBridge::processImageCompletions(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtGetNextDiffResults(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    // Process any pending completions from the worker thread via Library
-    library_->processImageCompletions();
-    return JSValueMakeUndefined(ctx);
+    // Extract optional pageSize (number)
+    int pageSize = 100;
+    if (argumentCount > 0) {
+        pageSize = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
+    }
+
+    Library::DiffPage page = library_->dbtGetNextDiffResults(pageSize);
+
+    return diffPageToJSObject(ctx, page);
 }
 
-JSValueRef JSBridge::debugTesterJoint(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtCloseDiff(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] debugTesterJoint called from JavaScript\n");
-    OutputDebugStringA("=== SQLite Database Analysis Started ===\n");
+    OutputDebugStringA("[JSBridge] dbtCloseDiff called from JavaScript\n");
 
-    std::string versionMsg = "SQLite Version: " + dbManager_->getVersion();
-    OutputDebugStringA((versionMsg + "\n").c_str());
+    library_->dbtCloseDiff();
 
-    std::string dbPathMsg = "Database Path: " + config_->getDatabasePath();
-    OutputDebugStringA((dbPathMsg + "\n").c_str());
+    return JSValueMakeUndefined(ctx);
+}
 
-    bool success = true;
+// Helper function to read a string property from a JavaScript object ("" if missing)
+static std::string jsObjectGetString(JSContextRef ctx, JSObjectRef obj, const char* name, JSValueRef* exception) {
+    JSStringRef propName = JSStringCreateWithUTF8CString(name);
+    JSValueRef value = JSObjectGetProperty(ctx, obj, propName, exception);
+    JSStringRelease(propName);
 
-    // Open or create database using config path
-    if (!dbManager_->openDatabase(config_->getDatabasePath())) {
-        OutputDebugStringA("[JSBridge] Failed to open database!\n");
-        success = false;
+    if (!value || JSValueIsUndefined(ctx, value) || JSValueIsNull(ctx, value)) {
+        return "";
     }
 
-    if (success) {
-        // Get general database information
-        if (!dbManager_->getDatabaseInfo()) {
-            OutputDebugStringA("[JSBridge] Failed to get database info!\n");
-            success = false;
-        }
+    JSStringRef valueStr = JSValueToStringCopy(ctx, value, exception);
+    if (!valueStr) {
+        return "";
+    }
+    size_t valueLength = JSStringGetMaximumUTF8CStringSize(valueStr);
+    char* valueBuffer = new char[valueLength];
+    JSStringGetUTF8CString(valueStr, valueBuffer, valueLength);
+    std::string result(valueBuffer);
+    delete[] valueBuffer;
+    JSStringRelease(valueStr);
+    return result;
+}
 
-        // List all tables in the database
-        if (!dbManager_->listTables()) {
-            OutputDebugStringA("[JSBridge] Failed to list tables!\n");
-            success = false;
-        }
+// Helper function to read a property from a JavaScript object (undefined if missing)
+static JSValueRef jsObjectGetValue(JSContextRef ctx, JSObjectRef obj, const char* name, JSValueRef* exception) {
+    JSStringRef propName = JSStringCreateWithUTF8CString(name);
+    JSValueRef value = JSObjectGetProperty(ctx, obj, propName, exception);
+    JSStringRelease(propName);
+    return value;
+}
 
-        OutputDebugStringA("[JSBridge] Database analysis complete. Check output above for details.\n");
+// Helper function to read a JavaScript array of strings
+static std::vector<std::string> jsArrayToStrings(JSContextRef ctx, JSValueRef value, JSValueRef* exception) {
+    std::vector<std::string> strings;
+    if (!JSValueIsObject(ctx, value)) {
+        return strings;
     }
+    JSObjectRef array = JSValueToObject(ctx, value, exception);
 
-    if (success) {
-        OutputDebugStringA("=== SQLite Database Analysis Completed Successfully ===\n");
-    }
-    else {
-        OutputDebugStringA("=== SQLite Database Analysis Failed ===\n");
+    JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
+    JSValueRef lengthValue = JSObjectGetProperty(ctx, array, lengthProp, exception);
+    JSStringRelease(lengthProp);
+    double arrayLength = JSValueToNumber(ctx, lengthValue, exception);
+
+    for (size_t i = 0; i < arrayLength; i++) {
+        JSValueRef itemValue = JSObjectGetPropertyAtIndex(ctx, array, i, exception);
+        JSStringRef itemStr = JSValueToStringCopy(ctx, itemValue, exception);
+        if (itemStr) {
+            size_t itemLength = JSStringGetMaximumUTF8CStringSize(itemStr);
+            char* itemBuffer = new char[itemLength];
+            JSStringGetUTF8CString(itemStr, itemBuffer, itemLength);
+            strings.push_back(std::string(itemBuffer));
+            delete[] itemBuffer;
+            JSStringRelease(itemStr);
+        }
     }
+    return strings;
+}
 
-    // Return success status to JavaScript
-    return JSValueMakeBoolean(ctx, success);
+// Helper function to wrap sampled analysis results with their coverage
+JSObjectRef JSBridge::sampledResultToJSObject(JSContextRef ctx, JSObjectRef resultsArray, const Library::SampleInfo& sampleInfo) {
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set results property
+    JSStringRef resultsKey = JSStringCreateWithUTF8CString("results");
+    JSObjectSetProperty(ctx, resultObj, resultsKey, resultsArray, 0, nullptr);
+    JSStringRelease(resultsKey);
+
+    // Set sampled property
+    JSStringRef sampledKey = JSStringCreateWithUTF8CString("sampled");
+    JSObjectSetProperty(ctx, resultObj, sampledKey, JSValueMakeBoolean(ctx, sampleInfo.sampled), 0, nullptr);
+    JSStringRelease(sampledKey);
+
+    // Set sampledRows property
+    JSStringRef sampledRowsKey = JSStringCreateWithUTF8CString("sampledRows");
+    JSObjectSetProperty(ctx, resultObj, sampledRowsKey, JSValueMakeNumber(ctx, static_cast<double>(sampleInfo.sampledRows)), 0, nullptr);
+    JSStringRelease(sampledRowsKey);
+
+    // Set estimatedTotalRows property
+    JSStringRef estimatedTotalRowsKey = JSStringCreateWithUTF8CString("estimatedTotalRows");
+    JSObjectSetProperty(ctx, resultObj, estimatedTotalRowsKey, JSValueMakeNumber(ctx, static_cast<double>(sampleInfo.estimatedTotalRows)), 0, nullptr);
+    JSStringRelease(estimatedTotalRowsKey);
+
+    // Set coverage property
+    JSStringRef coverageKey = JSStringCreateWithUTF8CString("coverage");
+    JSObjectSetProperty(ctx, resultObj, coverageKey, JSValueMakeNumber(ctx, sampleInfo.coverage), 0, nullptr);
+    JSStringRelease(coverageKey);
+
+    return resultObj;
 }
 
-JSObjectRef JSBridge::arcadeKeyValuesToJSObject(JSContextRef ctx, const ArcadeKeyValues* kv) {
-    if (!kv) {
-        return JSObjectMake(ctx, nullptr, nullptr);
-    }
+// Helper function to convert field statistics to a JavaScript object
+JSObjectRef JSBridge::fieldStatisticsToJSObject(JSContextRef ctx, const Library::FieldStatisticsResult& result) {
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    JSObjectRef jsObj = JSObjectMake(ctx, nullptr, nullptr);
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
 
-    // Add all children as properties (no metadata)
-    const auto& children = kv->GetChildren();
-    for (const auto& pair : children) {
-        const std::string& childName = pair.first;
-        const std::unique_ptr<ArcadeKeyValues>& child = pair.second;
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
 
-        JSStringRef childKey = JSStringCreateWithUTF8CString(childName.c_str());
+    // Set entries property
+    JSStringRef entriesKey = JSStringCreateWithUTF8CString("entries");
+    JSObjectSetProperty(ctx, resultObj, entriesKey, JSValueMakeNumber(ctx, static_cast<double>(result.entries)), 0, nullptr);
+    JSStringRelease(entriesKey);
 
-        // If the child has its own children, recursively convert to JSObject
-        if (child->GetChildCount() > 0) {
-            JSObjectRef childObj = arcadeKeyValuesToJSObject(ctx, child.get());
-            JSObjectSetProperty(ctx, jsObj, childKey, childObj, 0, 0);
+    // Set computedAt property
+    JSStringRef computedAtKey = JSStringCreateWithUTF8CString("computedAt");
+    JSObjectSetProperty(ctx, resultObj, computedAtKey, JSValueMakeNumber(ctx, static_cast<double>(result.computedAt)), 0, nullptr);
+    JSStringRelease(computedAtKey);
+
+    // Set fields property
+    JSObjectRef fieldsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < result.fields.size(); i++) {
+        const auto& field = result.fields[i];
+        JSObjectRef fieldObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set path property
+        JSStringRef pathKey = JSStringCreateWithUTF8CString("path");
+        JSStringRef pathValue = JSStringCreateWithUTF8CString(field.path.c_str());
+        JSObjectSetProperty(ctx, fieldObj, pathKey, JSValueMakeString(ctx, pathValue), 0, nullptr);
+        JSStringRelease(pathKey);
+        JSStringRelease(pathValue);
+
+        // Set count property
+        JSStringRef countKey = JSStringCreateWithUTF8CString("count");
+        JSObjectSetProperty(ctx, fieldObj, countKey, JSValueMakeNumber(ctx, static_cast<double>(field.count)), 0, nullptr);
+        JSStringRelease(countKey);
+
+        // Set distinctEstimate property
+        JSStringRef distinctEstimateKey = JSStringCreateWithUTF8CString("distinctEstimate");
+        JSObjectSetProperty(ctx, fieldObj, distinctEstimateKey, JSValueMakeNumber(ctx, static_cast<double>(field.distinctEstimate)), 0, nullptr);
+        JSStringRelease(distinctEstimateKey);
+
+        // Set maxLength property
+        JSStringRef maxLengthKey = JSStringCreateWithUTF8CString("maxLength");
+        JSObjectSetProperty(ctx, fieldObj, maxLengthKey, JSValueMakeNumber(ctx, static_cast<double>(field.maxLength)), 0, nullptr);
+        JSStringRelease(maxLengthKey);
+
+        // Set topValues property
+        JSObjectRef topValuesArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        for (size_t j = 0; j < field.topValues.size(); j++) {
+            const auto& topValue = field.topValues[j];
+            JSObjectRef valueObj = JSObjectMake(ctx, nullptr, nullptr);
+
+            // Set value property
+            JSStringRef valueKey = JSStringCreateWithUTF8CString("value");
+            JSStringRef valueValue = JSStringCreateWithUTF8CString(topValue.value.c_str());
+            JSObjectSetProperty(ctx, valueObj, valueKey, JSValueMakeString(ctx, valueValue), 0, nullptr);
+            JSStringRelease(valueKey);
+            JSStringRelease(valueValue);
+
+            // Set count property
+            JSStringRef countKey = JSStringCreateWithUTF8CString("count");
+            JSObjectSetProperty(ctx, valueObj, countKey, JSValueMakeNumber(ctx, static_cast<double>(topValue.count)), 0, nullptr);
+            JSStringRelease(countKey);
+
+            JSObjectSetPropertyAtIndex(ctx, topValuesArray, j, valueObj, nullptr);
         }
-        else {
-            // If it's a leaf node, add its value directly
-            const char* childStringVal = child->GetString();
-            if (childStringVal && strlen(childStringVal) > 0) {
-                JSStringRef childValueStr = JSStringCreateWithUTF8CString(childStringVal);
-                JSValueRef childValueJS = JSValueMakeString(ctx, childValueStr);
-                JSObjectSetProperty(ctx, jsObj, childKey, childValueJS, 0, 0);
-                JSStringRelease(childValueStr);
-            }
-            else {
-                int childIntVal = child->GetInt();
-                if (childIntVal != 0) {
-                    JSValueRef childValueJS = JSValueMakeNumber(ctx, childIntVal);
-                    JSObjectSetProperty(ctx, jsObj, childKey, childValueJS, 0, 0);
-                }
-                else {
-                    float childFloatVal = child->GetFloat();
-                    if (childFloatVal != 0.0f) {
-                        JSValueRef childValueJS = JSValueMakeNumber(ctx, childFloatVal);
-                        JSObjectSetProperty(ctx, jsObj, childKey, childValueJS, 0, 0);
-                    }
-                }
-            }
+        JSStringRef topValuesKey = JSStringCreateWithUTF8CString("topValues");
+        JSObjectSetProperty(ctx, fieldObj, topValuesKey, topValuesArray, 0, nullptr);
+        JSStringRelease(topValuesKey);
+
+        // Set lengthHistogram property
+        JSObjectRef histogramArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        for (size_t j = 0; j < field.lengthHistogram.size(); j++) {
+            JSObjectSetPropertyAtIndex(ctx, histogramArray, j, JSValueMakeNumber(ctx, static_cast<double>(field.lengthHistogram[j])), nullptr);
         }
+        JSStringRef lengthHistogramKey = JSStringCreateWithUTF8CString("lengthHistogram");
+        JSObjectSetProperty(ctx, fieldObj, lengthHistogramKey, histogramArray, 0, nullptr);
+        JSStringRelease(lengthHistogramKey);
 
-        JSStringRelease(childKey);
+        JSObjectSetPropertyAtIndex(ctx, fieldsArray, i, fieldObj, nullptr);
     }
+    JSStringRef fieldsKey = JSStringCreateWithUTF8CString("fields");
+    JSObjectSetProperty(ctx, resultObj, fieldsKey, fieldsArray, 0, nullptr);
+    JSStringRelease(fieldsKey);
 
-    return jsObj;
+    return resultObj;
 }
 
-JSObjectRef JSBridge::entryDataToJSObject(JSContextRef ctx, const std::string& entryId, const std::string& hexData) {
-    if (entryId.empty() || hexData.empty()) {
-        return JSValueToObject(ctx, JSValueMakeNull(ctx), nullptr);
-    }
+// Helper function to convert a job status to a JavaScript object
+JSObjectRef JSBridge::jobStatusToJSObject(JSContextRef ctx, const JobManager::JobStatus& status) {
+    JSObjectRef statusObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set id property
+    JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+    JSObjectSetProperty(ctx, statusObj, idKey, JSValueMakeNumber(ctx, status.id), 0, nullptr);
+    JSStringRelease(idKey);
+
+    // Set type property
+    JSStringRef typeKey = JSStringCreateWithUTF8CString("type");
+    JSStringRef typeValue = JSStringCreateWithUTF8CString(status.type.c_str());
+    JSObjectSetProperty(ctx, statusObj, typeKey, JSValueMakeString(ctx, typeValue), 0, nullptr);
+    JSStringRelease(typeKey);
+    JSStringRelease(typeValue);
+
+    // Set status property
+    JSStringRef statusKey = JSStringCreateWithUTF8CString("status");
+    JSStringRef statusValue = JSStringCreateWithUTF8CString(status.status.c_str());
+    JSObjectSetProperty(ctx, statusObj, statusKey, JSValueMakeString(ctx, statusValue), 0, nullptr);
+    JSStringRelease(statusKey);
+    JSStringRelease(statusValue);
 
-    // Parse the hex data using ArcadeKeyValues
-    try {
-        auto keyValues = ArcadeKeyValues::ParseFromHex(hexData);
-        if (!keyValues) {
-            return JSValueToObject(ctx, JSValueMakeNull(ctx), nullptr);
-        }
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(status.error.c_str());
+    JSObjectSetProperty(ctx, statusObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
 
-        // For items table, try to navigate to item.local path for backwards compatibility
-        ArcadeKeyValues* itemSection = keyValues->GetFirstSubKey();
-        if (itemSection) {
-            ArcadeKeyValues* localSection = itemSection->FindKey("local");
-            if (localSection) {
-                return arcadeKeyValuesToJSObject(ctx, localSection);
-            }
-        }
+    // Set lastId property
+    JSStringRef lastIdKey = JSStringCreateWithUTF8CString("lastId");
+    JSStringRef lastIdValue = JSStringCreateWithUTF8CString(status.lastId.c_str());
+    JSObjectSetProperty(ctx, statusObj, lastIdKey, JSValueMakeString(ctx, lastIdValue), 0, nullptr);
+    JSStringRelease(lastIdKey);
+    JSStringRelease(lastIdValue);
 
-        // For other tables or if item.local doesn't exist, return the entire parsed structure
-        return arcadeKeyValuesToJSObject(ctx, keyValues.get());
+    // Set progress properties
+    JSStringRef rowsDoneKey = JSStringCreateWithUTF8CString("rowsDone");
+    JSObjectSetProperty(ctx, statusObj, rowsDoneKey, JSValueMakeNumber(ctx, static_cast<double>(status.rowsDone)), 0, nullptr);
+    JSStringRelease(rowsDoneKey);
 
-    }
-    catch (const std::exception& e) {
-        std::string errorMsg = "[JSBridge] Exception parsing KeyValues: " + std::string(e.what());
-        OutputDebugStringA((errorMsg + "\n").c_str());
-        return JSValueToObject(ctx, JSValueMakeNull(ctx), nullptr);
-    }
-}
+    JSStringRef rowsTotalKey = JSStringCreateWithUTF8CString("rowsTotal");
+    JSObjectSetProperty(ctx, statusObj, rowsTotalKey, JSValueMakeNumber(ctx, static_cast<double>(status.rowsTotal)), 0, nullptr);
+    JSStringRelease(rowsTotalKey);
 
-JSObjectRef JSBridge::createJSArray(JSContextRef ctx, const std::vector<std::pair<std::string, std::string>>& entries) {
-    JSObjectRef arrayObj = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    JSStringRef bytesDoneKey = JSStringCreateWithUTF8CString("bytesDone");
+    JSObjectSetProperty(ctx, statusObj, bytesDoneKey, JSValueMakeNumber(ctx, static_cast<double>(status.bytesDone)), 0, nullptr);
+    JSStringRelease(bytesDoneKey);
 
-    for (unsigned int i = 0; i < entries.size(); i++) {
-        JSObjectRef entryObj = entryDataToJSObject(ctx, entries[i].first, entries[i].second);
-        JSValueRef entryValue = static_cast<JSValueRef>(entryObj);
-        JSObjectSetPropertyAtIndex(ctx, arrayObj, i, entryValue, nullptr);
-    }
+    // Convert partial results to JavaScript array
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < status.results.size(); i++) {
+        const auto& result = status.results[i];
 
-    return arrayObj;
-}
+        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
-JSObjectRef JSBridge::createStringArray(JSContextRef ctx, const std::vector<std::string>& strings) {
-    JSObjectRef arrayObj = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        JSStringRef resultIdKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef resultIdValue = JSStringCreateWithUTF8CString(result.id.c_str());
+        JSObjectSetProperty(ctx, resultObj, resultIdKey, JSValueMakeString(ctx, resultIdValue), 0, nullptr);
+        JSStringRelease(resultIdKey);
+        JSStringRelease(resultIdValue);
 
-    for (unsigned int i = 0; i < strings.size(); i++) {
-        JSStringRef stringValue = JSStringCreateWithUTF8CString(strings[i].c_str());
-        JSValueRef jsStringValue = JSValueMakeString(ctx, stringValue);
-        JSObjectSetPropertyAtIndex(ctx, arrayObj, i, jsStringValue, nullptr);
-        JSStringRelease(stringValue);
-    }
+        JSStringRef actionKey = JSStringCreateWithUTF8CString("action");
+        JSStringRef actionValue = JSStringCreateWithUTF8CString(result.action.c_str());
+        JSObjectSetProperty(ctx, resultObj, actionKey, JSValueMakeString(ctx, actionValue), 0, nullptr);
+        JSStringRelease(actionKey);
+        JSStringRelease(actionValue);
 
-    return arrayObj;
-}
+        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+        JSStringRelease(successKey);
 
-JSValueRef JSBridge::getSupportedEntryTypes(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] getSupportedEntryTypes called from JavaScript\n");
+        JSStringRef resultErrorKey = JSStringCreateWithUTF8CString("error");
+        JSStringRef resultErrorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+        JSObjectSetProperty(ctx, resultObj, resultErrorKey, JSValueMakeString(ctx, resultErrorValue), 0, nullptr);
+        JSStringRelease(resultErrorKey);
+        JSStringRelease(resultErrorValue);
 
-    // Get supported types from Library
-    std::vector<std::string> supportedTypes = library_->getSupportedEntryTypes();
+        JSStringRef sizeKey = JSStringCreateWithUTF8CString("blobSizeBytes");
+        JSObjectSetProperty(ctx, resultObj, sizeKey, JSValueMakeNumber(ctx, result.sizeBytes), 0, nullptr);
+        JSStringRelease(sizeKey);
 
-    // Convert to JavaScript array
-    return createStringArray(ctx, supportedTypes);
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
+    }
+
+    // Set results property
+    JSStringRef resultsKey = JSStringCreateWithUTF8CString("results");
+    JSObjectSetProperty(ctx, statusObj, resultsKey, resultsArray, 0, nullptr);
+    JSStringRelease(resultsKey);
+
+    return statusObj;
 }
 
-JSValueRef JSBridge::constructSchema(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::jobStart(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] constructSchema called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] jobStart called from JavaScript\n");
 
-    if (argumentCount < 1) {
-        OutputDebugStringA("[JSBridge] constructSchema: Missing entryType parameter\n");
-        return JSValueMakeNull(ctx);
+    if (!jobManager_ || argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] jobStart: Missing parameters (type, [params])\n");
+        return JSValueMakeNumber(ctx, -1);
     }
 
-    // Get entry type from first argument
-    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
-    if (!entryTypeStr) {
-        OutputDebugStringA("[JSBridge] constructSchema: Invalid entry type parameter\n");
-        return JSValueMakeNull(ctx);
+    // Extract type (string)
+    JSStringRef typeStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!typeStr) {
+        OutputDebugStringA("[JSBridge] jobStart: Invalid type parameter\n");
+        return JSValueMakeNumber(ctx, -1);
     }
+    size_t typeLength = JSStringGetMaximumUTF8CStringSize(typeStr);
+    char* typeBuffer = new char[typeLength];
+    JSStringGetUTF8CString(typeStr, typeBuffer, typeLength);
+    std::string type(typeBuffer);
+    delete[] typeBuffer;
+    JSStringRelease(typeStr);
+
+    // Extract params object: { tableName, sourcePath, skipExisting, overwriteIfLarger, maxLength, minSizeBytes, entryIds,
+    //                          pathGlob, find, replace, regex, destinationPath, pagesPerStep, sleepMs, compress, incremental,
+    //                          rules, dryRun, keys, maxClusters }
+    JobManager::JobParams params;
+    if (argumentCount > 1 && JSValueIsObject(ctx, arguments[1])) {
+        JSObjectRef paramsObj = JSValueToObject(ctx, arguments[1], exception);
+
+        params.tableName = jsObjectGetString(ctx, paramsObj, "tableName", exception);
+        params.sourcePath = jsObjectGetString(ctx, paramsObj, "sourcePath", exception);
+
+        JSValueRef skipValue = jsObjectGetValue(ctx, paramsObj, "skipExisting", exception);
+        if (!JSValueIsUndefined(ctx, skipValue)) {
+            params.skipExisting = JSValueToBoolean(ctx, skipValue);
+        }
 
-    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
-    char* entryTypeBuffer = new char[entryTypeLength];
-    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
-    std::string entryType = entryTypeBuffer;
-    delete[] entryTypeBuffer;
-    JSStringRelease(entryTypeStr);
+        JSValueRef overwriteValue = jsObjectGetValue(ctx, paramsObj, "overwriteIfLarger", exception);
+        if (!JSValueIsUndefined(ctx, overwriteValue)) {
+            params.overwriteIfLarger = JSValueToBoolean(ctx, overwriteValue);
+        }
 
-    // Get schema from Library
-    std::vector<std::string> schema = library_->constructSchema(entryType);
+        JSValueRef maxLengthValue = jsObjectGetValue(ctx, paramsObj, "maxLength", exception);
+        if (!JSValueIsUndefined(ctx, maxLengthValue)) {
+            params.maxLength = static_cast<int>(JSValueToNumber(ctx, maxLengthValue, exception));
+        }
 
-    // Convert to JavaScript array
-    return createStringArray(ctx, schema);
-}
+        JSValueRef minSizeBytesValue = jsObjectGetValue(ctx, paramsObj, "minSizeBytes", exception);
+        if (!JSValueIsUndefined(ctx, minSizeBytesValue)) {
+            params.minSizeBytes = static_cast<int>(JSValueToNumber(ctx, minSizeBytesValue, exception));
+        }
 
-JSValueRef JSBridge::quitApplication(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] quitApplication called from JavaScript\n");
+        params.pathGlob = jsObjectGetString(ctx, paramsObj, "pathGlob", exception);
+        params.findText = jsObjectGetString(ctx, paramsObj, "find", exception);
+        params.replaceText = jsObjectGetString(ctx, paramsObj, "replace", exception);
 
-    if (app_) {
-        app_->Quit();
-        OutputDebugStringA("[JSBridge] Application quit requested\n");
-        return JSValueMakeBoolean(ctx, true);
-    }
-    else {
-        OutputDebugStringA("[JSBridge] ERROR: App instance not available\n");
-        return JSValueMakeBoolean(ctx, false);
-    }
-}
+        JSValueRef regexValue = jsObjectGetValue(ctx, paramsObj, "regex", exception);
+        if (!JSValueIsUndefined(ctx, regexValue)) {
+            params.useRegex = JSValueToBoolean(ctx, regexValue);
+        }
+
+        params.destinationPath = jsObjectGetString(ctx, paramsObj, "destinationPath", exception);
+
+        JSValueRef pagesPerStepValue = jsObjectGetValue(ctx, paramsObj, "pagesPerStep", exception);
+        if (!JSValueIsUndefined(ctx, pagesPerStepValue)) {
+            params.pagesPerStep = static_cast<int>(JSValueToNumber(ctx, pagesPerStepValue, exception));
+        }
+
+        JSValueRef sleepMsValue = jsObjectGetValue(ctx, paramsObj, "sleepMs", exception);
+        if (!JSValueIsUndefined(ctx, sleepMsValue)) {
+            params.sleepMs = static_cast<int>(JSValueToNumber(ctx, sleepMsValue, exception));
+        }
+
+        JSValueRef compressValue = jsObjectGetValue(ctx, paramsObj, "compress", exception);
+        if (!JSValueIsUndefined(ctx, compressValue)) {
+            params.compress = JSValueToBoolean(ctx, compressValue);
+        }
+
+        JSValueRef incrementalValue = jsObjectGetValue(ctx, paramsObj, "incremental", exception);
+        if (!JSValueIsUndefined(ctx, incrementalValue)) {
+            params.incremental = JSValueToBoolean(ctx, incrementalValue);
+        }
+
+        params.rulesText = jsObjectGetString(ctx, paramsObj, "rules", exception);
+
+        JSValueRef dryRunValue = jsObjectGetValue(ctx, paramsObj, "dryRun", exception);
+        if (!JSValueIsUndefined(ctx, dryRunValue)) {
+            params.dryRun = JSValueToBoolean(ctx, dryRunValue);
+        }
 
-JSValueRef JSBridge::getFirstEntry(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] getFirstEntry called from JavaScript\n");
+        params.keys = jsArrayToStrings(ctx, jsObjectGetValue(ctx, paramsObj, "keys", exception), exception);
 
-    if (argumentCount < 1) {
-        OutputDebugStringA("[JSBridge] getFirstEntry: Missing entry type parameter\n");
-        return JSValueMakeNull(ctx);
-    }
+        JSValueRef maxClustersValue = jsObjectGetValue(ctx, paramsObj, "maxClusters", exception);
+        if (!JSValueIsUndefined(ctx, maxClustersValue)) {
+            params.maxClusters = static_cast<int>(JSValueToNumber(ctx, maxClustersValue, exception));
+        }
 
-    // Get entry type from first argument
-    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
-    if (!entryTypeStr) {
-        OutputDebugStringA("[JSBridge] getFirstEntry: Invalid entry type parameter\n");
-        return JSValueMakeNull(ctx);
+        JSValueRef idsValue = jsObjectGetValue(ctx, paramsObj, "entryIds", exception);
+        if (JSValueIsObject(ctx, idsValue)) {
+            JSObjectRef idsArray = JSValueToObject(ctx, idsValue, exception);
+
+            JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
+            JSValueRef lengthValue = JSObjectGetProperty(ctx, idsArray, lengthProp, exception);
+            JSStringRelease(lengthProp);
+            double arrayLength = JSValueToNumber(ctx, lengthValue, exception);
+
+            for (size_t i = 0; i < arrayLength; i++) {
+                JSValueRef idValue = JSObjectGetPropertyAtIndex(ctx, idsArray, i, exception);
+                JSStringRef idStr = JSValueToStringCopy(ctx, idValue, exception);
+                if (idStr) {
+                    size_t idLength = JSStringGetMaximumUTF8CStringSize(idStr);
+                    char* idBuffer = new char[idLength];
+                    JSStringGetUTF8CString(idStr, idBuffer, idLength);
+                    params.entryIds.push_back(std::string(idBuffer));
+                    delete[] idBuffer;
+                    JSStringRelease(idStr);
+                }
+            }
+        }
     }
 
-    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
-    char* entryTypeBuffer = new char[entryTypeLength];
-    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
-    std::string entryType(entryTypeBuffer);
-    delete[] entryTypeBuffer;
-    JSStringRelease(entryTypeStr);
+    int jobId = jobManager_->startJob(type, params);
 
-    // Get the first entry via Library
-    std::pair<std::string, std::string> entry = library_->getFirstEntry(entryType);
+    OutputDebugStringA(("[JSBridge] jobStart: Started job " + std::to_string(jobId) + " (" + type + ")\n").c_str());
 
-    return entryDataToJSObject(ctx, entry.first, entry.second);
+    return JSValueMakeNumber(ctx, jobId);
 }
 
-JSValueRef JSBridge::getNextSearchResults(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::jobPause(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] getNextSearchResults called from JavaScript\n");
+    if (!jobManager_ || argumentCount < 1) {
+        return JSValueMakeBoolean(ctx, false);
+    }
 
-    // Get count from first argument (optional, default to 50)
-    int count = 50;
-    if (argumentCount >= 1) {
-        double countDouble = JSValueToNumber(ctx, arguments[0], exception);
-        count = static_cast<int>(countDouble);
-        if (count <= 0 || count > 1000) {
-            count = 50; // Reset to default if invalid
-        }
+    int jobId = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
+    return JSValueMakeBoolean(ctx, jobManager_->pauseJob(jobId));
+}
+
+JSValueRef JSBridge::jobResume(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    if (!jobManager_ || argumentCount < 1) {
+        return JSValueMakeBoolean(ctx, false);
     }
 
-    // Get the next search results via Library
-    std::vector<std::pair<std::string, std::string>> results = library_->getNextSearchResults(count);
+    int jobId = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
+    return JSValueMakeBoolean(ctx, jobManager_->resumeJob(jobId));
+}
 
-    return createJSArray(ctx, results);
+JSValueRef JSBridge::jobCancel(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    if (!jobManager_ || argumentCount < 1) {
+        return JSValueMakeBoolean(ctx, false);
+    }
+
+    int jobId = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
+    return JSValueMakeBoolean(ctx, jobManager_->cancelJob(jobId));
 }
 
-JSValueRef JSBridge::debugGetFirstItemAsJSObject(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::jobGetStatus(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] debugGetFirstItemAsJSObject called from JavaScript (legacy method)\n");
+    if (!jobManager_ || argumentCount < 1) {
+        return JSValueMakeNull(ctx);
+    }
 
-    // Get the first item from the database via Library (legacy method)
-    std::pair<std::string, std::string> itemResult = library_->getFirstItem();
+    int jobId = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
 
-    return entryDataToJSObject(ctx, itemResult.first, itemResult.second);
+    // Partial results are drained on each poll so the page only receives new rows
+    JobManager::JobStatus status = jobManager_->getJobStatus(jobId, true);
+
+    return jobStatusToJSObject(ctx, status);
 }
 
-JSValueRef JSBridge::getNextEntry(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::jobList(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] getNextEntry called from JavaScript\n");
+    JSObjectRef jobsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    if (!jobManager_) {
+        return jobsArray;
+    }
 
-    // Get the next entry via Library (no parameters needed)
-    std::pair<std::string, std::string> entry = library_->getNextEntry();
+    std::vector<JobManager::JobStatus> statuses = jobManager_->listJobs();
+    for (size_t i = 0; i < statuses.size(); i++) {
+        JSObjectSetPropertyAtIndex(ctx, jobsArray, i, jobStatusToJSObject(ctx, statuses[i]), nullptr);
+    }
 
-    return entryDataToJSObject(ctx, entry.first, entry.second);
+    return jobsArray;
 }
 
-JSValueRef JSBridge::getFirstEntries(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtFindDuplicates(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] getFirstEntries called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] dbtFindDuplicates called from JavaScript\n");
 
     if (argumentCount < 2) {
-        OutputDebugStringA("[JSBridge] getFirstEntries: Missing parameters (entryType, count)\n");
+        OutputDebugStringA("[JSBridge] dbtFindDuplicates: Missing parameters (tableName, keys)\n");
         return JSValueMakeNull(ctx);
     }
 
-    // Get entry type from first argument
-    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
-    if (!entryTypeStr) {
-        OutputDebugStringA("[JSBridge] getFirstEntries: Invalid entry type parameter\n");
+    // Get table name from first argument
+    JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!tableNameStr) {
+        OutputDebugStringA("[JSBridge] dbtFindDuplicates: Invalid table name parameter\n");
         return JSValueMakeNull(ctx);
     }
 
-    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
-    char* entryTypeBuffer = new char[entryTypeLength];
-    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
-    std::string entryType(entryTypeBuffer);
-    delete[] entryTypeBuffer;
-    JSStringRelease(entryTypeStr);
+    size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
+    char* tableNameBuffer = new char[tableNameLength];
+    JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
+    std::string tableName(tableNameBuffer);
+    delete[] tableNameBuffer;
+    JSStringRelease(tableNameStr);
 
-    // Get count from second argument
-    double countDouble = JSValueToNumber(ctx, arguments[1], exception);
-    int count = static_cast<int>(countDouble);
+    // Blocking keys, e.g. ["file", "title", "screen", "content"]
+    std::vector<std::string> keys = jsArrayToStrings(ctx, arguments[1], exception);
 
-    if (count <= 0 || count > 1000) { // Reasonable limit
-        OutputDebugStringA("[JSBridge] getFirstEntries: Invalid count parameter\n");
-        return JSValueMakeNull(ctx);
+    // Optional maximum number of clusters returned
+    int maxClusters = 5000;
+    if (argumentCount >= 3) {
+        maxClusters = static_cast<int>(JSValueToNumber(ctx, arguments[2], exception));
     }
 
-    // Get the first entries via Library
-    std::vector<std::pair<std::string, std::string>> entries = library_->getFirstEntries(entryType, count);
-
-    return createJSArray(ctx, entries);
-}
+    Library::DuplicateResult result = library_->dbtFindDuplicates(tableName, keys, maxClusters);
 
-JSValueRef JSBridge::getNextEntries(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] getNextEntries called from JavaScript\n");
+    JSObjectRef clustersArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < result.clusters.size(); i++) {
+        const auto& cluster = result.clusters[i];
 
-    if (argumentCount < 1) {
-        OutputDebugStringA("[JSBridge] getNextEntries: Missing count parameter\n");
-        return JSValueMakeNull(ctx);
-    }
+        JSObjectRef keysArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        for (size_t k = 0; k < cluster.matchedKeys.size(); k++) {
+            JSStringRef keyValue = JSStringCreateWithUTF8CString(cluster.matchedKeys[k].c_str());
+            JSObjectSetPropertyAtIndex(ctx, keysArray, k, JSValueMakeString(ctx, keyValue), nullptr);
+            JSStringRelease(keyValue);
+        }
 
-    // Get count from first argument
-    double countDouble = JSValueToNumber(ctx, arguments[0], exception);
-    int count = static_cast<int>(countDouble);
+        JSObjectRef membersArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        for (size_t m = 0; m < cluster.members.size(); m++) {
+            const auto& member = cluster.members[m];
+            JSObjectRef memberObj = JSObjectMake(ctx, nullptr, nullptr);
+
+            // Set id property
+            JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+            JSStringRef idValue = JSStringCreateWithUTF8CString(member.id.c_str());
+            JSObjectSetProperty(ctx, memberObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+            JSStringRelease(idKey);
+            JSStringRelease(idValue);
+
+            // Set title property
+            JSStringRef titleKey = JSStringCreateWithUTF8CString("title");
+            JSStringRef titleValue = JSStringCreateWithUTF8CString(member.title.c_str());
+            JSObjectSetProperty(ctx, memberObj, titleKey, JSValueMakeString(ctx, titleValue), 0, nullptr);
+            JSStringRelease(titleKey);
+            JSStringRelease(titleValue);
+
+            // Set sizeBytes property
+            JSStringRef sizeBytesKey = JSStringCreateWithUTF8CString("sizeBytes");
+            JSObjectSetProperty(ctx, memberObj, sizeBytesKey, JSValueMakeNumber(ctx, member.sizeBytes), 0, nullptr);
+            JSStringRelease(sizeBytesKey);
+
+            // Set similarity property
+            JSStringRef similarityKey = JSStringCreateWithUTF8CString("similarity");
+            JSObjectSetProperty(ctx, memberObj, similarityKey, JSValueMakeNumber(ctx, member.similarity), 0, nullptr);
+            JSStringRelease(similarityKey);
+
+            JSObjectSetPropertyAtIndex(ctx, membersArray, m, memberObj, nullptr);
+        }
 
-    if (count <= 0 || count > 1000) { // Reasonable limit
-        OutputDebugStringA("[JSBridge] getNextEntries: Invalid count parameter\n");
-        return JSValueMakeNull(ctx);
-    }
+        JSObjectRef clusterObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    // Get the next entries via Library
-    std::vector<std::pair<std::string, std::string>> entries = library_->getNextEntries(count);
+        // Set similarity property
+        JSStringRef similarityKey = JSStringCreateWithUTF8CString("similarity");
+        JSObjectSetProperty(ctx, clusterObj, similarityKey, JSValueMakeNumber(ctx, cluster.similarity), 0, nullptr);
+        JSStringRelease(similarityKey);
 
-    return createJSArray(ctx, entries);
-}
+        // Set matchedKeys property
+        JSStringRef matchedKeysKey = JSStringCreateWithUTF8CString("matchedKeys");
+        JSObjectSetProperty(ctx, clusterObj, matchedKeysKey, keysArray, 0, nullptr);
+        JSStringRelease(matchedKeysKey);
 
-JSValueRef JSBridge::getFirstSearchResults(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] getFirstSearchResults called from JavaScript\n");
+        // Set members property
+        JSStringRef membersKey = JSStringCreateWithUTF8CString("members");
+        JSObjectSetProperty(ctx, clusterObj, membersKey, membersArray, 0, nullptr);
+        JSStringRelease(membersKey);
 
-    if (argumentCount < 2) {
-        OutputDebugStringA("[JSBridge] getFirstSearchResults: Missing parameters (entryType, searchTerm)\n");
-        return JSValueMakeNull(ctx);
+        JSObjectSetPropertyAtIndex(ctx, clustersArray, i, clusterObj, nullptr);
     }
 
-    // Get entry type from first argument
-    JSStringRef entryTypeStr = JSValueToStringCopy(ctx, arguments[0], exception);
-    if (!entryTypeStr) {
-        OutputDebugStringA("[JSBridge] getFirstSearchResults: Invalid entry type parameter\n");
-        return JSValueMakeNull(ctx);
-    }
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    size_t entryTypeLength = JSStringGetMaximumUTF8CStringSize(entryTypeStr);
-    char* entryTypeBuffer = new char[entryTypeLength];
-    JSStringGetUTF8CString(entryTypeStr, entryTypeBuffer, entryTypeLength);
-    std::string entryType(entryTypeBuffer);
-    delete[] entryTypeBuffer;
-    JSStringRelease(entryTypeStr);
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
 
-    // Get search term from second argument
-    JSStringRef searchTermStr = JSValueToStringCopy(ctx, arguments[1], exception);
-    if (!searchTermStr) {
-        OutputDebugStringA("[JSBridge] getFirstSearchResults: Invalid search term parameter\n");
-        return JSValueMakeNull(ctx);
-    }
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
 
-    size_t searchTermLength = JSStringGetMaximumUTF8CStringSize(searchTermStr);
-    char* searchTermBuffer = new char[searchTermLength];
-    JSStringGetUTF8CString(searchTermStr, searchTermBuffer, searchTermLength);
-    std::string searchTerm(searchTermBuffer);
-    delete[] searchTermBuffer;
-    JSStringRelease(searchTermStr);
+    // Set rowsScanned property
+    JSStringRef rowsScannedKey = JSStringCreateWithUTF8CString("rowsScanned");
+    JSObjectSetProperty(ctx, resultObj, rowsScannedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsScanned)), 0, nullptr);
+    JSStringRelease(rowsScannedKey);
 
-    // Get count from third argument (optional, default to 50)
-    int count = 50;
-    if (argumentCount >= 3) {
-        double countDouble = JSValueToNumber(ctx, arguments[2], exception);
-        count = static_cast<int>(countDouble);
-        if (count <= 0 || count > 1000) {
-            count = 50; // Reset to default if invalid
-        }
-    }
+    // Set clusterCount property
+    JSStringRef clusterCountKey = JSStringCreateWithUTF8CString("clusterCount");
+    JSObjectSetProperty(ctx, resultObj, clusterCountKey, JSValueMakeNumber(ctx, static_cast<double>(result.clusterCount)), 0, nullptr);
+    JSStringRelease(clusterCountKey);
 
-    // Get the first search results via Library
-    std::vector<std::pair<std::string, std::string>> results = library_->getFirstSearchResults(entryType, searchTerm, count);
+    // Set duplicateCount property
+    JSStringRef duplicateCountKey = JSStringCreateWithUTF8CString("duplicateCount");
+    JSObjectSetProperty(ctx, resultObj, duplicateCountKey, JSValueMakeNumber(ctx, static_cast<double>(result.duplicateCount)), 0, nullptr);
+    JSStringRelease(duplicateCountKey);
 
-    return createJSArray(ctx, results);
+    // Set clusters property
+    JSStringRef clustersKey = JSStringCreateWithUTF8CString("clusters");
+    JSObjectSetProperty(ctx, resultObj, clustersKey, clustersArray, 0, nullptr);
+    JSStringRelease(clustersKey);
+
+    return resultObj;
 }
 
-JSValueRef JSBridge::dbtFindLargeEntriesInTable(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtCollapseDuplicates(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtFindLargeEntriesInTable called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] dbtCollapseDuplicates called from JavaScript\n");
 
-    if (argumentCount < 2) {
-        OutputDebugStringA("[JSBridge] dbtFindLargeEntriesInTable: Missing parameters (tableName, minSizeBytes)\n");
+    if (argumentCount < 2 || !JSValueIsObject(ctx, arguments[1])) {
+        OutputDebugStringA("[JSBridge] dbtCollapseDuplicates: Missing parameters (tableName, collapses)\n");
         return JSValueMakeNull(ctx);
     }
 
     // Get table name from first argument
     JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
     if (!tableNameStr) {
-        OutputDebugStringA("[JSBridge] dbtFindLargeEntriesInTable: Invalid table name parameter\n");
+        OutputDebugStringA("[JSBridge] dbtCollapseDuplicates: Invalid table name parameter\n");
         return JSValueMakeNull(ctx);
     }
 
@@ -1021,67 +3989,214 @@ JSValueRef JSBridge::dbtFindLargeEntriesInTable(JSContextRef ctx, JSObjectRef fu
     delete[] tableNameBuffer;
     JSStringRelease(tableNameStr);
 
-    // Get minimum size from second argument
-    double minSizeBytesDouble = JSValueToNumber(ctx, arguments[1], exception);
-    int minSizeBytes = static_cast<int>(minSizeBytesDouble);
+    // Collapses array: [{ keepId, removeIds: [...] }, ...]
+    JSObjectRef collapsesArray = JSValueToObject(ctx, arguments[1], exception);
+    JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
+    JSValueRef lengthValue = JSObjectGetProperty(ctx, collapsesArray, lengthProp, exception);
+    JSStringRelease(lengthProp);
+    double arrayLength = JSValueToNumber(ctx, lengthValue, exception);
 
-    if (minSizeBytes <= 0) {
-        OutputDebugStringA("[JSBridge] dbtFindLargeEntriesInTable: Invalid minSizeBytes parameter\n");
-        return JSValueMakeNull(ctx);
+    std::vector<Library::DuplicateCollapse> collapses;
+    for (size_t i = 0; i < arrayLength; i++) {
+        JSValueRef collapseValue = JSObjectGetPropertyAtIndex(ctx, collapsesArray, i, exception);
+        if (!JSValueIsObject(ctx, collapseValue)) {
+            continue;
+        }
+        JSObjectRef collapseObj = JSValueToObject(ctx, collapseValue, exception);
+
+        Library::DuplicateCollapse collapse;
+        collapse.keepId = jsObjectGetString(ctx, collapseObj, "keepId", exception);
+        collapse.removeIds = jsArrayToStrings(ctx, jsObjectGetValue(ctx, collapseObj, "removeIds", exception), exception);
+        collapses.push_back(collapse);
     }
 
-    OutputDebugStringA(("[JSBridge] Searching " + tableName + " for entries over " + std::to_string(minSizeBytes) + " bytes\n").c_str());
+    std::vector<Library::CollapseResult> results = library_->dbtCollapseDuplicates(tableName, collapses);
 
-    // Get large entries from Library
-    std::vector<Library::LargeBlobEntry> entries = library_->dbtFindLargeEntriesInTable(tableName, minSizeBytes);
+    // Convert to JavaScript array of objects
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+
+        // Create object for this result
+        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set id property
+        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
+        JSStringRef idValue = JSStringCreateWithUTF8CString(result.id.c_str());
+        JSObjectSetProperty(ctx, resultObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRelease(idKey);
+        JSStringRelease(idValue);
+
+        // Set keptId property
+        JSStringRef keptIdKey = JSStringCreateWithUTF8CString("keptId");
+        JSStringRef keptIdValue = JSStringCreateWithUTF8CString(result.keptId.c_str());
+        JSObjectSetProperty(ctx, resultObj, keptIdKey, JSValueMakeString(ctx, keptIdValue), 0, nullptr);
+        JSStringRelease(keptIdKey);
+        JSStringRelease(keptIdValue);
+
+        // Set referencesMoved property
+        JSStringRef referencesMovedKey = JSStringCreateWithUTF8CString("referencesMoved");
+        JSObjectSetProperty(ctx, resultObj, referencesMovedKey, JSValueMakeNumber(ctx, static_cast<double>(result.referencesMoved)), 0, nullptr);
+        JSStringRelease(referencesMovedKey);
+
+        // Set success property
+        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+        JSStringRelease(successKey);
+
+        // Set error property
+        JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+        JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+        JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+        JSStringRelease(errorKey);
+        JSStringRelease(errorValue);
+
+        // Add to results array
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
+    }
+
+    return resultsArray;
+}
+
+JSValueRef JSBridge::dbtCheckReferences(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtCheckReferences called from JavaScript\n");
+
+    Library::ReferenceCheckResult result = library_->dbtCheckReferences();
+
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set rowsScanned property
+    JSStringRef rowsScannedKey = JSStringCreateWithUTF8CString("rowsScanned");
+    JSObjectSetProperty(ctx, resultObj, rowsScannedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsScanned)), 0, nullptr);
+    JSStringRelease(rowsScannedKey);
+
+    // Set danglingCount property
+    JSStringRef danglingCountKey = JSStringCreateWithUTF8CString("danglingCount");
+    JSObjectSetProperty(ctx, resultObj, danglingCountKey, JSValueMakeNumber(ctx, static_cast<double>(result.danglingCount)), 0, nullptr);
+    JSStringRelease(danglingCountKey);
+
+    // Set unreferencedCount property
+    JSStringRef unreferencedCountKey = JSStringCreateWithUTF8CString("unreferencedCount");
+    JSObjectSetProperty(ctx, resultObj, unreferencedCountKey, JSValueMakeNumber(ctx, static_cast<double>(result.unreferencedCount)), 0, nullptr);
+    JSStringRelease(unreferencedCountKey);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtGetReferenceFindings(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtGetReferenceFindings called from JavaScript\n");
+
+    // Get kind from argument 1 (optional, empty matches all)
+    std::string kind;
+    if (argumentCount > 0) {
+        JSStringRef kindStr = JSValueToStringCopy(ctx, arguments[0], exception);
+        if (kindStr) {
+            size_t kindLength = JSStringGetMaximumUTF8CStringSize(kindStr);
+            char* kindBuffer = new char[kindLength];
+            JSStringGetUTF8CString(kindStr, kindBuffer, kindLength);
+            kind = std::string(kindBuffer);
+            delete[] kindBuffer;
+            JSStringRelease(kindStr);
+        }
+    }
+
+    // Get tableName from argument 2 (optional, empty matches all)
+    std::string tableName;
+    if (argumentCount > 1) {
+        JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[1], exception);
+        if (tableNameStr) {
+            size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
+            char* tableNameBuffer = new char[tableNameLength];
+            JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
+            tableName = std::string(tableNameBuffer);
+            delete[] tableNameBuffer;
+            JSStringRelease(tableNameStr);
+        }
+    }
 
-    OutputDebugStringA(("[JSBridge] Found " + std::to_string(entries.size()) + " large entries\n").c_str());
+    std::vector<Library::ReferenceFinding> findings = library_->dbtGetReferenceFindings(kind, tableName);
 
-    // Convert to JavaScript array of objects
-    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    JSObjectRef findingsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < findings.size(); i++) {
+        const auto& finding = findings[i];
+        JSObjectRef findingObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    for (size_t i = 0; i < entries.size(); i++) {
-        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
+        // Set tableName property
+        JSStringRef tableNameKey = JSStringCreateWithUTF8CString("tableName");
+        JSStringRef tableNameValue = JSStringCreateWithUTF8CString(finding.tableName.c_str());
+        JSObjectSetProperty(ctx, findingObj, tableNameKey, JSValueMakeString(ctx, tableNameValue), 0, nullptr);
+        JSStringRelease(tableNameKey);
+        JSStringRelease(tableNameValue);
 
         // Set id property
         JSStringRef idKey = JSStringCreateWithUTF8CString("id");
-        JSStringRef idValue = JSStringCreateWithUTF8CString(entries[i].id.c_str());
-        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRef idValue = JSStringCreateWithUTF8CString(finding.id.c_str());
+        JSObjectSetProperty(ctx, findingObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
         JSStringRelease(idKey);
         JSStringRelease(idValue);
 
-        // Set title property
-        JSStringRef titleKey = JSStringCreateWithUTF8CString("title");
-        JSStringRef titleValue = JSStringCreateWithUTF8CString(entries[i].title.c_str());
-        JSObjectSetProperty(ctx, entryObj, titleKey, JSValueMakeString(ctx, titleValue), 0, nullptr);
-        JSStringRelease(titleKey);
-        JSStringRelease(titleValue);
-
-        // Set sizeBytes property
-        JSStringRef sizeKey = JSStringCreateWithUTF8CString("sizeBytes");
-        JSObjectSetProperty(ctx, entryObj, sizeKey, JSValueMakeNumber(ctx, entries[i].sizeBytes), 0, nullptr);
-        JSStringRelease(sizeKey);
-
-        // Add to array
-        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, entryObj, nullptr);
+        // Set kind property
+        JSStringRef kindKey = JSStringCreateWithUTF8CString("kind");
+        JSStringRef kindValue = JSStringCreateWithUTF8CString(finding.kind.c_str());
+        JSObjectSetProperty(ctx, findingObj, kindKey, JSValueMakeString(ctx, kindValue), 0, nullptr);
+        JSStringRelease(kindKey);
+        JSStringRelease(kindValue);
+
+        // Set field property
+        JSStringRef fieldKey = JSStringCreateWithUTF8CString("field");
+        JSStringRef fieldValue = JSStringCreateWithUTF8CString(finding.field.c_str());
+        JSObjectSetProperty(ctx, findingObj, fieldKey, JSValueMakeString(ctx, fieldValue), 0, nullptr);
+        JSStringRelease(fieldKey);
+        JSStringRelease(fieldValue);
+
+        // Set targetTable property
+        JSStringRef targetTableKey = JSStringCreateWithUTF8CString("targetTable");
+        JSStringRef targetTableValue = JSStringCreateWithUTF8CString(finding.targetTable.c_str());
+        JSObjectSetProperty(ctx, findingObj, targetTableKey, JSValueMakeString(ctx, targetTableValue), 0, nullptr);
+        JSStringRelease(targetTableKey);
+        JSStringRelease(targetTableValue);
+
+        // Set targetId property
+        JSStringRef targetIdKey = JSStringCreateWithUTF8CString("targetId");
+        JSStringRef targetIdValue = JSStringCreateWithUTF8CString(finding.targetId.c_str());
+        JSObjectSetProperty(ctx, findingObj, targetIdKey, JSValueMakeString(ctx, targetIdValue), 0, nullptr);
+        JSStringRelease(targetIdKey);
+        JSStringRelease(targetIdValue);
+
+        JSObjectSetPropertyAtIndex(ctx, findingsArray, i, findingObj, nullptr);
     }
 
-    return resultsArray;
+    return findingsArray;
 }
 
-JSValueRef JSBridge::dbtTrimTextFields(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtFixDanglingReferences(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtTrimTextFields called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] dbtFixDanglingReferences called from JavaScript\n");
 
-    if (argumentCount < 3) {
-        OutputDebugStringA("[JSBridge] dbtTrimTextFields: Missing parameters (tableName, entryIds, maxLength)\n");
+    if (argumentCount < 2) {
+        OutputDebugStringA("[JSBridge] dbtFixDanglingReferences: Missing parameters (tableName, entryIds)\n");
         return JSValueMakeNull(ctx);
     }
 
     // Get table name from first argument
     JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
     if (!tableNameStr) {
-        OutputDebugStringA("[JSBridge] dbtTrimTextFields: Invalid table name parameter\n");
+        OutputDebugStringA("[JSBridge] dbtFixDanglingReferences: Invalid table name parameter\n");
         return JSValueMakeNull(ctx);
     }
 
@@ -1092,286 +4207,243 @@ JSValueRef JSBridge::dbtTrimTextFields(JSContextRef ctx, JSObjectRef function, J
     delete[] tableNameBuffer;
     JSStringRelease(tableNameStr);
 
-    // Get entryIds array from second argument
-    JSObjectRef entryIdsArray = JSValueToObject(ctx, arguments[1], exception);
-    if (!entryIdsArray) {
-        OutputDebugStringA("[JSBridge] dbtTrimTextFields: Invalid entryIds parameter\n");
-        return JSValueMakeNull(ctx);
-    }
-
-    // Get array length
-    JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
-    JSValueRef lengthValue = JSObjectGetProperty(ctx, entryIdsArray, lengthProp, exception);
-    JSStringRelease(lengthProp);
-    double lengthDouble = JSValueToNumber(ctx, lengthValue, exception);
-    size_t arrayLength = static_cast<size_t>(lengthDouble);
-
-    // Extract entry IDs from array
-    std::vector<std::string> entryIds;
-    for (size_t i = 0; i < arrayLength; i++) {
-        JSValueRef idValue = JSObjectGetPropertyAtIndex(ctx, entryIdsArray, i, exception);
-        JSStringRef idStr = JSValueToStringCopy(ctx, idValue, exception);
-        if (idStr) {
-            size_t idLength = JSStringGetMaximumUTF8CStringSize(idStr);
-            char* idBuffer = new char[idLength];
-            JSStringGetUTF8CString(idStr, idBuffer, idLength);
-            entryIds.push_back(std::string(idBuffer));
-            delete[] idBuffer;
-            JSStringRelease(idStr);
-        }
-    }
-
-    // Get max length from third argument
-    double maxLengthDouble = JSValueToNumber(ctx, arguments[2], exception);
-    int maxLength = static_cast<int>(maxLengthDouble);
-
-    if (maxLength <= 0) {
-        OutputDebugStringA("[JSBridge] dbtTrimTextFields: Invalid maxLength parameter\n");
-        return JSValueMakeNull(ctx);
-    }
-
-    OutputDebugStringA(("[JSBridge] Trimming text fields for " + std::to_string(entryIds.size()) + " entries to max " + std::to_string(maxLength) + " chars\n").c_str());
-
-    // Call Library method
-    std::vector<Library::TrimResult> results = library_->dbtTrimTextFields(tableName, entryIds, maxLength);
+    std::vector<std::string> entryIds = jsArrayToStrings(ctx, arguments[1], exception);
 
-    OutputDebugStringA(("[JSBridge] Trim operation completed for " + std::to_string(results.size()) + " entries\n").c_str());
+    std::vector<Library::PurgeResult> results = library_->dbtFixDanglingReferences(tableName, entryIds);
 
     // Convert to JavaScript array of objects
     JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
 
     for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+
+        // Create object for this result
         JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
         // Set id property
         JSStringRef idKey = JSStringCreateWithUTF8CString("id");
-        JSStringRef idValue = JSStringCreateWithUTF8CString(results[i].id.c_str());
+        JSStringRef idValue = JSStringCreateWithUTF8CString(result.id.c_str());
         JSObjectSetProperty(ctx, resultObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
         JSStringRelease(idKey);
         JSStringRelease(idValue);
 
         // Set success property
         JSStringRef successKey = JSStringCreateWithUTF8CString("success");
-        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, results[i].success), 0, nullptr);
+        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
         JSStringRelease(successKey);
 
         // Set error property
         JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
-        JSStringRef errorValue = JSStringCreateWithUTF8CString(results[i].error.c_str());
+        JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
         JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
         JSStringRelease(errorKey);
         JSStringRelease(errorValue);
 
-        // Add to array
+        // Add to results array
         JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
     }
 
     return resultsArray;
 }
 
-JSValueRef JSBridge::dbtGetDatabaseStats(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtGetDatabaseStats called from JavaScript\n");
-
-    // Get database stats from Library
-    Library::DatabaseStats stats = library_->dbtGetDatabaseStats();
-
-    OutputDebugStringA(("[JSBridge] Stats received: fragmentationPercent=" + std::to_string(stats.fragmentationPercent) +
-                       ", freePages=" + std::to_string(stats.freePages) +
-                       ", pageCount=" + std::to_string(stats.pageCount) + "\n").c_str());
-
-    // Convert to JavaScript object
-    JSObjectRef statsObj = JSObjectMake(ctx, nullptr, nullptr);
-
-    // Set filePath property
-    JSStringRef filePathKey = JSStringCreateWithUTF8CString("filePath");
-    JSStringRef filePathValue = JSStringCreateWithUTF8CString(stats.filePath.c_str());
-    JSObjectSetProperty(ctx, statsObj, filePathKey, JSValueMakeString(ctx, filePathValue), 0, nullptr);
-    JSStringRelease(filePathKey);
-    JSStringRelease(filePathValue);
-
-    // Set fileSizeBytes property
-    JSStringRef fileSizeBytesKey = JSStringCreateWithUTF8CString("fileSizeBytes");
-    JSObjectSetProperty(ctx, statsObj, fileSizeBytesKey, JSValueMakeNumber(ctx, stats.fileSizeBytes), 0, nullptr);
-    JSStringRelease(fileSizeBytesKey);
-
-    // Set pageCount property
-    JSStringRef pageCountKey = JSStringCreateWithUTF8CString("pageCount");
-    JSObjectSetProperty(ctx, statsObj, pageCountKey, JSValueMakeNumber(ctx, stats.pageCount), 0, nullptr);
-    JSStringRelease(pageCountKey);
-
-    // Set pageSize property
-    JSStringRef pageSizeKey = JSStringCreateWithUTF8CString("pageSize");
-    JSObjectSetProperty(ctx, statsObj, pageSizeKey, JSValueMakeNumber(ctx, stats.pageSize), 0, nullptr);
-    JSStringRelease(pageSizeKey);
-
-    // Set freePages property
-    JSStringRef freePagesKey = JSStringCreateWithUTF8CString("freePages");
-    JSObjectSetProperty(ctx, statsObj, freePagesKey, JSValueMakeNumber(ctx, stats.freePages), 0, nullptr);
-    JSStringRelease(freePagesKey);
-
-    // Set fragmentationPercent property
-    JSStringRef fragmentationPercentKey = JSStringCreateWithUTF8CString("fragmentationPercent");
-    JSObjectSetProperty(ctx, statsObj, fragmentationPercentKey, JSValueMakeNumber(ctx, stats.fragmentationPercent), 0, nullptr);
-    JSStringRelease(fragmentationPercentKey);
-
-    return statsObj;
-}
-
-JSValueRef JSBridge::dbtCompactDatabase(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtPurgeUnreferenced(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtCompactDatabase called from JavaScript\n");
-
-    // Call Library method
-    Library::CompactResult result = library_->dbtCompactDatabase();
-
-    OutputDebugStringA(("[JSBridge] Compact result: success=" + std::string(result.success ? "true" : "false") +
-                       ", saved=" + std::to_string(result.spaceSavedBytes) + " bytes\n").c_str());
-
-    // Convert to JavaScript object
-    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
-
-    // Set success property
-    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
-    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
-    JSStringRelease(successKey);
-
-    // Set error property
-    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
-    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
-    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
-    JSStringRelease(errorKey);
-    JSStringRelease(errorValue);
-
-    // Set beforeSizeBytes property
-    JSStringRef beforeSizeBytesKey = JSStringCreateWithUTF8CString("beforeSizeBytes");
-    JSObjectSetProperty(ctx, resultObj, beforeSizeBytesKey, JSValueMakeNumber(ctx, result.beforeSizeBytes), 0, nullptr);
-    JSStringRelease(beforeSizeBytesKey);
-
-    // Set afterSizeBytes property
-    JSStringRef afterSizeBytesKey = JSStringCreateWithUTF8CString("afterSizeBytes");
-    JSObjectSetProperty(ctx, resultObj, afterSizeBytesKey, JSValueMakeNumber(ctx, result.afterSizeBytes), 0, nullptr);
-    JSStringRelease(afterSizeBytesKey);
+    OutputDebugStringA("[JSBridge] dbtPurgeUnreferenced called from JavaScript\n");
 
-    // Set spaceSavedBytes property
-    JSStringRef spaceSavedBytesKey = JSStringCreateWithUTF8CString("spaceSavedBytes");
-    JSObjectSetProperty(ctx, resultObj, spaceSavedBytesKey, JSValueMakeNumber(ctx, result.spaceSavedBytes), 0, nullptr);
-    JSStringRelease(spaceSavedBytesKey);
+    if (argumentCount < 2) {
+        OutputDebugStringA("[JSBridge] dbtPurgeUnreferenced: Missing parameters (tableName, entryIds)\n");
+        return JSValueMakeNull(ctx);
+    }
 
-    return resultObj;
-}
+    // Get table name from first argument
+    JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!tableNameStr) {
+        OutputDebugStringA("[JSBridge] dbtPurgeUnreferenced: Invalid table name parameter\n");
+        return JSValueMakeNull(ctx);
+    }
 
-JSValueRef JSBridge::dbtFindAnomalousInstances(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
-    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtFindAnomalousInstances called from JavaScript\n");
+    size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
+    char* tableNameBuffer = new char[tableNameLength];
+    JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
+    std::string tableName(tableNameBuffer);
+    delete[] tableNameBuffer;
+    JSStringRelease(tableNameStr);
 
-    // Call Library method
-    std::vector<Library::AnomalousInstanceEntry> entries = library_->dbtFindAnomalousInstances();
+    std::vector<std::string> entryIds = jsArrayToStrings(ctx, arguments[1], exception);
 
-    OutputDebugStringA(("[JSBridge] Found " + std::to_string(entries.size()) + " anomalous instances\n").c_str());
+    std::vector<Library::PurgeResult> results = library_->dbtPurgeUnreferenced(tableName, entryIds);
 
     // Convert to JavaScript array of objects
     JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
 
-    for (size_t i = 0; i < entries.size(); i++) {
-        const auto& entry = entries[i];
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
 
-        // Create object for this entry
-        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
+        // Create object for this result
+        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
         // Set id property
         JSStringRef idKey = JSStringCreateWithUTF8CString("id");
-        JSStringRef idValue = JSStringCreateWithUTF8CString(entry.id.c_str());
-        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRef idValue = JSStringCreateWithUTF8CString(result.id.c_str());
+        JSObjectSetProperty(ctx, resultObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
         JSStringRelease(idKey);
         JSStringRelease(idValue);
 
-        // Set unexpectedKeys property (array of strings)
-        JSObjectRef unexpectedKeysArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
-        for (size_t j = 0; j < entry.unexpectedKeys.size(); j++) {
-            JSStringRef keyStr = JSStringCreateWithUTF8CString(entry.unexpectedKeys[j].c_str());
-            JSValueRef keyValue = JSValueMakeString(ctx, keyStr);
-            JSObjectSetPropertyAtIndex(ctx, unexpectedKeysArray, j, keyValue, nullptr);
-            JSStringRelease(keyStr);
-        }
-
-        JSStringRef unexpectedKeysKey = JSStringCreateWithUTF8CString("unexpectedKeys");
-        JSObjectSetProperty(ctx, entryObj, unexpectedKeysKey, unexpectedKeysArray, 0, nullptr);
-        JSStringRelease(unexpectedKeysKey);
-
-        // Set keyCount property
-        JSStringRef keyCountKey = JSStringCreateWithUTF8CString("keyCount");
-        JSObjectSetProperty(ctx, entryObj, keyCountKey, JSValueMakeNumber(ctx, entry.keyCount), 0, nullptr);
-        JSStringRelease(keyCountKey);
-
-        // Set generation property (integer)
-        JSStringRef generationKey = JSStringCreateWithUTF8CString("generation");
-        JSObjectSetProperty(ctx, entryObj, generationKey, JSValueMakeNumber(ctx, entry.generation), 0, nullptr);
-        JSStringRelease(generationKey);
+        // Set success property
+        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+        JSStringRelease(successKey);
 
-        // Set legacy property (integer)
-        JSStringRef legacyKey = JSStringCreateWithUTF8CString("legacy");
-        JSObjectSetProperty(ctx, entryObj, legacyKey, JSValueMakeNumber(ctx, entry.legacy), 0, nullptr);
-        JSStringRelease(legacyKey);
+        // Set error property
+        JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+        JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+        JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+        JSStringRelease(errorKey);
+        JSStringRelease(errorValue);
 
         // Add to results array
-        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, entryObj, nullptr);
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
     }
 
     return resultsArray;
 }
 
-JSValueRef JSBridge::dbtGetInstanceKeyValues(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtRunCleanupRules(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtGetInstanceKeyValues called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] dbtRunCleanupRules called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtRunCleanupRules: Missing parameters (rules, dryRun)\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    // Get rule text from first argument
+    JSStringRef rulesStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!rulesStr) {
+        OutputDebugStringA("[JSBridge] dbtRunCleanupRules: Invalid rules parameter\n");
+        return JSValueMakeNull(ctx);
+    }
+
+    size_t rulesLength = JSStringGetMaximumUTF8CStringSize(rulesStr);
+    char* rulesBuffer = new char[rulesLength];
+    JSStringGetUTF8CString(rulesStr, rulesBuffer, rulesLength);
+    std::string rulesText(rulesBuffer);
+    delete[] rulesBuffer;
+    JSStringRelease(rulesStr);
+
+    // Dry run unless explicitly disabled
+    bool dryRun = true;
+    if (argumentCount >= 2) {
+        dryRun = JSValueToBoolean(ctx, arguments[1]);
+    }
+
+    Library::CleanupResult result = library_->dbtRunCleanupRules(rulesText, dryRun);
+
+    JSObjectRef rulesArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < result.rules.size(); i++) {
+        const auto& report = result.rules[i];
+
+        JSObjectRef sampleIdsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        for (size_t k = 0; k < report.sampleIds.size(); k++) {
+            JSStringRef idValue = JSStringCreateWithUTF8CString(report.sampleIds[k].c_str());
+            JSObjectSetPropertyAtIndex(ctx, sampleIdsArray, k, JSValueMakeString(ctx, idValue), nullptr);
+            JSStringRelease(idValue);
+        }
 
-    if (argumentCount < 1) {
-        OutputDebugStringA("[JSBridge] dbtGetInstanceKeyValues: Missing parameter (instanceId)\n");
-        return JSValueMakeNull(ctx);
+        JSObjectRef ruleObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set rule property
+        JSStringRef ruleKey = JSStringCreateWithUTF8CString("rule");
+        JSStringRef ruleValue = JSStringCreateWithUTF8CString(report.rule.c_str());
+        JSObjectSetProperty(ctx, ruleObj, ruleKey, JSValueMakeString(ctx, ruleValue), 0, nullptr);
+        JSStringRelease(ruleKey);
+        JSStringRelease(ruleValue);
+
+        // Set tableName property
+        JSStringRef tableNameKey = JSStringCreateWithUTF8CString("tableName");
+        JSStringRef tableNameValue = JSStringCreateWithUTF8CString(report.tableName.c_str());
+        JSObjectSetProperty(ctx, ruleObj, tableNameKey, JSValueMakeString(ctx, tableNameValue), 0, nullptr);
+        JSStringRelease(tableNameKey);
+        JSStringRelease(tableNameValue);
+
+        // Set matched property
+        JSStringRef matchedKey = JSStringCreateWithUTF8CString("matched");
+        JSObjectSetProperty(ctx, ruleObj, matchedKey, JSValueMakeNumber(ctx, static_cast<double>(report.matched)), 0, nullptr);
+        JSStringRelease(matchedKey);
+
+        // Set applied property
+        JSStringRef appliedKey = JSStringCreateWithUTF8CString("applied");
+        JSObjectSetProperty(ctx, ruleObj, appliedKey, JSValueMakeNumber(ctx, static_cast<double>(report.applied)), 0, nullptr);
+        JSStringRelease(appliedKey);
+
+        // Set failed property
+        JSStringRef failedKey = JSStringCreateWithUTF8CString("failed");
+        JSObjectSetProperty(ctx, ruleObj, failedKey, JSValueMakeNumber(ctx, static_cast<double>(report.failed)), 0, nullptr);
+        JSStringRelease(failedKey);
+
+        // Set sampleIds property
+        JSStringRef sampleIdsKey = JSStringCreateWithUTF8CString("sampleIds");
+        JSObjectSetProperty(ctx, ruleObj, sampleIdsKey, sampleIdsArray, 0, nullptr);
+        JSStringRelease(sampleIdsKey);
+
+        JSObjectSetPropertyAtIndex(ctx, rulesArray, i, ruleObj, nullptr);
     }
 
-    // Get instance ID from first argument
-    JSStringRef instanceIdStr = JSValueToStringCopy(ctx, arguments[0], exception);
-    if (!instanceIdStr) {
-        OutputDebugStringA("[JSBridge] dbtGetInstanceKeyValues: Invalid instance ID parameter\n");
-        return JSValueMakeNull(ctx);
-    }
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    size_t instanceIdLength = JSStringGetMaximumUTF8CStringSize(instanceIdStr);
-    char* instanceIdBuffer = new char[instanceIdLength];
-    JSStringGetUTF8CString(instanceIdStr, instanceIdBuffer, instanceIdLength);
-    std::string instanceId(instanceIdBuffer);
-    delete[] instanceIdBuffer;
-    JSStringRelease(instanceIdStr);
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
 
-    OutputDebugStringA(("[JSBridge] Fetching KeyValues for instance " + instanceId + "\n").c_str());
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
 
-    // Call Library method
-    std::string plainText = library_->dbtGetInstanceKeyValues(instanceId);
+    // Set dryRun property
+    JSStringRef dryRunKey = JSStringCreateWithUTF8CString("dryRun");
+    JSObjectSetProperty(ctx, resultObj, dryRunKey, JSValueMakeBoolean(ctx, result.dryRun), 0, nullptr);
+    JSStringRelease(dryRunKey);
 
-    OutputDebugStringA(("[JSBridge] Retrieved KeyValues plain text (" + std::to_string(plainText.length()) + " chars)\n").c_str());
+    // Set rowsScanned property
+    JSStringRef rowsScannedKey = JSStringCreateWithUTF8CString("rowsScanned");
+    JSObjectSetProperty(ctx, resultObj, rowsScannedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsScanned)), 0, nullptr);
+    JSStringRelease(rowsScannedKey);
 
-    // Convert to JavaScript string
-    JSStringRef resultStr = JSStringCreateWithUTF8CString(plainText.c_str());
-    JSValueRef result = JSValueMakeString(ctx, resultStr);
-    JSStringRelease(resultStr);
+    // Set entriesChanged property
+    JSStringRef entriesChangedKey = JSStringCreateWithUTF8CString("entriesChanged");
+    JSObjectSetProperty(ctx, resultObj, entriesChangedKey, JSValueMakeNumber(ctx, static_cast<double>(result.entriesChanged)), 0, nullptr);
+    JSStringRelease(entriesChangedKey);
 
-    return result;
+    // Set entriesDeleted property
+    JSStringRef entriesDeletedKey = JSStringCreateWithUTF8CString("entriesDeleted");
+    JSObjectSetProperty(ctx, resultObj, entriesDeletedKey, JSValueMakeNumber(ctx, static_cast<double>(result.entriesDeleted)), 0, nullptr);
+    JSStringRelease(entriesDeletedKey);
+
+    // Set rules property
+    JSStringRef rulesKey = JSStringCreateWithUTF8CString("rules");
+    JSObjectSetProperty(ctx, resultObj, rulesKey, rulesArray, 0, nullptr);
+    JSStringRelease(rulesKey);
+
+    return resultObj;
 }
 
-JSValueRef JSBridge::dbtGetEntryKeyValues(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtReplaceInFields(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtGetEntryKeyValues called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] dbtReplaceInFields called from JavaScript\n");
 
-    if (argumentCount < 2) {
-        OutputDebugStringA("[JSBridge] dbtGetEntryKeyValues: Missing parameters (tableName, entryId)\n");
+    if (argumentCount < 4) {
+        OutputDebugStringA("[JSBridge] dbtReplaceInFields: Missing parameters (tableName, pathGlob, find, replace, [regex])\n");
         return JSValueMakeNull(ctx);
     }
 
     // Get table name from first argument
     JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[0], exception);
     if (!tableNameStr) {
-        OutputDebugStringA("[JSBridge] dbtGetEntryKeyValues: Invalid table name parameter\n");
+        OutputDebugStringA("[JSBridge] dbtReplaceInFields: Invalid table name parameter\n");
         return JSValueMakeNull(ctx);
     }
 
@@ -1382,377 +4454,716 @@ JSValueRef JSBridge::dbtGetEntryKeyValues(JSContextRef ctx, JSObjectRef function
     delete[] tableNameBuffer;
     JSStringRelease(tableNameStr);
 
-    // Get entry ID from second argument
-    JSStringRef entryIdStr = JSValueToStringCopy(ctx, arguments[1], exception);
-    if (!entryIdStr) {
-        OutputDebugStringA("[JSBridge] dbtGetEntryKeyValues: Invalid entry ID parameter\n");
+    // Field paths, e.g. "screen,marquee,file"
+    JSStringRef pathGlobStr = JSValueToStringCopy(ctx, arguments[1], exception);
+    if (!pathGlobStr) {
+        OutputDebugStringA("[JSBridge] dbtReplaceInFields: Invalid path glob parameter\n");
         return JSValueMakeNull(ctx);
     }
 
-    size_t entryIdLength = JSStringGetMaximumUTF8CStringSize(entryIdStr);
-    char* entryIdBuffer = new char[entryIdLength];
-    JSStringGetUTF8CString(entryIdStr, entryIdBuffer, entryIdLength);
-    std::string entryId(entryIdBuffer);
-    delete[] entryIdBuffer;
-    JSStringRelease(entryIdStr);
+    size_t pathGlobLength = JSStringGetMaximumUTF8CStringSize(pathGlobStr);
+    char* pathGlobBuffer = new char[pathGlobLength];
+    JSStringGetUTF8CString(pathGlobStr, pathGlobBuffer, pathGlobLength);
+    std::string pathGlob(pathGlobBuffer);
+    delete[] pathGlobBuffer;
+    JSStringRelease(pathGlobStr);
+
+    // Text (or pattern) to find
+    JSStringRef findStr = JSValueToStringCopy(ctx, arguments[2], exception);
+    if (!findStr) {
+        OutputDebugStringA("[JSBridge] dbtReplaceInFields: Invalid find parameter\n");
+        return JSValueMakeNull(ctx);
+    }
 
-    OutputDebugStringA(("[JSBridge] Fetching KeyValues for entry " + entryId + " from table " + tableName + "\n").c_str());
+    size_t findLength = JSStringGetMaximumUTF8CStringSize(findStr);
+    char* findBuffer = new char[findLength];
+    JSStringGetUTF8CString(findStr, findBuffer, findLength);
+    std::string find(findBuffer);
+    delete[] findBuffer;
+    JSStringRelease(findStr);
+
+    // Replacement text
+    JSStringRef replaceStr = JSValueToStringCopy(ctx, arguments[3], exception);
+    if (!replaceStr) {
+        OutputDebugStringA("[JSBridge] dbtReplaceInFields: Invalid replace parameter\n");
+        return JSValueMakeNull(ctx);
+    }
 
-    // Call Library method
-    std::string plainText = library_->dbtGetEntryKeyValues(tableName, entryId);
+    size_t replaceLength = JSStringGetMaximumUTF8CStringSize(replaceStr);
+    char* replaceBuffer = new char[replaceLength];
+    JSStringGetUTF8CString(replaceStr, replaceBuffer, replaceLength);
+    std::string replace(replaceBuffer);
+    delete[] replaceBuffer;
+    JSStringRelease(replaceStr);
 
-    OutputDebugStringA(("[JSBridge] Retrieved KeyValues plain text (" + std::to_string(plainText.length()) + " chars)\n").c_str());
+    bool useRegex = false;
+    if (argumentCount >= 5) {
+        useRegex = JSValueToBoolean(ctx, arguments[4]);
+    }
 
-    // Convert to JavaScript string
-    JSStringRef resultStr = JSStringCreateWithUTF8CString(plainText.c_str());
-    JSValueRef result = JSValueMakeString(ctx, resultStr);
-    JSStringRelease(resultStr);
+    Library::ReplaceResult result = library_->dbtReplaceInFields(tableName, pathGlob, find, replace, useRegex);
 
-    return result;
+    JSObjectRef fieldsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < result.fields.size(); i++) {
+        JSObjectRef fieldObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set path property
+        JSStringRef pathKey = JSStringCreateWithUTF8CString("path");
+        JSStringRef pathValue = JSStringCreateWithUTF8CString(result.fields[i].path.c_str());
+        JSObjectSetProperty(ctx, fieldObj, pathKey, JSValueMakeString(ctx, pathValue), 0, nullptr);
+        JSStringRelease(pathKey);
+        JSStringRelease(pathValue);
+
+        // Set rowsChanged property
+        JSStringRef rowsChangedKey = JSStringCreateWithUTF8CString("rowsChanged");
+        JSObjectSetProperty(ctx, fieldObj, rowsChangedKey, JSValueMakeNumber(ctx, static_cast<double>(result.fields[i].rowsChanged)), 0, nullptr);
+        JSStringRelease(rowsChangedKey);
+
+        JSObjectSetPropertyAtIndex(ctx, fieldsArray, i, fieldObj, nullptr);
+    }
+
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set rowsScanned property
+    JSStringRef rowsScannedKey = JSStringCreateWithUTF8CString("rowsScanned");
+    JSObjectSetProperty(ctx, resultObj, rowsScannedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsScanned)), 0, nullptr);
+    JSStringRelease(rowsScannedKey);
+
+    // Set rowsChanged property
+    JSStringRef rowsChangedKey = JSStringCreateWithUTF8CString("rowsChanged");
+    JSObjectSetProperty(ctx, resultObj, rowsChangedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsChanged)), 0, nullptr);
+    JSStringRelease(rowsChangedKey);
+
+    // Set fields property
+    JSStringRef fieldsKey = JSStringCreateWithUTF8CString("fields");
+    JSObjectSetProperty(ctx, resultObj, fieldsKey, fieldsArray, 0, nullptr);
+    JSStringRelease(fieldsKey);
+
+    return resultObj;
 }
 
-JSValueRef JSBridge::dbtRemoveAnomalousKeys(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtGetInstanceGenerations(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtRemoveAnomalousKeys called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] dbtGetInstanceGenerations called from JavaScript\n");
 
-    if (argumentCount < 1) {
-        OutputDebugStringA("[JSBridge] dbtRemoveAnomalousKeys: Missing parameter (instanceIds array)\n");
-        return JSValueMakeNull(ctx);
-    }
+    Library::GenerationCensus census = library_->dbtGetInstanceGenerations();
 
-    // Get instance IDs array from first argument
-    JSObjectRef entryIdsArray = JSValueToObject(ctx, arguments[0], exception);
-    if (!entryIdsArray) {
-        OutputDebugStringA("[JSBridge] dbtRemoveAnomalousKeys: Invalid instanceIds array parameter\n");
-        return JSValueMakeNull(ctx);
+    JSObjectRef generationsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < census.generations.size(); i++) {
+        JSObjectRef generationObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        // Set generation property
+        JSStringRef generationKey = JSStringCreateWithUTF8CString("generation");
+        JSObjectSetProperty(ctx, generationObj, generationKey, JSValueMakeNumber(ctx, census.generations[i].generation), 0, nullptr);
+        JSStringRelease(generationKey);
+
+        // Set count property
+        JSStringRef countKey = JSStringCreateWithUTF8CString("count");
+        JSObjectSetProperty(ctx, generationObj, countKey, JSValueMakeNumber(ctx, static_cast<double>(census.generations[i].count)), 0, nullptr);
+        JSStringRelease(countKey);
+
+        JSObjectSetPropertyAtIndex(ctx, generationsArray, i, generationObj, nullptr);
     }
 
-    // Get array length
-    JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
-    JSValueRef lengthValue = JSObjectGetProperty(ctx, entryIdsArray, lengthProp, exception);
-    JSStringRelease(lengthProp);
-    double arrayLength = JSValueToNumber(ctx, lengthValue, exception);
+    JSObjectRef migrationsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < census.migrations.size(); i++) {
+        JSObjectRef migrationObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    // Extract instance IDs from array
-    std::vector<std::string> instanceIds;
-    for (size_t i = 0; i < arrayLength; i++) {
-        JSValueRef idValue = JSObjectGetPropertyAtIndex(ctx, entryIdsArray, i, exception);
-        JSStringRef idStr = JSValueToStringCopy(ctx, idValue, exception);
-        if (idStr) {
-            size_t idLength = JSStringGetMaximumUTF8CStringSize(idStr);
-            char* idBuffer = new char[idLength];
-            JSStringGetUTF8CString(idStr, idBuffer, idLength);
-            instanceIds.push_back(std::string(idBuffer));
-            delete[] idBuffer;
-            JSStringRelease(idStr);
-        }
+        // Set fromGeneration property
+        JSStringRef fromGenerationKey = JSStringCreateWithUTF8CString("fromGeneration");
+        JSObjectSetProperty(ctx, migrationObj, fromGenerationKey, JSValueMakeNumber(ctx, census.migrations[i].first), 0, nullptr);
+        JSStringRelease(fromGenerationKey);
+
+        // Set name property
+        JSStringRef nameKey = JSStringCreateWithUTF8CString("name");
+        JSStringRef nameValue = JSStringCreateWithUTF8CString(census.migrations[i].second.c_str());
+        JSObjectSetProperty(ctx, migrationObj, nameKey, JSValueMakeString(ctx, nameValue), 0, nullptr);
+        JSStringRelease(nameKey);
+        JSStringRelease(nameValue);
+
+        JSObjectSetPropertyAtIndex(ctx, migrationsArray, i, migrationObj, nullptr);
     }
 
-    OutputDebugStringA(("[JSBridge] Removing anomalous keys from " + std::to_string(instanceIds.size()) + " instances\n").c_str());
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    // Call Library method
-    std::vector<Library::RemoveKeysResult> results = library_->dbtRemoveAnomalousKeys(instanceIds);
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, census.success), 0, nullptr);
+    JSStringRelease(successKey);
 
-    OutputDebugStringA(("[JSBridge] Remove operation completed for " + std::to_string(results.size()) + " instances\n").c_str());
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(census.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
 
-    // Convert to JavaScript array of objects
-    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    // Set targetGeneration property
+    JSStringRef targetGenerationKey = JSStringCreateWithUTF8CString("targetGeneration");
+    JSObjectSetProperty(ctx, resultObj, targetGenerationKey, JSValueMakeNumber(ctx, census.targetGeneration), 0, nullptr);
+    JSStringRelease(targetGenerationKey);
 
-    for (size_t i = 0; i < results.size(); i++) {
-        const auto& result = results[i];
+    // Set rowsScanned property
+    JSStringRef rowsScannedKey = JSStringCreateWithUTF8CString("rowsScanned");
+    JSObjectSetProperty(ctx, resultObj, rowsScannedKey, JSValueMakeNumber(ctx, static_cast<double>(census.rowsScanned)), 0, nullptr);
+    JSStringRelease(rowsScannedKey);
 
-        // Create object for this result
-        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+    // Set pendingRows property
+    JSStringRef pendingRowsKey = JSStringCreateWithUTF8CString("pendingRows");
+    JSObjectSetProperty(ctx, resultObj, pendingRowsKey, JSValueMakeNumber(ctx, static_cast<double>(census.pendingRows)), 0, nullptr);
+    JSStringRelease(pendingRowsKey);
+
+    // Set lazyMigration property
+    JSStringRef lazyMigrationKey = JSStringCreateWithUTF8CString("lazyMigration");
+    JSObjectSetProperty(ctx, resultObj, lazyMigrationKey, JSValueMakeBoolean(ctx, config_->getLazyInstanceMigration()), 0, nullptr);
+    JSStringRelease(lazyMigrationKey);
+
+    // Set generations property
+    JSStringRef generationsKey = JSStringCreateWithUTF8CString("generations");
+    JSObjectSetProperty(ctx, resultObj, generationsKey, generationsArray, 0, nullptr);
+    JSStringRelease(generationsKey);
+
+    // Set migrations property
+    JSStringRef migrationsKey = JSStringCreateWithUTF8CString("migrations");
+    JSObjectSetProperty(ctx, resultObj, migrationsKey, migrationsArray, 0, nullptr);
+    JSStringRelease(migrationsKey);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtMigrateInstances(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtMigrateInstances called from JavaScript\n");
+
+    Library::MigrationResult result = library_->dbtMigrateInstances();
+
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set targetGeneration property
+    JSStringRef targetGenerationKey = JSStringCreateWithUTF8CString("targetGeneration");
+    JSObjectSetProperty(ctx, resultObj, targetGenerationKey, JSValueMakeNumber(ctx, result.targetGeneration), 0, nullptr);
+    JSStringRelease(targetGenerationKey);
+
+    // Set rowsScanned property
+    JSStringRef rowsScannedKey = JSStringCreateWithUTF8CString("rowsScanned");
+    JSObjectSetProperty(ctx, resultObj, rowsScannedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsScanned)), 0, nullptr);
+    JSStringRelease(rowsScannedKey);
+
+    // Set rowsUpgraded property
+    JSStringRef rowsUpgradedKey = JSStringCreateWithUTF8CString("rowsUpgraded");
+    JSObjectSetProperty(ctx, resultObj, rowsUpgradedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsUpgraded)), 0, nullptr);
+    JSStringRelease(rowsUpgradedKey);
+
+    // Set rowsFailed property
+    JSStringRef rowsFailedKey = JSStringCreateWithUTF8CString("rowsFailed");
+    JSObjectSetProperty(ctx, resultObj, rowsFailedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsFailed)), 0, nullptr);
+    JSStringRelease(rowsFailedKey);
+
+    // Set pendingRows property
+    JSStringRef pendingRowsKey = JSStringCreateWithUTF8CString("pendingRows");
+    JSObjectSetProperty(ctx, resultObj, pendingRowsKey, JSValueMakeNumber(ctx, static_cast<double>(result.pendingRows)), 0, nullptr);
+    JSStringRelease(pendingRowsKey);
+
+    return resultObj;
+}
+
+JSValueRef JSBridge::dbtSetLazyMigration(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtSetLazyMigration called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtSetLazyMigration: Missing enabled parameter\n");
+        return JSValueMakeBoolean(ctx, false);
+    }
+
+    // For this session only; lazy_instance_migration in config.ini sets the startup value
+    config_->setLazyInstanceMigration(JSValueToBoolean(ctx, arguments[0]));
+    return JSValueMakeBoolean(ctx, true);
+}
+
+// Helper function to convert an undo result to a JavaScript object
+JSObjectRef JSBridge::undoResultToJSObject(JSContextRef ctx, const Library::UndoResult& result) {
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+
+    // Set success property
+    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+    JSStringRelease(successKey);
+
+    // Set error property
+    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
+    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
+    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
+    JSStringRelease(errorKey);
+    JSStringRelease(errorValue);
+
+    // Set recordsReplayed property
+    JSStringRef recordsReplayedKey = JSStringCreateWithUTF8CString("recordsReplayed");
+    JSObjectSetProperty(ctx, resultObj, recordsReplayedKey, JSValueMakeNumber(ctx, static_cast<double>(result.recordsReplayed)), 0, nullptr);
+    JSStringRelease(recordsReplayedKey);
+
+    // Set rowsRestored property
+    JSStringRef rowsRestoredKey = JSStringCreateWithUTF8CString("rowsRestored");
+    JSObjectSetProperty(ctx, resultObj, rowsRestoredKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsRestored)), 0, nullptr);
+    JSStringRelease(rowsRestoredKey);
+
+    // Set rowsDeleted property
+    JSStringRef rowsDeletedKey = JSStringCreateWithUTF8CString("rowsDeleted");
+    JSObjectSetProperty(ctx, resultObj, rowsDeletedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsDeleted)), 0, nullptr);
+    JSStringRelease(rowsDeletedKey);
+
+    // Set rowsSkipped property
+    JSStringRef rowsSkippedKey = JSStringCreateWithUTF8CString("rowsSkipped");
+    JSObjectSetProperty(ctx, resultObj, rowsSkippedKey, JSValueMakeNumber(ctx, static_cast<double>(result.rowsSkipped)), 0, nullptr);
+    JSStringRelease(rowsSkippedKey);
+
+    // Set skippedRows property: [{ tableName, id }, ...]
+    JSObjectRef skippedArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < result.skippedRows.size(); i++) {
+        JSObjectRef rowObj = JSObjectMake(ctx, nullptr, nullptr);
+
+        JSStringRef tableNameKey = JSStringCreateWithUTF8CString("tableName");
+        JSStringRef tableNameValue = JSStringCreateWithUTF8CString(result.skippedRows[i].tableName.c_str());
+        JSObjectSetProperty(ctx, rowObj, tableNameKey, JSValueMakeString(ctx, tableNameValue), 0, nullptr);
+        JSStringRelease(tableNameKey);
+        JSStringRelease(tableNameValue);
 
-        // Set id property
         JSStringRef idKey = JSStringCreateWithUTF8CString("id");
-        JSStringRef idValue = JSStringCreateWithUTF8CString(result.id.c_str());
-        JSObjectSetProperty(ctx, resultObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
+        JSStringRef idValue = JSStringCreateWithUTF8CString(result.skippedRows[i].id.c_str());
+        JSObjectSetProperty(ctx, rowObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
         JSStringRelease(idKey);
         JSStringRelease(idValue);
 
-        // Set success property
-        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
-        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
-        JSStringRelease(successKey);
+        JSObjectSetPropertyAtIndex(ctx, skippedArray, static_cast<unsigned>(i), rowObj, nullptr);
+    }
+    JSStringRef skippedRowsKey = JSStringCreateWithUTF8CString("skippedRows");
+    JSObjectSetProperty(ctx, resultObj, skippedRowsKey, skippedArray, 0, nullptr);
+    JSStringRelease(skippedRowsKey);
 
-        // Set error property
-        JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
-        JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
-        JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
-        JSStringRelease(errorKey);
-        JSStringRelease(errorValue);
+    return resultObj;
+}
 
-        // Add to results array
-        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
+JSValueRef JSBridge::jobUndo(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] jobUndo called from JavaScript\n");
+
+    if (!jobManager_ || argumentCount < 1) {
+        return JSValueMakeNull(ctx);
     }
 
-    return resultsArray;
+    int jobId = static_cast<int>(JSValueToNumber(ctx, arguments[0], exception));
+
+    // The job's journal is still growing while it can run
+    JobManager::JobStatus status = jobManager_->getJobStatus(jobId, false);
+    if (status.status == "queued" || status.status == "running" || status.status == "paused") {
+        Library::UndoResult result;
+        result.success = false;
+        result.error = "Job " + std::to_string(jobId) + " is " + status.status + "; cancel it before undoing";
+        result.recordsReplayed = 0;
+        result.rowsRestored = 0;
+        result.rowsDeleted = 0;
+        result.rowsSkipped = 0;
+        return undoResultToJSObject(ctx, result);
+    }
+
+    return undoResultToJSObject(ctx, library_->dbtUndoJob(jobId));
 }
 
-JSValueRef JSBridge::dbtFindEmptyInstances(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtListUndoJournals(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtFindEmptyInstances called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] dbtListUndoJournals called from JavaScript\n");
 
-    // Call Library method
-    std::vector<Library::EmptyInstanceEntry> entries = library_->dbtFindEmptyInstances();
+    std::vector<Library::UndoJournalInfo> journals = library_->dbtListUndoJournals();
 
-    OutputDebugStringA(("[JSBridge] Found " + std::to_string(entries.size()) + " empty instances\n").c_str());
+    JSObjectRef journalsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    for (size_t i = 0; i < journals.size(); i++) {
+        JSObjectRef journalObj = JSObjectMake(ctx, nullptr, nullptr);
 
-    // Convert to JavaScript array of objects
-    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+        // Set name property
+        JSStringRef nameKey = JSStringCreateWithUTF8CString("name");
+        JSStringRef nameValue = JSStringCreateWithUTF8CString(journals[i].name.c_str());
+        JSObjectSetProperty(ctx, journalObj, nameKey, JSValueMakeString(ctx, nameValue), 0, nullptr);
+        JSStringRelease(nameKey);
+        JSStringRelease(nameValue);
 
-    for (size_t i = 0; i < entries.size(); i++) {
-        const auto& entry = entries[i];
+        // Set sizeBytes property
+        JSStringRef sizeBytesKey = JSStringCreateWithUTF8CString("sizeBytes");
+        JSObjectSetProperty(ctx, journalObj, sizeBytesKey, JSValueMakeNumber(ctx, static_cast<double>(journals[i].sizeBytes)), 0, nullptr);
+        JSStringRelease(sizeBytesKey);
 
-        // Create object for this entry
-        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
+        // Set modifiedTime property
+        JSStringRef modifiedTimeKey = JSStringCreateWithUTF8CString("modifiedTime");
+        JSObjectSetProperty(ctx, journalObj, modifiedTimeKey, JSValueMakeNumber(ctx, static_cast<double>(journals[i].modifiedTime)), 0, nullptr);
+        JSStringRelease(modifiedTimeKey);
 
-        // Set id property
-        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
-        JSStringRef idValue = JSStringCreateWithUTF8CString(entry.id.c_str());
-        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
-        JSStringRelease(idKey);
-        JSStringRelease(idValue);
+        JSObjectSetPropertyAtIndex(ctx, journalsArray, i, journalObj, nullptr);
+    }
 
-        // Set objectCount property
-        JSStringRef objectCountKey = JSStringCreateWithUTF8CString("objectCount");
-        JSObjectSetProperty(ctx, entryObj, objectCountKey, JSValueMakeNumber(ctx, entry.objectCount), 0, nullptr);
-        JSStringRelease(objectCountKey);
+    return journalsArray;
+}
 
-        // Set hasObjectsKey property
-        JSStringRef hasObjectsKeyKey = JSStringCreateWithUTF8CString("hasObjectsKey");
-        JSObjectSetProperty(ctx, entryObj, hasObjectsKeyKey, JSValueMakeBoolean(ctx, entry.hasObjectsKey), 0, nullptr);
-        JSStringRelease(hasObjectsKeyKey);
+JSValueRef JSBridge::dbtUndoJournal(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] dbtUndoJournal called from JavaScript\n");
+
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] dbtUndoJournal: Missing journal name parameter\n");
+        return JSValueMakeNull(ctx);
+    }
 
-        // Add to results array
-        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, entryObj, nullptr);
+    // Journal name, e.g. "job-12" or "trimTextFields-1760000000"
+    JSStringRef nameStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!nameStr) {
+        OutputDebugStringA("[JSBridge] dbtUndoJournal: Invalid name parameter\n");
+        return JSValueMakeNull(ctx);
     }
 
-    return resultsArray;
+    size_t nameLength = JSStringGetMaximumUTF8CStringSize(nameStr);
+    char* nameBuffer = new char[nameLength];
+    JSStringGetUTF8CString(nameStr, nameBuffer, nameLength);
+    std::string name(nameBuffer);
+    delete[] nameBuffer;
+    JSStringRelease(nameStr);
+
+    return undoResultToJSObject(ctx, library_->dbtUndoJournal(name));
 }
 
-JSValueRef JSBridge::dbtPurgeEmptyInstances(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::dbtDeleteUndoJournal(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtPurgeEmptyInstances called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] dbtDeleteUndoJournal called from JavaScript\n");
 
     if (argumentCount < 1) {
-        OutputDebugStringA("[JSBridge] dbtPurgeEmptyInstances: Missing parameter (instanceIds array)\n");
-        return JSValueMakeNull(ctx);
+        OutputDebugStringA("[JSBridge] dbtDeleteUndoJournal: Missing journal name parameter\n");
+        return JSValueMakeBoolean(ctx, false);
     }
 
-    // Get instance IDs array from first argument
-    JSObjectRef entryIdsArray = JSValueToObject(ctx, arguments[0], exception);
-    if (!entryIdsArray) {
-        OutputDebugStringA("[JSBridge] dbtPurgeEmptyInstances: Invalid instanceIds array parameter\n");
+    // Journal to discard
+    JSStringRef nameStr = JSValueToStringCopy(ctx, arguments[0], exception);
+    if (!nameStr) {
+        OutputDebugStringA("[JSBridge] dbtDeleteUndoJournal: Invalid name parameter\n");
         return JSValueMakeNull(ctx);
     }
 
-    // Get array length
-    JSStringRef lengthProp = JSStringCreateWithUTF8CString("length");
-    JSValueRef lengthValue = JSObjectGetProperty(ctx, entryIdsArray, lengthProp, exception);
-    JSStringRelease(lengthProp);
-    double arrayLength = JSValueToNumber(ctx, lengthValue, exception);
+    size_t nameLength = JSStringGetMaximumUTF8CStringSize(nameStr);
+    char* nameBuffer = new char[nameLength];
+    JSStringGetUTF8CString(nameStr, nameBuffer, nameLength);
+    std::string name(nameBuffer);
+    delete[] nameBuffer;
+    JSStringRelease(nameStr);
 
-    // Extract instance IDs from array
-    std::vector<std::string> instanceIds;
-    for (size_t i = 0; i < arrayLength; i++) {
-        JSValueRef idValue = JSObjectGetPropertyAtIndex(ctx, entryIdsArray, i, exception);
-        JSStringRef idStr = JSValueToStringCopy(ctx, idValue, exception);
-        if (idStr) {
-            size_t idLength = JSStringGetMaximumUTF8CStringSize(idStr);
-            char* idBuffer = new char[idLength];
-            JSStringGetUTF8CString(idStr, idBuffer, idLength);
-            instanceIds.push_back(std::string(idBuffer));
-            delete[] idBuffer;
-            JSStringRelease(idStr);
-        }
+    return JSValueMakeBoolean(ctx, library_->dbtDeleteUndoJournal(name));
+}
+
+JSValueRef JSBridge::getImageCacheLayout(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getImageCacheLayout called from JavaScript\n");
+
+    // The layout the image cache writes new files in ("v2" or "kodi"), for predicting cache paths
+    ImageCacheIndex::Layout layout = ImageCacheIndex::layoutFromName(config_->getImageCacheLayout());
+    JSStringRef layoutStr = JSStringCreateWithUTF8CString(layout == ImageCacheIndex::LAYOUT_KODI ? "kodi" : "v2");
+    JSValueRef result = JSValueMakeString(ctx, layoutStr);
+    JSStringRelease(layoutStr);
+    return result;
+}
+
+JSValueRef JSBridge::reprioritizeImages(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] reprioritizeImages called from JavaScript\n");
+
+    if (argumentCount < 2) {
+        OutputDebugStringA("[JSBridge] reprioritizeImages: Missing parameters (urls, priority)\n");
+        return JSValueMakeNumber(ctx, 0);
     }
 
-    OutputDebugStringA(("[JSBridge] Purging " + std::to_string(instanceIds.size()) + " instances\n").c_str());
+    // Only jobs that have not started are reprioritized. "cancel" takes the requestId of the
+    // getCacheImage(s) promise and rejects only that request; other callers of the URLs keep waiting
+    std::vector<std::string> urls = jsArrayToStrings(ctx, arguments[0], exception);
+    int priority = jsValueToImagePriority(ctx, arguments[1], exception);
+    if (priority >= 0) {
+        return JSValueMakeNumber(ctx, library_->reprioritizeImages(urls, priority));
+    }
 
-    // Call Library method
-    std::vector<Library::PurgeResult> results = library_->dbtPurgeEmptyInstances(instanceIds);
+    if (argumentCount < 3 || !JSValueIsNumber(ctx, arguments[2])) {
+        OutputDebugStringA("[JSBridge] reprioritizeImages: cancel needs the requestId of the request\n");
+        return JSValueMakeNumber(ctx, 0);
+    }
+    uint64_t requestId = static_cast<uint64_t>(JSValueToNumber(ctx, arguments[2], exception));
+    return JSValueMakeNumber(ctx, library_->cancelImages(urls, requestId));
+}
 
-    OutputDebugStringA(("[JSBridge] Purge operation completed for " + std::to_string(results.size()) + " instances\n").c_str());
+JSValueRef JSBridge::getImageCompletionStats(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getImageCompletionStats called from JavaScript\n");
 
-    // Convert to JavaScript array of objects
-    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+    // How completions reach the page ("push" or "poll") and their enqueue-to-callback latency
+    ImageCompletionStats stats = {};
+    bool pushing = false;
+    if (imageLoader_) {
+        stats = imageLoader_->getCompletionStats();
+        pushing = imageLoader_->isPushingCompletions();
+    }
 
-    for (size_t i = 0; i < results.size(); i++) {
-        const auto& result = results[i];
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
 
-        // Create object for this result
-        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+    JSStringRef deliveryKey = JSStringCreateWithUTF8CString("delivery");
+    JSStringRef deliveryValue = JSStringCreateWithUTF8CString(pushing ? "push" : "poll");
+    JSObjectSetProperty(ctx, resultObj, deliveryKey, JSValueMakeString(ctx, deliveryValue), 0, nullptr);
+    JSStringRelease(deliveryKey);
+    JSStringRelease(deliveryValue);
 
-        // Set id property
-        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
-        JSStringRef idValue = JSStringCreateWithUTF8CString(result.id.c_str());
-        JSObjectSetProperty(ctx, resultObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
-        JSStringRelease(idKey);
-        JSStringRelease(idValue);
+    JSStringRef deliveredKey = JSStringCreateWithUTF8CString("delivered");
+    JSObjectSetProperty(ctx, resultObj, deliveredKey, JSValueMakeNumber(ctx, static_cast<double>(stats.delivered)), 0, nullptr);
+    JSStringRelease(deliveredKey);
 
-        // Set success property
-        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
-        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
-        JSStringRelease(successKey);
+    JSStringRef batchesKey = JSStringCreateWithUTF8CString("batches");
+    JSObjectSetProperty(ctx, resultObj, batchesKey, JSValueMakeNumber(ctx, static_cast<double>(stats.batches)), 0, nullptr);
+    JSStringRelease(batchesKey);
 
-        // Set error property
-        JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
-        JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
-        JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
-        JSStringRelease(errorKey);
-        JSStringRelease(errorValue);
+    double averageMs = stats.delivered > 0 ? stats.totalLatencyMs / stats.delivered : 0.0;
+    JSStringRef averageKey = JSStringCreateWithUTF8CString("averageLatencyMs");
+    JSObjectSetProperty(ctx, resultObj, averageKey, JSValueMakeNumber(ctx, averageMs), 0, nullptr);
+    JSStringRelease(averageKey);
 
-        // Add to results array
-        JSObjectSetPropertyAtIndex(ctx, resultsArray, i, resultObj, nullptr);
-    }
+    JSStringRef maxKey = JSStringCreateWithUTF8CString("maxLatencyMs");
+    JSObjectSetProperty(ctx, resultObj, maxKey, JSValueMakeNumber(ctx, stats.maxLatencyMs), 0, nullptr);
+    JSStringRelease(maxKey);
 
-    return resultsArray;
+    return resultObj;
 }
 
-JSValueRef JSBridge::dbtMergeDatabase(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+JSValueRef JSBridge::getImageMemoryCacheStats(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
-    OutputDebugStringA("[JSBridge] dbtMergeDatabase called from JavaScript\n");
+    OutputDebugStringA("[JSBridge] getImageMemoryCacheStats called from JavaScript\n");
 
-    if (argumentCount < 4) {
-        OutputDebugStringA("[JSBridge] dbtMergeDatabase: Missing parameters (sourcePath, tableName, skipExisting, overwriteIfLarger)\n");
-        return JSValueMakeNull(ctx);
+    // Hits are cache images the page got from memory, misses ones it read from disk
+    BitmapCache::Stats stats = {};
+    BitmapCache* bitmapCache = imageLoader_ ? imageLoader_->getBitmapCache() : nullptr;
+    if (bitmapCache) {
+        stats = bitmapCache->getStats();
     }
 
-    // Extract sourcePath (string)
-    JSStringRef sourcePathStr = JSValueToStringCopy(ctx, arguments[0], exception);
-    if (!sourcePathStr) {
-        OutputDebugStringA("[JSBridge] dbtMergeDatabase: Invalid sourcePath parameter\n");
-        return JSValueMakeNull(ctx);
+    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+    const std::pair<const char*, int64_t> fields[] = {
+        { "hits", stats.hits },
+        { "misses", stats.misses },
+        { "evictions", stats.evictions },
+        { "entries", stats.entries },
+        { "bytes", stats.bytes },
+        { "budgetBytes", stats.budgetBytes }
+    };
+    for (const auto& field : fields) {
+        JSStringRef key = JSStringCreateWithUTF8CString(field.first);
+        JSObjectSetProperty(ctx, resultObj, key, JSValueMakeNumber(ctx, static_cast<double>(field.second)), 0, nullptr);
+        JSStringRelease(key);
     }
-    size_t sourcePathLength = JSStringGetMaximumUTF8CStringSize(sourcePathStr);
-    char* sourcePathBuffer = new char[sourcePathLength];
-    JSStringGetUTF8CString(sourcePathStr, sourcePathBuffer, sourcePathLength);
-    std::string sourcePath(sourcePathBuffer);
-    delete[] sourcePathBuffer;
-    JSStringRelease(sourcePathStr);
 
-    // Extract tableName (string)
-    JSStringRef tableNameStr = JSValueToStringCopy(ctx, arguments[1], exception);
-    if (!tableNameStr) {
-        OutputDebugStringA("[JSBridge] dbtMergeDatabase: Invalid tableName parameter\n");
-        return JSValueMakeNull(ctx);
+    return resultObj;
+}
+
+JSValueRef JSBridge::clearImageFailures(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] clearImageFailures called from JavaScript\n");
+
+    // Optional array of URLs; without one every failing URL may be tried again
+    std::vector<std::string> urls;
+    if (argumentCount >= 1 && !JSValueIsUndefined(ctx, arguments[0]) && !JSValueIsNull(ctx, arguments[0])) {
+        urls = jsArrayToStrings(ctx, arguments[0], exception);
+        if (urls.empty()) {
+            return JSValueMakeNumber(ctx, 0);
+        }
     }
-    size_t tableNameLength = JSStringGetMaximumUTF8CStringSize(tableNameStr);
-    char* tableNameBuffer = new char[tableNameLength];
-    JSStringGetUTF8CString(tableNameStr, tableNameBuffer, tableNameLength);
-    std::string tableName(tableNameBuffer);
-    delete[] tableNameBuffer;
-    JSStringRelease(tableNameStr);
 
-    // Extract skipExisting (boolean)
-    bool skipExisting = JSValueToBoolean(ctx, arguments[2]);
+    return JSValueMakeNumber(ctx, library_->clearImageFailures(urls));
+}
 
-    // Extract overwriteIfLarger (boolean)
-    bool overwriteIfLarger = JSValueToBoolean(ctx, arguments[3]);
+// Helper function to set a string property on a JavaScript object
+static void jsObjectSetString(JSContextRef ctx, JSObjectRef obj, const char* name, const std::string& value) {
+    JSStringRef key = JSStringCreateWithUTF8CString(name);
+    JSStringRef valueStr = JSStringCreateWithUTF8CString(value.c_str());
+    JSObjectSetProperty(ctx, obj, key, JSValueMakeString(ctx, valueStr), 0, nullptr);
+    JSStringRelease(key);
+    JSStringRelease(valueStr);
+}
 
-    OutputDebugStringA(("[JSBridge] Merging database: source=" + sourcePath + ", table=" + tableName +
-                       ", skipExisting=" + (skipExisting ? "true" : "false") +
-                       ", overwriteIfLarger=" + (overwriteIfLarger ? "true" : "false") + "\n").c_str());
+JSValueRef JSBridge::getCacheImages(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+    size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
+    OutputDebugStringA("[JSBridge] getCacheImages called from JavaScript\n");
 
-    // Call Library method
-    Library::MergeResult result = library_->dbtMergeDatabase(sourcePath, tableName, skipExisting, overwriteIfLarger);
+    if (argumentCount < 1) {
+        OutputDebugStringA("[JSBridge] getCacheImages: Missing URLs parameter\n");
+        return JSValueMakeNull(ctx);
+    }
 
-    OutputDebugStringA(("[JSBridge] Merge operation completed: success=" + std::string(result.success ? "true" : "false") +
-                       ", total=" + std::to_string(result.totalEntries) +
-                       ", merged=" + std::to_string(result.mergedCount) +
-                       ", skipped=" + std::to_string(result.skippedCount) +
-                       ", overwritten=" + std::to_string(result.overwrittenCount) +
-                       ", failed=" + std::to_string(result.failedCount) + "\n").c_str());
+    std::vector<std::string> urls = jsArrayToStrings(ctx, arguments[0], exception);
 
-    // Convert result to JavaScript object
-    JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+    // Optional second argument: scheduling priority for the URLs that are not cached
+    int priority = IMAGE_PRIORITY_VISIBLE;
+    if (argumentCount >= 2) {
+        priority = (std::max)(jsValueToImagePriority(ctx, arguments[1], exception), static_cast<int>(IMAGE_PRIORITY_VISIBLE));
+    }
 
-    // Set success property
-    JSStringRef successKey = JSStringCreateWithUTF8CString("success");
-    JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
-    JSStringRelease(successKey);
+    OutputDebugStringA(("[JSBridge] getCacheImages: Processing " + std::to_string(urls.size()) + " URLs (priority " +
+        std::to_string(priority) + ")\n").c_str());
 
-    // Set error property
-    JSStringRef errorKey = JSStringCreateWithUTF8CString("error");
-    JSStringRef errorValue = JSStringCreateWithUTF8CString(result.error.c_str());
-    JSObjectSetProperty(ctx, resultObj, errorKey, JSValueMakeString(ctx, errorValue), 0, nullptr);
-    JSStringRelease(errorKey);
-    JSStringRelease(errorValue);
+    // One promise-like object for the whole batch. then() receives the array of results in request
+    // order; progress() receives each result as it completes, with the completed and total counts.
+    JSObjectRef promiseObj = JSObjectMake(ctx, nullptr, nullptr);
+    JSObjectRef resultsArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
 
-    // Set totalEntries property
-    JSStringRef totalKey = JSStringCreateWithUTF8CString("totalEntries");
-    JSObjectSetProperty(ctx, resultObj, totalKey, JSValueMakeNumber(ctx, result.totalEntries), 0, nullptr);
-    JSStringRelease(totalKey);
+    JSStringRef resultsKey = JSStringCreateWithUTF8CString("_results");
+    JSObjectSetProperty(ctx, promiseObj, resultsKey, resultsArray, 0, 0);
+    JSStringRelease(resultsKey);
 
-    // Set mergedCount property
-    JSStringRef mergedKey = JSStringCreateWithUTF8CString("mergedCount");
-    JSObjectSetProperty(ctx, resultObj, mergedKey, JSValueMakeNumber(ctx, result.mergedCount), 0, nullptr);
-    JSStringRelease(mergedKey);
+    JSStringRef thenStr = JSStringCreateWithUTF8CString("then");
+    JSObjectRef thenFunc = JSObjectMakeFunctionWithCallback(ctx, thenStr,
+        [](JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+            size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) -> JSValueRef {
 
-    // Set skippedCount property
-    JSStringRef skippedKey = JSStringCreateWithUTF8CString("skippedCount");
-    JSObjectSetProperty(ctx, resultObj, skippedKey, JSValueMakeNumber(ctx, result.skippedCount), 0, nullptr);
-    JSStringRelease(skippedKey);
+                if (argumentCount < 1) return JSValueMakeUndefined(ctx);
 
-    // Set overwrittenCount property
-    JSStringRef overwrittenKey = JSStringCreateWithUTF8CString("overwrittenCount");
-    JSObjectSetProperty(ctx, resultObj, overwrittenKey, JSValueMakeNumber(ctx, result.overwrittenCount), 0, nullptr);
-    JSStringRelease(overwrittenKey);
+                JSStringRef resolveKey = JSStringCreateWithUTF8CString("_resolve");
+                JSObjectSetProperty(ctx, thisObject, resolveKey, arguments[0], 0, 0);
+                JSStringRelease(resolveKey);
 
-    // Set failedCount property
-    JSStringRef failedKey = JSStringCreateWithUTF8CString("failedCount");
-    JSObjectSetProperty(ctx, resultObj, failedKey, JSValueMakeNumber(ctx, result.failedCount), 0, nullptr);
-    JSStringRelease(failedKey);
+                // An empty batch is already complete
+                JSStringRef settledKey = JSStringCreateWithUTF8CString("_settled");
+                bool settled = JSValueToBoolean(ctx, JSObjectGetProperty(ctx, thisObject, settledKey, nullptr));
+                JSStringRelease(settledKey);
+                if (settled && JSValueIsObject(ctx, arguments[0])) {
+                    JSStringRef resultsKey = JSStringCreateWithUTF8CString("_results");
+                    JSValueRef args[] = { JSObjectGetProperty(ctx, thisObject, resultsKey, nullptr) };
+                    JSStringRelease(resultsKey);
+                    JSObjectCallAsFunction(ctx, (JSObjectRef)arguments[0], nullptr, 1, args, nullptr);
+                }
 
-    // Convert entries vector to JavaScript array
-    JSObjectRef entriesArray = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
-    for (size_t i = 0; i < result.entries.size(); i++) {
-        const auto& entry = result.entries[i];
+                return thisObject;
+        });
+    JSObjectSetProperty(ctx, promiseObj, thenStr, thenFunc, 0, 0);
+    JSStringRelease(thenStr);
 
-        JSObjectRef entryObj = JSObjectMake(ctx, nullptr, nullptr);
+    JSStringRef progressStr = JSStringCreateWithUTF8CString("progress");
+    JSObjectRef progressFunc = JSObjectMakeFunctionWithCallback(ctx, progressStr,
+        [](JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+            size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) -> JSValueRef {
 
-        // Set id property
-        JSStringRef idKey = JSStringCreateWithUTF8CString("id");
-        JSStringRef idValue = JSStringCreateWithUTF8CString(entry.id.c_str());
-        JSObjectSetProperty(ctx, entryObj, idKey, JSValueMakeString(ctx, idValue), 0, nullptr);
-        JSStringRelease(idKey);
-        JSStringRelease(idValue);
+                if (argumentCount < 1) return JSValueMakeUndefined(ctx);
 
-        // Set action property
-        JSStringRef actionKey = JSStringCreateWithUTF8CString("action");
-        JSStringRef actionValue = JSStringCreateWithUTF8CString(entry.action.c_str());
-        JSObjectSetProperty(ctx, entryObj, actionKey, JSValueMakeString(ctx, actionValue), 0, nullptr);
-        JSStringRelease(actionKey);
-        JSStringRelease(actionValue);
+                JSStringRef progressKey = JSStringCreateWithUTF8CString("_progress");
+                JSObjectSetProperty(ctx, thisObject, progressKey, arguments[0], 0, 0);
+                JSStringRelease(progressKey);
 
-        // Set error property
-        JSStringRef entryErrorKey = JSStringCreateWithUTF8CString("error");
-        JSStringRef entryErrorValue = JSStringCreateWithUTF8CString(entry.error.c_str());
-        JSObjectSetProperty(ctx, entryObj, entryErrorKey, JSValueMakeString(ctx, entryErrorValue), 0, nullptr);
-        JSStringRelease(entryErrorKey);
-        JSStringRelease(entryErrorValue);
+                return thisObject;
+        });
+    JSObjectSetProperty(ctx, promiseObj, progressStr, progressFunc, 0, 0);
+    JSStringRelease(progressStr);
 
-        // Set blobSizeBytes property
-        JSStringRef sizeKey = JSStringCreateWithUTF8CString("blobSizeBytes");
-        JSObjectSetProperty(ctx, entryObj, sizeKey, JSValueMakeNumber(ctx, entry.blobSizeBytes), 0, nullptr);
-        JSStringRelease(sizeKey);
+    // The batch never rejects (failed URLs are in the results), so catch only keeps chains working
+    JSStringRef catchStr = JSStringCreateWithUTF8CString("catch");
+    JSObjectRef catchFunc = JSObjectMakeFunctionWithCallback(ctx, catchStr,
+        [](JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+            size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) -> JSValueRef {
+                return thisObject;
+        });
+    JSObjectSetProperty(ctx, promiseObj, catchStr, catchFunc, 0, 0);
+    JSStringRelease(catchStr);
 
-        // Add to entries array
-        JSObjectSetPropertyAtIndex(ctx, entriesArray, i, entryObj, nullptr);
+    if (urls.empty()) {
+        JSStringRef settledKey = JSStringCreateWithUTF8CString("_settled");
+        JSObjectSetProperty(ctx, promiseObj, settledKey, JSValueMakeBoolean(ctx, true), 0, 0);
+        JSStringRelease(settledKey);
+        return promiseObj;
     }
 
-    // Set entries property
-    JSStringRef entriesKey = JSStringCreateWithUTF8CString("entries");
-    JSObjectSetProperty(ctx, resultObj, entriesKey, entriesArray, 0, nullptr);
-    JSStringRelease(entriesKey);
+    // Protect the promise object (and the results array it holds) until the last result is in
+    JSValueProtect(ctx, promiseObj);
 
-    return resultObj;
+    std::shared_ptr<size_t> completed = std::make_shared<size_t>(0);
+    size_t total = urls.size();
+
+    uint64_t requestId = library_->cacheImages(urls, [this, ctx, promiseObj, completed, total](size_t index, const ImageLoadResult& result) {
+        // Result object for this URL
+        JSObjectRef resultObj = JSObjectMake(ctx, nullptr, nullptr);
+        jsObjectSetString(ctx, resultObj, "url", result.url);
+
+        JSStringRef successKey = JSStringCreateWithUTF8CString("success");
+        JSObjectSetProperty(ctx, resultObj, successKey, JSValueMakeBoolean(ctx, result.success), 0, nullptr);
+        JSStringRelease(successKey);
+
+        if (result.success) {
+            jsObjectSetString(ctx, resultObj, "filePath", convertToFileUrl(result.filePath));
+        } else {
+            jsObjectSetString(ctx, resultObj, "error", result.cancelled ? "Cancelled" : "Failed to load image");
+        }
+
+        JSStringRef resultsKey = JSStringCreateWithUTF8CString("_results");
+        JSObjectRef resultsArray = (JSObjectRef)JSObjectGetProperty(ctx, promiseObj, resultsKey, nullptr);
+        JSStringRelease(resultsKey);
+        JSObjectSetPropertyAtIndex(ctx, resultsArray, static_cast<unsigned>(index), resultObj, nullptr);
+
+        (*completed)++;
+
+        // Per-URL progress event
+        JSStringRef progressKey = JSStringCreateWithUTF8CString("_progress");
+        JSValueRef progressFunc = JSObjectGetProperty(ctx, promiseObj, progressKey, nullptr);
+        JSStringRelease(progressKey);
+        if (JSValueIsObject(ctx, progressFunc)) {
+            JSValueRef args[] = { resultObj, JSValueMakeNumber(ctx, static_cast<double>(*completed)),
+                                  JSValueMakeNumber(ctx, static_cast<double>(total)) };
+            JSObjectCallAsFunction(ctx, (JSObjectRef)progressFunc, nullptr, 3, args, nullptr);
+        }
+
+        if (*completed < total) {
+            return;
+        }
+
+        // Whole batch done: resolve with every result, failures included
+        OutputDebugStringA(("[JSBridge] getCacheImages: Batch of " + std::to_string(total) + " complete\n").c_str());
+
+        JSStringRef resolveKey = JSStringCreateWithUTF8CString("_resolve");
+        JSValueRef resolveFunc = JSObjectGetProperty(ctx, promiseObj, resolveKey, nullptr);
+        JSStringRelease(resolveKey);
+        if (JSValueIsObject(ctx, resolveFunc)) {
+            JSValueRef args[] = { resultsArray };
+            JSObjectCallAsFunction(ctx, (JSObjectRef)resolveFunc, nullptr, 1, args, nullptr);
+        }
+
+        JSValueUnprotect(ctx, promiseObj);
+    }, priority);
+
+    // Handle for reprioritizeImages(urls, "cancel", requestId); one handle covers the whole batch
+    JSStringRef requestIdKey = JSStringCreateWithUTF8CString("requestId");
+    JSObjectSetProperty(ctx, promiseObj, requestIdKey, JSValueMakeNumber(ctx, static_cast<double>(requestId)), 0, nullptr);
+    JSStringRelease(requestIdKey);
+
+    return promiseObj;
 }
 
 // Setup JS bridge for image loader view
-void JSBridge::setupImageLoaderBridge(View* view) {
+void JSBridge::setupImageLoaderBridge(View* view, int viewIndex) {
     OutputDebugStringA("[JSBridge] Setting up image loader JS bridge\n");
 
     // Acquire the JS execution context
@@ -1777,6 +5188,11 @@ void JSBridge::setupImageLoaderBridge(View* view) {
     JSObjectSetProperty(ctx, bridgeObj, methodName, methodFunc, 0, 0);
     JSStringRelease(methodName);
 
+    // Tell the page which view of the pool it is running in
+    JSStringRef viewIndexName = JSStringCreateWithUTF8CString("viewIndex");
+    JSObjectSetProperty(ctx, bridgeObj, viewIndexName, JSValueMakeNumber(ctx, viewIndex), 0, 0);
+    JSStringRelease(viewIndexName);
+
     // Add the cppBridge object to the global object
     JSStringRef bridgeName = JSStringCreateWithUTF8CString("cppBridge");
     JSObjectSetProperty(ctx, globalObj, bridgeName, bridgeObj, 0, 0);
@@ -1785,6 +5201,7 @@ void JSBridge::setupImageLoaderBridge(View* view) {
     OutputDebugStringA("[JSBridge] Image loader JS bridge registered:\n");
     OutputDebugStringA("[JSBridge]   - window.cppBridge.onImageLoaded\n");
     OutputDebugStringA("[JSBridge]   - window.cppBridge.onImageLoaderReady\n");
+    OutputDebugStringA(("[JSBridge]   - window.cppBridge.viewIndex = " + std::to_string(viewIndex) + "\n").c_str());
 }
 
 // Image loader bridge method implementations
@@ -1821,13 +5238,19 @@ JSValueRef JSBridge::onImageLoaded(JSContextRef ctx, JSObjectRef function, JSObj
     int rectWidth = (int)JSValueToNumber(ctx, arguments[4], exception);
     int rectHeight = (int)JSValueToNumber(ctx, arguments[5], exception);
 
+    // Optional view index of the image loader view that sent it
+    int viewIndex = -1;
+    if (argumentCount > 6 && JSValueIsNumber(ctx, arguments[6])) {
+        viewIndex = (int)JSValueToNumber(ctx, arguments[6], exception);
+    }
+
     OutputDebugStringA(("[JSBridge] Image loaded: " + url + " (success: " + (success ? "true" : "false") + ")\n").c_str());
     OutputDebugStringA(("[JSBridge] Rect: (" + std::to_string(rectX) + ", " + std::to_string(rectY) + ", " +
                        std::to_string(rectWidth) + "x" + std::to_string(rectHeight) + ")\n").c_str());
 
     // Call the image loader
     if (imageLoader_) {
-        imageLoader_->onImageLoaded(success, url, rectX, rectY, rectWidth, rectHeight);
+        imageLoader_->onImageLoaded(viewIndex, success, url, rectX, rectY, rectWidth, rectHeight);
     } else {
         OutputDebugStringA("[JSBridge] ERROR: ImageLoader not initialized!\n");
     }
@@ -1839,9 +5262,14 @@ JSValueRef JSBridge::onImageLoaderReady(JSContextRef ctx, JSObjectRef function,
     size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
     OutputDebugStringA("[JSBridge] onImageLoaderReady called from image-loader.html\n");
 
-    // Call the image loader
+    // Call the image loader for the view that sent it (OnFinishLoading covers pages that don't say)
     if (imageLoader_) {
-        imageLoader_->onImageLoaderReady();
+        if (argumentCount > 0 && JSValueIsNumber(ctx, arguments[0])) {
+            int viewIndex = (int)JSValueToNumber(ctx, arguments[0], exception);
+            if (viewIndex >= 0) {
+                imageLoader_->onImageLoaderReady(imageLoader_->getView(viewIndex));
+            }
+        }
     } else {
         OutputDebugStringA("[JSBridge] ERROR: ImageLoader not initialized!\n");
     }
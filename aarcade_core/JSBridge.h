@@ -10,6 +10,7 @@
 #include "ArcadeKeyValues.h"
 #include "ImageLoader.h"
 #include "Library.h"
+#include "JobManager.h"
 #include <memory>
 
 using namespace ultralight;
@@ -22,6 +23,11 @@ private:
     RefPtr<Renderer> renderer_; // Store renderer for future use
     RefPtr<App> app_; // Store app for quit functionality
     Library* library_; // Library manager for arcade functionality
+    JobManager* jobManager_; // Background job runner, owned by MainApp
+    int lazyMigrationJobId_; // Job writing back instances upgraded on read, -1 if none yet
+
+    // Write back the instances the last browse/search call upgraded, as a "migrateInstances" job
+    void queueLazyMigration();
 
 public:
     // Constructor takes references to the managers it needs
@@ -32,7 +38,7 @@ public:
     void setupJavaScriptBridge(View* view, uint64_t frame_id, bool is_main_frame, const String& url);
 
     // Setup JS bridge for image loader view
-    void setupImageLoaderBridge(View* view);
+    void setupImageLoaderBridge(View* view, int viewIndex);
 
     // Set the app (to access renderer)
     void setApp(RefPtr<App> app);
@@ -40,6 +46,9 @@ public:
     // Set the image loader (owned by MainApp)
     void setImageLoader(ImageLoader* imageLoader);
 
+    // Set the job manager (owned by MainApp)
+    void setJobManager(JobManager* jobManager);
+
     std::string convertToFileUrl(const std::string& filePath);
 
     // JavaScript bridge methods (called by C callback wrappers)
@@ -74,6 +83,9 @@ public:
     JSValueRef getCacheImage(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
         size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
 
+    JSValueRef getCacheImages(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
     JSValueRef processImageCompletions(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
         size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
 
@@ -130,11 +142,152 @@ public:
     JSValueRef dbtMergeDatabase(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
         size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
 
+    JSValueRef dbtDiffDatabases(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtGetNextDiffResults(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtCloseDiff(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Background job methods
+    JSValueRef jobStart(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef jobPause(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef jobResume(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef jobCancel(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef jobGetStatus(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef jobList(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Database tools: Online compaction and incremental vacuum
+    JSValueRef dbtStartOnlineCompaction(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtGetOnlineCompactionStatus(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtFinishOnlineCompaction(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtCancelOnlineCompaction(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtSetAutoVacuumMode(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtIncrementalVacuum(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Database tools: Storage breakdown
+    JSValueRef dbtAnalyzeStorage(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Database tools: Library health scan results (the scan itself runs as a "healthScan" job)
+    JSValueRef dbtGetHealthFindings(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtGetHealthScanSummary(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Database tools: Approximate field statistics
+    JSValueRef dbtComputeFieldStatistics(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtGetFieldStatistics(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Duplicate detection
+    JSValueRef dbtFindDuplicates(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtCollapseDuplicates(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Reference integrity
+    JSValueRef dbtCheckReferences(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtGetReferenceFindings(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtFixDanglingReferences(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtPurgeUnreferenced(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Rule-based cleanup
+    JSValueRef dbtRunCleanupRules(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Find and replace
+    JSValueRef dbtReplaceInFields(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Instance migrations
+    JSValueRef dbtGetInstanceGenerations(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtMigrateInstances(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtSetLazyMigration(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Undo journals
+    JSValueRef jobUndo(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtListUndoJournals(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtUndoJournal(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    JSValueRef dbtDeleteUndoJournal(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Image cache
+    JSValueRef getImageCacheLayout(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Image job scheduling
+    JSValueRef reprioritizeImages(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Image completion delivery
+    JSValueRef getImageCompletionStats(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Decoded image memory cache
+    JSValueRef getImageMemoryCacheStats(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
+    // Image failure backoff
+    JSValueRef clearImageFailures(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+        size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
+
     // Helper functions
     JSObjectRef arcadeKeyValuesToJSObject(JSContextRef ctx, const ArcadeKeyValues* kv);
     JSObjectRef entryDataToJSObject(JSContextRef ctx, const std::string& entryId, const std::string& hexData);
     JSObjectRef createJSArray(JSContextRef ctx, const std::vector<std::pair<std::string, std::string>>& entries);
     JSObjectRef createStringArray(JSContextRef ctx, const std::vector<std::string>& strings);
+    JSObjectRef diffPageToJSObject(JSContextRef ctx, const Library::DiffPage& page);
+    JSObjectRef jobStatusToJSObject(JSContextRef ctx, const JobManager::JobStatus& status);
+    JSObjectRef undoResultToJSObject(JSContextRef ctx, const Library::UndoResult& result);
+    JSObjectRef fieldStatisticsToJSObject(JSContextRef ctx, const Library::FieldStatisticsResult& result);
+    JSObjectRef sampledResultToJSObject(JSContextRef ctx, JSObjectRef resultsArray, const Library::SampleInfo& sampleInfo);
 
     // Static instance getter for callbacks
     static JSBridge* getInstance();
@@ -0,0 +1,239 @@
+#ifndef JOB_CONTEXT_H
+#define JOB_CONTEXT_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <windows.h>
+#include "sqlite/sqlite3.h"
+#include "UndoJournal.h"
+
+/**
+ * JobResult - One row of partial output produced by a running job
+ */
+struct JobResult {
+    std::string id;
+    std::string action;  // Tool specific, e.g. "merged", "trimmed", "purged", "failed"
+    bool success;
+    std::string error;
+    int sizeBytes;
+};
+
+/**
+ * JobContext - Control channel between a running database tool and the JobManager
+ *
+ * Database tools accept an optional JobContext*. When present they:
+ * - Skip rows up to and including resumeAfterId (rows are processed in id order)
+ * - Commit every batchSize rows, writing the checkpoint inside the same transaction
+ * - Check for pause/cancel between batches (never while holding a write lock)
+ * - Push partial results here instead of accumulating them in memory
+ * - Flush undoJournal (if the tool keeps one) before each commit
+ *
+ * Progress counters are atomics so the UI thread can read them while the worker runs.
+ */
+class JobContext {
+private:
+    std::mutex resultsMutex_;
+    std::vector<JobResult> pendingResults_;
+
+    std::mutex pauseMutex_;
+    std::condition_variable pauseCondition_;
+
+    std::string committedId_;  // lastId as of the last successful batch commit
+    std::string failure_;      // Set when a batch could not be committed; the job stops and fails
+
+public:
+    int jobId;
+    std::string resumeAfterId;
+    int batchSize;
+    int rowsSinceCommit;
+
+    std::atomic<bool> cancelRequested;
+    std::atomic<bool> pauseRequested;
+
+    std::atomic<int64_t> rowsDone;
+    std::atomic<int64_t> rowsTotal;
+    std::atomic<int64_t> bytesDone;
+
+    std::mutex lastIdMutex;
+    std::string lastId;
+
+    // Before-images of the rows written by the current run; set by the tool while it runs
+    UndoJournal* undoJournal;
+
+    JobContext(int id, const std::string& resumeAfter, int batch)
+        : committedId_(resumeAfter), jobId(id), resumeAfterId(resumeAfter), batchSize(batch > 0 ? batch : 500), rowsSinceCommit(0),
+          cancelRequested(false), pauseRequested(false), rowsDone(0), rowsTotal(0), bytesDone(0), lastId(resumeAfter),
+          undoJournal(nullptr) {
+    }
+
+    // Run COMMIT / BEGIN, retrying while another connection holds the lock past its busy timeout
+    static bool execWithRetry(sqlite3* db, const char* sql, std::string& error) {
+        const int MAX_ATTEMPTS = 5;
+        for (int attempt = 1; ; attempt++) {
+            char* errMsg = nullptr;
+            int rc = sqlite3_exec(db, sql, nullptr, nullptr, &errMsg);
+            if (rc == SQLITE_OK) {
+                return true;
+            }
+
+            error = std::string(sql) + " failed: " + (errMsg ? errMsg : sqlite3_errstr(rc));
+            if (errMsg) sqlite3_free(errMsg);
+            if ((rc != SQLITE_BUSY && rc != SQLITE_LOCKED) || attempt == MAX_ATTEMPTS) {
+                return false;
+            }
+            Sleep(200 * attempt);
+        }
+    }
+
+    // True once a batch could not be committed; getFailure() says why
+    bool hasFailed() const {
+        return !failure_.empty();
+    }
+
+    const std::string& getFailure() const {
+        return failure_;
+    }
+
+    // Stop the job and fail it. The batch in progress is rolled back (along with its checkpoint)
+    // and lastId goes back to the last committed one, so a resume redoes exactly that batch.
+    // A fresh transaction is opened where possible, so the tool's final COMMIT has nothing to write.
+    void failBatch(sqlite3* db, const std::string& error) {
+        OutputDebugStringA(("[JobContext] Job " + std::to_string(jobId) + " failed: " + error + "\n").c_str());
+        failure_ = error;
+        setLastId(committedId_);
+        if (!sqlite3_get_autocommit(db)) {
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        }
+        sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+    }
+
+    // True if this row was already handled by a previous run of the job
+    bool isAlreadyProcessed(const std::string& id) const {
+        return !resumeAfterId.empty() && id <= resumeAfterId;
+    }
+
+    void pushResult(const JobResult& result) {
+        std::lock_guard<std::mutex> lock(resultsMutex_);
+        pendingResults_.push_back(result);
+    }
+
+    // Take every result produced since the previous call
+    std::vector<JobResult> drainResults() {
+        std::lock_guard<std::mutex> lock(resultsMutex_);
+        std::vector<JobResult> drained;
+        drained.swap(pendingResults_);
+        return drained;
+    }
+
+    void setLastId(const std::string& id) {
+        std::lock_guard<std::mutex> lock(lastIdMutex);
+        lastId = id;
+    }
+
+    std::string getLastId() {
+        std::lock_guard<std::mutex> lock(lastIdMutex);
+        return lastId;
+    }
+
+    void requestPause() {
+        pauseRequested = true;
+    }
+
+    void requestResume() {
+        {
+            std::lock_guard<std::mutex> lock(pauseMutex_);
+            pauseRequested = false;
+        }
+        pauseCondition_.notify_all();
+    }
+
+    void requestCancel() {
+        {
+            std::lock_guard<std::mutex> lock(pauseMutex_);
+            cancelRequested = true;
+        }
+        pauseCondition_.notify_all();
+    }
+
+    // Called by the worker between batches. Blocks while paused.
+    // Returns true if the job should stop (cancelled).
+    bool shouldStop() {
+        std::unique_lock<std::mutex> lock(pauseMutex_);
+        if (pauseRequested && !cancelRequested) {
+            OutputDebugStringA(("[JobContext] Job " + std::to_string(jobId) + " paused\n").c_str());
+            pauseCondition_.wait(lock, [this]() { return !pauseRequested || cancelRequested; });
+            OutputDebugStringA(("[JobContext] Job " + std::to_string(jobId) + " continuing\n").c_str());
+        }
+        return cancelRequested;
+    }
+
+    // Persist progress to the jobs table. Must be called inside the batch transaction
+    // so the checkpoint commits atomically with the rows it describes.
+    bool saveCheckpoint(sqlite3* db, const std::string& id) {
+        setLastId(id);
+
+        sqlite3_stmt* stmt = nullptr;
+        const char* sql = "UPDATE jobs SET last_id = ?, rows_done = ?, rows_total = ?, bytes_done = ?, "
+                          "updated_at = strftime('%s','now') WHERE id = ?;";
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            OutputDebugStringA(("[JobContext] Failed to prepare checkpoint: " + std::string(sqlite3_errmsg(db)) + "\n").c_str());
+            return false;
+        }
+
+        sqlite3_bind_text(stmt, 1, id.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, rowsDone);
+        sqlite3_bind_int64(stmt, 3, rowsTotal);
+        sqlite3_bind_int64(stmt, 4, bytesDone);
+        sqlite3_bind_int(stmt, 5, jobId);
+
+        bool success = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_finalize(stmt);
+        return success;
+    }
+
+    // Batch boundary: checkpoint, commit, honour pause/cancel, then open the next transaction.
+    // Returns false if the job was cancelled or the batch could not be committed (see hasFailed()).
+    // A fresh transaction is normally still open for the caller's final COMMIT.
+    bool commitBatchIfNeeded(sqlite3* db, const std::string& id) {
+        if (hasFailed()) {
+            return false;
+        }
+
+        setLastId(id);
+        rowsSinceCommit++;
+        if (rowsSinceCommit < batchSize) {
+            return !cancelRequested;
+        }
+        rowsSinceCommit = 0;
+
+        if (!saveCheckpoint(db, id)) {
+            failBatch(db, "Failed to save checkpoint: " + std::string(sqlite3_errmsg(db)));
+            return false;
+        }
+        if (undoJournal) {
+            undoJournal->flush();
+        }
+
+        std::string error;
+        if (!execWithRetry(db, "COMMIT;", error)) {
+            failBatch(db, error);
+            return false;
+        }
+        committedId_ = id;
+
+        // Pause between batches, with no transaction open
+        bool stop = shouldStop();
+
+        if (!execWithRetry(db, "BEGIN TRANSACTION;", error)) {
+            failure_ = error;
+            OutputDebugStringA(("[JobContext] Job " + std::to_string(jobId) + " failed: " + error + "\n").c_str());
+            return false;
+        }
+        return !stop;
+    }
+};
+
+#endif // JOB_CONTEXT_H
@@ -0,0 +1,663 @@
+#include "JobManager.h"
+#include <windows.h>
+#include <algorithm>
+
+JobManager::JobManager(ArcadeConfig* config)
+    : config_(config), workerLibrary_(&workerDb_, config), batchSize_(500), persisting_(false), stopping_(false), initialized_(false) {
+    debugOutput("JobManager created");
+}
+
+JobManager::~JobManager() {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        stopping_ = true;
+
+        // Cancel the running job at its next batch boundary; its checkpoint survives for next session
+        for (auto& pair : jobs_) {
+            if (pair.second.context && (pair.second.status == "running" || pair.second.status == "paused")) {
+                pair.second.context->requestCancel();
+            }
+        }
+    }
+    queueCondition_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    // The worker is gone, so this thread owns the connection. Jobs it never reached are
+    // recorded as interrupted so they can be resumed next session instead of vanishing.
+    if (initialized_ && workerDb_.openDatabase(config_->getDatabasePath())) {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        persistStatusWrites(takeStatusWrites());
+        for (int jobId : queue_) {
+            Job& job = jobs_[jobId];
+            persistJob(job);
+            persistStatus(jobId, "interrupted", "");
+        }
+        queue_.clear();
+    }
+
+    debugOutput("JobManager destroyed");
+}
+
+bool JobManager::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    if (!workerDb_.openDatabase(config_->getDatabasePath())) {
+        debugOutput("Failed to open worker database connection");
+        return false;
+    }
+
+    if (!createJobsTable()) {
+        return false;
+    }
+
+    loadPersistedJobs();
+
+    worker_ = std::thread(&JobManager::workerLoop, this);
+    initialized_ = true;
+
+    debugOutput("Initialized with " + std::to_string(jobs_.size()) + " persisted jobs");
+    return true;
+}
+
+bool JobManager::createJobsTable() {
+    const char* sql =
+        "CREATE TABLE IF NOT EXISTS jobs ("
+        "id INTEGER PRIMARY KEY, "
+        "type TEXT NOT NULL, "
+        "params BLOB, "
+        "status TEXT NOT NULL, "
+        "error TEXT, "
+        "last_id TEXT, "
+        "rows_done INTEGER DEFAULT 0, "
+        "rows_total INTEGER DEFAULT 0, "
+        "bytes_done INTEGER DEFAULT 0, "
+        "created_at INTEGER, "
+        "updated_at INTEGER);";
+
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(workerDb_.getDb(), sql, nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        debugOutput("Failed to create jobs table: " + std::string(errMsg ? errMsg : "unknown error"));
+        if (errMsg) sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+// Jobs that were queued or running when the app last closed are marked "interrupted"
+// so the tool pages can offer to resume them from their checkpoint.
+void JobManager::loadPersistedJobs() {
+    sqlite3* db = workerDb_.getDb();
+
+    sqlite3_exec(db, "UPDATE jobs SET status = 'interrupted' WHERE status IN ('queued', 'running', 'paused');",
+                 nullptr, nullptr, nullptr);
+
+    sqlite3_stmt* stmt = nullptr;
+    const char* sql = "SELECT id, type, params, status, error, last_id, rows_done, rows_total, bytes_done FROM jobs ORDER BY id;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        debugOutput("Failed to load jobs: " + std::string(sqlite3_errmsg(db)));
+        return;
+    }
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        Job job;
+        job.id = sqlite3_column_int(stmt, 0);
+        const char* type = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        job.type = type ? type : "";
+        job.params = deserializeParams(sqlite3_column_blob(stmt, 2), sqlite3_column_bytes(stmt, 2));
+        const char* status = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+        job.status = status ? status : "";
+        const char* error = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
+        job.error = error ? error : "";
+        const char* lastId = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
+
+        job.context = std::make_shared<JobContext>(job.id, lastId ? lastId : "", batchSize_);
+        job.context->rowsDone = sqlite3_column_int64(stmt, 6);
+        job.context->rowsTotal = sqlite3_column_int64(stmt, 7);
+        job.context->bytesDone = sqlite3_column_int64(stmt, 8);
+        job.started = false;
+
+        jobs_[job.id] = job;
+    }
+
+    sqlite3_finalize(stmt);
+}
+
+std::vector<uint8_t> JobManager::serializeParams(const JobParams& params) {
+    ArcadeKeyValues kv("params");
+    kv.SetString("tableName", params.tableName.c_str());
+    kv.SetString("sourcePath", params.sourcePath.c_str());
+    kv.SetBool("skipExisting", params.skipExisting);
+    kv.SetBool("overwriteIfLarger", params.overwriteIfLarger);
+    kv.SetInt("maxLength", params.maxLength);
+    kv.SetInt("minSizeBytes", params.minSizeBytes);
+    kv.SetString("pathGlob", params.pathGlob.c_str());
+    kv.SetString("findText", params.findText.c_str());
+    kv.SetString("replaceText", params.replaceText.c_str());
+    kv.SetBool("useRegex", params.useRegex);
+    kv.SetString("destinationPath", params.destinationPath.c_str());
+    kv.SetInt("pagesPerStep", params.pagesPerStep);
+    kv.SetInt("sleepMs", params.sleepMs);
+    kv.SetBool("compress", params.compress);
+    kv.SetBool("incremental", params.incremental);
+    kv.SetString("rulesText", params.rulesText.c_str());
+    kv.SetBool("dryRun", params.dryRun);
+    kv.SetInt("maxClusters", params.maxClusters);
+
+    // Entry ids are stored newline separated (lists can hold hundreds of thousands of ids)
+    std::string ids;
+    for (const auto& id : params.entryIds) {
+        ids += id;
+        ids += '\n';
+    }
+    kv.SetString("entryIds", ids.c_str());
+
+    std::string keys;
+    for (const auto& key : params.keys) {
+        keys += key;
+        keys += '\n';
+    }
+    kv.SetString("keys", keys.c_str());
+
+    return kv.SerializeToBinary();
+}
+
+JobManager::JobParams JobManager::deserializeParams(const void* blob, int size) {
+    JobParams params;
+    if (!blob || size <= 0) {
+        return params;
+    }
+
+    auto kv = ArcadeKeyValues::ParseFromBinary(blob, size);
+    params.tableName = kv->GetString("tableName", "");
+    params.sourcePath = kv->GetString("sourcePath", "");
+    params.skipExisting = kv->GetBool("skipExisting", true);
+    params.overwriteIfLarger = kv->GetBool("overwriteIfLarger", false);
+    params.maxLength = kv->GetInt("maxLength", 0);
+    params.minSizeBytes = kv->GetInt("minSizeBytes", 0);
+    params.pathGlob = kv->GetString("pathGlob", "");
+    params.findText = kv->GetString("findText", "");
+    params.replaceText = kv->GetString("replaceText", "");
+    params.useRegex = kv->GetBool("useRegex", false);
+    params.destinationPath = kv->GetString("destinationPath", "");
+    params.pagesPerStep = kv->GetInt("pagesPerStep", 256);
+    params.sleepMs = kv->GetInt("sleepMs", 10);
+    params.compress = kv->GetBool("compress", false);
+    params.incremental = kv->GetBool("incremental", false);
+    params.rulesText = kv->GetString("rulesText", "");
+    params.dryRun = kv->GetBool("dryRun", true);
+    params.maxClusters = kv->GetInt("maxClusters", 5000);
+
+    std::string ids = kv->GetString("entryIds", "");
+    size_t start = 0;
+    size_t end;
+    while ((end = ids.find('\n', start)) != std::string::npos) {
+        if (end > start) {
+            params.entryIds.push_back(ids.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+
+    std::string keys = kv->GetString("keys", "");
+    start = 0;
+    while ((end = keys.find('\n', start)) != std::string::npos) {
+        if (end > start) {
+            params.keys.push_back(keys.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+
+    return params;
+}
+
+void JobManager::persistJob(const Job& job) {
+    sqlite3* db = workerDb_.getDb();
+    sqlite3_stmt* stmt = nullptr;
+    const char* sql = "INSERT OR IGNORE INTO jobs (id, type, params, status, error, last_id, created_at, updated_at) "
+                      "VALUES (?, ?, ?, ?, ?, '', strftime('%s','now'), strftime('%s','now'));";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        debugOutput("Failed to persist job: " + std::string(sqlite3_errmsg(db)));
+        return;
+    }
+
+    std::vector<uint8_t> params = serializeParams(job.params);
+    sqlite3_bind_int(stmt, 1, job.id);
+    sqlite3_bind_text(stmt, 2, job.type.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_blob(stmt, 3, params.data(), static_cast<int>(params.size()), SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 4, job.status.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 5, job.error.c_str(), -1, SQLITE_TRANSIENT);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        debugOutput("Failed to persist job: " + std::string(sqlite3_errmsg(db)));
+    }
+    sqlite3_finalize(stmt);
+}
+
+void JobManager::persistStatus(int jobId, const std::string& status, const std::string& error) {
+    sqlite3* db = workerDb_.getDb();
+    sqlite3_stmt* stmt = nullptr;
+    const char* sql = "UPDATE jobs SET status = ?, error = ?, updated_at = strftime('%s','now') WHERE id = ?;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        return;
+    }
+
+    sqlite3_bind_text(stmt, 1, status.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, error.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 3, jobId);
+    sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+}
+
+// Copy the jobs whose status the UI thread changed (caller holds jobsMutex_)
+std::vector<JobManager::Job> JobManager::takeStatusWrites() {
+    std::vector<Job> writes;
+    for (int jobId : statusWrites_) {
+        writes.push_back(jobs_[jobId]);
+    }
+    statusWrites_.clear();
+    return writes;
+}
+
+// Write copied status changes (on the thread that owns workerDb_). Jobs paused before the
+// worker reached them have no row yet, so the row is created first.
+void JobManager::persistStatusWrites(const std::vector<Job>& writes) {
+    for (const Job& job : writes) {
+        persistJob(job);
+        persistStatus(job.id, job.status, job.error);
+    }
+}
+
+int JobManager::startJob(const std::string& type, const JobParams& params) {
+    if (!initialize()) {
+        return -1;
+    }
+
+    if (type != "compact" && type != "merge" && type != "purgeEmptyInstances" && type != "trimTextFields" &&
+        type != "healthScan" && type != "buildSchemaCatalog" && type != "replaceInFields" && type != "migrateInstances" &&
+        type != "backup" && type != "runCleanupRules" && type != "computeFieldStatistics" && type != "findDuplicates" &&
+        type != "checkReferences") {
+        debugOutput("Unknown job type: " + type);
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    Job job;
+    job.id = jobs_.empty() ? 1 : jobs_.rbegin()->first + 1;
+    job.type = type;
+    job.status = "queued";
+    job.params = params;
+    job.context = std::make_shared<JobContext>(job.id, "", batchSize_);
+
+    job.started = false;
+
+    // Only the worker thread writes to the jobs table (see workerLoop), so nothing
+    // from the UI thread can end up inside a tool's open batch transaction
+    jobs_[job.id] = job;
+    queue_.push_back(job.id);
+    queueCondition_.notify_all();
+
+    debugOutput("Queued job " + std::to_string(job.id) + " (" + type + ")");
+    return job.id;
+}
+
+bool JobManager::pauseJob(int jobId) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    auto it = jobs_.find(jobId);
+    if (it == jobs_.end() || (it->second.status != "running" && it->second.status != "queued")) {
+        return false;
+    }
+
+    it->second.context->requestPause();
+    it->second.status = "paused";
+    if (!it->second.started) {
+        // Still in the queue; the worker skips it and records it as paused
+        statusWrites_.push_back(jobId);
+        queueCondition_.notify_all();
+    }
+    debugOutput("Pause requested for job " + std::to_string(jobId));
+    return true;
+}
+
+bool JobManager::resumeJob(int jobId) {
+    if (!initialize()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    auto it = jobs_.find(jobId);
+    if (it == jobs_.end()) {
+        return false;
+    }
+
+    Job& job = it->second;
+
+    if (job.status == "paused") {
+        // Still owned by the worker (running or queued) - just release it
+        job.context->requestResume();
+        job.status = job.started ? "running" : "queued";
+        if (!job.started) {
+            statusWrites_.push_back(jobId);
+            queueCondition_.notify_all();
+        }
+        debugOutput("Resumed job " + std::to_string(jobId));
+        return true;
+    }
+
+    if (job.status == "interrupted" || job.status == "failed" || job.status == "cancelled") {
+        // Restart from the last committed checkpoint
+        std::shared_ptr<JobContext> previous = job.context;
+        job.context = std::make_shared<JobContext>(job.id, previous->getLastId(), batchSize_);
+        job.context->rowsDone = previous->rowsDone.load();
+        job.context->rowsTotal = previous->rowsTotal.load();
+        job.context->bytesDone = previous->bytesDone.load();
+        job.status = "queued";
+        job.error = "";
+        job.started = false;
+        queue_.push_back(job.id);
+        queueCondition_.notify_all();
+        debugOutput("Re-queued job " + std::to_string(jobId) + " after id '" + job.context->resumeAfterId + "'");
+        return true;
+    }
+
+    return false;
+}
+
+bool JobManager::cancelJob(int jobId) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    auto it = jobs_.find(jobId);
+    if (it == jobs_.end()) {
+        return false;
+    }
+
+    Job& job = it->second;
+    if (job.status == "completed" || job.status == "cancelled") {
+        return false;
+    }
+
+    job.context->requestCancel();
+
+    // Jobs that never reached the worker can be cancelled immediately
+    bool waiting = job.status == "queued" || (job.status == "paused" && !job.started);
+    if (waiting || job.status == "interrupted" || job.status == "failed") {
+        for (auto q = queue_.begin(); q != queue_.end(); ++q) {
+            if (*q == jobId) {
+                queue_.erase(q);
+                break;
+            }
+        }
+        job.status = "cancelled";
+
+        // Interrupted and failed jobs are in the jobs table; let the worker record the cancel
+        statusWrites_.push_back(jobId);
+        queueCondition_.notify_all();
+    }
+
+    debugOutput("Cancel requested for job " + std::to_string(jobId));
+    return true;
+}
+
+bool JobManager::releaseConnection() {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    for (const auto& pair : jobs_) {
+        const std::string& status = pair.second.status;
+        if (status == "queued" || status == "running" || status == "paused") {
+            debugOutput("Cannot release connection while job " + std::to_string(pair.first) + " is " + status);
+            return false;
+        }
+    }
+    if (!statusWrites_.empty() || persisting_) {
+        debugOutput("Cannot release connection while job status changes are pending");
+        return false;
+    }
+
+    workerDb_.closeDatabase();
+    return true;
+}
+
+JobManager::JobStatus JobManager::getJobStatus(int jobId, bool drainResults) {
+    JobStatus status;
+    status.id = jobId;
+    status.rowsDone = 0;
+    status.rowsTotal = 0;
+    status.bytesDone = 0;
+
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    auto it = jobs_.find(jobId);
+    if (it == jobs_.end()) {
+        status.status = "unknown";
+        status.error = "Job not found";
+        return status;
+    }
+
+    const Job& job = it->second;
+    status.type = job.type;
+    status.status = job.status;
+    status.error = job.error;
+    status.lastId = job.context->getLastId();
+    status.rowsDone = job.context->rowsDone;
+    status.rowsTotal = job.context->rowsTotal;
+    status.bytesDone = job.context->bytesDone;
+
+    if (drainResults) {
+        status.results = job.context->drainResults();
+    }
+
+    return status;
+}
+
+std::vector<JobManager::JobStatus> JobManager::listJobs() {
+    std::vector<int> ids;
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        for (const auto& pair : jobs_) {
+            ids.push_back(pair.first);
+        }
+    }
+
+    std::vector<JobStatus> statuses;
+    for (int id : ids) {
+        statuses.push_back(getJobStatus(id, false));
+    }
+    return statuses;
+}
+
+void JobManager::workerLoop() {
+    debugOutput("Worker thread started");
+
+    // Jobs paused before they started stay in the queue until resumed or cancelled
+    auto nextRunnable = [this]() {
+        return std::find_if(queue_.begin(), queue_.end(), [this](int id) { return jobs_[id].status != "paused"; });
+    };
+
+    while (true) {
+        int jobId = -1;
+        std::shared_ptr<JobContext> context;
+        std::vector<Job> writes;
+        Job picked;
+        {
+            std::unique_lock<std::mutex> lock(jobsMutex_);
+            queueCondition_.wait(lock, [&]() { return stopping_ || nextRunnable() != queue_.end() || !statusWrites_.empty(); });
+            if (stopping_) {
+                break;
+            }
+
+            // The connection may have been released for a file swap since the last job
+            workerDb_.openDatabase(config_->getDatabasePath());
+
+            writes = takeStatusWrites();
+            auto next = nextRunnable();
+            if (next != queue_.end()) {
+                jobId = *next;
+                queue_.erase(next);
+
+                Job& job = jobs_[jobId];
+                job.started = true;
+                job.status = "running";
+                context = job.context;
+                picked = job;
+            }
+            persisting_ = true;
+        }
+
+        // Write the copied state without holding jobsMutex_, so polls and pauses never wait on SQLite
+        persistStatusWrites(writes);
+        if (jobId >= 0) {
+            persistJob(picked);
+            persistStatus(jobId, "running", "");
+        }
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex_);
+            persisting_ = false;
+        }
+        if (jobId < 0) {
+            continue;
+        }
+
+        // Cancelled between being picked and starting
+        if (context->shouldStop()) {
+            std::string status;
+            {
+                std::lock_guard<std::mutex> lock(jobsMutex_);
+                status = stopping_ ? "interrupted" : "cancelled";
+                jobs_[jobId].status = status;
+            }
+            persistStatus(jobId, status, "");
+            continue;
+        }
+
+        runJob(jobId);
+    }
+
+    debugOutput("Worker thread stopped");
+}
+
+void JobManager::runJob(int jobId) {
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        job = jobs_[jobId];
+    }
+
+    JobContext* context = job.context.get();
+    debugOutput("Running job " + std::to_string(jobId) + " (" + job.type + ")" +
+                (context->resumeAfterId.empty() ? "" : " resuming after '" + context->resumeAfterId + "'"));
+
+    bool success = true;
+    std::string error;
+
+    if (job.type == "compact") {
+        Library::CompactResult result = workerLibrary_.dbtCompactDatabase(context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "merge") {
+        Library::MergeResult result = workerLibrary_.dbtMergeDatabase(job.params.sourcePath, job.params.tableName,
+            job.params.skipExisting, job.params.overwriteIfLarger, context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "purgeEmptyInstances") {
+        std::vector<Library::PurgeResult> results = workerLibrary_.dbtPurgeEmptyInstances(job.params.entryIds, context);
+        // Non-empty return means the tool failed before streaming anything
+        if (!results.empty()) {
+            success = false;
+            error = results.front().error;
+        }
+    }
+    else if (job.type == "trimTextFields") {
+        std::vector<Library::TrimResult> results = workerLibrary_.dbtTrimTextFields(job.params.tableName, job.params.entryIds,
+            job.params.maxLength, context);
+        if (!results.empty()) {
+            success = false;
+            error = results.front().error;
+        }
+    }
+    else if (job.type == "healthScan") {
+        Library::HealthScanResult result = workerLibrary_.dbtRunHealthScan(job.params.tableName, job.params.minSizeBytes, context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "replaceInFields") {
+        Library::ReplaceResult result = workerLibrary_.dbtReplaceInFields(job.params.tableName, job.params.pathGlob,
+            job.params.findText, job.params.replaceText, job.params.useRegex, context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "migrateInstances") {
+        // With entry ids: the instances upgrade-on-read queued, otherwise the whole table
+        Library::MigrationResult result = job.params.entryIds.empty() ? workerLibrary_.dbtMigrateInstances(context)
+                                                                     : workerLibrary_.dbtMigrateInstances(job.params.entryIds, context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "backup") {
+        // Restarts from the first page when resumed; the copy has no row checkpoint
+        Library::BackupResult result = workerLibrary_.dbtBackupTo(job.params.destinationPath, job.params.pagesPerStep,
+            job.params.sleepMs, job.params.compress, job.params.incremental, context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "runCleanupRules") {
+        // Starts over when resumed; entries cleaned by the first run no longer match
+        Library::CleanupResult result = workerLibrary_.dbtRunCleanupRules(job.params.rulesText, job.params.dryRun, 20, context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "computeFieldStatistics") {
+        // Starts over when resumed; the sketches are only saved once the whole table is scanned
+        Library::FieldStatisticsResult result = workerLibrary_.dbtComputeFieldStatistics(job.params.tableName, context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "findDuplicates") {
+        // Starts over when resumed; clusters need the whole table
+        Library::DuplicateResult result = workerLibrary_.dbtFindDuplicates(job.params.tableName, job.params.keys,
+            job.params.maxClusters, context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "checkReferences") {
+        // Starts over when resumed; findings are only saved once every table is scanned
+        Library::ReferenceCheckResult result = workerLibrary_.dbtCheckReferences(context);
+        success = result.success;
+        error = result.error;
+    }
+    else if (job.type == "buildSchemaCatalog") {
+        // Single parallel scan; cannot be paused or resumed part way
+        success = workerLibrary_.dbtBuildSchemaCatalog(job.params.tableName, error);
+    }
+
+    std::unique_lock<std::mutex> lock(jobsMutex_);
+    Job& stored = jobs_[jobId];
+
+    if (context->hasFailed()) {
+        // A batch could not be committed; the tool's own error (usually "Cancelled") is secondary
+        stored.status = "failed";
+        error = context->getFailure();
+    } else if (context->cancelRequested) {
+        // Shutdown cancels are recorded as interrupted so the job can resume next session
+        stored.status = stopping_ ? "interrupted" : "cancelled";
+    } else {
+        stored.status = success ? "completed" : "failed";
+    }
+    stored.error = error;
+    std::string status = stored.status;
+    persisting_ = true;
+    lock.unlock();
+
+    persistStatus(jobId, status, error);
+    {
+        std::lock_guard<std::mutex> persisted(jobsMutex_);
+        persisting_ = false;
+    }
+
+    debugOutput("Job " + std::to_string(jobId) + " finished with status " + status +
+                " (" + std::to_string(context->rowsDone) + "/" + std::to_string(context->rowsTotal) + " rows)");
+}
@@ -0,0 +1,134 @@
+#ifndef JOB_MANAGER_H
+#define JOB_MANAGER_H
+
+#include "SQLiteManager.h"
+#include "Config.h"
+#include "Library.h"
+#include "JobContext.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/**
+ * JobManager - Runs long database tools as resumable background jobs
+ *
+ * Jobs run one at a time on a worker thread that owns its own SQLite connection
+ * (and its own Library bound to it), so the UI thread keeps browsing while a
+ * multi-hour merge or purge is in progress. Each job is persisted in a "jobs"
+ * table together with its parameters and last processed id; the checkpoint is
+ * written inside each batch transaction, so a job interrupted by a crash or
+ * restart resumes exactly after the last committed row.
+ *
+ * Supported job types: "compact", "merge", "purgeEmptyInstances", "trimTextFields", "healthScan",
+ * "buildSchemaCatalog", "replaceInFields", "migrateInstances", "backup", "runCleanupRules"
+ */
+class JobManager {
+public:
+    struct JobParams {
+        std::string tableName;
+        std::string sourcePath;
+        bool skipExisting;
+        bool overwriteIfLarger;
+        int maxLength;
+        int minSizeBytes;  // healthScan: large blob threshold
+        std::vector<std::string> entryIds;
+        std::string pathGlob;     // replaceInFields
+        std::string findText;
+        std::string replaceText;
+        bool useRegex;
+        std::string destinationPath;  // backup
+        int pagesPerStep;
+        int sleepMs;
+        bool compress;
+        bool incremental;
+        std::string rulesText;  // runCleanupRules
+        bool dryRun;
+        std::vector<std::string> keys;  // findDuplicates: blocking keys
+        int maxClusters;
+
+        JobParams() : skipExisting(true), overwriteIfLarger(false), maxLength(0), minSizeBytes(0), useRegex(false),
+            pagesPerStep(256), sleepMs(10), compress(false), incremental(false), dryRun(true), maxClusters(5000) {}
+    };
+
+    struct JobStatus {
+        int id;
+        std::string type;
+        std::string status;  // "queued", "running", "paused", "cancelled", "completed", "failed", "interrupted"
+        std::string error;
+        std::string lastId;
+        int64_t rowsDone;
+        int64_t rowsTotal;
+        int64_t bytesDone;
+        std::vector<JobResult> results;  // Partial results produced since the previous poll
+    };
+
+private:
+    struct Job {
+        int id;
+        std::string type;
+        std::string status;
+        std::string error;
+        JobParams params;
+        bool started;  // Picked up by the worker at least once this session
+        std::shared_ptr<JobContext> context;
+    };
+
+    ArcadeConfig* config_;
+    SQLiteManager workerDb_;   // Worker thread's own connection
+    Library workerLibrary_;    // Tools executed against workerDb_
+    int batchSize_;
+
+    std::map<int, Job> jobs_;
+    std::deque<int> queue_;
+    std::vector<int> statusWrites_;  // Status changes made off the worker thread, persisted by the worker
+    bool persisting_;  // The worker is writing copied job state outside jobsMutex_
+    std::mutex jobsMutex_;
+    std::condition_variable queueCondition_;
+    std::thread worker_;
+    bool stopping_;
+    bool initialized_;
+
+    void debugOutput(const std::string& message) {
+        OutputDebugStringA(("[JobManager] " + message + "\n").c_str());
+    }
+
+    void workerLoop();
+    void runJob(int jobId);
+    bool createJobsTable();
+    void loadPersistedJobs();
+    void persistJob(const Job& job);
+    void persistStatus(int jobId, const std::string& status, const std::string& error);
+    std::vector<Job> takeStatusWrites();
+    void persistStatusWrites(const std::vector<Job>& writes);
+    std::vector<uint8_t> serializeParams(const JobParams& params);
+    JobParams deserializeParams(const void* blob, int size);
+
+public:
+    JobManager(ArcadeConfig* config);
+    virtual ~JobManager();
+
+    // Open the worker connection and recover jobs left over from a previous session.
+    // Must be called after the config has been loaded.
+    bool initialize();
+
+    int startJob(const std::string& type, const JobParams& params);
+    bool pauseJob(int jobId);
+    bool resumeJob(int jobId);  // Resumes paused jobs and re-queues interrupted/failed/cancelled ones from their checkpoint
+    bool cancelJob(int jobId);
+
+    // Close the worker connection so the database file can be replaced (online compaction).
+    // Fails while a job is queued, running or paused, or a status change is still to be written;
+    // the worker reopens on its next job.
+    bool releaseConnection();
+
+    // Snapshot of a job's progress; drains partial results when requested
+    JobStatus getJobStatus(int jobId, bool drainResults);
+    std::vector<JobStatus> listJobs();
+};
+
+#endif // JOB_MANAGER_H
@@ -2,13 +2,43 @@
 #include <windows.h>
 #include <set>
 #include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <ctime>
+#include <cctype>
+#include <cstring>
+#include <unordered_set>
+#include <regex>
+#include <atomic>
+#include <fstream>
+#include <winioctl.h>
 
 Library::Library(SQLiteManager* dbManager, ArcadeConfig* config)
     : dbManager_(dbManager), config_(config), imageLoader_(nullptr) {
+    diff_.dbA = nullptr;
+    diff_.dbB = nullptr;
+    diff_.stmtA = nullptr;
+    diff_.stmtB = nullptr;
+    diff_.hasRowA = false;
+    diff_.hasRowB = false;
+    diff_.tableIndex = 0;
+    diff_.active = false;
+    compaction_.copyDb = nullptr;
+    compaction_.status.running = false;
+    compaction_.status.readyToSwap = false;
+    compaction_.status.success = false;
+    compaction_.status.beforeSizeBytes = 0;
+    compaction_.status.copySizeBytes = 0;
+    compaction_.status.changesLogged = 0;
+    pendingAutoVacuumMode_ = -1;
     OutputDebugStringA("[Library] Library initialized\n");
 }
 
 Library::~Library() {
+    dbtCloseDiff();
+    if (compaction_.thread.joinable() || compaction_.status.readyToSwap) {
+        dbtCancelOnlineCompaction();
+    }
     OutputDebugStringA("[Library] Library destroyed\n");
 }
 
@@ -44,7 +74,12 @@ std::vector<std::pair<std::string, std::string>> Library::getFirstEntries(const
     }
 
     // Get the first entries
-    return dbManager_->getFirstEntries(entryType, count);
+    browseEntryType_ = entryType;
+    std::vector<std::pair<std::string, std::string>> entries = dbManager_->getFirstEntries(entryType, count);
+    for (auto& entry : entries) {
+        upgradeOnRead(entryType, entry);
+    }
+    return entries;
 }
 
 std::vector<std::pair<std::string, std::string>> Library::getNextEntries(int count) {
@@ -57,7 +92,11 @@ std::vector<std::pair<std::string, std::string>> Library::getNextEntries(int cou
     }
 
     // Get the next entries
-    return dbManager_->getNextEntries(count);
+    std::vector<std::pair<std::string, std::string>> entries = dbManager_->getNextEntries(count);
+    for (auto& entry : entries) {
+        upgradeOnRead(browseEntryType_, entry);
+    }
+    return entries;
 }
 
 std::pair<std::string, std::string> Library::getFirstEntry(const std::string& entryType) {
@@ -69,9 +108,11 @@ std::pair<std::string, std::string> Library::getFirstEntry(const std::string& en
     }
 
     // Get first entries with count of 1
+    browseEntryType_ = entryType;
     std::vector<std::pair<std::string, std::string>> entries = dbManager_->getFirstEntries(entryType, 1);
 
     if (!entries.empty()) {
+        upgradeOnRead(entryType, entries[0]);
         return entries[0];
     }
 
@@ -80,7 +121,9 @@ std::pair<std::string, std::string> Library::getFirstEntry(const std::string& en
 
 std::pair<std::string, std::string> Library::getNextEntry() {
     OutputDebugStringA("[Library] getNextEntry: Getting next entry\n");
-    return dbManager_->getNextEntry();
+    std::pair<std::string, std::string> entry = dbManager_->getNextEntry();
+    upgradeOnRead(browseEntryType_, entry);
+    return entry;
 }
 
 std::vector<std::pair<std::string, std::string>> Library::getFirstSearchResults(const std::string& entryType, const std::string& searchTerm, int count) {
@@ -98,7 +141,12 @@ std::vector<std::pair<std::string, std::string>> Library::getFirstSearchResults(
     }
 
     // Get the first search results
-    return dbManager_->getFirstSearchResults(entryType, searchTerm, count);
+    searchEntryType_ = entryType;
+    std::vector<std::pair<std::string, std::string>> entries = dbManager_->getFirstSearchResults(entryType, searchTerm, count);
+    for (auto& entry : entries) {
+        upgradeOnRead(entryType, entry);
+    }
+    return entries;
 }
 
 std::vector<std::pair<std::string, std::string>> Library::getNextSearchResults(int count) {
@@ -111,10 +159,14 @@ std::vector<std::pair<std::string, std::string>> Library::getNextSearchResults(i
     }
 
     // Get the next search results
-    return dbManager_->getNextSearchResults(count);
+    std::vector<std::pair<std::string, std::string>> entries = dbManager_->getNextSearchResults(count);
+    for (auto& entry : entries) {
+        upgradeOnRead(searchEntryType_, entry);
+    }
+    return entries;
 }
 
-void Library::cacheImage(const std::string& url, std::function<void(const ImageLoadResult&)> callback) {
+uint64_t Library::cacheImage(const std::string& url, std::function<void(const ImageLoadResult&)> callback, int priority) {
     OutputDebugStringA(("[Library] cacheImage: Processing URL '" + url + "'\n").c_str());
 
     if (!imageLoader_) {
@@ -124,11 +176,44 @@ void Library::cacheImage(const std::string& url, std::function<void(const ImageL
         result.success = false;
         result.filePath = "";
         result.url = url;
+        result.cancelled = false;
         callback(result);
-        return;
+        return 0;
+    }
+
+    return imageLoader_->loadAndCacheImage(url, callback, priority);
+}
+
+uint64_t Library::cacheImages(const std::vector<std::string>& urls, std::function<void(size_t, const ImageLoadResult&)> callback,
+                              int priority) {
+    OutputDebugStringA(("[Library] cacheImages: Processing " + std::to_string(urls.size()) + " URLs\n").c_str());
+
+    if (!imageLoader_) {
+        OutputDebugStringA("[Library] ERROR: ImageLoader not initialized!\n");
+        for (size_t i = 0; i < urls.size(); i++) {
+            ImageLoadResult result;
+            result.success = false;
+            result.filePath = "";
+            result.url = urls[i];
+            result.cancelled = false;
+            callback(i, result);
+        }
+        return 0;
     }
 
-    imageLoader_->loadAndCacheImage(url, callback);
+    return imageLoader_->loadAndCacheImages(urls, callback, priority);
+}
+
+int Library::reprioritizeImages(const std::vector<std::string>& urls, int priority) {
+    return imageLoader_ ? imageLoader_->reprioritize(urls, priority) : 0;
+}
+
+int Library::cancelImages(const std::vector<std::string>& urls, uint64_t requestId) {
+    return imageLoader_ ? imageLoader_->cancel(urls, requestId) : 0;
+}
+
+int Library::clearImageFailures(const std::vector<std::string>& urls) {
+    return imageLoader_ ? imageLoader_->clearFailures(urls) : 0;
 }
 
 void Library::processImageCompletions() {
@@ -137,8 +222,22 @@ void Library::processImageCompletions() {
     }
 }
 
-// Helper function to recursively collect field paths
-void Library::collectFieldPathsRecursive(ArcadeKeyValues* node, const std::string& currentPath, std::set<std::string>& fieldSet, bool isInstanceData, int depth) {
+// Value type label stored in the schema catalog
+static const char* schemaValueTypeName(ArcadeKeyValues* node) {
+    if (node->GetFirstSubKey() != nullptr) {
+        return "section";
+    }
+    switch (node->GetValueType()) {
+    case ArcadeKeyValues::TYPE_STRING: return "string";
+    case ArcadeKeyValues::TYPE_INT: return "int";
+    case ArcadeKeyValues::TYPE_FLOAT: return "float";
+    case ArcadeKeyValues::TYPE_SUBSECTION: return "section";
+    default: return "none";
+    }
+}
+
+// Helper function to recursively visit field paths (object and material ids collapse to placeholders)
+void Library::visitFieldPathsRecursive(ArcadeKeyValues* node, const std::string& currentPath, const FieldPathVisitor& visit, bool isInstanceData, int depth) {
     if (!node) return;
 
     ArcadeKeyValues* child = node->GetFirstSubKey();
@@ -153,14 +252,14 @@ void Library::collectFieldPathsRecursive(ArcadeKeyValues* node, const std::strin
                 // Check if we're entering the "objects" section (root level)
                 if (fieldName == "objects" && currentPath.empty()) {
                     // This is the "objects" field at the root level
-                    fieldSet.insert(fullPath);
+                    visit(fullPath, child);
 
                     // Inside objects, we have object IDs - handle them specially
                     ArcadeKeyValues* objectChild = child->GetFirstSubKey();
                     while (objectChild != nullptr) {
                         // Don't add the object ID itself, but process its children with placeholder
                         if (objectChild->GetFirstSubKey() != nullptr) {
-                            collectFieldPathsRecursive(objectChild, fullPath + ".[object_id]", fieldSet, isInstanceData, depth + 1);
+                            visitFieldPathsRecursive(objectChild, fullPath + ".[object_id]", visit, isInstanceData, depth + 1);
                         }
                         objectChild = objectChild->GetNextKey();
                     }
@@ -168,34 +267,34 @@ void Library::collectFieldPathsRecursive(ArcadeKeyValues* node, const std::strin
                 // Check if we're entering the "materials" section (under overrides)
                 else if (fieldName == "materials" && currentPath == "overrides") {
                     // This is the "materials" field under "overrides"
-                    fieldSet.insert(fullPath);
+                    visit(fullPath, child);
 
                     // Inside materials, we have material IDs - handle them specially
                     ArcadeKeyValues* materialChild = child->GetFirstSubKey();
                     while (materialChild != nullptr) {
                         // Don't add the material ID itself, but process its children with placeholder
                         if (materialChild->GetFirstSubKey() != nullptr) {
-                            collectFieldPathsRecursive(materialChild, fullPath + ".[material_id]", fieldSet, isInstanceData, depth + 1);
+                            visitFieldPathsRecursive(materialChild, fullPath + ".[material_id]", visit, isInstanceData, depth + 1);
                         }
                         materialChild = materialChild->GetNextKey();
                     }
                 }
                 else {
                     // Normal field - add it and recurse
-                    fieldSet.insert(fullPath);
+                    visit(fullPath, child);
 
                     // Recursively process nested objects
                     if (child->GetFirstSubKey() != nullptr) {
-                        collectFieldPathsRecursive(child, fullPath, fieldSet, isInstanceData, depth + 1);
+                        visitFieldPathsRecursive(child, fullPath, visit, isInstanceData, depth + 1);
                     }
                 }
             } else {
                 // Normal field - add it and recurse
-                fieldSet.insert(fullPath);
+                visit(fullPath, child);
 
                 // Recursively process nested objects
                 if (child->GetFirstSubKey() != nullptr) {
-                    collectFieldPathsRecursive(child, fullPath, fieldSet, isInstanceData, depth + 1);
+                    visitFieldPathsRecursive(child, fullPath, visit, isInstanceData, depth + 1);
                 }
             }
         }
@@ -203,418 +302,4767 @@ void Library::collectFieldPathsRecursive(ArcadeKeyValues* node, const std::strin
     }
 }
 
-std::vector<std::string> Library::constructSchema(const std::string& entryType) {
-    OutputDebugStringA(("[Library] constructSchema: Constructing schema for '" + entryType + "'\n").c_str());
+// Visit the field paths of one parsed entry (root -> "item"/"app"/etc -> fields)
+void Library::visitEntryFields(ArcadeKeyValues* root, const std::string& entryType, const FieldPathVisitor& visit) {
+    ArcadeKeyValues* tableSection = root ? root->GetFirstSubKey() : nullptr;
+    if (!tableSection) {
+        return;
+    }
 
-    std::vector<std::string> schema;
-    std::set<std::string> fieldSet; // Use set to track unique fields with paths
+    // Check if there's a "local" subsection (for items table compatibility)
+    ArcadeKeyValues* dataSection = tableSection->FindKey("local");
+    if (!dataSection) {
+        // If no local section, use the table section itself
+        dataSection = tableSection;
+    }
 
-    // Open database if not already open
-    if (!openDatabase()) {
-        OutputDebugStringA("[Library] constructSchema: Failed to open database\n");
-        return schema;
+    // Instances get special "objects" / "materials" handling
+    visitFieldPathsRecursive(dataSection, "", visit, entryType == "instances", 0);
+}
+
+// Collect the (path, value type) pairs of one parsed entry
+void Library::collectSchemaFields(ArcadeKeyValues* root, const std::string& entryType, SchemaFieldSet& fieldSet) {
+    visitEntryFields(root, entryType, [&fieldSet](const std::string& path, ArcadeKeyValues* node) {
+        fieldSet.insert({ path, schemaValueTypeName(node) });
+    });
+}
+
+bool Library::createSchemaCatalogTables(sqlite3* db) {
+    const char* sql =
+        "CREATE TABLE IF NOT EXISTS schema_catalog ("
+        "entry_type TEXT NOT NULL, "
+        "path TEXT NOT NULL, "
+        "value_type TEXT NOT NULL, "
+        "occurrences INTEGER NOT NULL, "
+        "first_seen INTEGER, "
+        "last_seen INTEGER, "
+        "PRIMARY KEY (entry_type, path, value_type));"
+        "CREATE TABLE IF NOT EXISTS schema_catalog_state ("
+        "entry_type TEXT PRIMARY KEY, "
+        "entries INTEGER NOT NULL, "
+        "built_at INTEGER);";
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] createSchemaCatalogTables: " + std::string(errMsg ? errMsg : "unknown error") + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        return false;
     }
+    return true;
+}
 
-    // Get all entries for this type
-    std::vector<std::pair<std::string, std::string>> allEntries = dbManager_->getFirstEntries(entryType, 10000);
+bool Library::isSchemaCatalogBuilt(sqlite3* db, const std::string& entryType) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM schema_catalog_state WHERE entry_type = ?;", -1, &stmt, nullptr) != SQLITE_OK) {
+        // Table doesn't exist yet - nothing to maintain
+        return false;
+    }
+    sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+    bool built = (sqlite3_step(stmt) == SQLITE_ROW);
+    sqlite3_finalize(stmt);
+    return built;
+}
 
-    OutputDebugStringA(("[Library] constructSchema: Analyzing " + std::to_string(allEntries.size()) + " entries\n").c_str());
+void Library::updateSchemaCatalog(sqlite3* db, const std::string& entryType, const SchemaFieldSet* before, const SchemaFieldSet* after) {
+    static const SchemaFieldSet emptySet;
+    const SchemaFieldSet& oldFields = before ? *before : emptySet;
+    const SchemaFieldSet& newFields = after ? *after : emptySet;
 
-    // Iterate through all entries and collect field names with paths
-    for (const auto& entry : allEntries) {
-        if (entry.second.empty()) {
-            continue;
-        }
+    std::vector<std::pair<std::string, std::string>> removed;
+    std::vector<std::pair<std::string, std::string>> added;
+    std::set_difference(oldFields.begin(), oldFields.end(), newFields.begin(), newFields.end(), std::back_inserter(removed));
+    std::set_difference(newFields.begin(), newFields.end(), oldFields.begin(), oldFields.end(), std::back_inserter(added));
 
-        // Parse the hex data
-        auto kvData = ArcadeKeyValues::ParseFromHex(entry.second);
-        if (!kvData) {
-            continue;
+    int entryDelta = (after ? 1 : 0) - (before ? 1 : 0);
+    if (removed.empty() && added.empty() && entryDelta == 0) {
+        return;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (entryDelta != 0 &&
+        sqlite3_prepare_v2(db, "UPDATE schema_catalog_state SET entries = MAX(0, entries + ?) WHERE entry_type = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_int(stmt, 1, entryDelta);
+        sqlite3_bind_text(stmt, 2, entryType.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+    }
+
+    if (!removed.empty() &&
+        sqlite3_prepare_v2(db, "UPDATE schema_catalog SET occurrences = occurrences - 1 WHERE entry_type = ? AND path = ? AND value_type = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        for (const auto& field : removed) {
+            sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 2, field.first.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 3, field.second.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(stmt);
+            sqlite3_reset(stmt);
         }
+        sqlite3_finalize(stmt);
 
-        // Navigate to the actual data section
-        // Structure is: root -> "item"/"app"/etc -> fields
-        ArcadeKeyValues* tableSection = kvData->GetFirstSubKey();
-        if (!tableSection) {
-            continue;
+        // Paths no longer present in any entry drop out of the schema
+        if (sqlite3_prepare_v2(db, "DELETE FROM schema_catalog WHERE entry_type = ? AND occurrences <= 0;", -1, &stmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
         }
+    }
 
-        // Check if there's a "local" subsection (for items table compatibility)
-        ArcadeKeyValues* dataSection = tableSection->FindKey("local");
-        if (!dataSection) {
-            // If no local section, use the table section itself
-            dataSection = tableSection;
+    if (!added.empty() &&
+        sqlite3_prepare_v2(db,
+            "INSERT INTO schema_catalog (entry_type, path, value_type, occurrences, first_seen, last_seen) "
+            "VALUES (?, ?, ?, 1, strftime('%s','now'), strftime('%s','now')) "
+            "ON CONFLICT (entry_type, path, value_type) DO UPDATE SET "
+            "occurrences = occurrences + 1, last_seen = excluded.last_seen;", -1, &stmt, nullptr) == SQLITE_OK) {
+        for (const auto& field : added) {
+            sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 2, field.first.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 3, field.second.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(stmt);
+            sqlite3_reset(stmt);
         }
+        sqlite3_finalize(stmt);
+    }
+}
+
+int Library::parallelScanWorkerCount() {
+    // One worker per core, at most 8
+    int workers = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(workers, 8));
+}
 
-        // Determine if this is an instances table (for special "objects" handling)
-        bool isInstanceData = (entryType == "instances");
+int64_t Library::scanTableParallel(const std::string& entryType, int workerCount, const std::function<void(int, int64_t, ArcadeKeyValues*)>& visit, std::string& error) {
+    sqlite3* db = dbManager_->getDb();
 
-        // Recursively collect all field paths
-        collectFieldPathsRecursive(dataSection, "", fieldSet, isInstanceData, 0);
+    int64_t minRowId = 0;
+    int64_t maxRowId = -1;
+    sqlite3_stmt* stmt = nullptr;
+    std::string rangeSql = "SELECT MIN(rowid), MAX(rowid) FROM \"" + entryType + "\";";
+    if (sqlite3_prepare_v2(db, rangeSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        error = "Failed to read table " + entryType + ": " + std::string(sqlite3_errmsg(db));
+        return -1;
+    }
+    if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
+        minRowId = sqlite3_column_int64(stmt, 0);
+        maxRowId = sqlite3_column_int64(stmt, 1);
     }
+    sqlite3_finalize(stmt);
 
-    // Convert set to vector for return
-    schema.assign(fieldSet.begin(), fieldSet.end());
+    if (maxRowId < minRowId) {
+        return 0;
+    }
 
-    // Sort alphabetically for consistency
-    std::sort(schema.begin(), schema.end());
+    // Small tables aren't worth the extra connections
+    int threadCount = std::max(1, workerCount);
+    if (maxRowId - minRowId < 1000) {
+        threadCount = 1;
+    }
 
-    OutputDebugStringA(("[Library] constructSchema: Found " + std::to_string(schema.size()) + " unique fields\n").c_str());
+    struct ScanPartition {
+        int64_t firstRowId;
+        int64_t lastRowId;
+        int64_t entries;
+        std::string error;
+    };
+
+    std::vector<ScanPartition> partitions(threadCount);
+    int64_t span = (maxRowId - minRowId + threadCount) / threadCount;
+    for (int i = 0; i < threadCount; i++) {
+        partitions[i].firstRowId = minRowId + span * i;
+        partitions[i].lastRowId = (i == threadCount - 1) ? maxRowId : minRowId + span * (i + 1) - 1;
+        partitions[i].entries = 0;
+    }
 
-    return schema;
-}
+    std::string dbPath = config_->getDatabasePath();
+    std::string scanSql = "SELECT rowid, value FROM \"" + entryType + "\" WHERE rowid BETWEEN ? AND ?;";
 
-std::vector<Library::LargeBlobEntry> Library::dbtFindLargeEntriesInTable(const std::string& tableName, int minSizeBytes) {
-    OutputDebugStringA(("[Library] dbtFindLargeEntriesInTable: Searching '" + tableName + "' for BLOBs over " + std::to_string(minSizeBytes) + " bytes\n").c_str());
+    auto scanPartition = [&dbPath, &scanSql, &visit](int worker, ScanPartition& partition) {
+        sqlite3* readDb = nullptr;
+        if (sqlite3_open_v2(dbPath.c_str(), &readDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+            partition.error = "Failed to open read connection";
+            if (readDb) sqlite3_close(readDb);
+            return;
+        }
+        sqlite3_busy_timeout(readDb, 5000);
 
-    std::vector<LargeBlobEntry> results;
+        sqlite3_stmt* scanStmt = nullptr;
+        if (sqlite3_prepare_v2(readDb, scanSql.c_str(), -1, &scanStmt, nullptr) != SQLITE_OK) {
+            partition.error = "Failed to prepare scan: " + std::string(sqlite3_errmsg(readDb));
+            sqlite3_close(readDb);
+            return;
+        }
+        sqlite3_bind_int64(scanStmt, 1, partition.firstRowId);
+        sqlite3_bind_int64(scanStmt, 2, partition.lastRowId);
 
-    // Open database if not already open
-    if (!openDatabase()) {
-        OutputDebugStringA("[Library] dbtFindLargeEntriesInTable: Failed to open database\n");
-        return results;
+        int rc;
+        while ((rc = sqlite3_step(scanStmt)) == SQLITE_ROW) {
+            partition.entries++;
+
+            const void* blob = sqlite3_column_blob(scanStmt, 1);
+            int blobSize = sqlite3_column_bytes(scanStmt, 1);
+            if (!blob || blobSize == 0) {
+                continue;
+            }
+
+            auto kvData = ArcadeKeyValues::ParseFromBinary(blob, blobSize);
+            visit(worker, sqlite3_column_int64(scanStmt, 0), kvData.get());
+        }
+        if (rc != SQLITE_DONE) {
+            partition.error = "Scan failed: " + std::string(sqlite3_errmsg(readDb));
+        }
+
+        sqlite3_finalize(scanStmt);
+        sqlite3_close(readDb);
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(scanPartition, i, std::ref(partitions[i]));
+    }
+    scanPartition(0, partitions[0]);
+    for (auto& worker : workers) {
+        worker.join();
     }
 
-    // Get large BLOBs from database
-    std::vector<std::pair<std::string, int>> largeBlobs = dbManager_->dbtFindLargeBlobsInTable(tableName, minSizeBytes);
+    int64_t entries = 0;
+    for (const auto& partition : partitions) {
+        if (!partition.error.empty()) {
+            error = partition.error;
+            return -1;
+        }
+        entries += partition.entries;
+    }
+    return entries;
+}
 
-    OutputDebugStringA(("[Library] dbtFindLargeEntriesInTable: Found " + std::to_string(largeBlobs.size()) + " large BLOBs\n").c_str());
+// Full catalog build for one entry type. The table is split into rowid ranges that
+// are parsed in parallel on read-only connections while this connection holds the
+// write lock, so no write can slip in between the scan and the catalog update.
+bool Library::buildSchemaCatalog(const std::string& entryType, std::string& error) {
+    OutputDebugStringA(("[Library] buildSchemaCatalog: Building schema catalog for '" + entryType + "'\n").c_str());
 
-    // For each large BLOB, fetch the full entry and extract title
-    for (const auto& blob : largeBlobs) {
-        const std::string& id = blob.first;
-        int sizeBytes = blob.second;
+    sqlite3* db = dbManager_->getDb();
+    if (!createSchemaCatalogTables(db)) {
+        error = "Failed to create schema catalog tables";
+        return false;
+    }
 
-        LargeBlobEntry entry;
-        entry.id = id;
-        entry.sizeBytes = sizeBytes;
-        entry.title = id; // Default to ID if title extraction fails
+    // === BEGIN TRANSACTION ===
+    // IMMEDIATE takes the write lock now; readers on other connections still proceed
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, "BEGIN IMMEDIATE;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        error = "Failed to begin transaction (is a background job writing?): " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] buildSchemaCatalog: " + error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        return false;
+    }
 
-        // Fetch the full entry data by ID
-        std::pair<std::string, std::string> entryData = dbManager_->getEntryById(tableName, id);
+    // Count (path, type) pairs per worker, merged once the scan is done
+    int workerCount = parallelScanWorkerCount();
+    std::vector<std::map<std::pair<std::string, std::string>, int64_t>> workerCounts(workerCount);
 
-        if (!entryData.second.empty()) {
-            // Parse the hex data to extract title
-            auto kvData = ArcadeKeyValues::ParseFromHex(entryData.second);
-            if (kvData) {
-                // Navigate to the actual data section
-                // Structure is: root -> "item"/"app"/etc -> fields
-                ArcadeKeyValues* tableSection = kvData->GetFirstSubKey();
-                if (tableSection) {
-                    // Check if there's a "local" subsection (for items table compatibility)
-                    ArcadeKeyValues* dataSection = tableSection->FindKey("local");
-                    if (!dataSection) {
-                        // If no local section, use the table section itself
-                        dataSection = tableSection;
-                    }
+    int64_t entries = scanTableParallel(entryType, workerCount, [this, &entryType, &workerCounts](int worker, int64_t, ArcadeKeyValues* root) {
+        SchemaFieldSet entryFields;
+        collectSchemaFields(root, entryType, entryFields);
+        for (const auto& field : entryFields) {
+            workerCounts[worker][field]++;
+        }
+    }, error);
 
-                    // Extract the title field
-                    std::string extractedTitle = dataSection->GetString("title", "");
-                    if (!extractedTitle.empty()) {
-                        entry.title = extractedTitle;
-                    }
-                }
+    if (entries < 0) {
+        OutputDebugStringA(("[Library] buildSchemaCatalog: " + error + "\n").c_str());
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return false;
+    }
+
+    std::map<std::pair<std::string, std::string>, int64_t> counts;
+    for (const auto& partial : workerCounts) {
+        for (const auto& count : partial) {
+            counts[count.first] += count.second;
+        }
+    }
+
+    // Replace the counts, keeping first_seen for paths that were already known
+    bool ok = true;
+    sqlite3_stmt* stmt = nullptr;
+    std::string resetSql = "UPDATE schema_catalog SET occurrences = 0 WHERE entry_type = ?;";
+    if (sqlite3_prepare_v2(db, resetSql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+        ok = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_finalize(stmt);
+    }
+
+    if (ok && sqlite3_prepare_v2(db,
+            "INSERT INTO schema_catalog (entry_type, path, value_type, occurrences, first_seen, last_seen) "
+            "VALUES (?, ?, ?, ?, strftime('%s','now'), strftime('%s','now')) "
+            "ON CONFLICT (entry_type, path, value_type) DO UPDATE SET occurrences = excluded.occurrences;", -1, &stmt, nullptr) == SQLITE_OK) {
+        for (const auto& count : counts) {
+            sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 2, count.first.first.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 3, count.first.second.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt, 4, count.second);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                ok = false;
             }
+            sqlite3_reset(stmt);
         }
+        sqlite3_finalize(stmt);
+    }
+    else {
+        ok = false;
+    }
 
-        results.push_back(entry);
+    if (ok && sqlite3_prepare_v2(db, "DELETE FROM schema_catalog WHERE entry_type = ? AND occurrences = 0;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+        ok = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_finalize(stmt);
     }
 
-    OutputDebugStringA(("[Library] dbtFindLargeEntriesInTable: Processed " + std::to_string(results.size()) + " entries\n").c_str());
+    if (ok && sqlite3_prepare_v2(db,
+            "INSERT OR REPLACE INTO schema_catalog_state (entry_type, entries, built_at) VALUES (?, ?, strftime('%s','now'));",
+            -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, entries);
+        ok = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_finalize(stmt);
+    }
 
-    return results;
+    // === COMMIT TRANSACTION ===
+    if (!ok || sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        error = "Failed to write schema catalog: " + std::string(sqlite3_errmsg(db));
+        OutputDebugStringA(("[Library] buildSchemaCatalog: " + error + "\n").c_str());
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return false;
+    }
+
+    OutputDebugStringA(("[Library] buildSchemaCatalog: " + std::to_string(entries) + " entries, " + std::to_string(counts.size()) + " fields\n").c_str());
+    return true;
 }
 
-std::vector<Library::TrimResult> Library::dbtTrimTextFields(const std::string& tableName, const std::vector<std::string>& entryIds, int maxLength) {
-    OutputDebugStringA(("[Library] dbtTrimTextFields: Trimming text fields for " + std::to_string(entryIds.size()) + " entries in " + tableName + "\n").c_str());
+std::vector<Library::SchemaField> Library::constructSchema(const std::string& entryType, bool rebuild, int sampleSize, SampleInfo* sampleInfo) {
+    OutputDebugStringA(("[Library] constructSchema: Constructing schema for '" + entryType + "'\n").c_str());
 
-    std::vector<TrimResult> results;
+    std::vector<SchemaField> schema;
 
     // Open database if not already open
     if (!openDatabase()) {
-        OutputDebugStringA("[Library] dbtTrimTextFields: Failed to open database\n");
-        // Return failure for all entries
-        for (const auto& id : entryIds) {
-            results.push_back({ id, false, "Database not available" });
-        }
-        return results;
+        OutputDebugStringA("[Library] constructSchema: Failed to open database\n");
+        return schema;
     }
 
-    // Get database handle
-    sqlite3* db = dbManager_->getDb();
-    if (!db) {
-        OutputDebugStringA("[Library] dbtTrimTextFields: Database handle is null\n");
-        for (const auto& id : entryIds) {
-            results.push_back({ id, false, "Database handle is null" });
-        }
-        return results;
+    // Only the supported entry tables may be scanned (the name ends up in SQL)
+    std::vector<std::string> supportedTypes = getSupportedEntryTypes();
+    if (std::find(supportedTypes.begin(), supportedTypes.end(), entryType) == supportedTypes.end()) {
+        OutputDebugStringA(("[Library] constructSchema: Unsupported entry type '" + entryType + "'\n").c_str());
+        return schema;
     }
 
-    // === TRANSACTION DIAGNOSTICS ===
-    OutputDebugStringA("[Library] dbtTrimTextFields: === Transaction Diagnostics ===\n");
+    // Sampled: count paths over the sample only, leaving the catalog untouched
+    if (sampleSize > 0) {
+        std::vector<std::pair<std::string, std::string>> sample = getAnalysisEntries(entryType, 0, sampleSize, sampleInfo);
 
-    // Check current journal mode
-    sqlite3_stmt* diagStmt = nullptr;
-    if (sqlite3_prepare_v2(db, "PRAGMA journal_mode;", -1, &diagStmt, nullptr) == SQLITE_OK) {
-        if (sqlite3_step(diagStmt) == SQLITE_ROW) {
-            const char* mode = (const char*)sqlite3_column_text(diagStmt, 0);
-            OutputDebugStringA(("[Library] Current journal_mode: " + std::string(mode ? mode : "unknown") + "\n").c_str());
+        std::map<std::pair<std::string, std::string>, int64_t> counts;
+        for (const auto& entry : sample) {
+            if (entry.second.empty()) {
+                continue;
+            }
+            auto kvData = ArcadeKeyValues::ParseFromHex(entry.second);
+            SchemaFieldSet entryFields;
+            collectSchemaFields(kvData.get(), entryType, entryFields);
+            for (const auto& field : entryFields) {
+                counts[field]++;
+            }
         }
-        sqlite3_finalize(diagStmt);
-    }
 
-    // Check current synchronous setting
-    if (sqlite3_prepare_v2(db, "PRAGMA synchronous;", -1, &diagStmt, nullptr) == SQLITE_OK) {
-        if (sqlite3_step(diagStmt) == SQLITE_ROW) {
-            int syncValue = sqlite3_column_int(diagStmt, 0);
-            OutputDebugStringA(("[Library] Current synchronous: " + std::to_string(syncValue) +
-                              " (0=OFF, 1=NORMAL, 2=FULL)\n").c_str());
+        for (const auto& count : counts) {
+            SchemaField field;
+            field.path = count.first.first;
+            field.valueType = count.first.second;
+            field.occurrences = count.second;
+            field.frequency = static_cast<double>(count.second) / sample.size();
+            field.firstSeen = 0;
+            field.lastSeen = 0;
+            schema.push_back(field);
         }
-        sqlite3_finalize(diagStmt);
-    }
 
-    // === CONFIGURE DATABASE FOR RELIABLE WRITES ===
-    OutputDebugStringA("[Library] dbtTrimTextFields: Configuring database for reliable writes...\n");
+        OutputDebugStringA(("[Library] constructSchema: Found " + std::to_string(schema.size()) + " fields in a sample of " + std::to_string(sample.size()) + " entries\n").c_str());
+        return schema;
+    }
 
-    // Force DELETE journal mode (not WAL)
-    char* errMsg = nullptr;
-    int rc = sqlite3_exec(db, "PRAGMA journal_mode=DELETE;", nullptr, nullptr, &errMsg);
-    if (rc != SQLITE_OK) {
-        std::string error = "Failed to set journal mode: " + std::string(errMsg ? errMsg : "unknown error");
-        OutputDebugStringA(("[Library] dbtTrimTextFields: " + error + "\n").c_str());
-        if (errMsg) sqlite3_free(errMsg);
-        for (const auto& id : entryIds) {
-            results.push_back({ id, false, error });
+    sqlite3* db = dbManager_->getDb();
+    if (rebuild || !isSchemaCatalogBuilt(db, entryType)) {
+        std::string error;
+        if (!buildSchemaCatalog(entryType, error)) {
+            return schema;
         }
-        return results;
     }
-    OutputDebugStringA("[Library] Journal mode set to DELETE\n");
 
-    // Set synchronous to FULL
-    rc = sqlite3_exec(db, "PRAGMA synchronous=FULL;", nullptr, nullptr, &errMsg);
-    if (rc != SQLITE_OK) {
-        std::string error = "Failed to set synchronous mode: " + std::string(errMsg ? errMsg : "unknown error");
-        OutputDebugStringA(("[Library] dbtTrimTextFields: " + error + "\n").c_str());
-        if (errMsg) sqlite3_free(errMsg);
-        for (const auto& id : entryIds) {
-            results.push_back({ id, false, error });
+    int64_t entries = 0;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT entries FROM schema_catalog_state WHERE entry_type = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            entries = sqlite3_column_int64(stmt, 0);
         }
-        return results;
+        sqlite3_finalize(stmt);
     }
-    OutputDebugStringA("[Library] Synchronous mode set to FULL\n");
 
-    // === BEGIN TRANSACTION ===
-    OutputDebugStringA("[Library] dbtTrimTextFields: Beginning transaction...\n");
-    rc = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg);
-    if (rc != SQLITE_OK) {
-        std::string error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
-        OutputDebugStringA(("[Library] dbtTrimTextFields: " + error + "\n").c_str());
-        if (errMsg) sqlite3_free(errMsg);
-        for (const auto& id : entryIds) {
-            results.push_back({ id, false, error });
-        }
-        return results;
+    const char* sql = "SELECT path, value_type, occurrences, first_seen, last_seen FROM schema_catalog "
+                      "WHERE entry_type = ? ORDER BY path, value_type;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] constructSchema: Failed to query catalog: " + std::string(sqlite3_errmsg(db)) + "\n").c_str());
+        return schema;
     }
-    OutputDebugStringA("[Library] Transaction started successfully\n");
+    sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
 
-    // Process each entry
-    for (const auto& id : entryIds) {
-        TrimResult result;
-        result.id = id;
-        result.success = false;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        SchemaField field;
+        const char* path = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        const char* valueType = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        field.path = path ? path : "";
+        field.valueType = valueType ? valueType : "";
+        field.occurrences = sqlite3_column_int64(stmt, 2);
+        field.frequency = entries > 0 ? static_cast<double>(field.occurrences) / entries : 0.0;
+        field.firstSeen = sqlite3_column_int64(stmt, 3);
+        field.lastSeen = sqlite3_column_int64(stmt, 4);
+        schema.push_back(field);
+    }
+    sqlite3_finalize(stmt);
 
-        // Fetch the entry data
-        std::pair<std::string, std::string> entryData = dbManager_->getEntryById(tableName, id);
+    if (sampleInfo) {
+        sampleInfo->sampled = false;
+        sampleInfo->sampledRows = entries;
+        sampleInfo->estimatedTotalRows = entries;
+        sampleInfo->coverage = 1.0;
+    }
 
-        if (entryData.second.empty()) {
-            result.error = "Entry not found";
-            results.push_back(result);
-            continue;
-        }
+    OutputDebugStringA(("[Library] constructSchema: Found " + std::to_string(schema.size()) + " fields in " + std::to_string(entries) + " entries\n").c_str());
 
-        // Parse the KeyValues data
-        auto kvData = ArcadeKeyValues::ParseFromHex(entryData.second);
-        if (!kvData) {
-            result.error = "Failed to parse KeyValues data";
-            results.push_back(result);
+    return schema;
+}
+
+bool Library::dbtBuildSchemaCatalog(const std::string& entryType, std::string& error) {
+    // Open database if not already open
+    if (!openDatabase()) {
+        error = "Failed to open database";
+        return false;
+    }
+
+    // Only the supported entry tables may be scanned (the name ends up in SQL)
+    std::vector<std::string> supportedTypes = getSupportedEntryTypes();
+    if (std::find(supportedTypes.begin(), supportedTypes.end(), entryType) == supportedTypes.end()) {
+        error = "Unsupported entry type: " + entryType;
+        return false;
+    }
+
+    return buildSchemaCatalog(entryType, error);
+}
+
+std::vector<std::pair<std::string, std::string>> Library::getAnalysisEntries(const std::string& tableName, int maxRows, int sampleSize, SampleInfo* sampleInfo) {
+    std::vector<std::pair<std::string, std::string>> entries;
+    int64_t estimatedTotalRows = 0;
+
+    if (sampleSize > 0) {
+        entries = dbManager_->dbtSampleEntries(tableName, sampleSize, estimatedTotalRows);
+    }
+    else {
+        entries = dbManager_->getFirstEntries(tableName, maxRows);
+        estimatedTotalRows = static_cast<int64_t>(entries.size());
+    }
+
+    if (sampleInfo) {
+        sampleInfo->sampled = sampleSize > 0 && static_cast<int64_t>(entries.size()) < estimatedTotalRows;  // Small tables are read completely
+        sampleInfo->sampledRows = static_cast<int64_t>(entries.size());
+        sampleInfo->estimatedTotalRows = estimatedTotalRows;
+        sampleInfo->coverage = estimatedTotalRows > 0 ? static_cast<double>(entries.size()) / estimatedTotalRows : 1.0;
+    }
+
+    return entries;
+}
+
+bool Library::createFieldStatisticsTables(sqlite3* db) {
+    const char* sql =
+        "CREATE TABLE IF NOT EXISTS field_statistics ("
+        "entry_type TEXT NOT NULL, "
+        "path TEXT NOT NULL, "
+        "value_count INTEGER, "
+        "distinct_estimate INTEGER, "
+        "sketch BLOB, "
+        "PRIMARY KEY (entry_type, path));"
+        "CREATE TABLE IF NOT EXISTS field_statistics_state ("
+        "entry_type TEXT PRIMARY KEY, "
+        "entries INTEGER NOT NULL, "
+        "computed_at INTEGER);";
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] createFieldStatisticsTables: " + std::string(errMsg ? errMsg : "unknown error") + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+// Convert merged sketches to the result structure
+static Library::FieldStatistics fieldStatisticsFromSketch(const std::string& path, const FieldSketch& sketch) {
+    Library::FieldStatistics stats;
+    stats.path = path;
+    stats.count = sketch.count;
+    stats.distinctEstimate = static_cast<int64_t>(std::llround(sketch.distinct.estimate()));
+    stats.maxLength = static_cast<int64_t>(sketch.maxLength);
+    for (const auto& value : sketch.topValues.top()) {
+        stats.topValues.push_back({ value.first, value.second });
+    }
+    stats.lengthHistogram = sketch.lengths.getBuckets();
+    return stats;
+}
+
+Library::FieldStatisticsResult Library::dbtComputeFieldStatistics(const std::string& entryType, JobContext* job) {
+    OutputDebugStringA(("[Library] dbtComputeFieldStatistics: Computing field statistics for '" + entryType + "'\n").c_str());
+
+    FieldStatisticsResult result;
+    result.success = false;
+    result.entries = 0;
+    result.computedAt = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Failed to open database";
+        OutputDebugStringA("[Library] dbtComputeFieldStatistics: Failed to open database\n");
+        return result;
+    }
+
+    // Only the supported entry tables may be scanned (the name ends up in SQL)
+    std::vector<std::string> supportedTypes = getSupportedEntryTypes();
+    if (std::find(supportedTypes.begin(), supportedTypes.end(), entryType) == supportedTypes.end()) {
+        result.error = "Unsupported entry type: " + entryType;
+        return result;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    if (!createFieldStatisticsTables(db)) {
+        result.error = "Failed to create field statistics tables";
+        return result;
+    }
+
+    // As a job, progress counts scanned rows and each saved field is pushed as a "field" result
+    // (id = path, sizeBytes = distinct estimate). There is no row checkpoint; a resumed job starts over.
+    if (job) {
+        job->rowsTotal = dbManager_->getTableRowCount(entryType);
+        job->rowsDone = 0;
+    }
+
+    // Each scan thread keeps its own sketches; they are merged afterwards
+    int workerCount = parallelScanWorkerCount();
+    std::vector<std::map<std::string, FieldSketch>> workerSketches(workerCount);
+
+    result.entries = scanTableParallel(entryType, workerCount, [this, &entryType, &workerSketches, job](int worker, int64_t, ArcadeKeyValues* root) {
+        if (job) {
+            // The scan can't stop part way; once cancelled, the remaining rows are only read
+            if (job->cancelRequested) {
+                return;
+            }
+            job->rowsDone++;
+        }
+
+        std::map<std::string, FieldSketch>& sketches = workerSketches[worker];
+        visitEntryFields(root, entryType, [&sketches](const std::string& path, ArcadeKeyValues* node) {
+            // Only leaf values are counted; sections have no value of their own
+            if (node->GetFirstSubKey() != nullptr) {
+                return;
+            }
+            switch (node->GetValueType()) {
+            case ArcadeKeyValues::TYPE_STRING:
+                sketches[path].add(node->GetString());
+                break;
+            case ArcadeKeyValues::TYPE_INT:
+                sketches[path].add(std::to_string(node->GetInt()));
+                break;
+            case ArcadeKeyValues::TYPE_FLOAT:
+                sketches[path].add(std::to_string(node->GetFloat()));
+                break;
+            default:
+                break;
+            }
+        });
+    }, result.error);
+
+    if (result.entries < 0) {
+        OutputDebugStringA(("[Library] dbtComputeFieldStatistics: " + result.error + "\n").c_str());
+        result.entries = 0;
+        return result;
+    }
+
+    // A cancelled scan saw only part of the table; keep the previous statistics
+    if (job && job->shouldStop()) {
+        result.error = "Cancelled";
+        return result;
+    }
+
+    std::map<std::string, FieldSketch> merged;
+    for (auto& sketches : workerSketches) {
+        for (auto& sketch : sketches) {
+            merged[sketch.first].merge(sketch.second);
+        }
+        sketches.clear();
+    }
+
+    // === BEGIN TRANSACTION ===
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        result.error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        return result;
+    }
+
+    bool ok = true;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "DELETE FROM field_statistics WHERE entry_type = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+        ok = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_finalize(stmt);
+    }
+
+    if (ok && sqlite3_prepare_v2(db,
+            "INSERT INTO field_statistics (entry_type, path, value_count, distinct_estimate, sketch) VALUES (?, ?, ?, ?, ?);",
+            -1, &stmt, nullptr) == SQLITE_OK) {
+        for (const auto& sketch : merged) {
+            FieldStatistics stats = fieldStatisticsFromSketch(sketch.first, sketch.second);
+            std::vector<uint8_t> blob = sketch.second.serialize();
+
+            sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 2, sketch.first.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt, 3, stats.count);
+            sqlite3_bind_int64(stmt, 4, stats.distinctEstimate);
+            sqlite3_bind_blob(stmt, 5, blob.data(), static_cast<int>(blob.size()), SQLITE_TRANSIENT);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                ok = false;
+            }
+            sqlite3_reset(stmt);
+
+            result.fields.push_back(stats);
+        }
+        sqlite3_finalize(stmt);
+    }
+    else {
+        ok = false;
+    }
+
+    if (ok && sqlite3_prepare_v2(db,
+            "INSERT OR REPLACE INTO field_statistics_state (entry_type, entries, computed_at) VALUES (?, ?, strftime('%s','now'));",
+            -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, result.entries);
+        ok = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_finalize(stmt);
+    }
+
+    // === COMMIT TRANSACTION ===
+    if (!ok || sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        result.error = "Failed to save field statistics: " + std::string(sqlite3_errmsg(db));
+        OutputDebugStringA(("[Library] dbtComputeFieldStatistics: " + result.error + "\n").c_str());
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        result.fields.clear();
+        return result;
+    }
+
+    result.success = true;
+    result.computedAt = static_cast<int64_t>(time(nullptr));
+
+    if (job) {
+        for (const auto& stats : result.fields) {
+            job->pushResult({ stats.path, "field", true, "", static_cast<int>(stats.distinctEstimate) });
+        }
+    }
+
+    OutputDebugStringA(("[Library] dbtComputeFieldStatistics: " + std::to_string(result.fields.size()) + " fields over " +
+                      std::to_string(result.entries) + " entries\n").c_str());
+
+    return result;
+}
+
+Library::FieldStatisticsResult Library::dbtGetFieldStatistics(const std::string& entryType) {
+    FieldStatisticsResult result;
+    result.success = false;
+    result.entries = 0;
+    result.computedAt = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Failed to open database";
+        return result;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    if (!createFieldStatisticsTables(db)) {
+        result.error = "Failed to create field statistics tables";
+        return result;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT entries, computed_at FROM field_statistics_state WHERE entry_type = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            result.entries = sqlite3_column_int64(stmt, 0);
+            result.computedAt = sqlite3_column_int64(stmt, 1);
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    if (sqlite3_prepare_v2(db, "SELECT path, sketch FROM field_statistics WHERE entry_type = ? ORDER BY path;", -1, &stmt, nullptr) != SQLITE_OK) {
+        result.error = "Failed to query field statistics: " + std::string(sqlite3_errmsg(db));
+        return result;
+    }
+    sqlite3_bind_text(stmt, 1, entryType.c_str(), -1, SQLITE_TRANSIENT);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const char* path = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        const void* blob = sqlite3_column_blob(stmt, 1);
+        int blobSize = sqlite3_column_bytes(stmt, 1);
+
+        FieldSketch sketch;
+        if (!path || !blob || !sketch.deserialize(blob, blobSize)) {
+            OutputDebugStringA(("[Library] dbtGetFieldStatistics: Skipping unreadable sketch for " + std::string(path ? path : "") + "\n").c_str());
             continue;
         }
+        result.fields.push_back(fieldStatisticsFromSketch(path, sketch));
+    }
+    sqlite3_finalize(stmt);
+
+    result.success = true;
+    return result;
+}
+
+std::vector<Library::LargeBlobEntry> Library::dbtFindLargeEntriesInTable(const std::string& tableName, int minSizeBytes, int sampleSize, SampleInfo* sampleInfo) {
+    OutputDebugStringA(("[Library] dbtFindLargeEntriesInTable: Searching '" + tableName + "' for BLOBs over " + std::to_string(minSizeBytes) + " bytes\n").c_str());
+
+    std::vector<LargeBlobEntry> results;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        OutputDebugStringA("[Library] dbtFindLargeEntriesInTable: Failed to open database\n");
+        return results;
+    }
+
+    std::vector<std::pair<std::string, int>> largeBlobs;
+    if (sampleSize > 0) {
+        // Sampled: size check over the sampled rows only
+        std::vector<std::string> supportedTypes = getSupportedEntryTypes();
+        if (std::find(supportedTypes.begin(), supportedTypes.end(), tableName) == supportedTypes.end()) {
+            OutputDebugStringA(("[Library] dbtFindLargeEntriesInTable: Unsupported table '" + tableName + "'\n").c_str());
+            return results;
+        }
+
+        for (const auto& entry : getAnalysisEntries(tableName, 0, sampleSize, sampleInfo)) {
+            int sizeBytes = static_cast<int>(entry.second.size() / 2);
+            if (sizeBytes > minSizeBytes) {
+                largeBlobs.push_back({ entry.first, sizeBytes });
+            }
+        }
+        std::sort(largeBlobs.begin(), largeBlobs.end(), [](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
+            return a.second > b.second;
+        });
+    }
+    else {
+        // Get large BLOBs from database
+        largeBlobs = dbManager_->dbtFindLargeBlobsInTable(tableName, minSizeBytes);
+        if (sampleInfo) {
+            sampleInfo->sampled = false;
+            sampleInfo->sampledRows = 0;
+            sampleInfo->estimatedTotalRows = 0;
+            sampleInfo->coverage = 1.0;
+        }
+    }
+
+    OutputDebugStringA(("[Library] dbtFindLargeEntriesInTable: Found " + std::to_string(largeBlobs.size()) + " large BLOBs\n").c_str());
+
+    // For each large BLOB, fetch the full entry and extract title
+    for (const auto& blob : largeBlobs) {
+        const std::string& id = blob.first;
+        int sizeBytes = blob.second;
+
+        LargeBlobEntry entry;
+        entry.id = id;
+        entry.sizeBytes = sizeBytes;
+        entry.title = id; // Default to ID if title extraction fails
+
+        // Fetch the full entry data by ID
+        std::pair<std::string, std::string> entryData = dbManager_->getEntryById(tableName, id);
+
+        if (!entryData.second.empty()) {
+            // Parse the hex data to extract title
+            auto kvData = ArcadeKeyValues::ParseFromHex(entryData.second);
+            if (kvData) {
+                // Navigate to the actual data section
+                // Structure is: root -> "item"/"app"/etc -> fields
+                ArcadeKeyValues* tableSection = kvData->GetFirstSubKey();
+                if (tableSection) {
+                    // Check if there's a "local" subsection (for items table compatibility)
+                    ArcadeKeyValues* dataSection = tableSection->FindKey("local");
+                    if (!dataSection) {
+                        // If no local section, use the table section itself
+                        dataSection = tableSection;
+                    }
+
+                    // Extract the title field
+                    std::string extractedTitle = dataSection->GetString("title", "");
+                    if (!extractedTitle.empty()) {
+                        entry.title = extractedTitle;
+                    }
+                }
+            }
+        }
+
+        results.push_back(entry);
+    }
+
+    OutputDebugStringA(("[Library] dbtFindLargeEntriesInTable: Processed " + std::to_string(results.size()) + " entries\n").c_str());
+
+    return results;
+}
+
+// Helper to hand finished rows to a running job and cross batch boundaries.
+// Returns false if the job was cancelled.
+template <typename ResultT>
+static bool flushResultsToJob(sqlite3* db, JobContext* job, std::vector<ResultT>& results, const char* doneAction) {
+    bool keepGoing = true;
+    for (const auto& r : results) {
+        job->pushResult({ r.id, r.success ? doneAction : "failed", r.success, r.error, 0 });
+        job->rowsDone++;
+        if (!job->commitBatchIfNeeded(db, r.id)) {
+            keepGoing = false;
+        }
+    }
+    results.clear();
+    return keepGoing;
+}
+
+static bool flushResultsToJob(sqlite3* db, JobContext* job, std::vector<Library::MergeEntry>& entries) {
+    bool keepGoing = true;
+    for (const auto& e : entries) {
+        job->pushResult({ e.id, e.action, e.action != "failed", e.error, e.blobSizeBytes });
+        job->rowsDone++;
+        job->bytesDone += e.blobSizeBytes;
+        if (!job->commitBatchIfNeeded(db, e.id)) {
+            keepGoing = false;
+        }
+    }
+    entries.clear();
+    return keepGoing;
+}
+
+// Flush the undo journal before the final COMMIT and detach it from the job.
+// A direct call that wrote nothing leaves no journal behind.
+static void finishUndoJournal(UndoJournal& journal, JobContext* job) {
+    journal.flush();
+    if (job) {
+        job->undoJournal = nullptr;
+    } else if (journal.recordCount() == 0) {
+        std::string path = journal.path();
+        journal.close();
+        DeleteFileA(path.c_str());
+    }
+}
+
+// Helper to order an id list for a job and drop ids handled by a previous run
+static std::vector<std::string> prepareJobIds(JobContext* job, const std::vector<std::string>& ids) {
+    if (!job) {
+        return ids;
+    }
+
+    std::vector<std::string> sorted = ids;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::vector<std::string> remaining;
+    for (const auto& id : sorted) {
+        if (!job->isAlreadyProcessed(id)) {
+            remaining.push_back(id);
+        }
+    }
+
+    job->rowsTotal = static_cast<int64_t>(sorted.size());
+    job->rowsDone = static_cast<int64_t>(sorted.size() - remaining.size());
+    return remaining;
+}
+
+std::vector<Library::TrimResult> Library::dbtTrimTextFields(const std::string& tableName, const std::vector<std::string>& requestedIds, int maxLength, JobContext* job) {
+    OutputDebugStringA(("[Library] dbtTrimTextFields: Trimming text fields for " + std::to_string(requestedIds.size()) + " entries in " + tableName + "\n").c_str());
+
+    // Jobs process ids in order so the checkpoint can resume mid-list
+    const std::vector<std::string> entryIds = prepareJobIds(job, requestedIds);
+
+    std::vector<TrimResult> results;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        OutputDebugStringA("[Library] dbtTrimTextFields: Failed to open database\n");
+        // Return failure for all entries
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, "Database not available" });
+        }
+        return results;
+    }
+
+    // Get database handle
+    sqlite3* db = dbManager_->getDb();
+    if (!db) {
+        OutputDebugStringA("[Library] dbtTrimTextFields: Database handle is null\n");
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, "Database handle is null" });
+        }
+        return results;
+    }
+
+    // === TRANSACTION DIAGNOSTICS ===
+    OutputDebugStringA("[Library] dbtTrimTextFields: === Transaction Diagnostics ===\n");
+
+    // Check current journal mode
+    sqlite3_stmt* diagStmt = nullptr;
+    if (sqlite3_prepare_v2(db, "PRAGMA journal_mode;", -1, &diagStmt, nullptr) == SQLITE_OK) {
+        if (sqlite3_step(diagStmt) == SQLITE_ROW) {
+            const char* mode = (const char*)sqlite3_column_text(diagStmt, 0);
+            OutputDebugStringA(("[Library] Current journal_mode: " + std::string(mode ? mode : "unknown") + "\n").c_str());
+        }
+        sqlite3_finalize(diagStmt);
+    }
+
+    // Check current synchronous setting
+    if (sqlite3_prepare_v2(db, "PRAGMA synchronous;", -1, &diagStmt, nullptr) == SQLITE_OK) {
+        if (sqlite3_step(diagStmt) == SQLITE_ROW) {
+            int syncValue = sqlite3_column_int(diagStmt, 0);
+            OutputDebugStringA(("[Library] Current synchronous: " + std::to_string(syncValue) +
+                              " (0=OFF, 1=NORMAL, 2=FULL)\n").c_str());
+        }
+        sqlite3_finalize(diagStmt);
+    }
+
+    // === CONFIGURE DATABASE FOR RELIABLE WRITES ===
+    OutputDebugStringA("[Library] dbtTrimTextFields: Configuring database for reliable writes...\n");
+
+    // Force DELETE journal mode (not WAL)
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(db, "PRAGMA journal_mode=DELETE;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = "Failed to set journal mode: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtTrimTextFields: " + error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, error });
+        }
+        return results;
+    }
+    OutputDebugStringA("[Library] Journal mode set to DELETE\n");
+
+    // Set synchronous to FULL
+    rc = sqlite3_exec(db, "PRAGMA synchronous=FULL;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = "Failed to set synchronous mode: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtTrimTextFields: " + error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, error });
+        }
+        return results;
+    }
+    OutputDebugStringA("[Library] Synchronous mode set to FULL\n");
+
+    // Before-images of every row written, so the run can be undone
+    UndoJournal undo;
+    std::string undoError;
+    if (!openUndoJournal("trimTextFields", job, undo, undoError)) {
+        OutputDebugStringA(("[Library] dbtTrimTextFields: " + undoError + "\n").c_str());
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, undoError });
+        }
+        return results;
+    }
+
+    // === BEGIN TRANSACTION ===
+    OutputDebugStringA("[Library] dbtTrimTextFields: Beginning transaction...\n");
+    rc = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtTrimTextFields: " + error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, error });
+        }
+        return results;
+    }
+    OutputDebugStringA("[Library] Transaction started successfully\n");
+    if (job) {
+        job->undoJournal = &undo;
+    }
+
+    // Keep the schema catalog current if it has been built for this table
+    bool trackSchema = isSchemaCatalogBuilt(db, tableName);
+
+    // Process each entry
+    for (const auto& id : entryIds) {
+        // Stream finished rows to the job (commits every batch, honours pause/cancel)
+        if (job && !flushResultsToJob(db, job, results, "trimmed")) {
+            OutputDebugStringA("[Library] dbtTrimTextFields: Job cancelled\n");
+            break;
+        }
+
+        TrimResult result;
+        result.id = id;
+        result.success = false;
+
+        // Fetch the entry data
+        std::pair<std::string, std::string> entryData = dbManager_->getEntryById(tableName, id);
+
+        if (entryData.second.empty()) {
+            result.error = "Entry not found";
+            results.push_back(result);
+            continue;
+        }
+
+        // Parse the KeyValues data
+        auto kvData = ArcadeKeyValues::ParseFromHex(entryData.second);
+        if (!kvData) {
+            result.error = "Failed to parse KeyValues data";
+            results.push_back(result);
+            continue;
+        }
+
+        // Navigate to the data section
+        ArcadeKeyValues* tableSection = kvData->GetFirstSubKey();
+        if (!tableSection) {
+            result.error = "Invalid data structure";
+            results.push_back(result);
+            continue;
+        }
+
+        // Check for "local" subsection (items table compatibility)
+        ArcadeKeyValues* dataSection = tableSection->FindKey("local");
+        if (!dataSection) {
+            dataSection = tableSection;
+        }
+
+        SchemaFieldSet fieldsBefore;
+        if (trackSchema) {
+            collectSchemaFields(kvData.get(), tableName, fieldsBefore);
+        }
+
+        // Track if we made any changes
+        bool modified = false;
+
+        // Trim "title" field
+        std::string title = dataSection->GetString("title", "");
+        if (title.length() > static_cast<size_t>(maxLength)) {
+            std::string trimmedTitle = title.substr(0, maxLength);
+            dataSection->SetString("title", trimmedTitle.c_str());
+            modified = true;
+            OutputDebugStringA(("[Library] Trimmed title for " + id + " from " + std::to_string(title.length()) + " to " + std::to_string(maxLength) + " chars\n").c_str());
+        }
+
+        // Trim "description" field
+        std::string description = dataSection->GetString("description", "");
+        if (description.length() > static_cast<size_t>(maxLength)) {
+            std::string trimmedDescription = description.substr(0, maxLength);
+            dataSection->SetString("description", trimmedDescription.c_str());
+            modified = true;
+            OutputDebugStringA(("[Library] Trimmed description for " + id + " from " + std::to_string(description.length()) + " to " + std::to_string(maxLength) + " chars\n").c_str());
+        }
+
+        // Only update if we made changes
+        if (modified) {
+            // Serialize back to hex
+            std::string updatedHex = kvData->SerializeToHex();
+
+            // Journal the old value, then update in database
+            if (!undo.recordBefore(tableName, id, entryData.second, updatedHex)) {
+                result.error = "Failed to write undo journal";
+            }
+            else if (dbManager_->updateEntryById(tableName, id, updatedHex)) {
+                result.success = true;
+                result.error = "";
+                if (trackSchema) {
+                    SchemaFieldSet fieldsAfter;
+                    collectSchemaFields(kvData.get(), tableName, fieldsAfter);
+                    updateSchemaCatalog(db, tableName, &fieldsBefore, &fieldsAfter);
+                }
+                OutputDebugStringA(("[Library] Successfully trimmed text fields for " + id + "\n").c_str());
+            }
+            else {
+                result.error = "Failed to update database";
+                OutputDebugStringA(("[Library] Failed to update database for " + id + "\n").c_str());
+            }
+        }
+        else {
+            // No changes needed, consider it a success
+            result.success = true;
+            result.error = "No trimming needed";
+            OutputDebugStringA(("[Library] No trimming needed for " + id + "\n").c_str());
+        }
+
+        results.push_back(result);
+    }
+
+    if (job) {
+        flushResultsToJob(db, job, results, "trimmed");
+        job->saveCheckpoint(db, job->getLastId());
+    }
+
+    finishUndoJournal(undo, job);
+
+    // === COMMIT TRANSACTION ===
+    OutputDebugStringA("[Library] dbtTrimTextFields: Committing transaction...\n");
+    errMsg = nullptr;
+    rc = sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = "Failed to commit transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtTrimTextFields: " + error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+
+        // Attempt rollback
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        OutputDebugStringA("[Library] Transaction rolled back\n");
+
+        // Mark all results as failed
+        for (auto& r : results) {
+            r.success = false;
+            r.error = error;
+        }
+        return results;
+    }
+    OutputDebugStringA("[Library] Transaction committed successfully\n");
+
+    // === EXPLICIT CACHE FLUSH ===
+    OutputDebugStringA("[Library] dbtTrimTextFields: Flushing database cache...\n");
+    rc = sqlite3_db_cacheflush(db);
+    if (rc != SQLITE_OK) {
+        OutputDebugStringA(("[Library] Warning: Cache flush returned code " + std::to_string(rc) +
+                          " (this may be normal if no pages to flush)\n").c_str());
+    } else {
+        OutputDebugStringA("[Library] Cache flushed successfully\n");
+    }
+
+    // Ensure synchronous setting persists after commit
+    rc = sqlite3_exec(db, "PRAGMA synchronous=FULL;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        OutputDebugStringA("[Library] Warning: Could not re-set synchronous mode after commit\n");
+        if (errMsg) sqlite3_free(errMsg);
+    }
+
+    OutputDebugStringA(("[Library] dbtTrimTextFields: Completed processing " + std::to_string(results.size()) + " entries\n").c_str());
+
+    return results;
+}
+
+bool Library::createHealthTables(sqlite3* db) {
+    const char* sql =
+        "CREATE TABLE IF NOT EXISTS health_findings ("
+        "table_name TEXT NOT NULL, "
+        "entry_id TEXT NOT NULL, "
+        "check_name TEXT NOT NULL, "
+        "detail TEXT, "
+        "size_bytes INTEGER, "
+        "count INTEGER, "
+        "found_at INTEGER, "
+        "PRIMARY KEY (table_name, entry_id, check_name));"
+        "CREATE INDEX IF NOT EXISTS health_findings_check ON health_findings (check_name, table_name);"
+        "CREATE TABLE IF NOT EXISTS health_scan_tables ("
+        "table_name TEXT PRIMARY KEY, "
+        "rows_scanned INTEGER, "
+        "started_at INTEGER, "
+        "completed_at INTEGER);";
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] createHealthTables: " + std::string(errMsg ? errMsg : "unknown error") + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+Library::HealthScanResult Library::dbtRunHealthScan(const std::string& tableName, int minSizeBytes, JobContext* job) {
+    OutputDebugStringA(("[Library] dbtRunHealthScan: Scanning " + (tableName.empty() ? std::string("all tables") : tableName) + "\n").c_str());
+
+    HealthScanResult result;
+    result.success = false;
+    result.rowsScanned = 0;
+    result.findingsCount = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Failed to open database";
+        OutputDebugStringA("[Library] dbtRunHealthScan: Failed to open database\n");
+        return result;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    if (!createHealthTables(db)) {
+        result.error = "Failed to create health tables";
+        return result;
+    }
+
+    // Tables in a fixed order, so a checkpoint of "<table>\t<id>" identifies a position
+    std::vector<std::string> tables;
+    for (const auto& name : getSupportedEntryTypes()) {
+        if (!tableName.empty() && name != tableName) {
+            continue;
+        }
+        sqlite3_stmt* existsStmt = nullptr;
+        if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?;", -1, &existsStmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(existsStmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+            if (sqlite3_step(existsStmt) == SQLITE_ROW) {
+                tables.push_back(name);
+            }
+            sqlite3_finalize(existsStmt);
+        }
+    }
+
+    // Resume position from a previous run of the job
+    size_t startIndex = 0;
+    std::string resumeId;
+    if (job && !job->resumeAfterId.empty()) {
+        size_t tab = job->resumeAfterId.find('\t');
+        std::string resumeTable = job->resumeAfterId.substr(0, tab);
+        auto it = std::find(tables.begin(), tables.end(), resumeTable);
+        if (it != tables.end() && tab != std::string::npos) {
+            startIndex = it - tables.begin();
+            resumeId = job->resumeAfterId.substr(tab + 1);
+        }
+    }
+
+    if (job) {
+        int64_t total = 0;
+        for (size_t t = startIndex; t < tables.size(); t++) {
+            total += dbManager_->getTableRowCount(tables[t]);
+        }
+        job->rowsTotal = total;
+    }
+
+    std::vector<std::unique_ptr<HealthCheck>> checks = createDefaultHealthChecks(minSizeBytes > 0 ? minSizeBytes : 8000);
+
+    // === BEGIN TRANSACTION ===
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        result.error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtRunHealthScan: " + result.error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        return result;
+    }
+
+    sqlite3_stmt* insertStmt = nullptr;
+    sqlite3_prepare_v2(db, "INSERT OR REPLACE INTO health_findings (table_name, entry_id, check_name, detail, size_bytes, count, found_at) "
+                           "VALUES (?, ?, ?, ?, ?, ?, strftime('%s','now'));", -1, &insertStmt, nullptr);
+
+    bool cancelled = false;
+    std::vector<HealthFinding> findings;
+
+    for (size_t t = startIndex; t < tables.size() && !cancelled; t++) {
+        const std::string& table = tables[t];
+        bool resuming = (t == startIndex && !resumeId.empty());
+
+        // Old findings for this table are replaced by this scan (past the checkpoint when resuming)
+        sqlite3_stmt* stmt = nullptr;
+        const char* clearSql = resuming ?
+            "DELETE FROM health_findings WHERE table_name = ? AND entry_id > ?;" :
+            "DELETE FROM health_findings WHERE table_name = ?;";
+        if (sqlite3_prepare_v2(db, clearSql, -1, &stmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+            if (resuming) {
+                sqlite3_bind_text(stmt, 2, resumeId.c_str(), -1, SQLITE_TRANSIENT);
+            }
+            sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+        }
+        if (!resuming && sqlite3_prepare_v2(db, "INSERT OR REPLACE INTO health_scan_tables (table_name, rows_scanned, started_at, completed_at) "
+                                                "VALUES (?, 0, strftime('%s','now'), NULL);", -1, &stmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+        }
+
+        OutputDebugStringA(("[Library] dbtRunHealthScan: Scanning " + table + (resuming ? " after '" + resumeId + "'" : "") + "\n").c_str());
+
+        std::string selectSql = "SELECT id, value FROM \"" + table + "\" WHERE id > ? ORDER BY id;";
+        if (sqlite3_prepare_v2(db, selectSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            OutputDebugStringA(("[Library] dbtRunHealthScan: Failed to query " + table + ": " + sqlite3_errmsg(db) + "\n").c_str());
+            continue;
+        }
+        sqlite3_bind_text(stmt, 1, resuming ? resumeId.c_str() : "", -1, SQLITE_TRANSIENT);
+
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* id = (const char*)sqlite3_column_text(stmt, 0);
+            const void* blob = sqlite3_column_blob(stmt, 1);
+            int blobSize = sqlite3_column_bytes(stmt, 1);
+
+            HealthScanRow row;
+            row.tableName = table;
+            row.id = id ? id : "";
+            row.sizeBytes = blobSize;
+            row.parsed = false;
+            row.section = nullptr;
+
+            // Decode once; every check visits the same tree
+            std::unique_ptr<ArcadeKeyValues> kvData;
+            if (!blob || blobSize == 0) {
+                row.parseError = "Empty blob";
+            }
+            else {
+                size_t consumed = 0;
+                kvData = ArcadeKeyValues::ParseFromBinary(blob, blobSize, &consumed);
+                row.section = kvData->GetFirstSubKey();
+                if (!row.section || row.section->GetValueType() != ArcadeKeyValues::TYPE_SUBSECTION) {
+                    row.section = nullptr;
+                    row.parseError = "No root section";
+                }
+                else if (consumed + 2 < static_cast<size_t>(blobSize)) {
+                    // Allow for trailing end markers; anything more means parsing stopped early
+                    row.parseError = "Parsing stopped at byte " + std::to_string(consumed) + " of " + std::to_string(blobSize);
+                }
+                else {
+                    row.parsed = true;
+                }
+            }
+
+            for (const auto& check : checks) {
+                check->visit(row, findings);
+            }
+
+            for (const auto& finding : findings) {
+                sqlite3_reset(insertStmt);
+                sqlite3_bind_text(insertStmt, 1, finding.tableName.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(insertStmt, 2, finding.id.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(insertStmt, 3, finding.check.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(insertStmt, 4, finding.detail.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(insertStmt, 5, finding.sizeBytes);
+                sqlite3_bind_int(insertStmt, 6, finding.count);
+                sqlite3_step(insertStmt);
+
+                if (job) {
+                    job->pushResult({ finding.id, finding.check, true, finding.detail, finding.sizeBytes });
+                }
+                result.findingsCount++;
+            }
+            findings.clear();
+            result.rowsScanned++;
+
+            if (job) {
+                job->rowsDone++;
+                job->bytesDone += blobSize;
+                if (!job->commitBatchIfNeeded(db, table + "\t" + row.id)) {
+                    OutputDebugStringA("[Library] dbtRunHealthScan: Job cancelled\n");
+                    cancelled = true;
+                    break;
+                }
+            }
+        }
+        sqlite3_finalize(stmt);
+
+        if (!cancelled && sqlite3_prepare_v2(db, "UPDATE health_scan_tables SET rows_scanned = ?, completed_at = strftime('%s','now') "
+                                                 "WHERE table_name = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_int64(stmt, 1, dbManager_->getTableRowCount(table));
+            sqlite3_bind_text(stmt, 2, table.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+        }
+    }
+
+    sqlite3_finalize(insertStmt);
+
+    if (job) {
+        job->saveCheckpoint(db, job->getLastId());
+    }
+
+    // === COMMIT TRANSACTION ===
+    rc = sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        result.error = "Failed to commit transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtRunHealthScan: " + result.error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return result;
+    }
+
+    result.success = !cancelled;
+    if (cancelled) {
+        result.error = "Cancelled";
+    }
+
+    OutputDebugStringA(("[Library] dbtRunHealthScan: Scanned " + std::to_string(result.rowsScanned) + " rows, " +
+                       std::to_string(result.findingsCount) + " findings\n").c_str());
+
+    return result;
+}
+
+std::vector<HealthFinding> Library::dbtGetHealthFindings(const std::string& checkName, const std::string& tableName) {
+    std::vector<HealthFinding> findings;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        OutputDebugStringA("[Library] dbtGetHealthFindings: Failed to open database\n");
+        return findings;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    if (!createHealthTables(db)) {
+        return findings;
+    }
+
+    // Empty filters match everything
+    const char* sql = "SELECT table_name, entry_id, check_name, detail, size_bytes, count FROM health_findings "
+                      "WHERE (?1 = '' OR check_name = ?1) AND (?2 = '' OR table_name = ?2) "
+                      "ORDER BY check_name, table_name, entry_id;";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] dbtGetHealthFindings: " + std::string(sqlite3_errmsg(db)) + "\n").c_str());
+        return findings;
+    }
+    sqlite3_bind_text(stmt, 1, checkName.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, tableName.c_str(), -1, SQLITE_TRANSIENT);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        HealthFinding finding;
+        const char* table = (const char*)sqlite3_column_text(stmt, 0);
+        const char* id = (const char*)sqlite3_column_text(stmt, 1);
+        const char* check = (const char*)sqlite3_column_text(stmt, 2);
+        const char* detail = (const char*)sqlite3_column_text(stmt, 3);
+        finding.tableName = table ? table : "";
+        finding.id = id ? id : "";
+        finding.check = check ? check : "";
+        finding.detail = detail ? detail : "";
+        finding.sizeBytes = sqlite3_column_int(stmt, 4);
+        finding.count = sqlite3_column_int(stmt, 5);
+        findings.push_back(finding);
+    }
+    sqlite3_finalize(stmt);
+
+    OutputDebugStringA(("[Library] dbtGetHealthFindings: " + std::to_string(findings.size()) + " findings for check '" +
+                       checkName + "', table '" + tableName + "'\n").c_str());
+
+    return findings;
+}
+
+std::vector<Library::HealthScanTable> Library::dbtGetHealthScanSummary() {
+    std::vector<HealthScanTable> summary;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        OutputDebugStringA("[Library] dbtGetHealthScanSummary: Failed to open database\n");
+        return summary;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    if (!createHealthTables(db)) {
+        return summary;
+    }
+
+    const char* sql = "SELECT s.table_name, s.rows_scanned, s.started_at, s.completed_at, "
+                      "(SELECT COUNT(*) FROM health_findings f WHERE f.table_name = s.table_name) "
+                      "FROM health_scan_tables s ORDER BY s.table_name;";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] dbtGetHealthScanSummary: " + std::string(sqlite3_errmsg(db)) + "\n").c_str());
+        return summary;
+    }
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        HealthScanTable table;
+        const char* name = (const char*)sqlite3_column_text(stmt, 0);
+        table.tableName = name ? name : "";
+        table.rowsScanned = sqlite3_column_int64(stmt, 1);
+        table.startedAt = sqlite3_column_int64(stmt, 2);
+        table.completedAt = sqlite3_column_int64(stmt, 3);
+        table.findingsCount = sqlite3_column_int64(stmt, 4);
+        summary.push_back(table);
+    }
+    sqlite3_finalize(stmt);
+
+    return summary;
+}
+
+// Normalize a blocking key value so trivial differences (case, slashes, URL scheme) still match
+static std::string normalizeDuplicateKey(const std::string& key, const std::string& value) {
+    std::string normalized;
+    normalized.reserve(value.size());
+
+    if (key == "title") {
+        // Letters and digits only; any run of other characters becomes one space
+        bool pendingSpace = false;
+        for (unsigned char c : value) {
+            if (std::isalnum(c) || c >= 0x80) {
+                if (pendingSpace && !normalized.empty()) {
+                    normalized += ' ';
+                }
+                pendingSpace = false;
+                normalized += static_cast<char>(std::tolower(c));
+            }
+            else {
+                pendingSpace = true;
+            }
+        }
+        return normalized;
+    }
+
+    // Paths and URLs: lower case, forward slashes, no surrounding whitespace or quotes
+    size_t start = value.find_first_not_of(" \t\r\n\"");
+    if (start == std::string::npos) {
+        return normalized;
+    }
+    size_t end = value.find_last_not_of(" \t\r\n\"");
+    for (size_t i = start; i <= end; i++) {
+        char c = value[i] == '\\' ? '/' : value[i];
+        normalized += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    // The scheme, "www." and trailing slashes don't make a different URL
+    size_t scheme = normalized.find("://");
+    if (scheme != std::string::npos) {
+        normalized.erase(0, scheme + 3);
+        if (normalized.compare(0, 4, "www.") == 0) {
+            normalized.erase(0, 4);
+        }
+    }
+    while (!normalized.empty() && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+Library::DuplicateResult Library::dbtFindDuplicates(const std::string& tableName, const std::vector<std::string>& requestedKeys, int maxClusters, JobContext* job) {
+    OutputDebugStringA(("[Library] dbtFindDuplicates: Searching '" + tableName + "' for duplicates\n").c_str());
+
+    DuplicateResult result;
+    result.success = false;
+    result.rowsScanned = 0;
+    result.clusterCount = 0;
+    result.duplicateCount = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Failed to open database";
+        return result;
+    }
+
+    // Only the supported entry tables may be scanned (the name ends up in SQL)
+    std::vector<std::string> supportedTypes = getSupportedEntryTypes();
+    if (std::find(supportedTypes.begin(), supportedTypes.end(), tableName) == supportedTypes.end()) {
+        result.error = "Unsupported table: " + tableName;
+        return result;
+    }
+
+    std::vector<std::string> keys;
+    for (const auto& key : requestedKeys) {
+        if (!key.empty() && std::find(keys.begin(), keys.end(), key) == keys.end()) {
+            keys.push_back(key);
+        }
+    }
+    if (keys.empty()) {
+        result.error = "No blocking keys given";
+        return result;
+    }
+    const size_t keyCount = keys.size();
+
+    // As a job, progress counts scanned rows, then looked up clusters. Results stream per cluster: one
+    // "summary" row (id = cluster count, error = duplicate count), then per reported cluster a "cluster"
+    // row (id = cluster index, error = "<similarity>\t<matched keys, comma separated>", sizeBytes = members)
+    // followed by its "member" rows (id = entry id, error = "<cluster index>\t<similarity>\t<title>").
+    // There is no row checkpoint; a resumed job starts over.
+    if (job) {
+        job->rowsTotal = dbManager_->getTableRowCount(tableName);
+        job->rowsDone = 0;
+    }
+
+    // Each scan thread records rowids plus keyCount hashes per row (0 = field missing or empty)
+    struct DuplicateScanState {
+        std::vector<int64_t> rowIds;
+        std::vector<uint64_t> hashes;
+    };
+    int workerCount = parallelScanWorkerCount();
+    std::vector<DuplicateScanState> workerStates(workerCount);
+
+    int64_t scanned = scanTableParallel(tableName, workerCount, [this, &tableName, &keys, keyCount, &workerStates, job](int worker, int64_t rowId, ArcadeKeyValues* root) {
+        if (job) {
+            // The scan can't stop part way; once cancelled, the remaining rows are only read
+            if (job->cancelRequested) {
+                return;
+            }
+            job->rowsDone++;
+        }
+
+        DuplicateScanState& state = workerStates[worker];
+        size_t offset = state.hashes.size();
+        state.rowIds.push_back(rowId);
+        state.hashes.resize(offset + keyCount, 0);
+
+        uint64_t contentHash = 0;
+        visitEntryFields(root, tableName, [&](const std::string& path, ArcadeKeyValues* node) {
+            // Only leaf values take part; sections have no value of their own
+            if (node->GetFirstSubKey() != nullptr) {
+                return;
+            }
+            std::string value;
+            switch (node->GetValueType()) {
+            case ArcadeKeyValues::TYPE_STRING:
+                value = node->GetString();
+                break;
+            case ArcadeKeyValues::TYPE_INT:
+                value = std::to_string(node->GetInt());
+                break;
+            case ArcadeKeyValues::TYPE_FLOAT:
+                value = std::to_string(node->GetFloat());
+                break;
+            default:
+                return;
+            }
+
+            // Order independent sum of field hashes; id fields differ between duplicates by definition
+            size_t nameStart = path.rfind('.');
+            if ((nameStart == std::string::npos ? path : path.substr(nameStart + 1)) != "id") {
+                contentHash += sketchHash(path + "=" + value);
+            }
+
+            for (size_t k = 0; k < keyCount; k++) {
+                if (keys[k] == path) {
+                    std::string normalized = normalizeDuplicateKey(keys[k], value);
+                    if (!normalized.empty()) {
+                        state.hashes[offset + k] = sketchHash(normalized);
+                    }
+                }
+            }
+        });
+
+        for (size_t k = 0; k < keyCount; k++) {
+            if (keys[k] == "content") {
+                state.hashes[offset + k] = contentHash;
+            }
+        }
+    }, result.error);
+
+    if (scanned < 0) {
+        OutputDebugStringA(("[Library] dbtFindDuplicates: " + result.error + "\n").c_str());
+        return result;
+    }
+    result.rowsScanned = scanned;
+
+    if (job && job->shouldStop()) {
+        result.error = "Cancelled";
+        return result;
+    }
+
+    std::vector<int64_t> rowIds;
+    std::vector<uint64_t> hashes;
+    for (auto& state : workerStates) {
+        rowIds.insert(rowIds.end(), state.rowIds.begin(), state.rowIds.end());
+        hashes.insert(hashes.end(), state.hashes.begin(), state.hashes.end());
+        state = DuplicateScanState();
+    }
+    const size_t rowCount = rowIds.size();
+
+    // Union-find over row indexes. One common value (a title like "Tetris") would chain unrelated
+    // entries together, so rows are joined only when they agree on two keys at once, or on
+    // "content" alone (which already covers every field). A single requested key is used as is.
+    std::vector<size_t> parent(rowCount);
+    for (size_t row = 0; row < rowCount; row++) {
+        parent[row] = row;
+    }
+    auto findRoot = [&parent](size_t row) {
+        while (parent[row] != row) {
+            parent[row] = parent[parent[row]];
+            row = parent[row];
+        }
+        return row;
+    };
+
+    // Blocking keys: each single key that may decide on its own, and every pair of keys combined
+    std::vector<std::pair<size_t, size_t>> blocks;  // (key, key); equal for a single key
+    for (size_t k = 0; k < keyCount; k++) {
+        if (keyCount == 1 || keys[k] == "content") {
+            blocks.push_back({ k, k });
+        }
+        for (size_t other = k + 1; other < keyCount; other++) {
+            blocks.push_back({ k, other });
+        }
+    }
+
+    // One sort per blocking key puts equal hashes next to each other
+    std::vector<std::pair<uint64_t, size_t>> bucket;
+    bucket.reserve(rowCount);
+    for (const auto& block : blocks) {
+        bucket.clear();
+        for (size_t row = 0; row < rowCount; row++) {
+            uint64_t first = hashes[row * keyCount + block.first];
+            uint64_t second = hashes[row * keyCount + block.second];
+            if (first != 0 && second != 0) {
+                // Both keys must be present; a pair hashes to one value that only matches on both
+                uint64_t hash = block.first == block.second ? first : first ^ (second * 0x9E3779B97F4A7C15ULL);
+                bucket.push_back({ hash, row });
+            }
+        }
+        std::sort(bucket.begin(), bucket.end());
+
+        for (size_t i = 1; i < bucket.size(); i++) {
+            if (bucket[i].first == bucket[i - 1].first) {
+                size_t a = findRoot(bucket[i - 1].second);
+                size_t b = findRoot(bucket[i].second);
+                if (a != b) {
+                    parent[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+    }
+    std::vector<std::pair<uint64_t, size_t>>().swap(bucket);
+
+    // Only rows whose cluster has more than one member are collected
+    std::vector<uint32_t> clusterSizes(rowCount, 0);
+    for (size_t row = 0; row < rowCount; row++) {
+        clusterSizes[findRoot(row)]++;
+    }
+    std::map<size_t, std::vector<size_t>> groups;
+    for (size_t row = 0; row < rowCount; row++) {
+        size_t root = findRoot(row);
+        if (clusterSizes[root] > 1) {
+            groups[root].push_back(row);
+        }
+    }
+
+    // Share of the keys on which a row agrees with the cluster's first row
+    auto rowSimilarity = [&hashes, keyCount](size_t first, size_t row) {
+        size_t shared = 0;
+        for (size_t k = 0; k < keyCount; k++) {
+            uint64_t hash = hashes[row * keyCount + k];
+            if (hash != 0 && hash == hashes[first * keyCount + k]) {
+                shared++;
+            }
+        }
+        return static_cast<double>(shared) / keyCount;
+    };
+    auto clusterSimilarity = [&rowSimilarity](const std::vector<size_t>& rows) {
+        double total = 0.0;
+        for (size_t i = 1; i < rows.size(); i++) {
+            total += rowSimilarity(rows[0], rows[i]);
+        }
+        return rows.size() > 1 ? total / (rows.size() - 1) : 0.0;
+    };
+
+    std::vector<std::pair<double, std::vector<size_t>>> candidates;
+    candidates.reserve(groups.size());
+    for (auto& group : groups) {
+        result.duplicateCount += static_cast<int64_t>(group.second.size()) - 1;
+        double similarity = clusterSimilarity(group.second);
+        candidates.push_back({ similarity, std::move(group.second) });
+    }
+    groups.clear();
+    result.clusterCount = static_cast<int64_t>(candidates.size());
+
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair<double, std::vector<size_t>>& a, const std::pair<double, std::vector<size_t>>& b) {
+        return a.first != b.first ? a.first > b.first : a.second.size() > b.second.size();
+    });
+    if (maxClusters > 0 && candidates.size() > static_cast<size_t>(maxClusters)) {
+        candidates.resize(maxClusters);
+    }
+
+    if (job) {
+        job->rowsTotal += static_cast<int64_t>(candidates.size());
+        job->pushResult({ std::to_string(result.clusterCount), "summary", true, std::to_string(result.duplicateCount), 0 });
+    }
+
+    // Look up ids, titles and sizes for the reported clusters only
+    sqlite3* db = dbManager_->getDb();
+    sqlite3_stmt* stmt = nullptr;
+    std::string sql = "SELECT id, value FROM \"" + tableName + "\" WHERE rowid = ?;";
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        result.error = "Failed to prepare lookup: " + std::string(sqlite3_errmsg(db));
+        return result;
+    }
+
+    for (const auto& candidate : candidates) {
+        if (job) {
+            if (job->shouldStop()) {
+                sqlite3_finalize(stmt);
+                result.error = "Cancelled";
+                return result;
+            }
+            job->rowsDone++;
+        }
+
+        std::vector<std::pair<DuplicateMember, size_t>> members;
+        for (size_t row : candidate.second) {
+            DuplicateMember member;
+            member.sizeBytes = 0;
+            member.similarity = 0.0;
+
+            sqlite3_bind_int64(stmt, 1, rowIds[row]);
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* id = (const char*)sqlite3_column_text(stmt, 0);
+                member.id = id ? id : "";
+                member.title = member.id;  // Default to ID if title extraction fails
+
+                const void* blob = sqlite3_column_blob(stmt, 1);
+                member.sizeBytes = sqlite3_column_bytes(stmt, 1);
+                auto kvData = blob ? ArcadeKeyValues::ParseFromBinary(blob, member.sizeBytes) : nullptr;
+                ArcadeKeyValues* tableSection = kvData ? kvData->GetFirstSubKey() : nullptr;
+                if (tableSection) {
+                    // Check if there's a "local" subsection (for items table compatibility)
+                    ArcadeKeyValues* dataSection = tableSection->FindKey("local");
+                    if (!dataSection) {
+                        dataSection = tableSection;
+                    }
+                    std::string extractedTitle = dataSection->GetString("title", "");
+                    if (!extractedTitle.empty()) {
+                        member.title = extractedTitle;
+                    }
+                }
+            }
+            sqlite3_reset(stmt);
+
+            if (!member.id.empty()) {
+                members.push_back({ member, row });
+            }
+        }
+        if (members.size() < 2) {
+            continue;  // Deleted since the scan
+        }
+
+        // Suggest keeping the largest entry, which usually carries the most data
+        std::stable_sort(members.begin(), members.end(), [](const std::pair<DuplicateMember, size_t>& a, const std::pair<DuplicateMember, size_t>& b) {
+            return a.first.sizeBytes > b.first.sizeBytes;
+        });
+
+        DuplicateCluster cluster;
+        std::vector<size_t> rows;
+        for (auto& member : members) {
+            member.first.similarity = rowSimilarity(members[0].second, member.second);
+            cluster.members.push_back(member.first);
+            rows.push_back(member.second);
+        }
+        cluster.members[0].similarity = 1.0;
+        cluster.similarity = clusterSimilarity(rows);
+
+        for (size_t k = 0; k < keyCount; k++) {
+            std::set<uint64_t> seen;
+            for (size_t row : rows) {
+                uint64_t hash = hashes[row * keyCount + k];
+                if (hash != 0 && !seen.insert(hash).second) {
+                    cluster.matchedKeys.push_back(keys[k]);
+                    break;
+                }
+            }
+        }
+
+        if (job) {
+            std::string clusterIndex = std::to_string(result.clusters.size());
+            std::string matchedKeys;
+            for (const auto& key : cluster.matchedKeys) {
+                matchedKeys += (matchedKeys.empty() ? "" : ",") + key;
+            }
+            job->pushResult({ clusterIndex, "cluster", true, std::to_string(cluster.similarity) + "\t" + matchedKeys,
+                              static_cast<int>(cluster.members.size()) });
+            for (const auto& member : cluster.members) {
+                job->pushResult({ member.id, "member", true, clusterIndex + "\t" + std::to_string(member.similarity) + "\t" + member.title,
+                                  member.sizeBytes });
+            }
+        }
+
+        result.clusters.push_back(cluster);
+    }
+    sqlite3_finalize(stmt);
+
+    result.success = true;
+    OutputDebugStringA(("[Library] dbtFindDuplicates: " + std::to_string(result.clusterCount) + " clusters, " +
+                        std::to_string(result.duplicateCount) + " duplicates in " + std::to_string(result.rowsScanned) + " rows\n").c_str());
+
+    return result;
+}
+
+// Reference fields checked by dbtCheckReferences, per source table
+struct ReferenceSpec {
+    const char* sourceTable;
+    const char* field;  // Key inside each object (instances) or the data section (items)
+    const char* targetTable;
+};
+
+static const ReferenceSpec referenceSpecs[] = {
+    { "instances", "item", "items" },
+    { "instances", "model", "models" },
+    { "items", "app", "apps" },
+    { "items", "platform", "platforms" },
+    { "items", "type", "types" },
+};
+
+// Single pass over one entry's reference fields. visit(spec, parent, path, value) gets the
+// section holding the key, so the fix action can remove it in place.
+typedef std::function<void(const ReferenceSpec&, ArcadeKeyValues*, const std::string&, const std::string&)> ReferenceVisitor;
+
+static void extractReferences(ArcadeKeyValues* section, const std::string& tableName, const ReferenceVisitor& visit) {
+    if (!section) {
+        return;
+    }
+
+    if (tableName == "instances") {
+        ArcadeKeyValues* objectsSection = section->FindKey("objects");
+        for (ArcadeKeyValues* object = objectsSection ? objectsSection->GetFirstSubKey() : nullptr; object; object = object->GetNextKey()) {
+            for (ArcadeKeyValues* child = object->GetFirstSubKey(); child; child = child->GetNextKey()) {
+                for (const auto& spec : referenceSpecs) {
+                    if (tableName == spec.sourceTable && std::strcmp(child->GetName(), spec.field) == 0) {
+                        std::string value = child->GetString();
+                        if (!value.empty()) {
+                            visit(spec, object, "objects." + std::string(object->GetName()) + "." + spec.field, value);
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Check if there's a "local" subsection (for items table compatibility)
+    ArcadeKeyValues* dataSection = section->FindKey("local");
+    if (!dataSection) {
+        dataSection = section;
+    }
+    for (ArcadeKeyValues* child = dataSection->GetFirstSubKey(); child; child = child->GetNextKey()) {
+        for (const auto& spec : referenceSpecs) {
+            if (tableName == spec.sourceTable && std::strcmp(child->GetName(), spec.field) == 0) {
+                std::string value = child->GetString();
+                if (!value.empty()) {
+                    visit(spec, dataSection, spec.field, value);
+                }
+            }
+        }
+    }
+}
+
+std::vector<Library::CollapseResult> Library::dbtCollapseDuplicates(const std::string& tableName, const std::vector<DuplicateCollapse>& collapses) {
+    std::vector<CollapseResult> results;
+    for (const auto& collapse : collapses) {
+        for (const auto& removeId : collapse.removeIds) {
+            results.push_back({ removeId, collapse.keepId, false, "", 0 });
+        }
+    }
+
+    OutputDebugStringA(("[Library] dbtCollapseDuplicates: Removing " + std::to_string(results.size()) + " duplicates from '" + tableName + "'\n").c_str());
+
+    auto failAll = [&results](const std::string& error) {
+        for (auto& result : results) {
+            result.success = false;
+            if (result.error.empty()) {
+                result.error = error;
+            }
+        }
+    };
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        failAll("Database not available");
+        return results;
+    }
+
+    std::vector<std::string> supportedTypes = getSupportedEntryTypes();
+    if (std::find(supportedTypes.begin(), supportedTypes.end(), tableName) == supportedTypes.end()) {
+        failAll("Unsupported table: " + tableName);
+        return results;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+
+    std::map<std::string, std::string> keepFor;  // Removed id -> id kept in its place
+    std::set<std::string> removeIds;
+    for (const auto& collapse : collapses) {
+        for (const auto& removeId : collapse.removeIds) {
+            keepFor[removeId] = collapse.keepId;
+            removeIds.insert(removeId);
+        }
+    }
+
+    // === BEGIN TRANSACTION ===
+    // IMMEDIATE: the references are found on read connections, so no other writer may slip in
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, "BEGIN IMMEDIATE;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        failAll("Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error"));
+        if (errMsg) sqlite3_free(errMsg);
+        return results;
+    }
+
+    std::map<std::string, std::set<int64_t>> referencingRows;
+    std::set<std::string> referencedIds;
+    std::string scanError;
+    if (!findReferencingRows(tableName, removeIds, referencingRows, referencedIds, scanError)) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        failAll("Failed to find references: " + scanError);
+        return results;
+    }
+
+    // Keep the schema catalog current if it has been built for this table
+    bool trackSchema = isSchemaCatalogBuilt(db, tableName);
+
+    bool ok = true;
+    size_t index = 0;
+    for (const auto& collapse : collapses) {
+        bool keepExists = ok && !dbManager_->getEntryById(tableName, collapse.keepId).second.empty();
+
+        for (const auto& removeId : collapse.removeIds) {
+            CollapseResult& result = results[index++];
+            if (!ok) {
+                continue;
+            }
+
+            if (!keepExists) {
+                result.error = "Entry to keep not found: " + collapse.keepId;
+            }
+            else if (removeId == collapse.keepId) {
+                result.error = "Cannot remove the entry being kept";
+            }
+            else {
+                std::pair<std::string, std::string> entryData = dbManager_->getEntryById(tableName, removeId);
+                if (entryData.second.empty()) {
+                    result.error = "Entry not found";
+                }
+                else if (!dbManager_->deleteEntryById(tableName, removeId)) {
+                    result.error = "Failed to delete from database";
+                }
+                else {
+                    result.success = true;
+                    if (trackSchema) {
+                        SchemaFieldSet fieldsBefore;
+                        auto kvData = ArcadeKeyValues::ParseFromHex(entryData.second);
+                        collectSchemaFields(kvData.get(), tableName, fieldsBefore);
+                        updateSchemaCatalog(db, tableName, &fieldsBefore, nullptr);
+                    }
+                }
+            }
+
+            if (!result.success) {
+                OutputDebugStringA(("[Library] dbtCollapseDuplicates: " + removeId + ": " + result.error + "\n").c_str());
+                ok = false;
+            }
+        }
+    }
+
+    // Point what referred to the removed entries at the kept ones. Only the values change,
+    // never a field path, so the schema catalog needs no update.
+    std::map<std::string, int64_t> movedCounts;
+    for (const auto& source : referencingRows) {
+        if (!ok) {
+            break;
+        }
+
+        const std::string& sourceTable = source.first;
+        sqlite3_stmt* stmt = nullptr;
+        std::string sql = "SELECT id, value FROM \"" + sourceTable + "\" WHERE rowid = ?;";
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            failAll("Failed to prepare lookup: " + std::string(sqlite3_errmsg(db)));
+            ok = false;
+            break;
+        }
+
+        for (int64_t rowId : source.second) {
+            sqlite3_bind_int64(stmt, 1, rowId);
+            std::string id;
+            std::unique_ptr<ArcadeKeyValues> kvData;
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* entryId = (const char*)sqlite3_column_text(stmt, 0);
+                const void* blob = sqlite3_column_blob(stmt, 1);
+                int blobSize = sqlite3_column_bytes(stmt, 1);
+                id = entryId ? entryId : "";
+                if (blob && blobSize > 0) {
+                    kvData = ArcadeKeyValues::ParseFromBinary(blob, blobSize);
+                }
+            }
+            sqlite3_reset(stmt);
+            if (!kvData) {
+                continue;
+            }
+
+            // Collect first, then rewrite, so the extractor never walks a modified section
+            std::vector<std::pair<ArcadeKeyValues*, std::pair<std::string, std::string>>> moves;  // (parent, (field, removed id))
+            extractReferences(kvData->GetFirstSubKey(), sourceTable,
+                [&](const ReferenceSpec& spec, ArcadeKeyValues* parent, const std::string&, const std::string& value) {
+                    if (tableName == spec.targetTable && keepFor.find(value) != keepFor.end()) {
+                        moves.push_back({ parent, { spec.field, value } });
+                    }
+                });
+            if (moves.empty()) {
+                continue;
+            }
+
+            for (const auto& move : moves) {
+                move.first->SetString(move.second.first.c_str(), keepFor[move.second.second].c_str());
+                movedCounts[move.second.second]++;
+            }
+            if (!dbManager_->updateEntryById(sourceTable, id, kvData->SerializeToHex())) {
+                failAll("Failed to update reference in " + sourceTable + " " + id);
+                ok = false;
+                break;
+            }
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    // All or nothing: one bad id rolls back the whole batch
+    if (!ok) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        failAll("Rolled back: another entry in the batch failed");
+        return results;
+    }
+
+    int64_t referencesMoved = 0;
+    for (auto& result : results) {
+        result.referencesMoved = movedCounts[result.id];
+        referencesMoved += result.referencesMoved;
+    }
+
+    // === COMMIT TRANSACTION ===
+    if (sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::string error = "Failed to commit transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtCollapseDuplicates: " + error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        for (auto& result : results) {
+            result.success = false;
+            result.error = error;
+        }
+        return results;
+    }
+
+    OutputDebugStringA(("[Library] dbtCollapseDuplicates: Removed " + std::to_string(results.size()) + " duplicates, moved " +
+                        std::to_string(referencesMoved) + " references\n").c_str());
+
+    return results;
+}
+
+bool Library::findReferencingRows(const std::string& targetTable, const std::set<std::string>& ids,
+    std::map<std::string, std::set<int64_t>>& rows, std::set<std::string>& referencedIds, std::string& error) {
+    std::set<std::string> sourceTables;
+    for (const auto& spec : referenceSpecs) {
+        if (targetTable == spec.targetTable) {
+            sourceTables.insert(spec.sourceTable);
+        }
+    }
+
+    struct ReferencingScanState {
+        std::vector<int64_t> rowIds;
+        std::set<std::string> referenced;
+    };
+    int workerCount = parallelScanWorkerCount();
+
+    for (const auto& sourceTable : sourceTables) {
+        std::vector<ReferencingScanState> workerStates(workerCount);
+        int64_t scanned = scanTableParallel(sourceTable, workerCount, [&](int worker, int64_t rowId, ArcadeKeyValues* root) {
+            ReferencingScanState& state = workerStates[worker];
+            bool references = false;
+            extractReferences(root ? root->GetFirstSubKey() : nullptr, sourceTable,
+                [&](const ReferenceSpec& spec, ArcadeKeyValues*, const std::string&, const std::string& value) {
+                    if (targetTable == spec.targetTable && ids.find(value) != ids.end()) {
+                        state.referenced.insert(value);
+                        references = true;
+                    }
+                });
+            if (references) {
+                state.rowIds.push_back(rowId);
+            }
+        }, error);
+
+        if (scanned < 0) {
+            return false;
+        }
+        for (const auto& state : workerStates) {
+            if (!state.rowIds.empty()) {
+                rows[sourceTable].insert(state.rowIds.begin(), state.rowIds.end());
+            }
+            referencedIds.insert(state.referenced.begin(), state.referenced.end());
+        }
+    }
+    return true;
+}
+
+bool Library::createReferenceTables(sqlite3* db) {
+    const char* sql =
+        "CREATE TABLE IF NOT EXISTS reference_findings ("
+        "table_name TEXT NOT NULL, "
+        "entry_id TEXT NOT NULL, "
+        "kind TEXT NOT NULL, "
+        "field TEXT NOT NULL, "
+        "target_table TEXT, "
+        "target_id TEXT, "
+        "found_at INTEGER, "
+        "PRIMARY KEY (table_name, entry_id, kind, field));"
+        "CREATE INDEX IF NOT EXISTS reference_findings_kind ON reference_findings (kind, table_name);";
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] createReferenceTables: " + std::string(errMsg ? errMsg : "unknown error") + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+Library::ReferenceCheckResult Library::dbtCheckReferences(JobContext* job) {
+    OutputDebugStringA("[Library] dbtCheckReferences: Checking cross-table references\n");
+
+    ReferenceCheckResult result;
+    result.success = false;
+    result.rowsScanned = 0;
+    result.danglingCount = 0;
+    result.unreferencedCount = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Failed to open database";
+        return result;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    if (!createReferenceTables(db)) {
+        result.error = "Failed to create reference findings table";
+        return result;
+    }
+
+    // As a job, progress counts the scanned instances and items. Each dangling reference streams as a
+    // "dangling" result (id = entry id, error = "<table>\t<field>\t<target table>\t<target id>") once its
+    // table is scanned, then an "unreferenced" row per target table (id = table, sizeBytes = count).
+    // There is no row checkpoint; a resumed job starts over. A cancelled check keeps the previous findings.
+    if (job) {
+        job->rowsTotal = dbManager_->getTableRowCount("instances") + dbManager_->getTableRowCount("items");
+        job->rowsDone = 0;
+    }
+
+    // Id sets of every table, each loaded on its own read-only connection
+    std::vector<std::string> tableNames = getSupportedEntryTypes();
+    std::map<std::string, std::unordered_set<std::string>> idSets;
+    std::map<std::string, std::string> loadErrors;
+    for (const auto& tableName : tableNames) {
+        idSets[tableName];
+        loadErrors[tableName];
+    }
+
+    std::string dbPath = config_->getDatabasePath();
+    auto loadIds = [&dbPath](const std::string& tableName, std::unordered_set<std::string>& ids, std::string& error) {
+        sqlite3* readDb = nullptr;
+        if (sqlite3_open_v2(dbPath.c_str(), &readDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+            error = "Failed to open read connection";
+            if (readDb) sqlite3_close(readDb);
+            return;
+        }
+        sqlite3_busy_timeout(readDb, 5000);
+
+        sqlite3_stmt* stmt = nullptr;
+        std::string sql = "SELECT id FROM \"" + tableName + "\";";
+        if (sqlite3_prepare_v2(readDb, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            error = "Failed to read ids of " + tableName + ": " + std::string(sqlite3_errmsg(readDb));
+            sqlite3_close(readDb);
+            return;
+        }
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* id = (const char*)sqlite3_column_text(stmt, 0);
+            if (id) {
+                ids.insert(id);
+            }
+        }
+        sqlite3_finalize(stmt);
+        sqlite3_close(readDb);
+    };
+
+    std::vector<std::thread> loaders;
+    for (const auto& tableName : tableNames) {
+        loaders.emplace_back(loadIds, tableName, std::ref(idSets[tableName]), std::ref(loadErrors[tableName]));
+    }
+    for (auto& loader : loaders) {
+        loader.join();
+    }
+    for (const auto& loadError : loadErrors) {
+        if (!loadError.second.empty()) {
+            result.error = loadError.second;
+            return result;
+        }
+    }
+
+    // Stream the tables holding references; each scan thread keeps its own findings
+    // (by rowid, ids are looked up afterwards) and the target ids it saw referenced
+    struct DanglingReference {
+        int64_t rowId;
+        std::string field;
+        std::string targetTable;
+        std::string targetId;
+    };
+    struct ReferenceScanState {
+        std::vector<DanglingReference> dangling;
+        std::map<std::string, std::unordered_set<std::string>> referenced;
+    };
+
+    std::vector<ReferenceFinding> findings;
+    std::map<std::string, std::unordered_set<std::string>> referenced;
+    int workerCount = parallelScanWorkerCount();
+
+    for (const char* sourceTable : { "instances", "items" }) {
+        std::string tableName = sourceTable;
+        std::vector<ReferenceScanState> workerStates(workerCount);
+
+        int64_t scanned = scanTableParallel(tableName, workerCount, [&tableName, &idSets, &workerStates, job](int worker, int64_t rowId, ArcadeKeyValues* root) {
+            if (job) {
+                // The scan can't stop part way; once cancelled, the remaining rows are only read
+                if (job->cancelRequested) {
+                    return;
+                }
+                job->rowsDone++;
+            }
+
+            ReferenceScanState& state = workerStates[worker];
+            extractReferences(root ? root->GetFirstSubKey() : nullptr, tableName,
+                [&](const ReferenceSpec& spec, ArcadeKeyValues*, const std::string& path, const std::string& value) {
+                    const std::unordered_set<std::string>& targetIds = idSets.at(spec.targetTable);
+                    if (targetIds.find(value) == targetIds.end()) {
+                        state.dangling.push_back({ rowId, path, spec.targetTable, value });
+                    }
+                    else if (tableName == "instances") {
+                        state.referenced[spec.targetTable].insert(value);
+                    }
+                });
+        }, result.error);
+
+        if (scanned < 0) {
+            OutputDebugStringA(("[Library] dbtCheckReferences: " + result.error + "\n").c_str());
+            return result;
+        }
+        result.rowsScanned += scanned;
+
+        if (job && job->shouldStop()) {
+            result.error = "Cancelled";
+            return result;
+        }
+
+        // Row ids are only looked up for entries with dangling references
+        sqlite3_stmt* stmt = nullptr;
+        std::string sql = "SELECT id FROM \"" + tableName + "\" WHERE rowid = ?;";
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            result.error = "Failed to prepare lookup: " + std::string(sqlite3_errmsg(db));
+            return result;
+        }
+        for (auto& state : workerStates) {
+            for (const auto& dangling : state.dangling) {
+                sqlite3_bind_int64(stmt, 1, dangling.rowId);
+                if (sqlite3_step(stmt) == SQLITE_ROW) {
+                    const char* id = (const char*)sqlite3_column_text(stmt, 0);
+                    findings.push_back({ tableName, id ? id : "", "dangling", dangling.field, dangling.targetTable, dangling.targetId });
+                    if (job) {
+                        job->pushResult({ findings.back().id, "dangling", true,
+                                          tableName + "\t" + dangling.field + "\t" + dangling.targetTable + "\t" + dangling.targetId, 0 });
+                    }
+                }
+                sqlite3_reset(stmt);
+            }
+            for (auto& targetIds : state.referenced) {
+                referenced[targetIds.first].insert(targetIds.second.begin(), targetIds.second.end());
+            }
+            state = ReferenceScanState();
+        }
+        sqlite3_finalize(stmt);
+    }
+    result.danglingCount = static_cast<int64_t>(findings.size());
+
+    // Items and models no instance places in the world
+    for (const char* targetTable : { "items", "models" }) {
+        const std::unordered_set<std::string>& referencedIds = referenced[targetTable];
+        std::vector<std::string> unreferencedIds;
+        for (const auto& id : idSets[targetTable]) {
+            if (referencedIds.find(id) == referencedIds.end()) {
+                unreferencedIds.push_back(id);
+            }
+        }
+        std::sort(unreferencedIds.begin(), unreferencedIds.end());
+        for (const auto& id : unreferencedIds) {
+            findings.push_back({ targetTable, id, "unreferenced", "", "", "" });
+        }
+        if (job) {
+            job->pushResult({ targetTable, "unreferenced", true, "", static_cast<int>(unreferencedIds.size()) });
+        }
+    }
+    result.unreferencedCount = static_cast<int64_t>(findings.size()) - result.danglingCount;
+
+    // === BEGIN TRANSACTION ===
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        result.error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        return result;
+    }
+
+    bool ok = sqlite3_exec(db, "DELETE FROM reference_findings;", nullptr, nullptr, nullptr) == SQLITE_OK;
+
+    sqlite3_stmt* insertStmt = nullptr;
+    const char* insertSql = "INSERT OR REPLACE INTO reference_findings (table_name, entry_id, kind, field, target_table, target_id, found_at) "
+                            "VALUES (?, ?, ?, ?, ?, ?, ?);";
+    if (ok && sqlite3_prepare_v2(db, insertSql, -1, &insertStmt, nullptr) == SQLITE_OK) {
+        int64_t now = static_cast<int64_t>(std::time(nullptr));
+        for (const auto& finding : findings) {
+            sqlite3_bind_text(insertStmt, 1, finding.tableName.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(insertStmt, 2, finding.id.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(insertStmt, 3, finding.kind.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(insertStmt, 4, finding.field.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(insertStmt, 5, finding.targetTable.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(insertStmt, 6, finding.targetId.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(insertStmt, 7, now);
+            if (sqlite3_step(insertStmt) != SQLITE_DONE) {
+                ok = false;
+                break;
+            }
+            sqlite3_reset(insertStmt);
+        }
+        sqlite3_finalize(insertStmt);
+    }
+    else {
+        ok = false;
+    }
+
+    if (!ok) {
+        result.error = "Failed to save findings: " + std::string(sqlite3_errmsg(db));
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return result;
+    }
+
+    // === COMMIT TRANSACTION ===
+    if (sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        result.error = "Failed to commit transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return result;
+    }
+
+    result.success = true;
+    OutputDebugStringA(("[Library] dbtCheckReferences: " + std::to_string(result.danglingCount) + " dangling references, " +
+                        std::to_string(result.unreferencedCount) + " unreferenced entries in " + std::to_string(result.rowsScanned) + " rows\n").c_str());
+
+    return result;
+}
+
+std::vector<Library::ReferenceFinding> Library::dbtGetReferenceFindings(const std::string& kind, const std::string& tableName) {
+    std::vector<ReferenceFinding> findings;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        OutputDebugStringA("[Library] dbtGetReferenceFindings: Failed to open database\n");
+        return findings;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    if (!createReferenceTables(db)) {
+        return findings;
+    }
+
+    // Empty filters match everything
+    const char* sql = "SELECT table_name, entry_id, kind, field, target_table, target_id FROM reference_findings "
+                      "WHERE (?1 = '' OR kind = ?1) AND (?2 = '' OR table_name = ?2) "
+                      "ORDER BY kind, table_name, entry_id, field;";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] dbtGetReferenceFindings: " + std::string(sqlite3_errmsg(db)) + "\n").c_str());
+        return findings;
+    }
+    sqlite3_bind_text(stmt, 1, kind.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, tableName.c_str(), -1, SQLITE_TRANSIENT);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        ReferenceFinding finding;
+        const char* table = (const char*)sqlite3_column_text(stmt, 0);
+        const char* id = (const char*)sqlite3_column_text(stmt, 1);
+        const char* findingKind = (const char*)sqlite3_column_text(stmt, 2);
+        const char* field = (const char*)sqlite3_column_text(stmt, 3);
+        const char* targetTable = (const char*)sqlite3_column_text(stmt, 4);
+        const char* targetId = (const char*)sqlite3_column_text(stmt, 5);
+        finding.tableName = table ? table : "";
+        finding.id = id ? id : "";
+        finding.kind = findingKind ? findingKind : "";
+        finding.field = field ? field : "";
+        finding.targetTable = targetTable ? targetTable : "";
+        finding.targetId = targetId ? targetId : "";
+        findings.push_back(finding);
+    }
+    sqlite3_finalize(stmt);
+
+    OutputDebugStringA(("[Library] dbtGetReferenceFindings: " + std::to_string(findings.size()) + " findings for kind '" +
+                       kind + "', table '" + tableName + "'\n").c_str());
+
+    return findings;
+}
+
+std::vector<Library::PurgeResult> Library::dbtFixDanglingReferences(const std::string& tableName, const std::vector<std::string>& entryIds) {
+    OutputDebugStringA(("[Library] dbtFixDanglingReferences: Fixing " + std::to_string(entryIds.size()) + " entries in '" + tableName + "'\n").c_str());
+
+    std::vector<PurgeResult> results;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, "Database not available" });
+        }
+        return results;
+    }
+
+    if (tableName != "instances" && tableName != "items") {
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, "Table has no reference fields: " + tableName });
+        }
+        return results;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    createReferenceTables(db);
+
+    // One existence query per target table, prepared on first use
+    std::map<std::string, sqlite3_stmt*> existsStmts;
+    auto targetExists = [db, &existsStmts](const std::string& targetTable, const std::string& targetId) {
+        sqlite3_stmt*& stmt = existsStmts[targetTable];
+        if (!stmt) {
+            std::string sql = "SELECT 1 FROM \"" + targetTable + "\" WHERE id = ? LIMIT 1;";
+            if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                stmt = nullptr;
+                return true;  // Unknown: leave the reference alone
+            }
+        }
+        sqlite3_bind_text(stmt, 1, targetId.c_str(), -1, SQLITE_TRANSIENT);
+        bool exists = sqlite3_step(stmt) == SQLITE_ROW;
+        sqlite3_reset(stmt);
+        return exists;
+    };
+
+    // === BEGIN TRANSACTION ===
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, error });
+        }
+        return results;
+    }
+
+    // Keep the schema catalog current if it has been built for this table
+    bool trackSchema = isSchemaCatalogBuilt(db, tableName);
+
+    sqlite3_stmt* clearStmt = nullptr;
+    sqlite3_prepare_v2(db, "DELETE FROM reference_findings WHERE table_name = ? AND entry_id = ? AND kind = 'dangling';", -1, &clearStmt, nullptr);
+
+    for (const auto& id : entryIds) {
+        PurgeResult result;
+        result.id = id;
+        result.success = false;
+
+        std::pair<std::string, std::string> entryData = dbManager_->getEntryById(tableName, id);
+        auto kvData = entryData.second.empty() ? nullptr : ArcadeKeyValues::ParseFromHex(entryData.second);
+        ArcadeKeyValues* section = kvData ? kvData->GetFirstSubKey() : nullptr;
+        if (!section) {
+            result.error = "Entry not found";
+            results.push_back(result);
+            continue;
+        }
+
+        SchemaFieldSet fieldsBefore;
+        if (trackSchema) {
+            collectSchemaFields(kvData.get(), tableName, fieldsBefore);
+        }
+
+        // Collect first, then remove, so the extractor never walks a modified section
+        std::vector<std::pair<ArcadeKeyValues*, std::string>> toRemove;
+        extractReferences(section, tableName, [&](const ReferenceSpec& spec, ArcadeKeyValues* parent, const std::string&, const std::string& value) {
+            if (!targetExists(spec.targetTable, value)) {
+                toRemove.push_back({ parent, spec.field });
+            }
+        });
+
+        std::set<std::string> emptiedObjects;
+        for (const auto& removal : toRemove) {
+            removal.first->RemoveKey(removal.second.c_str());
+            // An object left with neither an item nor a model has nothing to show
+            if (tableName == "instances" && !removal.first->FindKey("item") && !removal.first->FindKey("model")) {
+                emptiedObjects.insert(removal.first->GetName());
+            }
+        }
+        ArcadeKeyValues* objectsSection = section->FindKey("objects");
+        for (const auto& objectId : emptiedObjects) {
+            if (objectsSection) {
+                objectsSection->RemoveKey(objectId.c_str());
+            }
+        }
+
+        if (toRemove.empty()) {
+            result.success = true;  // Nothing dangling any more
+        }
+        else if (dbManager_->updateEntryById(tableName, id, kvData->SerializeToHex())) {
+            result.success = true;
+            if (trackSchema) {
+                SchemaFieldSet fieldsAfter;
+                collectSchemaFields(kvData.get(), tableName, fieldsAfter);
+                updateSchemaCatalog(db, tableName, &fieldsBefore, &fieldsAfter);
+            }
+            OutputDebugStringA(("[Library] dbtFixDanglingReferences: Removed " + std::to_string(toRemove.size()) + " references from " + id + "\n").c_str());
+        }
+        else {
+            result.error = "Failed to update database";
+        }
+
+        if (result.success && clearStmt) {
+            sqlite3_bind_text(clearStmt, 1, tableName.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(clearStmt, 2, id.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(clearStmt);
+            sqlite3_reset(clearStmt);
+        }
+
+        results.push_back(result);
+    }
+
+    if (clearStmt) sqlite3_finalize(clearStmt);
+    for (auto& stmt : existsStmts) {
+        if (stmt.second) sqlite3_finalize(stmt.second);
+    }
+
+    // === COMMIT TRANSACTION ===
+    errMsg = nullptr;
+    rc = sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = "Failed to commit transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtFixDanglingReferences: " + error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+
+        // Attempt rollback
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+
+        // Mark all results as failed
+        for (auto& r : results) {
+            r.success = false;
+            r.error = error;
+        }
+    }
+
+    return results;
+}
+
+std::vector<Library::PurgeResult> Library::dbtPurgeUnreferenced(const std::string& tableName, const std::vector<std::string>& entryIds) {
+    OutputDebugStringA(("[Library] dbtPurgeUnreferenced: Purging " + std::to_string(entryIds.size()) + " entries from '" + tableName + "'\n").c_str());
+
+    std::vector<PurgeResult> results;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, "Database not available" });
+        }
+        return results;
+    }
+
+    if (tableName != "items" && tableName != "models") {
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, "Only items and models can be purged as unreferenced" });
+        }
+        return results;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    createReferenceTables(db);
+
+    // === BEGIN TRANSACTION ===
+    // IMMEDIATE: no writer may add a reference between the check below and the deletes
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(db, "BEGIN IMMEDIATE;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, error });
+        }
+        return results;
+    }
+
+    // The findings may be stale: check again that nothing references each id
+    std::set<std::string> purgeIds(entryIds.begin(), entryIds.end());
+    std::map<std::string, std::set<int64_t>> referencingRows;
+    std::set<std::string> referencedIds;
+    std::string scanError;
+    if (!findReferencingRows(tableName, purgeIds, referencingRows, referencedIds, scanError)) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        for (const auto& id : entryIds) {
+            results.push_back({ id, false, "Failed to check references: " + scanError });
+        }
+        return results;
+    }
+
+    // Keep the schema catalog current if it has been built for this table
+    bool trackSchema = isSchemaCatalogBuilt(db, tableName);
+
+    sqlite3_stmt* clearStmt = nullptr;
+    sqlite3_prepare_v2(db, "DELETE FROM reference_findings WHERE table_name = ? AND entry_id = ? AND kind = 'unreferenced';", -1, &clearStmt, nullptr);
+
+    for (const auto& id : entryIds) {
+        PurgeResult result;
+        result.id = id;
+        result.success = false;
+
+        if (referencedIds.count(id)) {
+            result.error = "Referenced since the last check, skipped";
+            results.push_back(result);
+            continue;
+        }
+
+        // Field paths of the entry about to be removed, for the schema catalog
+        SchemaFieldSet fieldsBefore;
+        bool existed = false;
+        if (trackSchema) {
+            std::pair<std::string, std::string> entryData = dbManager_->getEntryById(tableName, id);
+            existed = !entryData.second.empty();
+            if (existed) {
+                auto kvData = ArcadeKeyValues::ParseFromHex(entryData.second);
+                collectSchemaFields(kvData.get(), tableName, fieldsBefore);
+            }
+        }
+
+        if (dbManager_->deleteEntryById(tableName, id)) {
+            result.success = true;
+            if (existed) {
+                updateSchemaCatalog(db, tableName, &fieldsBefore, nullptr);
+            }
+            if (clearStmt) {
+                sqlite3_bind_text(clearStmt, 1, tableName.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(clearStmt, 2, id.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_step(clearStmt);
+                sqlite3_reset(clearStmt);
+            }
+        }
+        else {
+            result.error = "Failed to delete from database";
+        }
+
+        results.push_back(result);
+    }
+
+    if (clearStmt) sqlite3_finalize(clearStmt);
+
+    // === COMMIT TRANSACTION ===
+    errMsg = nullptr;
+    rc = sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = "Failed to commit transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        OutputDebugStringA(("[Library] dbtPurgeUnreferenced: " + error + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+
+        // Attempt rollback
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+
+        // Mark all results as failed
+        for (auto& r : results) {
+            r.success = false;
+            r.error = error;
+        }
+    }
+
+    return results;
+}
+
+// Rows written per transaction by dbtRunCleanupRules
+static const int cleanupBatchSize = 500;
+
+Library::CleanupResult Library::dbtRunCleanupRules(const std::string& rulesText, bool dryRun, int maxSampleIds, JobContext* job) {
+    CleanupResult result;
+    result.success = false;
+    result.dryRun = dryRun;
+    result.rowsScanned = 0;
+    result.entriesChanged = 0;
+    result.entriesDeleted = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Database not available";
+        return result;
+    }
+
+    std::vector<CleanupRule> rules;
+    CleanupRuleCompiler compiler;
+    if (!compiler.compile(rulesText, getSupportedEntryTypes(), rules, result.error)) {
+        OutputDebugStringA(("[Library] dbtRunCleanupRules: " + result.error + "\n").c_str());
+        return result;
+    }
+
+    for (const auto& rule : rules) {
+        result.rules.push_back({ rule.text, rule.tableName, 0, 0, 0, {} });
+    }
+
+    // Rule indexes per table, in source order; matches are kept as a bit per rule
+    std::map<std::string, std::vector<size_t>> rulesByTable;
+    for (size_t i = 0; i < rules.size(); i++) {
+        rulesByTable[rules[i].tableName].push_back(i);
+    }
+    for (const auto& table : rulesByTable) {
+        if (table.second.size() > 64) {
+            result.error = "At most 64 rules per table";
+            return result;
+        }
+    }
+
+    OutputDebugStringA(("[Library] dbtRunCleanupRules: " + std::to_string(rules.size()) + " rules over " + std::to_string(rulesByTable.size()) +
+        " tables" + (dryRun ? " (dry run)" : "") + "\n").c_str());
+
+    sqlite3* db = dbManager_->getDb();
+
+    // As a job, results stream per entry: "rule" rows first (id = rule index, error = rule text),
+    // then "matched" counts per rule, and "sample" / "changed" / "deleted" / "failed" rows whose error holds the rule indexes.
+    // There is no row checkpoint; a resumed job starts over, and rows already cleaned no longer match.
+    if (job) {
+        job->rowsTotal = 0;
+        job->rowsDone = 0;
+        for (const auto& table : rulesByTable) {
+            job->rowsTotal += dbManager_->getTableRowCount(table.first);
+        }
+        for (size_t i = 0; i < rules.size(); i++) {
+            job->pushResult({ std::to_string(i), "rule", true, rules[i].text, 0 });
+        }
+    }
+    auto pushEntry = [job](const std::string& id, const char* action, const std::vector<size_t>& ruleIndexes) {
+        if (!job) {
+            return;
+        }
+        std::string indexes;
+        for (size_t ruleIndex : ruleIndexes) {
+            indexes += (indexes.empty() ? "" : ",") + std::to_string(ruleIndex);
+        }
+        job->pushResult({ id, action, std::strcmp(action, "failed") != 0, indexes, 0 });
+    };
+
+    for (const auto& table : rulesByTable) {
+        const std::string& tableName = table.first;
+        const std::vector<size_t>& tableRules = table.second;
+
+        // Find the matching rows in parallel
+        int workerCount = parallelScanWorkerCount();
+        std::vector<std::vector<std::pair<int64_t, uint64_t>>> workerMatches(workerCount);
+        std::vector<std::vector<int64_t>> workerCounts(workerCount, std::vector<int64_t>(tableRules.size(), 0));
+
+        std::string error;
+        int64_t scanned = scanTableParallel(tableName, workerCount, [&](int worker, int64_t rowId, ArcadeKeyValues* root) {
+            if (job) {
+                // The scan can't stop part way; once cancelled, the remaining rows are only read
+                if (job->cancelRequested) {
+                    return;
+                }
+                job->rowsDone++;
+            }
+
+            ArcadeKeyValues* section = root ? root->GetFirstSubKey() : nullptr;
+            if (!section) {
+                return;
+            }
+
+            uint64_t mask = 0;
+            for (size_t i = 0; i < tableRules.size(); i++) {
+                if (rules[tableRules[i]].matches(section)) {
+                    mask |= (1ULL << i);
+                    workerCounts[worker][i]++;
+                }
+            }
+            if (mask) {
+                workerMatches[worker].push_back({ rowId, mask });
+            }
+        }, error);
+
+        if (scanned < 0) {
+            result.error = error;
+            OutputDebugStringA(("[Library] dbtRunCleanupRules: " + error + "\n").c_str());
+            return result;
+        }
+        result.rowsScanned += scanned;
+
+        std::vector<std::pair<int64_t, uint64_t>> matches;
+        for (int worker = 0; worker < workerCount; worker++) {
+            matches.insert(matches.end(), workerMatches[worker].begin(), workerMatches[worker].end());
+            for (size_t i = 0; i < tableRules.size(); i++) {
+                result.rules[tableRules[i]].matched += workerCounts[worker][i];
+            }
+        }
+        std::sort(matches.begin(), matches.end());
+
+        OutputDebugStringA(("[Library] dbtRunCleanupRules: " + tableName + ": " + std::to_string(matches.size()) + " of " +
+            std::to_string(scanned) + " entries match\n").c_str());
+
+        if (job) {
+            if (job->shouldStop()) {
+                result.error = "Cancelled";
+                return result;
+            }
+            for (size_t ruleIndex : tableRules) {
+                job->pushResult({ std::to_string(ruleIndex), "matched", true, "", static_cast<int>(result.rules[ruleIndex].matched) });
+            }
+            if (!dryRun) {
+                job->rowsTotal += static_cast<int64_t>(matches.size());
+            }
+        }
+
+        std::string rowSql = "SELECT id, value FROM \"" + tableName + "\" WHERE rowid = ?;";
+        sqlite3_stmt* rowStmt = nullptr;
+        if (sqlite3_prepare_v2(db, rowSql.c_str(), -1, &rowStmt, nullptr) != SQLITE_OK) {
+            result.error = "Failed to read table " + tableName + ": " + std::string(sqlite3_errmsg(db));
+            return result;
+        }
+
+        if (dryRun) {
+            // Only the sample ids are needed
+            for (const auto& match : matches) {
+                bool needed = false;
+                for (size_t i = 0; i < tableRules.size(); i++) {
+                    if ((match.second & (1ULL << i)) && static_cast<int>(result.rules[tableRules[i]].sampleIds.size()) < maxSampleIds) {
+                        needed = true;
+                    }
+                }
+                if (!needed) {
+                    continue;
+                }
+
+                sqlite3_bind_int64(rowStmt, 1, match.first);
+                if (sqlite3_step(rowStmt) == SQLITE_ROW) {
+                    const char* entryId = reinterpret_cast<const char*>(sqlite3_column_text(rowStmt, 0));
+                    std::string id = entryId ? entryId : "";
+                    std::vector<size_t> sampledBy;
+                    for (size_t i = 0; i < tableRules.size(); i++) {
+                        std::vector<std::string>& sampleIds = result.rules[tableRules[i]].sampleIds;
+                        if ((match.second & (1ULL << i)) && static_cast<int>(sampleIds.size()) < maxSampleIds) {
+                            sampleIds.push_back(id);
+                            sampledBy.push_back(tableRules[i]);
+                        }
+                    }
+                    pushEntry(id, "sample", sampledBy);
+                }
+                sqlite3_reset(rowStmt);
+            }
+            sqlite3_finalize(rowStmt);
+            continue;
+        }
+
+        // === BEGIN TRANSACTION ===
+        if (!JobContext::execWithRetry(db, "BEGIN TRANSACTION;", result.error)) {
+            sqlite3_finalize(rowStmt);
+            OutputDebugStringA(("[Library] dbtRunCleanupRules: " + result.error + "\n").c_str());
+            return result;
+        }
+
+        // Keep the schema catalog current if it has been built for this table
+        bool trackSchema = isSchemaCatalogBuilt(db, tableName);
+        int rowsSinceCommit = 0;
+
+        for (const auto& match : matches) {
+            if (job) {
+                job->rowsDone++;
+            }
+
+            sqlite3_bind_int64(rowStmt, 1, match.first);
+            if (sqlite3_step(rowStmt) != SQLITE_ROW) {
+                sqlite3_reset(rowStmt);
+                continue;  // Deleted since the scan
+            }
+            const char* entryId = reinterpret_cast<const char*>(sqlite3_column_text(rowStmt, 0));
+            std::string id = entryId ? entryId : "";
+            auto kvData = ArcadeKeyValues::ParseFromBinary(sqlite3_column_blob(rowStmt, 1), sqlite3_column_bytes(rowStmt, 1));
+            sqlite3_reset(rowStmt);
+
+            ArcadeKeyValues* section = kvData ? kvData->GetFirstSubKey() : nullptr;
+            if (!section) {
+                continue;
+            }
+
+            SchemaFieldSet fieldsBefore;
+            if (trackSchema) {
+                collectSchemaFields(kvData.get(), tableName, fieldsBefore);
+            }
+
+            // Apply the rules that matched, in order, re-checking each against the current data
+            std::vector<size_t> changedBy;
+            size_t deletedBy = rules.size();
+            for (size_t i = 0; i < tableRules.size(); i++) {
+                const CleanupRule& rule = rules[tableRules[i]];
+                if (!(match.second & (1ULL << i)) || !rule.matches(section)) {
+                    continue;
+                }
+                if (rule.deletesEntry) {
+                    deletedBy = tableRules[i];
+                    break;
+                }
+                if (rule.apply(section)) {
+                    changedBy.push_back(tableRules[i]);
+                }
+            }
+
+            if (deletedBy < rules.size()) {
+                CleanupRuleReport& report = result.rules[deletedBy];
+                if (dbManager_->deleteEntryById(tableName, id)) {
+                    report.applied++;
+                    result.entriesDeleted++;
+                    if (trackSchema) {
+                        updateSchemaCatalog(db, tableName, &fieldsBefore, nullptr);
+                    }
+                    pushEntry(id, "deleted", { deletedBy });
+                }
+                else {
+                    report.failed++;
+                    pushEntry(id, "failed", { deletedBy });
+                }
+                if (static_cast<int>(report.sampleIds.size()) < maxSampleIds) {
+                    report.sampleIds.push_back(id);
+                }
+            }
+            else if (!changedBy.empty()) {
+                bool updated = dbManager_->updateEntryById(tableName, id, kvData->SerializeToHex());
+                if (updated) {
+                    result.entriesChanged++;
+                    if (trackSchema) {
+                        SchemaFieldSet fieldsAfter;
+                        collectSchemaFields(kvData.get(), tableName, fieldsAfter);
+                        updateSchemaCatalog(db, tableName, &fieldsBefore, &fieldsAfter);
+                    }
+                }
+                for (size_t ruleIndex : changedBy) {
+                    CleanupRuleReport& report = result.rules[ruleIndex];
+                    if (updated) {
+                        report.applied++;
+                    }
+                    else {
+                        report.failed++;
+                    }
+                    if (static_cast<int>(report.sampleIds.size()) < maxSampleIds) {
+                        report.sampleIds.push_back(id);
+                    }
+                }
+                pushEntry(id, updated ? "changed" : "failed", changedBy);
+            }
+            else {
+                continue;
+            }
+
+            // Commit in batches so the write lock is released regularly
+            if (++rowsSinceCommit >= cleanupBatchSize) {
+                rowsSinceCommit = 0;
+                bool committed = false;
+                if (job && !job->saveCheckpoint(db, "")) {
+                    result.error = "Failed to save progress: " + std::string(sqlite3_errmsg(db));
+                }
+                else {
+                    committed = JobContext::execWithRetry(db, "COMMIT;", result.error);
+                }
+                if (!committed) {
+                    sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+                    sqlite3_finalize(rowStmt);
+                    OutputDebugStringA(("[Library] dbtRunCleanupRules: " + result.error + "\n").c_str());
+                    return result;
+                }
+
+                // Pause or cancel between batches, with no transaction open
+                if (job && job->shouldStop()) {
+                    result.error = "Cancelled";
+                    sqlite3_finalize(rowStmt);
+                    return result;
+                }
+                if (!JobContext::execWithRetry(db, "BEGIN TRANSACTION;", result.error)) {
+                    sqlite3_finalize(rowStmt);
+                    OutputDebugStringA(("[Library] dbtRunCleanupRules: " + result.error + "\n").c_str());
+                    return result;
+                }
+            }
+        }
+
+        sqlite3_finalize(rowStmt);
+
+        // === COMMIT TRANSACTION ===
+        if (!JobContext::execWithRetry(db, "COMMIT;", result.error)) {
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+            OutputDebugStringA(("[Library] dbtRunCleanupRules: " + result.error + "\n").c_str());
+            return result;
+        }
+    }
+
+    result.success = true;
+    OutputDebugStringA(("[Library] dbtRunCleanupRules: Scanned " + std::to_string(result.rowsScanned) + " rows, changed " +
+        std::to_string(result.entriesChanged) + ", deleted " + std::to_string(result.entriesDeleted) + "\n").c_str());
+    return result;
+}
+
+bool Library::rewriteTableBatched(const std::string& tableName, const RewriteFilter& filter, const RewriteTransform& transform,
+    const std::function<void(const RewriteRow&)>& written, JobContext* job, int64_t& rowsScanned, bool& cancelled, std::string& error) {
+    sqlite3* db = dbManager_->getDb();
+    cancelled = false;
+
+    // Rows are read in id order, one batch at a time, so a job can resume after the last committed id.
+    // The database uses the DELETE journal, so the read stage shares this connection instead of a reader thread.
+    int batchSize = job ? job->batchSize : 500;
+    std::string lastId = job ? job->resumeAfterId : "";
+    if (job) {
+        job->rowsTotal = dbManager_->getTableRowCount(tableName);
+    }
+
+    std::string selectSql = "SELECT id, value FROM \"" + tableName + "\" WHERE id > ? ORDER BY id LIMIT ?;";
+    std::string upsertSql = "INSERT OR REPLACE INTO \"" + tableName + "\" (id, value) VALUES (?, ?);";
+    sqlite3_stmt* selectStmt = nullptr;
+    sqlite3_stmt* upsertStmt = nullptr;
+    if (sqlite3_prepare_v2(db, selectSql.c_str(), -1, &selectStmt, nullptr) != SQLITE_OK ||
+        sqlite3_prepare_v2(db, upsertSql.c_str(), -1, &upsertStmt, nullptr) != SQLITE_OK) {
+        error = "Failed to prepare statements: " + std::string(sqlite3_errmsg(db));
+        if (selectStmt) sqlite3_finalize(selectStmt);
+        return false;
+    }
+
+    // === BEGIN TRANSACTION ===
+    if (!JobContext::execWithRetry(db, "BEGIN TRANSACTION;", error)) {
+        sqlite3_finalize(selectStmt);
+        sqlite3_finalize(upsertStmt);
+        return false;
+    }
+
+    bool failed = false;
+    bool inTransaction = true;
+    std::string committedId = lastId;  // A failed batch leaves the job checkpoint here
+
+    while (!cancelled && !failed) {
+        // Read stage: pull one batch, keeping only rows that pass the filter
+        std::vector<RewriteRow> candidates;
+        int batchRows = 0;
+        int64_t batchBytes = 0;
+
+        sqlite3_bind_text(selectStmt, 1, lastId.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(selectStmt, 2, batchSize);
+        while (sqlite3_step(selectStmt) == SQLITE_ROW) {
+            const char* id = reinterpret_cast<const char*>(sqlite3_column_text(selectStmt, 0));
+            const uint8_t* blob = static_cast<const uint8_t*>(sqlite3_column_blob(selectStmt, 1));
+            int blobSize = sqlite3_column_bytes(selectStmt, 1);
+
+            lastId = id ? id : "";
+            batchRows++;
+            batchBytes += blobSize;
+
+            if (!blob || blobSize == 0 || !filter(blob, blobSize)) {
+                continue;
+            }
+            candidates.push_back({ lastId, std::vector<uint8_t>(blob, blob + blobSize), false, "" });
+        }
+        sqlite3_reset(selectStmt);
+
+        if (batchRows == 0) {
+            break;
+        }
+        rowsScanned += batchRows;
+
+        // Transform stage: parsing and rewriting run in parallel across the batch
+        int workerCount = std::min(parallelScanWorkerCount(), static_cast<int>(candidates.size() / 16) + 1);
+        std::vector<std::thread> workers;
+        for (int worker = 1; worker < workerCount; worker++) {
+            workers.emplace_back([&, worker]() {
+                for (size_t i = worker; i < candidates.size(); i += workerCount) {
+                    transform(candidates[i]);
+                }
+            });
+        }
+        for (size_t i = 0; i < candidates.size(); i += workerCount) {
+            transform(candidates[i]);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // Write stage: only the changed rows, from this thread
+        for (const auto& candidate : candidates) {
+            if (!candidate.changed) {
+                continue;
+            }
+
+            sqlite3_bind_text(upsertStmt, 1, candidate.id.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_blob(upsertStmt, 2, candidate.blob.data(), static_cast<int>(candidate.blob.size()), SQLITE_TRANSIENT);
+            int rc = sqlite3_step(upsertStmt);
+            sqlite3_reset(upsertStmt);
+            if (rc != SQLITE_DONE) {
+                error = "Failed to update " + candidate.id + ": " + std::string(sqlite3_errmsg(db));
+                failed = true;
+                break;
+            }
+            written(candidate);
+        }
+        if (failed) {
+            break;
+        }
+
+        if (job) {
+            job->rowsDone += batchRows;
+            job->bytesDone += batchBytes;
+            if (!job->saveCheckpoint(db, lastId)) {
+                error = "Failed to save checkpoint: " + std::string(sqlite3_errmsg(db));
+                failed = true;
+                break;
+            }
+        }
+
+        // Commit each batch so the write lock is released regularly
+        if (!JobContext::execWithRetry(db, "COMMIT;", error)) {
+            failed = true;
+            break;
+        }
+        inTransaction = false;
+        committedId = lastId;
+
+        if (job && job->shouldStop()) {
+            OutputDebugStringA(("[Library] rewriteTableBatched: Job cancelled (" + tableName + ")\n").c_str());
+            cancelled = true;
+            break;
+        }
+        if (!JobContext::execWithRetry(db, "BEGIN TRANSACTION;", error)) {
+            failed = true;
+            break;
+        }
+        inTransaction = true;
+    }
+
+    sqlite3_finalize(selectStmt);
+    sqlite3_finalize(upsertStmt);
+
+    if (failed) {
+        OutputDebugStringA(("[Library] rewriteTableBatched: " + error + "\n").c_str());
+        if (inTransaction) {
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        }
+        if (job) {
+            job->setLastId(committedId);
+        }
+        return false;
+    }
+
+    // === COMMIT TRANSACTION ===
+    if (inTransaction && !JobContext::execWithRetry(db, "COMMIT;", error)) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return false;
+    }
+    return true;
+}
+
+// Glob over dotted field paths: '*' matches within one path level, '**' across levels, '?' one character
+static bool fieldPathGlobMatch(const char* pattern, const char* path) {
+    if (*pattern == '\0') {
+        return *path == '\0';
+    }
+    if (pattern[0] == '*' && pattern[1] == '*') {
+        for (const char* p = path; ; p++) {
+            if (fieldPathGlobMatch(pattern + 2, p)) return true;
+            if (*p == '\0') return false;
+        }
+    }
+    if (*pattern == '*') {
+        for (const char* p = path; ; p++) {
+            if (fieldPathGlobMatch(pattern + 1, p)) return true;
+            if (*p == '\0' || *p == '.') return false;
+        }
+    }
+    if (*path == '\0') {
+        return false;
+    }
+    if (*pattern == '?' ? *path != '.' : *pattern == *path) {
+        return fieldPathGlobMatch(pattern + 1, path + 1);
+    }
+    return false;
+}
+
+Library::ReplaceResult Library::dbtReplaceInFields(const std::string& tableName, const std::string& pathGlob, const std::string& find,
+    const std::string& replace, bool useRegex, JobContext* job) {
+    OutputDebugStringA(("[Library] dbtReplaceInFields: Replacing '" + find + "' in " + tableName + " fields '" + pathGlob + "'" +
+        (useRegex ? " (regex)" : "") + "\n").c_str());
+
+    ReplaceResult result;
+    result.success = false;
+    result.rowsScanned = 0;
+    result.rowsChanged = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Database not available";
+        return result;
+    }
+
+    std::vector<std::string> supportedTypes = getSupportedEntryTypes();
+    if (std::find(supportedTypes.begin(), supportedTypes.end(), tableName) == supportedTypes.end()) {
+        result.error = "Unsupported table: " + tableName;
+        return result;
+    }
+    if (find.empty()) {
+        result.error = "Nothing to find";
+        return result;
+    }
+
+    // Comma separated globs
+    std::vector<std::string> globs;
+    size_t start = 0;
+    while (start <= pathGlob.size()) {
+        size_t comma = pathGlob.find(',', start);
+        if (comma == std::string::npos) {
+            comma = pathGlob.size();
+        }
+        std::string glob = pathGlob.substr(start, comma - start);
+        glob.erase(0, glob.find_first_not_of(" \t"));
+        glob.erase(glob.find_last_not_of(" \t") + 1);
+        if (!glob.empty()) {
+            globs.push_back(glob);
+        }
+        start = comma + 1;
+    }
+    if (globs.empty()) {
+        result.error = "No field paths given";
+        return result;
+    }
+
+    std::regex pattern;
+    if (useRegex) {
+        try {
+            pattern = std::regex(find, std::regex::ECMAScript);
+        }
+        catch (const std::regex_error& e) {
+            result.error = "Invalid regular expression: " + std::string(e.what());
+            return result;
+        }
+    }
+
+    // Parse, replace and re-serialize one row; rows without a change keep their original bytes
+    auto patch = [&](RewriteRow& row) {
+        auto kvData = ArcadeKeyValues::ParseFromBinary(row.blob.data(), row.blob.size());
+        std::set<std::string> changedPaths;
+        visitEntryFields(kvData.get(), tableName, [&](const std::string& path, ArcadeKeyValues* node) {
+            if (node->GetValueType() != ArcadeKeyValues::TYPE_STRING) {
+                return;
+            }
+            bool selected = false;
+            for (const auto& glob : globs) {
+                if (fieldPathGlobMatch(glob.c_str(), path.c_str())) {
+                    selected = true;
+                    break;
+                }
+            }
+            if (!selected) {
+                return;
+            }
+
+            std::string value = node->GetString();
+            std::string replaced;
+            if (useRegex) {
+                replaced = std::regex_replace(value, pattern, replace);
+            }
+            else {
+                size_t position = value.find(find);
+                if (position == std::string::npos) {
+                    return;
+                }
+                size_t copied = 0;
+                while (position != std::string::npos) {
+                    replaced.append(value, copied, position - copied);
+                    replaced += replace;
+                    copied = position + find.size();
+                    position = value.find(find, copied);
+                }
+                replaced.append(value, copied, std::string::npos);
+            }
+
+            if (replaced != value) {
+                node->SetString(nullptr, replaced.c_str());
+                changedPaths.insert(path);
+            }
+        });
+
+        if (!changedPaths.empty()) {
+            row.blob = kvData->SerializeToBinary();
+            row.changed = true;
+            for (const auto& path : changedPaths) {
+                row.detail += (row.detail.empty() ? "" : ", ") + path;
+            }
+        }
+    };
+
+    // Strings are stored as plain bytes, so a literal search rules most rows out without parsing
+    auto mayContain = [&](const uint8_t* blob, int blobSize) {
+        return useRegex || std::search(blob, blob + blobSize, find.begin(), find.end()) != blob + blobSize;
+    };
+
+    // Field paths and types don't change, so the schema catalog needs no update
+    std::map<std::string, int64_t> fieldCounts;
+    bool cancelled = false;
+    bool ok = rewriteTableBatched(tableName, mayContain, patch, [&](const RewriteRow& row) {
+        result.rowsChanged++;
+        // detail lists the changed paths
+        size_t position = 0;
+        while (position < row.detail.size()) {
+            size_t end = row.detail.find(", ", position);
+            if (end == std::string::npos) {
+                end = row.detail.size();
+            }
+            fieldCounts[row.detail.substr(position, end - position)]++;
+            position = end + 2;
+        }
+        if (job) {
+            job->pushResult({ row.id, "replaced", true, row.detail, static_cast<int>(row.blob.size()) });
+        }
+    }, job, result.rowsScanned, cancelled, result.error);
+
+    if (ok) {
+        result.success = !cancelled;
+        if (cancelled) {
+            result.error = "Cancelled";
+        }
+    }
+    else {
+        OutputDebugStringA(("[Library] dbtReplaceInFields: " + result.error + "\n").c_str());
+    }
+
+    for (const auto& field : fieldCounts) {
+        result.fields.push_back({ field.first, field.second });
+    }
+
+    OutputDebugStringA(("[Library] dbtReplaceInFields: Scanned " + std::to_string(result.rowsScanned) + " rows, changed " +
+        std::to_string(result.rowsChanged) + "\n").c_str());
+
+    return result;
+}
+
+void Library::upgradeOnRead(const std::string& entryType, std::pair<std::string, std::string>& entry) {
+    if (entryType != "instances" || entry.second.empty() || !config_->getLazyInstanceMigration()) {
+        return;
+    }
+
+    auto kvData = ArcadeKeyValues::ParseFromHex(entry.second);
+    ArcadeKeyValues* instance = kvData ? kvData->GetFirstSubKey() : nullptr;
+    if (!instance || !instanceMigrator_.needsUpgrade(instance)) {
+        return;
+    }
+
+    std::string error;
+    if (instanceMigrator_.upgrade(instance, error) < 0) {
+        OutputDebugStringA(("[Library] upgradeOnRead: " + entry.first + ": " + error + "\n").c_str());
+        return;
+    }
+
+    // The page sees the upgraded instance now; the row is written later by a batched job
+    entry.second = kvData->SerializeToHex();
+    pendingInstanceUpgrades_.insert(entry.first);
+}
+
+std::vector<std::string> Library::takePendingInstanceUpgrades() {
+    std::vector<std::string> ids(pendingInstanceUpgrades_.begin(), pendingInstanceUpgrades_.end());
+    pendingInstanceUpgrades_.clear();
+    return ids;
+}
+
+Library::GenerationCensus Library::dbtGetInstanceGenerations() {
+    GenerationCensus census;
+    census.success = false;
+    census.targetGeneration = instanceMigrator_.targetGeneration();
+    census.rowsScanned = 0;
+    census.pendingRows = 0;
+    census.migrations = instanceMigrator_.list();
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        census.error = "Database not available";
+        return census;
+    }
+
+    int workerCount = parallelScanWorkerCount();
+    std::vector<std::map<int, int64_t>> workerCounts(workerCount);
+
+    census.rowsScanned = scanTableParallel("instances", workerCount, [&](int worker, int64_t, ArcadeKeyValues* root) {
+        ArcadeKeyValues* instance = root ? root->GetFirstSubKey() : nullptr;
+        if (instance) {
+            workerCounts[worker][InstanceMigrator::generationOf(instance)]++;
+        }
+    }, census.error);
+
+    if (census.rowsScanned < 0) {
+        census.rowsScanned = 0;
+        return census;
+    }
+
+    std::map<int, int64_t> counts;
+    for (const auto& worker : workerCounts) {
+        for (const auto& generation : worker) {
+            counts[generation.first] += generation.second;
+        }
+    }
+    for (const auto& generation : counts) {
+        census.generations.push_back({ generation.first, generation.second });
+        if (generation.first >= 0 && generation.first < census.targetGeneration) {
+            census.pendingRows += generation.second;
+        }
+    }
+
+    census.success = true;
+    return census;
+}
+
+Library::MigrationResult Library::dbtMigrateInstances(JobContext* job) {
+    MigrationResult result;
+    result.success = false;
+    result.targetGeneration = instanceMigrator_.targetGeneration();
+    result.rowsScanned = 0;
+    result.rowsUpgraded = 0;
+    result.rowsFailed = 0;
+    result.pendingRows = 0;
+
+    OutputDebugStringA(("[Library] dbtMigrateInstances: Upgrading instances to generation " + std::to_string(result.targetGeneration) + "\n").c_str());
+
+    if (result.targetGeneration < 0) {
+        result.error = "No instance migrations are registered";
+        return result;
+    }
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Database not available";
+        return result;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    bool rebuildSchema = isSchemaCatalogBuilt(db, "instances");
+
+    std::atomic<int64_t> failures(0);
+    auto upgrade = [&](RewriteRow& row) {
+        auto kvData = ArcadeKeyValues::ParseFromBinary(row.blob.data(), row.blob.size());
+        ArcadeKeyValues* instance = kvData ? kvData->GetFirstSubKey() : nullptr;
+        if (!instance || !instanceMigrator_.needsUpgrade(instance)) {
+            return;
+        }
+
+        int fromGeneration = InstanceMigrator::generationOf(instance);
+        std::string error;
+        if (instanceMigrator_.upgrade(instance, error) < 0) {
+            failures++;
+            if (job) {
+                job->pushResult({ row.id, "failed", false, error, static_cast<int>(row.blob.size()) });
+            }
+            return;
+        }
+
+        row.blob = kvData->SerializeToBinary();
+        row.changed = true;
+        row.detail = "generation " + std::to_string(fromGeneration) + " to " + std::to_string(result.targetGeneration);
+    };
+
+    bool cancelled = false;
+    bool ok = rewriteTableBatched("instances", [](const uint8_t*, int) { return true; }, upgrade, [&](const RewriteRow& row) {
+        result.rowsUpgraded++;
+        if (job) {
+            job->pushResult({ row.id, "upgraded", true, row.detail, static_cast<int>(row.blob.size()) });
+        }
+    }, job, result.rowsScanned, cancelled, result.error);
+    result.rowsFailed = failures;
+
+    if (!ok) {
+        OutputDebugStringA(("[Library] dbtMigrateInstances: " + result.error + "\n").c_str());
+        return result;
+    }
+    if (cancelled) {
+        result.error = "Cancelled";
+        return result;
+    }
+
+    // Migrations can add and remove paths, so a built schema catalog is rebuilt rather than patched per row
+    if (rebuildSchema) {
+        std::string error;
+        if (!buildSchemaCatalog("instances", error)) {
+            OutputDebugStringA(("[Library] dbtMigrateInstances: Schema catalog rebuild failed: " + error + "\n").c_str());
+        }
+    }
+
+    // Verification pass: nothing should be left below the target generation
+    GenerationCensus census = dbtGetInstanceGenerations();
+    if (!census.success) {
+        result.error = "Verification failed: " + census.error;
+        return result;
+    }
+    result.pendingRows = census.pendingRows;
+    result.success = (census.pendingRows == 0);
+    if (!result.success) {
+        result.error = std::to_string(census.pendingRows) + " instances are still below generation " + std::to_string(result.targetGeneration);
+    }
+
+    OutputDebugStringA(("[Library] dbtMigrateInstances: Scanned " + std::to_string(result.rowsScanned) + " rows, upgraded " +
+        std::to_string(result.rowsUpgraded) + ", failed " + std::to_string(result.rowsFailed) + "\n").c_str());
+
+    return result;
+}
+
+Library::MigrationResult Library::dbtMigrateInstances(const std::vector<std::string>& requestedIds, JobContext* job) {
+    MigrationResult result;
+    result.success = false;
+    result.targetGeneration = instanceMigrator_.targetGeneration();
+    result.rowsScanned = 0;
+    result.rowsUpgraded = 0;
+    result.rowsFailed = 0;
+    result.pendingRows = 0;
+
+    OutputDebugStringA(("[Library] dbtMigrateInstances: Upgrading " + std::to_string(requestedIds.size()) + " instances\n").c_str());
+
+    // Jobs process ids in order so the checkpoint can resume mid-list
+    const std::vector<std::string> instanceIds = prepareJobIds(job, requestedIds);
+
+    if (result.targetGeneration < 0) {
+        result.error = "No instance migrations are registered";
+        return result;
+    }
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Database not available";
+        return result;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    bool trackSchema = isSchemaCatalogBuilt(db, "instances");
+
+    sqlite3_stmt* updateStmt = nullptr;
+    if (sqlite3_prepare_v2(db, "UPDATE instances SET value = ? WHERE id = ?;", -1, &updateStmt, nullptr) != SQLITE_OK) {
+        result.error = "Failed to prepare update: " + std::string(sqlite3_errmsg(db));
+        return result;
+    }
+
+    // One transaction per batch instead of an autocommit (and fsync) per row
+    if (!JobContext::execWithRetry(db, "BEGIN TRANSACTION;", result.error)) {
+        sqlite3_finalize(updateStmt);
+        return result;
+    }
+
+    bool cancelled = false;
+    for (const auto& id : instanceIds) {
+        result.rowsScanned++;
+
+        // Re-read under the write lock; the instance may have been upgraded or changed since it was browsed
+        std::pair<std::string, std::string> instanceData = dbManager_->getEntryById("instances", id);
+        auto kvData = instanceData.second.empty() ? nullptr : ArcadeKeyValues::ParseFromHex(instanceData.second);
+        ArcadeKeyValues* instance = kvData ? kvData->GetFirstSubKey() : nullptr;
+
+        if (instance && instanceMigrator_.needsUpgrade(instance)) {
+            SchemaFieldSet fieldsBefore;
+            if (trackSchema) {
+                collectSchemaFields(kvData.get(), "instances", fieldsBefore);
+            }
+
+            std::string error;
+            std::vector<uint8_t> blob;
+            if (instanceMigrator_.upgrade(instance, error) >= 0) {
+                blob = kvData->SerializeToBinary();
+                sqlite3_bind_blob(updateStmt, 1, blob.data(), static_cast<int>(blob.size()), SQLITE_TRANSIENT);
+                sqlite3_bind_text(updateStmt, 2, id.c_str(), -1, SQLITE_TRANSIENT);
+                if (sqlite3_step(updateStmt) != SQLITE_DONE) {
+                    error = "Failed to update: " + std::string(sqlite3_errmsg(db));
+                }
+                sqlite3_reset(updateStmt);
+            }
+
+            if (error.empty()) {
+                result.rowsUpgraded++;
+                if (trackSchema) {
+                    SchemaFieldSet fieldsAfter;
+                    collectSchemaFields(kvData.get(), "instances", fieldsAfter);
+                    updateSchemaCatalog(db, "instances", &fieldsBefore, &fieldsAfter);
+                }
+                if (job) {
+                    job->pushResult({ id, "upgraded", true, "generation " + std::to_string(result.targetGeneration),
+                                      static_cast<int>(blob.size()) });
+                }
+            } else {
+                result.rowsFailed++;
+                if (job) {
+                    job->pushResult({ id, "failed", false, error, 0 });
+                }
+            }
+        }
+
+        // Commits every batch with its checkpoint, honours pause/cancel
+        if (job) {
+            job->rowsDone++;
+            if (!job->commitBatchIfNeeded(db, id)) {
+                cancelled = true;
+                break;
+            }
+        }
+    }
+    sqlite3_finalize(updateStmt);
+
+    if (job && job->hasFailed()) {
+        result.error = job->getFailure();
+        if (!sqlite3_get_autocommit(db)) {
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        }
+        return result;
+    }
+    if (job && !job->saveCheckpoint(db, job->getLastId())) {
+        result.error = "Failed to save checkpoint: " + std::string(sqlite3_errmsg(db));
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return result;
+    }
+    if (!JobContext::execWithRetry(db, "COMMIT;", result.error)) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return result;
+    }
+
+    if (cancelled) {
+        result.error = "Cancelled";
+        return result;
+    }
+
+    result.success = (result.rowsFailed == 0);
+    if (!result.success) {
+        result.error = std::to_string(result.rowsFailed) + " instances could not be upgraded";
+    }
+
+    OutputDebugStringA(("[Library] dbtMigrateInstances: Upgraded " + std::to_string(result.rowsUpgraded) + " of " +
+        std::to_string(result.rowsScanned) + " listed instances, failed " + std::to_string(result.rowsFailed) + "\n").c_str());
+
+    return result;
+}
+
+Library::DatabaseStats Library::dbtGetDatabaseStats() {
+    OutputDebugStringA("[Library] dbtGetDatabaseStats: Getting database statistics\n");
+
+    DatabaseStats stats;
+    stats.fileSizeBytes = 0;
+    stats.pageCount = 0;
+    stats.pageSize = 0;
+    stats.freePages = 0;
+    stats.fragmentationPercent = 0.0;
+    stats.autoVacuumMode = "none";
+    stats.reclaimedPages = 0;
+    stats.reclaimedBytes = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        OutputDebugStringA("[Library] dbtGetDatabaseStats: Failed to open database\n");
+        return stats;
+    }
+
+    // Get stats from SQLiteManager
+    SQLiteManager::DatabaseStats dbStats = dbManager_->dbtGetDatabaseStats();
+
+    // Copy to Library stats
+    stats.filePath = dbStats.filePath;
+    stats.fileSizeBytes = dbStats.fileSizeBytes;
+    stats.pageCount = dbStats.pageCount;
+    stats.pageSize = dbStats.pageSize;
+    stats.freePages = dbStats.freePages;
+    stats.fragmentationPercent = dbStats.fragmentationPercent;
+    stats.autoVacuumMode = dbStats.autoVacuumMode == 2 ? "incremental" : (dbStats.autoVacuumMode == 1 ? "full" : "none");
+    stats.reclaimedPages = dbStats.reclaimedPages;
+    stats.reclaimedBytes = dbStats.reclaimedPages * dbStats.pageSize;
+
+    OutputDebugStringA(("[Library] Database size: " + std::to_string(stats.fileSizeBytes) + " bytes, " +
+                       std::to_string(stats.fragmentationPercent) + "% fragmentation\n").c_str());
+
+    return stats;
+}
+
+Library::CompactResult Library::dbtCompactDatabase(JobContext* job) {
+    OutputDebugStringA("[Library] dbtCompactDatabase: Starting database compaction\n");
+
+    CompactResult result;
+    result.success = false;
+    result.beforeSizeBytes = 0;
+    result.afterSizeBytes = 0;
+    result.spaceSavedBytes = 0;
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Failed to open database";
+        OutputDebugStringA("[Library] dbtCompactDatabase: Failed to open database\n");
+        return result;
+    }
+
+    // Get size before compaction
+    DatabaseStats beforeStats = dbtGetDatabaseStats();
+    result.beforeSizeBytes = beforeStats.fileSizeBytes;
+
+    // VACUUM is a single atomic statement, so a job can only be cancelled before it starts
+    if (job) {
+        job->rowsTotal = 1;
+        if (job->shouldStop()) {
+            result.error = "Cancelled";
+            return result;
+        }
+    }
+
+    // Run VACUUM
+    bool success = dbManager_->dbtCompactDatabase();
+
+    if (job) {
+        job->rowsDone = 1;
+        job->bytesDone = result.beforeSizeBytes;
+    }
+
+    if (!success) {
+        result.error = "VACUUM operation failed";
+        OutputDebugStringA("[Library] dbtCompactDatabase: VACUUM operation failed\n");
+        return result;
+    }
+
+    // VACUUM on this connection applied any pending auto_vacuum mode
+    pendingAutoVacuumMode_ = -1;
+
+    // Get size after compaction
+    DatabaseStats afterStats = dbtGetDatabaseStats();
+    result.afterSizeBytes = afterStats.fileSizeBytes;
+    result.spaceSavedBytes = result.beforeSizeBytes - result.afterSizeBytes;
+    result.success = true;
+
+    OutputDebugStringA(("[Library] dbtCompactDatabase: Completed! Saved " + std::to_string(result.spaceSavedBytes) + " bytes\n").c_str());
+
+    return result;
+}
+
+Library::StorageAnalysis Library::dbtAnalyzeStorage() {
+    OutputDebugStringA("[Library] dbtAnalyzeStorage: Analyzing storage\n");
+
+    if (!openDatabase()) {
+        StorageAnalysis analysis;
+        analysis.success = false;
+        analysis.error = "Failed to open database";
+        analysis.pageSize = 0;
+        return analysis;
+    }
+
+    StorageAnalysis analysis = dbManager_->dbtAnalyzeStorage();
+
+    OutputDebugStringA(("[Library] dbtAnalyzeStorage: " + std::to_string(analysis.objects.size()) + " objects via " +
+                       analysis.source + "\n").c_str());
+
+    return analysis;
+}
+
+bool Library::installCompactionChangeLog(sqlite3* db, std::string& error) {
+    // Every user table that has an id column gets per-row logging; the rest are
+    // logged with a NULL id, which makes the replay copy the whole table
+    std::vector<std::pair<std::string, bool>> tables;
+    sqlite3_stmt* stmt = nullptr;
+    const char* listSql = "SELECT name FROM sqlite_master WHERE type = 'table' "
+                          "AND name NOT LIKE 'sqlite_%' AND name != 'compaction_changelog';";
+    if (sqlite3_prepare_v2(db, listSql, -1, &stmt, nullptr) != SQLITE_OK) {
+        error = "Failed to list tables: " + std::string(sqlite3_errmsg(db));
+        return false;
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const char* name = (const char*)sqlite3_column_text(stmt, 0);
+        if (name) {
+            tables.push_back({ name, false });
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    for (auto& table : tables) {
+        std::string infoSql = "PRAGMA table_info(\"" + table.first + "\");";
+        if (sqlite3_prepare_v2(db, infoSql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* column = (const char*)sqlite3_column_text(stmt, 1);
+                if (column && std::string(column) == "id") {
+                    table.second = true;
+                }
+            }
+            sqlite3_finalize(stmt);
+        }
+    }
+
+    std::string sql = "CREATE TABLE IF NOT EXISTS compaction_changelog (seq INTEGER PRIMARY KEY, tbl TEXT NOT NULL, id TEXT);";
+    for (const auto& table : tables) {
+        const std::string& t = table.first;
+        std::string newId = table.second ? "NEW.id" : "NULL";
+        std::string oldId = table.second ? "OLD.id" : "NULL";
+        sql += "CREATE TRIGGER IF NOT EXISTS \"compact_log_" + t + "_ins\" AFTER INSERT ON \"" + t + "\" BEGIN "
+               "INSERT INTO compaction_changelog (tbl, id) VALUES ('" + t + "', " + newId + "); END;";
+        sql += "CREATE TRIGGER IF NOT EXISTS \"compact_log_" + t + "_upd\" AFTER UPDATE ON \"" + t + "\" BEGIN "
+               "INSERT INTO compaction_changelog (tbl, id) VALUES ('" + t + "', " + oldId + "); "
+               "INSERT INTO compaction_changelog (tbl, id) VALUES ('" + t + "', " + newId + "); END;";
+        sql += "CREATE TRIGGER IF NOT EXISTS \"compact_log_" + t + "_del\" AFTER DELETE ON \"" + t + "\" BEGIN "
+               "INSERT INTO compaction_changelog (tbl, id) VALUES ('" + t + "', " + oldId + "); END;";
+    }
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        error = "Failed to install change log: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        removeCompactionChangeLog(db, "main");
+        return false;
+    }
+
+    OutputDebugStringA(("[Library] Change log installed on " + std::to_string(tables.size()) + " tables\n").c_str());
+    return true;
+}
+
+void Library::removeCompactionChangeLog(sqlite3* db, const std::string& schema) {
+    // Look the triggers up by name so leftovers from a crashed session are removed too
+    std::string sql;
+    sqlite3_stmt* stmt = nullptr;
+    std::string listSql = "SELECT name FROM " + schema + ".sqlite_master WHERE type = 'trigger' AND name LIKE 'compact\\_log\\_%' ESCAPE '\\';";
+    if (sqlite3_prepare_v2(db, listSql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* name = (const char*)sqlite3_column_text(stmt, 0);
+            if (name) {
+                sql += "DROP TRIGGER IF EXISTS " + schema + ".\"" + std::string(name) + "\";";
+            }
+        }
+        sqlite3_finalize(stmt);
+    }
+    sql += "DROP TABLE IF EXISTS " + schema + ".compaction_changelog;";
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] removeCompactionChangeLog: " + std::string(errMsg ? errMsg : "unknown error") + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+    }
+}
+
+void Library::compactionCopyThread(std::string dbPath, std::string tempPath, int autoVacuumMode) {
+    OutputDebugStringA(("[Library] compactionCopyThread: VACUUM INTO " + tempPath + "\n").c_str());
+
+    std::string error;
+    sqlite3* copyDb = nullptr;
+    if (sqlite3_open_v2(dbPath.c_str(), &copyDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        error = "Failed to open background connection: " + std::string(copyDb ? sqlite3_errmsg(copyDb) : "unknown error");
+    }
+    else {
+        sqlite3_busy_timeout(copyDb, 5000);
+        {
+            std::lock_guard<std::mutex> lock(compaction_.mutex);
+            compaction_.copyDb = copyDb;
+        }
+
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(copyDb, "VACUUM INTO ?;", -1, &stmt, nullptr) != SQLITE_OK) {
+            error = "Failed to prepare VACUUM INTO: " + std::string(sqlite3_errmsg(copyDb));
+        }
+        else {
+            sqlite3_bind_text(stmt, 1, tempPath.c_str(), -1, SQLITE_TRANSIENT);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                error = "VACUUM INTO failed: " + std::string(sqlite3_errmsg(copyDb));
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        std::lock_guard<std::mutex> lock(compaction_.mutex);
+        compaction_.copyDb = nullptr;
+    }
+    if (copyDb) {
+        sqlite3_close(copyDb);
+        copyDb = nullptr;
+    }
+
+    // The copy is private until the swap, so it can be rebuilt in place: back to the rollback journal
+    // the library runs in, and with the auto_vacuum mode set since the last rebuild (VACUUM INTO
+    // runs on its own connection, so the pending mode would otherwise be lost)
+    if (error.empty()) {
+        if (sqlite3_open_v2(tempPath.c_str(), &copyDb, SQLITE_OPEN_READWRITE, nullptr) != SQLITE_OK) {
+            error = "Failed to open compacted copy: " + std::string(copyDb ? sqlite3_errmsg(copyDb) : "unknown error");
+        }
+        else {
+            {
+                std::lock_guard<std::mutex> lock(compaction_.mutex);
+                compaction_.copyDb = copyDb;
+            }
+
+            std::string sql = "PRAGMA journal_mode=DELETE;";
+            if (autoVacuumMode >= 0) {
+                OutputDebugStringA(("[Library] compactionCopyThread: Applying auto_vacuum " + std::to_string(autoVacuumMode) + "\n").c_str());
+                sql += "PRAGMA auto_vacuum = " + std::to_string(autoVacuumMode) + "; VACUUM;";
+            }
+            char* errMsg = nullptr;
+            if (sqlite3_exec(copyDb, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+                error = "Failed to rebuild compacted copy: " + std::string(errMsg ? errMsg : "unknown error");
+                if (errMsg) sqlite3_free(errMsg);
+            }
+
+            std::lock_guard<std::mutex> lock(compaction_.mutex);
+            compaction_.copyDb = nullptr;
+        }
+        if (copyDb) {
+            sqlite3_close(copyDb);
+        }
+    }
+
+    // The copy can't be swapped in, so nothing will replay the change log. Drop it now through a
+    // connection of our own (the UI thread's is not ours to use) rather than let every write log into it.
+    if (!error.empty()) {
+        DeleteFileA(tempPath.c_str());
+        sqlite3* cleanupDb = nullptr;
+        if (sqlite3_open_v2(dbPath.c_str(), &cleanupDb, SQLITE_OPEN_READWRITE, nullptr) == SQLITE_OK) {
+            sqlite3_busy_timeout(cleanupDb, 5000);
+            removeCompactionChangeLog(cleanupDb, "main");
+        }
+        if (cleanupDb) {
+            sqlite3_close(cleanupDb);
+        }
+    }
+
+    int64_t copySize = 0;
+    WIN32_FILE_ATTRIBUTE_DATA fileInfo;
+    if (error.empty() && GetFileAttributesExA(tempPath.c_str(), GetFileExInfoStandard, &fileInfo)) {
+        copySize = ((int64_t)fileInfo.nFileSizeHigh << 32) | fileInfo.nFileSizeLow;
+    }
+
+    std::lock_guard<std::mutex> lock(compaction_.mutex);
+    compaction_.status.running = false;
+    compaction_.status.readyToSwap = error.empty();
+    compaction_.status.error = error;
+    compaction_.status.copySizeBytes = copySize;
+
+    OutputDebugStringA(("[Library] compactionCopyThread: " + (error.empty() ? "Copy finished, " + std::to_string(copySize) + " bytes" : error) + "\n").c_str());
+}
+
+bool Library::dbtStartOnlineCompaction(std::string& error) {
+    OutputDebugStringA("[Library] dbtStartOnlineCompaction: Starting online compaction\n");
+
+    {
+        std::lock_guard<std::mutex> lock(compaction_.mutex);
+        if (compaction_.status.running || compaction_.status.readyToSwap) {
+            error = "An online compaction is already in progress";
+            return false;
+        }
+    }
+    if (compaction_.thread.joinable()) {
+        compaction_.thread.join();
+    }
+
+    if (!openDatabase()) {
+        error = "Failed to open database";
+        return false;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    std::string dbPath = config_->getDatabasePath();
+    std::string tempPath = dbPath + ".compact-tmp";
+    DeleteFileA(tempPath.c_str());
+
+    DatabaseStats beforeStats = dbtGetDatabaseStats();
+
+    // Triggers go in before the copy starts, so every write the copy might miss is logged
+    if (!installCompactionChangeLog(db, error)) {
+        OutputDebugStringA(("[Library] dbtStartOnlineCompaction: " + error + "\n").c_str());
+        return false;
+    }
+
+    // In the DELETE journal the copy's read lock would make every write wait out its busy timeout
+    // and fail, leaving nothing to replay. WAL lets writes go on while the copy reads; the old mode
+    // is restored when the compaction finishes or is cancelled.
+    std::string journalMode;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "PRAGMA journal_mode;", -1, &stmt, nullptr) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* mode = (const char*)sqlite3_column_text(stmt, 0);
+            journalMode = mode ? mode : "";
+        }
+        sqlite3_finalize(stmt);
+    }
+    std::string restoreMode;
+    if (!journalMode.empty() && journalMode != "wal") {
+        if (sqlite3_prepare_v2(db, "PRAGMA journal_mode=WAL;", -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* mode = (const char*)sqlite3_column_text(stmt, 0);
+                if (mode && std::string(mode) == "wal") {
+                    restoreMode = journalMode;
+                }
+            }
+            sqlite3_finalize(stmt);
+        }
+        if (restoreMode.empty()) {
+            // Another connection is busy; the copy still works, but writes wait for it
+            OutputDebugStringA("[Library] dbtStartOnlineCompaction: Could not switch to WAL, writes will block during the copy\n");
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(compaction_.mutex);
+        compaction_.tempPath = tempPath;
+        compaction_.journalMode = restoreMode;
+        compaction_.status.running = true;
+        compaction_.status.readyToSwap = false;
+        compaction_.status.success = false;
+        compaction_.status.error.clear();
+        compaction_.status.beforeSizeBytes = beforeStats.fileSizeBytes;
+        compaction_.status.copySizeBytes = 0;
+        compaction_.status.changesLogged = 0;
+    }
+
+    compaction_.thread = std::thread(&Library::compactionCopyThread, this, dbPath, tempPath, pendingAutoVacuumMode_);
+    return true;
+}
+
+// Put the library back in the journal mode it had before the compaction switched it to WAL.
+// Leaving WAL checkpoints and removes the -wal file, so it must happen before the file is swapped.
+void Library::restoreCompactionJournalMode() {
+    std::string journalMode;
+    {
+        std::lock_guard<std::mutex> lock(compaction_.mutex);
+        journalMode = compaction_.journalMode;
+    }
+    if (journalMode.empty() || !dbManager_->getDb()) {
+        return;
+    }
+
+    std::string sql = "PRAGMA journal_mode=" + journalMode + ";";
+    char* errMsg = nullptr;
+    if (sqlite3_exec(dbManager_->getDb(), sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        OutputDebugStringA(("[Library] restoreCompactionJournalMode: " + std::string(errMsg ? errMsg : "unknown error") + "\n").c_str());
+        if (errMsg) sqlite3_free(errMsg);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(compaction_.mutex);
+    compaction_.journalMode.clear();
+}
+
+Library::OnlineCompactionStatus Library::dbtGetOnlineCompactionStatus() {
+    OnlineCompactionStatus status;
+    {
+        std::lock_guard<std::mutex> lock(compaction_.mutex);
+        status = compaction_.status;
+    }
+
+    if (!status.running && !status.readyToSwap && compaction_.thread.joinable()) {
+        // The copy failed; it has already dropped the change log, the journal mode is ours to restore
+        compaction_.thread.join();
+        if (openDatabase()) {
+            restoreCompactionJournalMode();
+        }
+    }
+
+    if (!status.running && !status.readyToSwap && openDatabase()) {
+        // Nothing in flight: drop any change log a crashed session left behind
+        sqlite3_stmt* stmt = nullptr;
+        bool stale = false;
+        if (sqlite3_prepare_v2(dbManager_->getDb(), "SELECT 1 FROM sqlite_master WHERE name = 'compaction_changelog';", -1, &stmt, nullptr) == SQLITE_OK) {
+            stale = (sqlite3_step(stmt) == SQLITE_ROW);
+            sqlite3_finalize(stmt);
+        }
+        if (stale) {
+            OutputDebugStringA("[Library] dbtGetOnlineCompactionStatus: Removing stale change log\n");
+            removeCompactionChangeLog(dbManager_->getDb(), "main");
+        }
+    }
+    else if (openDatabase()) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(dbManager_->getDb(), "SELECT COUNT(*) FROM compaction_changelog;", -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                status.changesLogged = sqlite3_column_int64(stmt, 0);
+            }
+            sqlite3_finalize(stmt);
+        }
+    }
+
+    return status;
+}
+
+Library::CompactResult Library::dbtFinishOnlineCompaction() {
+    OutputDebugStringA("[Library] dbtFinishOnlineCompaction: Replaying change log and swapping files\n");
+
+    CompactResult result;
+    result.success = false;
+    result.beforeSizeBytes = 0;
+    result.afterSizeBytes = 0;
+    result.spaceSavedBytes = 0;
+
+    std::string tempPath;
+    {
+        std::lock_guard<std::mutex> lock(compaction_.mutex);
+        if (compaction_.status.running) {
+            result.error = "Copy is still in progress";
+            return result;
+        }
+        if (!compaction_.status.readyToSwap) {
+            result.error = compaction_.status.error.empty() ? "No online compaction to finish" : compaction_.status.error;
+            return result;
+        }
+        tempPath = compaction_.tempPath;
+        result.beforeSizeBytes = compaction_.status.beforeSizeBytes;
+    }
+    if (compaction_.thread.joinable()) {
+        compaction_.thread.join();
+    }
+
+    if (!openDatabase()) {
+        result.error = "Failed to open database";
+        return result;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+    std::string dbPath = config_->getDatabasePath();
+    char* errMsg = nullptr;
+
+    // === ATTACH COMPACTED COPY ===
+    sqlite3_stmt* stmt = nullptr;
+    bool attached = false;
+    if (sqlite3_prepare_v2(db, "ATTACH DATABASE ? AS compacted;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, tempPath.c_str(), -1, SQLITE_TRANSIENT);
+        attached = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_finalize(stmt);
+    }
+    if (!attached) {
+        result.error = "Failed to attach compacted copy: " + std::string(sqlite3_errmsg(db));
+        OutputDebugStringA(("[Library] dbtFinishOnlineCompaction: " + result.error + "\n").c_str());
+        dbtCancelOnlineCompaction();
+        return result;
+    }
+
+    // === REPLAY CHANGE LOG ===
+    // BEGIN IMMEDIATE holds the write lock, so nothing new is logged while we replay
+    int rc = sqlite3_exec(db, "BEGIN IMMEDIATE;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        result.error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        sqlite3_exec(db, "DETACH DATABASE compacted;", nullptr, nullptr, nullptr);
+        OutputDebugStringA(("[Library] dbtFinishOnlineCompaction: " + result.error + "\n").c_str());
+        return result;
+    }
+
+    // The copy carries the triggers along; drop them before replaying so they don't fire there
+    removeCompactionChangeLog(db, "compacted");
+
+    int replayed = 0;
+    bool replayOk = true;
+    if (sqlite3_prepare_v2(db, "SELECT DISTINCT tbl, id FROM main.compaction_changelog;", -1, &stmt, nullptr) == SQLITE_OK) {
+        while (replayOk && sqlite3_step(stmt) == SQLITE_ROW) {
+            std::string tbl = (const char*)sqlite3_column_text(stmt, 0);
+            bool wholeTable = (sqlite3_column_type(stmt, 1) == SQLITE_NULL);
+            std::string id = wholeTable ? "" : (const char*)sqlite3_column_text(stmt, 1);
+
+            std::string where = wholeTable ? "" : " WHERE id = ?";
+            std::string deleteSql = "DELETE FROM compacted.\"" + tbl + "\"" + where + ";";
+            std::string insertSql = "INSERT INTO compacted.\"" + tbl + "\" SELECT * FROM main.\"" + tbl + "\"" + where + ";";
+
+            for (const std::string& sql : { deleteSql, insertSql }) {
+                sqlite3_stmt* replayStmt = nullptr;
+                if (sqlite3_prepare_v2(db, sql.c_str(), -1, &replayStmt, nullptr) != SQLITE_OK) {
+                    replayOk = false;
+                    break;
+                }
+                if (!wholeTable) {
+                    sqlite3_bind_text(replayStmt, 1, id.c_str(), -1, SQLITE_TRANSIENT);
+                }
+                if (sqlite3_step(replayStmt) != SQLITE_DONE) {
+                    replayOk = false;
+                }
+                sqlite3_finalize(replayStmt);
+            }
+            replayed++;
+        }
+        sqlite3_finalize(stmt);
+    }
+    else {
+        replayOk = false;
+    }
+
+    if (!replayOk) {
+        result.error = "Failed to replay change log: " + std::string(sqlite3_errmsg(db));
+        OutputDebugStringA(("[Library] dbtFinishOnlineCompaction: " + result.error + "\n").c_str());
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        sqlite3_exec(db, "DETACH DATABASE compacted;", nullptr, nullptr, nullptr);
+        dbtCancelOnlineCompaction();
+        return result;
+    }
+    OutputDebugStringA(("[Library] Replayed " + std::to_string(replayed) + " changed rows\n").c_str());
+
+    rc = sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        result.error = "Failed to commit replay: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        OutputDebugStringA(("[Library] dbtFinishOnlineCompaction: " + result.error + "\n").c_str());
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        sqlite3_exec(db, "DETACH DATABASE compacted;", nullptr, nullptr, nullptr);
+        dbtCancelOnlineCompaction();
+        return result;
+    }
+    sqlite3_exec(db, "DETACH DATABASE compacted;", nullptr, nullptr, nullptr);
+
+    // The original keeps working if the swap fails, so clean it up first
+    removeCompactionChangeLog(db, "main");
+    restoreCompactionJournalMode();
+
+    // === SWAP FILES ===
+    dbManager_->closeDatabase();
+    BOOL moved = MoveFileExA(tempPath.c_str(), dbPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (!moved) {
+        result.error = "Failed to replace database file (error " + std::to_string(GetLastError()) + ")";
+        OutputDebugStringA(("[Library] dbtFinishOnlineCompaction: " + result.error + "\n").c_str());
+        DeleteFileA(tempPath.c_str());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(compaction_.mutex);
+        compaction_.status.readyToSwap = false;
+        compaction_.status.success = (moved != 0);
+        compaction_.status.error = result.error;
+    }
+
+    if (!openDatabase()) {
+        result.error = "Failed to reopen database";
+        return result;
+    }
+    // Covers a restore that failed before the close (the mode is kept until it succeeds)
+    restoreCompactionJournalMode();
+    if (!moved) {
+        return result;
+    }
+
+    // The rebuilt file has the requested auto_vacuum mode now
+    pendingAutoVacuumMode_ = -1;
+
+    DatabaseStats afterStats = dbtGetDatabaseStats();
+    result.afterSizeBytes = afterStats.fileSizeBytes;
+    result.spaceSavedBytes = result.beforeSizeBytes - result.afterSizeBytes;
+    result.success = true;
+
+    OutputDebugStringA(("[Library] dbtFinishOnlineCompaction: Completed! Saved " + std::to_string(result.spaceSavedBytes) + " bytes\n").c_str());
+
+    return result;
+}
+
+void Library::dbtCancelOnlineCompaction() {
+    OutputDebugStringA("[Library] dbtCancelOnlineCompaction: Cancelling online compaction\n");
+
+    {
+        std::lock_guard<std::mutex> lock(compaction_.mutex);
+        if (compaction_.copyDb) {
+            sqlite3_interrupt(compaction_.copyDb);
+        }
+    }
+    if (compaction_.thread.joinable()) {
+        compaction_.thread.join();
+    }
 
-        // Navigate to the data section
-        ArcadeKeyValues* tableSection = kvData->GetFirstSubKey();
-        if (!tableSection) {
-            result.error = "Invalid data structure";
-            results.push_back(result);
-            continue;
+    if (dbManager_->getDb()) {
+        removeCompactionChangeLog(dbManager_->getDb(), "main");
+        restoreCompactionJournalMode();
+    }
+
+    std::lock_guard<std::mutex> lock(compaction_.mutex);
+    if (!compaction_.tempPath.empty()) {
+        DeleteFileA(compaction_.tempPath.c_str());
+    }
+    compaction_.status.running = false;
+    compaction_.status.readyToSwap = false;
+    if (compaction_.status.error.empty()) {
+        compaction_.status.error = "Cancelled";
+    }
+}
+
+// Positioned whole-buffer file reads and writes for the page-level snapshot refresh
+static bool readFileAt(HANDLE file, int64_t offset, void* data, DWORD size) {
+    LARGE_INTEGER position;
+    position.QuadPart = offset;
+    DWORD read = 0;
+    return SetFilePointerEx(file, position, nullptr, FILE_BEGIN) && ReadFile(file, data, size, &read, nullptr) && read == size;
+}
+
+static bool writeFileAt(HANDLE file, int64_t offset, const void* data, DWORD size) {
+    LARGE_INTEGER position;
+    position.QuadPart = offset;
+    DWORD written = 0;
+    return SetFilePointerEx(file, position, nullptr, FILE_BEGIN) && WriteFile(file, data, size, &written, nullptr) && written == size;
+}
+
+// File change counter from the database header (offset 24, big-endian). Every commit bumps it in
+// rollback journal mode; the caller holds a read transaction so it cannot move while being read.
+static bool readFileChangeCounter(HANDLE file, uint32_t& counter) {
+    uint8_t bytes[4];
+    if (!readFileAt(file, 24, bytes, sizeof(bytes))) {
+        return false;
+    }
+    counter = (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+              (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+    return true;
+}
+
+static int64_t pragmaInt64(sqlite3* db, const char* sql) {
+    int64_t value = 0;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            value = sqlite3_column_int64(stmt, 0);
         }
+        sqlite3_finalize(stmt);
+    }
+    return value;
+}
 
-        // Check for "local" subsection (items table compatibility)
-        ArcadeKeyValues* dataSection = tableSection->FindKey("local");
-        if (!dataSection) {
-            dataSection = tableSection;
+// Change counter of the library when a snapshot was last completed, kept in "<snapshot>.snapshot"
+static bool readSnapshotCounter(const std::string& path, uint32_t& counter) {
+    std::ifstream file(path + ".snapshot");
+    unsigned long value = 0;
+    if (!(file >> value)) {
+        return false;
+    }
+    counter = static_cast<uint32_t>(value);
+    return true;
+}
+
+static void writeSnapshotCounter(const std::string& path, uint32_t counter) {
+    std::ofstream file(path + ".snapshot", std::ios::trunc);
+    file << counter << "\n";
+}
+
+// Copy the whole library with sqlite3_backup_step into "<path>.partial", then move it into place
+static bool backupFull(sqlite3* db, HANDLE sourceFile, const std::string& path, int pagesPerStep, int sleepMs, bool compress,
+    JobContext* job, Library::BackupResult& result, uint32_t& counter) {
+    std::string partialPath = path + ".partial";
+    DeleteFileA(partialPath.c_str());
+
+    // NTFS compression keeps the snapshot a plain SQLite file that opens without unpacking
+    if (compress) {
+        HANDLE file = CreateFileA(partialPath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file != INVALID_HANDLE_VALUE) {
+            USHORT format = COMPRESSION_FORMAT_DEFAULT;
+            DWORD returned = 0;
+            if (!DeviceIoControl(file, FSCTL_SET_COMPRESSION, &format, sizeof(format), nullptr, 0, &returned, nullptr)) {
+                OutputDebugStringA("[Library] dbtBackupTo: Compression is not supported on the target volume; writing uncompressed\n");
+            }
+            CloseHandle(file);
         }
+    }
 
-        // Track if we made any changes
-        bool modified = false;
+    sqlite3* destDb = nullptr;
+    if (sqlite3_open_v2(partialPath.c_str(), &destDb, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+        result.error = "Failed to create backup file: " + std::string(destDb ? sqlite3_errmsg(destDb) : "out of memory");
+        sqlite3_close(destDb);
+        return false;
+    }
 
-        // Trim "title" field
-        std::string title = dataSection->GetString("title", "");
-        if (title.length() > static_cast<size_t>(maxLength)) {
-            std::string trimmedTitle = title.substr(0, maxLength);
-            dataSection->SetString("title", trimmedTitle.c_str());
-            modified = true;
-            OutputDebugStringA(("[Library] Trimmed title for " + id + " from " + std::to_string(title.length()) + " to " + std::to_string(maxLength) + " chars\n").c_str());
+    sqlite3_backup* backup = sqlite3_backup_init(destDb, "main", db, "main");
+    if (!backup) {
+        result.error = "Failed to start backup: " + std::string(sqlite3_errmsg(destDb));
+        sqlite3_close(destDb);
+        DeleteFileA(partialPath.c_str());
+        return false;
+    }
+
+    int64_t pageSize = pragmaInt64(db, "PRAGMA page_size;");
+    int lastRemaining = -1;
+    bool cancelled = false;
+    int rc = SQLITE_OK;
+
+    while (true) {
+        // Each step runs in its own read transaction, so the change counter read with the final step
+        // describes exactly the pages copied. Between steps other connections are free to write;
+        // sqlite3_backup restarts the copy when they do.
+        sqlite3_exec(db, "BEGIN; SELECT COUNT(*) FROM sqlite_master;", nullptr, nullptr, nullptr);
+        rc = sqlite3_backup_step(backup, pagesPerStep);
+        if (rc == SQLITE_DONE && !readFileChangeCounter(sourceFile, counter)) {
+            counter = 0;
         }
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
 
-        // Trim "description" field
-        std::string description = dataSection->GetString("description", "");
-        if (description.length() > static_cast<size_t>(maxLength)) {
-            std::string trimmedDescription = description.substr(0, maxLength);
-            dataSection->SetString("description", trimmedDescription.c_str());
-            modified = true;
-            OutputDebugStringA(("[Library] Trimmed description for " + id + " from " + std::to_string(description.length()) + " to " + std::to_string(maxLength) + " chars\n").c_str());
+        int remaining = sqlite3_backup_remaining(backup);
+        int total = sqlite3_backup_pagecount(backup);
+        if (lastRemaining >= 0 && remaining > lastRemaining) {
+            result.restarts++;
         }
+        lastRemaining = remaining;
 
-        // Only update if we made changes
-        if (modified) {
-            // Serialize back to hex
-            std::string updatedHex = kvData->SerializeToHex();
+        result.pagesTotal = total;
+        if (job) {
+            job->rowsTotal = total;
+            job->rowsDone = total - remaining;
+            job->bytesDone = static_cast<int64_t>(total - remaining) * pageSize;
+        }
 
-            // Update in database
-            if (dbManager_->updateEntryById(tableName, id, updatedHex)) {
-                result.success = true;
-                result.error = "";
-                OutputDebugStringA(("[Library] Successfully trimmed text fields for " + id + "\n").c_str());
-            }
-            else {
-                result.error = "Failed to update database";
-                OutputDebugStringA(("[Library] Failed to update database for " + id + "\n").c_str());
-            }
+        if (rc == SQLITE_DONE) {
+            break;
         }
-        else {
-            // No changes needed, consider it a success
-            result.success = true;
-            result.error = "No trimming needed";
-            OutputDebugStringA(("[Library] No trimming needed for " + id + "\n").c_str());
+        if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+            result.error = "Backup step failed: " + std::string(sqlite3_errstr(rc));
+            break;
+        }
+        if (job && job->shouldStop()) {
+            cancelled = true;
+            break;
         }
+        Sleep(sleepMs);
+    }
 
-        results.push_back(result);
+    sqlite3_backup_finish(backup);
+    sqlite3_close(destDb);
+
+    if (rc != SQLITE_DONE) {
+        DeleteFileA(partialPath.c_str());
+        if (cancelled) {
+            result.error = "Cancelled";
+        }
+        return false;
     }
 
-    // === COMMIT TRANSACTION ===
-    OutputDebugStringA("[Library] dbtTrimTextFields: Committing transaction...\n");
-    errMsg = nullptr;
-    rc = sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg);
-    if (rc != SQLITE_OK) {
-        std::string error = "Failed to commit transaction: " + std::string(errMsg ? errMsg : "unknown error");
-        OutputDebugStringA(("[Library] dbtTrimTextFields: " + error + "\n").c_str());
-        if (errMsg) sqlite3_free(errMsg);
+    if (!MoveFileExA(partialPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        result.error = "Failed to move backup into place (error " + std::to_string(GetLastError()) + ")";
+        DeleteFileA(partialPath.c_str());
+        return false;
+    }
 
-        // Attempt rollback
-        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
-        OutputDebugStringA("[Library] Transaction rolled back\n");
+    result.pagesWritten = result.pagesTotal;
+    result.bytesWritten = result.pagesTotal * pageSize;
+    return true;
+}
 
-        // Mark all results as failed
-        for (auto& r : results) {
-            r.success = false;
-            r.error = error;
+// Refresh an existing snapshot, rewriting only the pages that differ from the library. The snapshot is
+// copied to "<path>.partial", which is patched and then moved into place, so an interrupted refresh leaves
+// the previous snapshot intact. Pages are compared a chunk at a time under a read transaction; if the
+// change counter moves between chunks the refresh starts over, so the result is one consistent state.
+// There is no record of which pages changed: every run reads all pages of the library and the snapshot.
+static bool backupIncremental(sqlite3* db, HANDLE sourceFile, const std::string& path, int pagesPerStep, int sleepMs,
+    bool haveLastCounter, uint32_t lastCounter, JobContext* job, Library::BackupResult& result, uint32_t& counter) {
+    int64_t pageSize = pragmaInt64(db, "PRAGMA page_size;");
+
+    // Nothing committed since the last snapshot: no copy at all
+    if (haveLastCounter) {
+        sqlite3_exec(db, "BEGIN; SELECT COUNT(*) FROM sqlite_master;", nullptr, nullptr, nullptr);
+        uint32_t current = 0;
+        bool unchanged = readFileChangeCounter(sourceFile, current) && current == lastCounter;
+        int64_t pageCount = pragmaInt64(db, "PRAGMA page_count;");
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+        if (unchanged) {
+            result.unchanged = true;
+            result.pagesTotal = pageCount;
+            counter = current;
+            return true;
         }
-        return results;
     }
-    OutputDebugStringA("[Library] Transaction committed successfully\n");
 
-    // === EXPLICIT CACHE FLUSH ===
-    OutputDebugStringA("[Library] dbtTrimTextFields: Flushing database cache...\n");
-    rc = sqlite3_db_cacheflush(db);
-    if (rc != SQLITE_OK) {
-        OutputDebugStringA(("[Library] Warning: Cache flush returned code " + std::to_string(rc) +
-                          " (this may be normal if no pages to flush)\n").c_str());
-    } else {
-        OutputDebugStringA("[Library] Cache flushed successfully\n");
+    // CopyFile keeps the NTFS compression of the snapshot
+    std::string partialPath = path + ".partial";
+    if (!CopyFileA(path.c_str(), partialPath.c_str(), FALSE)) {
+        result.error = "Failed to copy snapshot " + path + " (error " + std::to_string(GetLastError()) + ")";
+        return false;
     }
 
-    // Ensure synchronous setting persists after commit
-    rc = sqlite3_exec(db, "PRAGMA synchronous=FULL;", nullptr, nullptr, &errMsg);
-    if (rc != SQLITE_OK) {
-        OutputDebugStringA("[Library] Warning: Could not re-set synchronous mode after commit\n");
-        if (errMsg) sqlite3_free(errMsg);
+    HANDLE partialFile = CreateFileA(partialPath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (partialFile == INVALID_HANDLE_VALUE) {
+        result.error = "Failed to open " + partialPath + " (error " + std::to_string(GetLastError()) + ")";
+        DeleteFileA(partialPath.c_str());
+        return false;
     }
 
-    OutputDebugStringA(("[Library] dbtTrimTextFields: Completed processing " + std::to_string(results.size()) + " entries\n").c_str());
+    std::vector<uint8_t> sourcePage(static_cast<size_t>(pageSize));
+    std::vector<uint8_t> snapshotPage(static_cast<size_t>(pageSize));
 
-    return results;
-}
+    int64_t page = 0;
+    int64_t pageCount = 0;
+    uint32_t startCounter = 0;
+    bool started = false;
+    bool cancelled = false;
+    bool failed = false;
 
-Library::DatabaseStats Library::dbtGetDatabaseStats() {
-    OutputDebugStringA("[Library] dbtGetDatabaseStats: Getting database statistics\n");
+    while (true) {
+        sqlite3_exec(db, "BEGIN; SELECT COUNT(*) FROM sqlite_master;", nullptr, nullptr, nullptr);
 
-    DatabaseStats stats;
-    stats.fileSizeBytes = 0;
-    stats.pageCount = 0;
-    stats.pageSize = 0;
-    stats.freePages = 0;
-    stats.fragmentationPercent = 0.0;
+        uint32_t current = 0;
+        if (!readFileChangeCounter(sourceFile, current)) {
+            result.error = "Failed to read the library header";
+            failed = true;
+        }
+        pageCount = pragmaInt64(db, "PRAGMA page_count;");
+
+        if (!failed && !started) {
+            started = true;
+            startCounter = current;
+        } else if (!failed && current != startCounter) {
+            // Pages already patched stay in the copy; the ones that changed again are rewritten
+            startCounter = current;
+            page = 0;
+            result.restarts++;
+        }
+
+        int64_t end = std::min(page + pagesPerStep, pageCount);
+        for (; !failed && page < end; page++) {
+            int64_t offset = page * pageSize;
+            if (!readFileAt(sourceFile, offset, sourcePage.data(), static_cast<DWORD>(pageSize))) {
+                result.error = "Failed to read library page " + std::to_string(page + 1);
+                failed = true;
+                break;
+            }
+            bool same = readFileAt(partialFile, offset, snapshotPage.data(), static_cast<DWORD>(pageSize)) &&
+                memcmp(sourcePage.data(), snapshotPage.data(), static_cast<size_t>(pageSize)) == 0;
+            if (same) {
+                continue;
+            }
+            if (!writeFileAt(partialFile, offset, sourcePage.data(), static_cast<DWORD>(pageSize))) {
+                result.error = "Failed to write snapshot page " + std::to_string(page + 1);
+                failed = true;
+                break;
+            }
+            result.pagesWritten++;
+            result.bytesWritten += pageSize;
+        }
+
+        bool done = !failed && page >= pageCount;
+        if (done) {
+            counter = current;
+        }
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+
+        result.pagesTotal = pageCount;
+        if (job) {
+            job->rowsTotal = pageCount;
+            job->rowsDone = page;
+            job->bytesDone = result.bytesWritten;
+        }
+
+        if (done || failed) {
+            break;
+        }
+        if (job && job->shouldStop()) {
+            cancelled = true;
+            break;
+        }
+        Sleep(sleepMs);
+    }
+
+    if (!failed && !cancelled) {
+        // Drop pages past the end (the library shrinks after a compaction)
+        LARGE_INTEGER size;
+        size.QuadPart = pageCount * pageSize;
+        if (!SetFilePointerEx(partialFile, size, nullptr, FILE_BEGIN) || !SetEndOfFile(partialFile) || !FlushFileBuffers(partialFile)) {
+            result.error = "Failed to finish " + partialPath + " (error " + std::to_string(GetLastError()) + ")";
+            failed = true;
+        }
+    }
+    CloseHandle(partialFile);
+
+    if (failed || cancelled) {
+        DeleteFileA(partialPath.c_str());
+        if (cancelled) {
+            result.error = "Cancelled";
+        }
+        return false;
+    }
+
+    if (!MoveFileExA(partialPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        result.error = "Failed to move backup into place (error " + std::to_string(GetLastError()) + ")";
+        DeleteFileA(partialPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+Library::BackupResult Library::dbtBackupTo(const std::string& path, int pagesPerStep, int sleepMs, bool compress, bool incremental, JobContext* job) {
+    BackupResult result;
+    result.success = false;
+    result.incremental = false;
+    result.unchanged = false;
+    result.pagesTotal = 0;
+    result.pagesWritten = 0;
+    result.bytesWritten = 0;
+    result.restarts = 0;
+
+    OutputDebugStringA(("[Library] dbtBackupTo: Backing up to " + path + (incremental ? " (incremental)" : "") + "\n").c_str());
+
+    std::string databasePath = config_->getDatabasePath();
+    if (path.empty() || _stricmp(path.c_str(), databasePath.c_str()) == 0) {
+        result.error = "Invalid backup path";
+        return result;
+    }
 
     // Open database if not already open
     if (!openDatabase()) {
-        OutputDebugStringA("[Library] dbtGetDatabaseStats: Failed to open database\n");
-        return stats;
+        result.error = "Database not available";
+        return result;
     }
 
-    // Get stats from SQLiteManager
-    SQLiteManager::DatabaseStats dbStats = dbManager_->dbtGetDatabaseStats();
+    sqlite3* db = dbManager_->getDb();
+    pagesPerStep = std::max(1, pagesPerStep);
+    sleepMs = std::max(0, sleepMs);
+
+    // Read-only handle on the library file for the header change counter (and pages, when incremental)
+    HANDLE sourceFile = CreateFileA(databasePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (sourceFile == INVALID_HANDLE_VALUE) {
+        result.error = "Failed to open " + databasePath + " (error " + std::to_string(GetLastError()) + ")";
+        return result;
+    }
 
-    // Copy to Library stats
-    stats.filePath = dbStats.filePath;
-    stats.fileSizeBytes = dbStats.fileSizeBytes;
-    stats.pageCount = dbStats.pageCount;
-    stats.pageSize = dbStats.pageSize;
-    stats.freePages = dbStats.freePages;
-    stats.fragmentationPercent = dbStats.fragmentationPercent;
+    uint32_t lastCounter = 0;
+    bool haveLastCounter = readSnapshotCounter(path, lastCounter);
+    result.incremental = incremental && GetFileAttributesA(path.c_str()) != INVALID_FILE_ATTRIBUTES;
 
-    OutputDebugStringA(("[Library] Database size: " + std::to_string(stats.fileSizeBytes) + " bytes, " +
-                       std::to_string(stats.fragmentationPercent) + "% fragmentation\n").c_str());
+    // Until this run completes, the snapshot no longer matches any recorded state
+    DeleteFileA((path + ".snapshot").c_str());
 
-    return stats;
+    uint32_t counter = 0;
+    bool ok = result.incremental
+        ? backupIncremental(db, sourceFile, path, pagesPerStep, sleepMs, haveLastCounter, lastCounter, job, result, counter)
+        : backupFull(db, sourceFile, path, pagesPerStep, sleepMs, compress, job, result, counter);
+    CloseHandle(sourceFile);
+
+    if (!ok) {
+        // Both kinds of backup leave the previous snapshot untouched when they fail
+        if (haveLastCounter) {
+            writeSnapshotCounter(path, lastCounter);
+        }
+        OutputDebugStringA(("[Library] dbtBackupTo: " + result.error + "\n").c_str());
+        return result;
+    }
+
+    writeSnapshotCounter(path, counter);
+    result.success = true;
+
+    OutputDebugStringA(("[Library] dbtBackupTo: " + std::string(result.unchanged ? "Unchanged since last snapshot" : "Done") +
+        ", wrote " + std::to_string(result.pagesWritten) + " of " + std::to_string(result.pagesTotal) + " pages, " +
+        std::to_string(result.restarts) + " restarts\n").c_str());
+    return result;
 }
 
-Library::CompactResult Library::dbtCompactDatabase() {
-    OutputDebugStringA("[Library] dbtCompactDatabase: Starting database compaction\n");
+Library::AutoVacuumResult Library::dbtSetAutoVacuumMode(const std::string& mode) {
+    OutputDebugStringA(("[Library] dbtSetAutoVacuumMode: " + mode + "\n").c_str());
 
-    CompactResult result;
+    AutoVacuumResult result;
     result.success = false;
-    result.beforeSizeBytes = 0;
-    result.afterSizeBytes = 0;
-    result.spaceSavedBytes = 0;
+    result.mode = mode;
+    result.requiresCompaction = false;
+
+    int modeValue = -1;
+    if (mode == "none") modeValue = 0;
+    else if (mode == "full") modeValue = 1;
+    else if (mode == "incremental") modeValue = 2;
+
+    if (modeValue < 0) {
+        result.error = "Unknown auto_vacuum mode: " + mode;
+        return result;
+    }
 
-    // Open database if not already open
     if (!openDatabase()) {
         result.error = "Failed to open database";
-        OutputDebugStringA("[Library] dbtCompactDatabase: Failed to open database\n");
         return result;
     }
 
-    // Get size before compaction
-    DatabaseStats beforeStats = dbtGetDatabaseStats();
-    result.beforeSizeBytes = beforeStats.fileSizeBytes;
+    if (!dbManager_->dbtSetAutoVacuumMode(modeValue)) {
+        result.error = "Failed to set auto_vacuum";
+        return result;
+    }
 
-    // Run VACUUM
-    bool success = dbManager_->dbtCompactDatabase();
+    // The pragma reports the new mode only once the file has been rebuilt
+    DatabaseStats stats = dbtGetDatabaseStats();
+    result.requiresCompaction = (stats.autoVacuumMode != mode);
+    result.success = true;
 
-    if (!success) {
-        result.error = "VACUUM operation failed";
-        OutputDebugStringA("[Library] dbtCompactDatabase: VACUUM operation failed\n");
+    // Remembered for online compaction, whose copy is made on another connection
+    pendingAutoVacuumMode_ = result.requiresCompaction ? modeValue : -1;
+
+    return result;
+}
+
+Library::IncrementalVacuumResult Library::dbtIncrementalVacuum(int maxPages) {
+    IncrementalVacuumResult result;
+    result.success = false;
+    result.pagesReclaimed = 0;
+    result.bytesReclaimed = 0;
+    result.freePagesRemaining = 0;
+
+    if (!openDatabase()) {
+        result.error = "Failed to open database";
+        return result;
+    }
+
+    DatabaseStats before = dbtGetDatabaseStats();
+    if (before.autoVacuumMode != "incremental") {
+        result.error = "auto_vacuum is not INCREMENTAL";
+        result.freePagesRemaining = before.freePages;
         return result;
     }
 
-    // Get size after compaction
-    DatabaseStats afterStats = dbtGetDatabaseStats();
-    result.afterSizeBytes = afterStats.fileSizeBytes;
-    result.spaceSavedBytes = result.beforeSizeBytes - result.afterSizeBytes;
+    result.pagesReclaimed = dbManager_->dbtIncrementalVacuum(maxPages);
+    result.bytesReclaimed = result.pagesReclaimed * before.pageSize;
+    result.freePagesRemaining = before.freePages - result.pagesReclaimed;
     result.success = true;
 
-    OutputDebugStringA(("[Library] dbtCompactDatabase: Completed! Saved " + std::to_string(result.spaceSavedBytes) + " bytes\n").c_str());
-
     return result;
 }
 
@@ -686,7 +5134,7 @@ std::string Library::keyValuesToPlainText(ArcadeKeyValues* kv, int indent) {
     return result;
 }
 
-std::vector<Library::AnomalousInstanceEntry> Library::dbtFindAnomalousInstances() {
+std::vector<Library::AnomalousInstanceEntry> Library::dbtFindAnomalousInstances(int sampleSize, SampleInfo* sampleInfo) {
     OutputDebugStringA("[Library] dbtFindAnomalousInstances: Searching for instances with unexpected root keys\n");
 
     std::vector<AnomalousInstanceEntry> results;
@@ -697,8 +5145,8 @@ std::vector<Library::AnomalousInstanceEntry> Library::dbtFindAnomalousInstances(
         return results;
     }
 
-    // Get all instances (up to 10000)
-    std::vector<std::pair<std::string, std::string>> allInstances = dbManager_->getFirstEntries("instances", 10000);
+    // Get all instances (up to 10000), or a random sample of them
+    std::vector<std::pair<std::string, std::string>> allInstances = getAnalysisEntries("instances", 10000, sampleSize, sampleInfo);
 
     OutputDebugStringA(("[Library] dbtFindAnomalousInstances: Analyzing " + std::to_string(allInstances.size()) + " instances\n").c_str());
 
@@ -1000,6 +5448,17 @@ std::vector<Library::RemoveKeysResult> Library::dbtRemoveAnomalousKeys(const std
     }
     OutputDebugStringA("[Library] Synchronous mode set to FULL\n");
 
+    // Before-images of every row written, so the run can be undone
+    UndoJournal undo;
+    std::string undoError;
+    if (!openUndoJournal("removeAnomalousKeys", nullptr, undo, undoError)) {
+        OutputDebugStringA(("[Library] dbtRemoveAnomalousKeys: " + undoError + "\n").c_str());
+        for (const auto& id : instanceIds) {
+            results.push_back({ id, false, undoError });
+        }
+        return results;
+    }
+
     // === BEGIN TRANSACTION ===
     OutputDebugStringA("[Library] dbtRemoveAnomalousKeys: Beginning transaction...\n");
     rc = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg);
@@ -1017,6 +5476,9 @@ std::vector<Library::RemoveKeysResult> Library::dbtRemoveAnomalousKeys(const std
     // Expected keys at the root of an instance
     std::set<std::string> expectedKeys = { "generation", "info", "objects", "overrides", "legacy" };
 
+    // Keep the schema catalog current if it has been built for instances
+    bool trackSchema = isSchemaCatalogBuilt(db, "instances");
+
     // Process each instance
     for (const auto& id : instanceIds) {
         RemoveKeysResult result;
@@ -1048,6 +5510,11 @@ std::vector<Library::RemoveKeysResult> Library::dbtRemoveAnomalousKeys(const std
             continue;
         }
 
+        SchemaFieldSet fieldsBefore;
+        if (trackSchema) {
+            collectSchemaFields(kvData.get(), "instances", fieldsBefore);
+        }
+
         // Collect all anomalous keys (keys that are not in the expected set)
         std::vector<std::string> keysToRemove;
         ArcadeKeyValues* child = instanceSection->GetFirstSubKey();
@@ -1084,10 +5551,17 @@ std::vector<Library::RemoveKeysResult> Library::dbtRemoveAnomalousKeys(const std
         // Serialize the modified KeyValues back to hex
         std::string updatedHex = kvData->SerializeToHex();
 
-        // Update in database
-        if (dbManager_->updateEntryById("instances", id, updatedHex)) {
+        // Journal the old value, then update in database
+        if (!undo.recordBefore("instances", id, instanceData.second, updatedHex)) {
+            result.error = "Failed to write undo journal";
+        } else if (dbManager_->updateEntryById("instances", id, updatedHex)) {
             result.success = true;
             result.error = "";
+            if (trackSchema) {
+                SchemaFieldSet fieldsAfter;
+                collectSchemaFields(kvData.get(), "instances", fieldsAfter);
+                updateSchemaCatalog(db, "instances", &fieldsBefore, &fieldsAfter);
+            }
             OutputDebugStringA(("[Library] dbtRemoveAnomalousKeys: Successfully removed " + std::to_string(keysToRemove.size()) + " keys from " + id + "\n").c_str());
         } else {
             result.error = "Failed to update database";
@@ -1097,6 +5571,8 @@ std::vector<Library::RemoveKeysResult> Library::dbtRemoveAnomalousKeys(const std
         results.push_back(result);
     }
 
+    finishUndoJournal(undo, nullptr);
+
     // === COMMIT TRANSACTION ===
     OutputDebugStringA("[Library] dbtRemoveAnomalousKeys: Committing transaction...\n");
     errMsg = nullptr;
@@ -1141,7 +5617,7 @@ std::vector<Library::RemoveKeysResult> Library::dbtRemoveAnomalousKeys(const std
     return results;
 }
 
-std::vector<Library::EmptyInstanceEntry> Library::dbtFindEmptyInstances() {
+std::vector<Library::EmptyInstanceEntry> Library::dbtFindEmptyInstances(int sampleSize, SampleInfo* sampleInfo) {
     OutputDebugStringA("[Library] dbtFindEmptyInstances: Searching for instances with zero objects\n");
 
     std::vector<EmptyInstanceEntry> results;
@@ -1152,8 +5628,8 @@ std::vector<Library::EmptyInstanceEntry> Library::dbtFindEmptyInstances() {
         return results;
     }
 
-    // Get all instances (up to 10000)
-    std::vector<std::pair<std::string, std::string>> allInstances = dbManager_->getFirstEntries("instances", 10000);
+    // Get all instances (up to 10000), or a random sample of them
+    std::vector<std::pair<std::string, std::string>> allInstances = getAnalysisEntries("instances", 10000, sampleSize, sampleInfo);
 
     OutputDebugStringA(("[Library] dbtFindEmptyInstances: Analyzing " + std::to_string(allInstances.size()) + " instances\n").c_str());
 
@@ -1203,8 +5679,11 @@ std::vector<Library::EmptyInstanceEntry> Library::dbtFindEmptyInstances() {
     return results;
 }
 
-std::vector<Library::PurgeResult> Library::dbtPurgeEmptyInstances(const std::vector<std::string>& instanceIds) {
-    OutputDebugStringA(("[Library] dbtPurgeEmptyInstances: Purging " + std::to_string(instanceIds.size()) + " instances\n").c_str());
+std::vector<Library::PurgeResult> Library::dbtPurgeEmptyInstances(const std::vector<std::string>& requestedIds, JobContext* job) {
+    OutputDebugStringA(("[Library] dbtPurgeEmptyInstances: Purging " + std::to_string(requestedIds.size()) + " instances\n").c_str());
+
+    // Jobs process ids in order so the checkpoint can resume mid-list
+    const std::vector<std::string> instanceIds = prepareJobIds(job, requestedIds);
 
     std::vector<PurgeResult> results;
 
@@ -1281,6 +5760,17 @@ std::vector<Library::PurgeResult> Library::dbtPurgeEmptyInstances(const std::vec
     }
     OutputDebugStringA("[Library] Synchronous mode set to FULL\n");
 
+    // Before-images of every row written, so the run can be undone
+    UndoJournal undo;
+    std::string undoError;
+    if (!openUndoJournal("purgeEmptyInstances", job, undo, undoError)) {
+        OutputDebugStringA(("[Library] dbtPurgeEmptyInstances: " + undoError + "\n").c_str());
+        for (const auto& id : instanceIds) {
+            results.push_back({ id, false, undoError });
+        }
+        return results;
+    }
+
     // === BEGIN TRANSACTION ===
     OutputDebugStringA("[Library] dbtPurgeEmptyInstances: Beginning transaction...\n");
     rc = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg);
@@ -1294,17 +5784,43 @@ std::vector<Library::PurgeResult> Library::dbtPurgeEmptyInstances(const std::vec
         return results;
     }
     OutputDebugStringA("[Library] Transaction started successfully\n");
+    if (job) {
+        job->undoJournal = &undo;
+    }
+
+    // Keep the schema catalog current if it has been built for instances
+    bool trackSchema = isSchemaCatalogBuilt(db, "instances");
 
     // Process each instance
     for (const auto& id : instanceIds) {
+        // Stream finished rows to the job (commits every batch, honours pause/cancel)
+        if (job && !flushResultsToJob(db, job, results, "purged")) {
+            OutputDebugStringA("[Library] dbtPurgeEmptyInstances: Job cancelled\n");
+            break;
+        }
+
         PurgeResult result;
         result.id = id;
         result.success = false;
 
+        // The instance about to be removed goes to the undo journal (and its field paths to the schema catalog)
+        std::pair<std::string, std::string> instanceData = dbManager_->getEntryById("instances", id);
+        bool existed = !instanceData.second.empty();
+        SchemaFieldSet fieldsBefore;
+        if (trackSchema && existed) {
+            auto kvData = ArcadeKeyValues::ParseFromHex(instanceData.second);
+            collectSchemaFields(kvData.get(), "instances", fieldsBefore);
+        }
+
         // Delete the instance from the database
-        if (dbManager_->deleteEntryById("instances", id)) {
+        if (existed && !undo.recordBefore("instances", id, instanceData.second, "")) {
+            result.error = "Failed to write undo journal";
+        } else if (dbManager_->deleteEntryById("instances", id)) {
             result.success = true;
             result.error = "";
+            if (trackSchema && existed) {
+                updateSchemaCatalog(db, "instances", &fieldsBefore, nullptr);
+            }
             OutputDebugStringA(("[Library] dbtPurgeEmptyInstances: Successfully purged instance " + id + "\n").c_str());
         } else {
             result.error = "Failed to delete from database";
@@ -1314,6 +5830,13 @@ std::vector<Library::PurgeResult> Library::dbtPurgeEmptyInstances(const std::vec
         results.push_back(result);
     }
 
+    if (job) {
+        flushResultsToJob(db, job, results, "purged");
+        job->saveCheckpoint(db, job->getLastId());
+    }
+
+    finishUndoJournal(undo, job);
+
     // === COMMIT TRANSACTION ===
     OutputDebugStringA("[Library] dbtPurgeEmptyInstances: Committing transaction...\n");
     errMsg = nullptr;
@@ -1358,7 +5881,7 @@ std::vector<Library::PurgeResult> Library::dbtPurgeEmptyInstances(const std::vec
     return results;
 }
 
-Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, const std::string& tableName, bool skipExisting, bool overwriteIfLarger) {
+Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, const std::string& tableName, bool skipExisting, bool overwriteIfLarger, JobContext* job) {
     OutputDebugStringA(("[Library] dbtMergeDatabase: Merging from '" + sourcePath + "' into table '" + tableName + "'\n").c_str());
     OutputDebugStringA(("[Library] Options: skipExisting=" + std::string(skipExisting ? "true" : "false") +
                        ", overwriteIfLarger=" + std::string(overwriteIfLarger ? "true" : "false") + "\n").c_str());
@@ -1450,6 +5973,14 @@ Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, co
     }
     OutputDebugStringA("[Library] Synchronous mode set to FULL\n");
 
+    // Before-images of every row written, so the merge can be undone
+    UndoJournal undo;
+    if (!openUndoJournal("merge", job, undo, result.error)) {
+        OutputDebugStringA(("[Library] dbtMergeDatabase: " + result.error + "\n").c_str());
+        sqlite3_close(sourceDb);
+        return result;
+    }
+
     // === BEGIN TRANSACTION ===
     OutputDebugStringA("[Library] dbtMergeDatabase: Beginning transaction...\n");
     rc = sqlite3_exec(targetDb, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg);
@@ -1461,11 +5992,35 @@ Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, co
         return result;
     }
     OutputDebugStringA("[Library] Transaction started successfully\n");
+    if (job) {
+        job->undoJournal = &undo;
+    }
 
     // Prepare query to read all entries from source table
+    // (jobs read in id order and skip past their checkpoint)
     std::string sql = "SELECT id, value FROM " + tableName + ";";
+    if (job) {
+        sql = job->resumeAfterId.empty()
+            ? "SELECT id, value FROM " + tableName + " ORDER BY id;"
+            : "SELECT id, value FROM " + tableName + " WHERE id > ? ORDER BY id;";
+
+        sqlite3_stmt* countStmt = nullptr;
+        std::string countSql = "SELECT COUNT(*), COUNT(CASE WHEN id <= ? THEN 1 END) FROM " + tableName + ";";
+        if (sqlite3_prepare_v2(sourceDb, countSql.c_str(), -1, &countStmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(countStmt, 1, job->resumeAfterId.c_str(), -1, SQLITE_TRANSIENT);
+            if (sqlite3_step(countStmt) == SQLITE_ROW) {
+                job->rowsTotal = sqlite3_column_int64(countStmt, 0);
+                job->rowsDone = job->resumeAfterId.empty() ? 0 : sqlite3_column_int64(countStmt, 1);
+            }
+            sqlite3_finalize(countStmt);
+        }
+    }
+
     sqlite3_stmt* stmt = nullptr;
     rc = sqlite3_prepare_v2(sourceDb, sql.c_str(), -1, &stmt, nullptr);
+    if (rc == SQLITE_OK && job && !job->resumeAfterId.empty()) {
+        sqlite3_bind_text(stmt, 1, job->resumeAfterId.c_str(), -1, SQLITE_TRANSIENT);
+    }
 
     if (rc != SQLITE_OK) {
         result.error = "Failed to prepare query: " + std::string(sqlite3_errmsg(sourceDb));
@@ -1473,14 +6028,24 @@ Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, co
         // Rollback transaction on error
         sqlite3_exec(targetDb, "ROLLBACK;", nullptr, nullptr, nullptr);
         OutputDebugStringA("[Library] Transaction rolled back due to error\n");
+        finishUndoJournal(undo, job);
         sqlite3_close(sourceDb);
         return result;
     }
 
     OutputDebugStringA("[Library] dbtMergeDatabase: Query prepared, processing entries...\n");
 
+    // Keep the schema catalog current if it has been built for this table
+    bool trackSchema = isSchemaCatalogBuilt(targetDb, tableName);
+
     // Process each entry from the source database
     while (sqlite3_step(stmt) == SQLITE_ROW) {
+        // Stream finished rows to the job (commits every batch, honours pause/cancel)
+        if (job && !flushResultsToJob(targetDb, job, result.entries)) {
+            OutputDebugStringA("[Library] dbtMergeDatabase: Job cancelled\n");
+            break;
+        }
+
         const char* id = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
         const void* blob = sqlite3_column_blob(stmt, 1);
         int blobSize = sqlite3_column_bytes(stmt, 1);
@@ -1510,10 +6075,11 @@ Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, co
 
         // Check if entry exists in target database
         std::pair<std::string, std::string> existing = dbManager_->getEntryById(tableName, id);
+        size_t writesBefore = static_cast<size_t>(result.mergedCount + result.overwrittenCount);
 
         if (existing.second.empty()) {
-            // Entry doesn't exist in target - insert it
-            if (dbManager_->updateEntryById(tableName, id, hexData)) {
+            // Entry doesn't exist in target - insert it (undo deletes it again)
+            if (undo.recordBefore(tableName, id, existing.second, hexData) && dbManager_->updateEntryById(tableName, id, hexData)) {
                 entry.action = "merged";
                 result.mergedCount++;
                 OutputDebugStringA(("[Library] Merged new entry: " + std::string(id) + "\n").c_str());
@@ -1546,7 +6112,7 @@ Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, co
                 }
 
                 if (blobSize > existingSize) {
-                    if (dbManager_->updateEntryById(tableName, id, hexData)) {
+                    if (undo.recordBefore(tableName, id, existing.second, hexData) && dbManager_->updateEntryById(tableName, id, hexData)) {
                         entry.action = "overwritten";
                         result.overwrittenCount++;
                         OutputDebugStringA(("[Library] Overwritten (larger): " + std::string(id) +
@@ -1563,7 +6129,7 @@ Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, co
                 }
             } else {
                 // Overwrite all existing entries
-                if (dbManager_->updateEntryById(tableName, id, hexData)) {
+                if (undo.recordBefore(tableName, id, existing.second, hexData) && dbManager_->updateEntryById(tableName, id, hexData)) {
                     entry.action = "overwritten";
                     result.overwrittenCount++;
                     OutputDebugStringA(("[Library] Overwritten: " + std::string(id) + "\n").c_str());
@@ -1576,13 +6142,33 @@ Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, co
             }
         }
 
+        // Written rows update the schema catalog with old vs new field paths
+        if (trackSchema && static_cast<size_t>(result.mergedCount + result.overwrittenCount) > writesBefore) {
+            SchemaFieldSet fieldsBefore;
+            SchemaFieldSet fieldsAfter;
+            if (!existing.second.empty()) {
+                auto oldData = ArcadeKeyValues::ParseFromHex(existing.second);
+                collectSchemaFields(oldData.get(), tableName, fieldsBefore);
+            }
+            auto newData = ArcadeKeyValues::ParseFromBinary(blob, blobSize);
+            collectSchemaFields(newData.get(), tableName, fieldsAfter);
+            updateSchemaCatalog(targetDb, tableName, existing.second.empty() ? nullptr : &fieldsBefore, &fieldsAfter);
+        }
+
         result.entries.push_back(entry);
     }
 
+    if (job) {
+        flushResultsToJob(targetDb, job, result.entries);
+        job->saveCheckpoint(targetDb, job->getLastId());
+    }
+
     // Clean up source database
     sqlite3_finalize(stmt);
     sqlite3_close(sourceDb);
 
+    finishUndoJournal(undo, job);
+
     // === COMMIT TRANSACTION ===
     OutputDebugStringA("[Library] dbtMergeDatabase: Committing transaction...\n");
     errMsg = nullptr;
@@ -1627,3 +6213,655 @@ Library::MergeResult Library::dbtMergeDatabase(const std::string& sourcePath, co
 
     return result;
 }
+
+bool Library::openUndoJournal(const std::string& tool, JobContext* job, UndoJournal& journal, std::string& error) {
+    std::string databasePath = config_->getDatabasePath();
+    std::string name;
+    if (job) {
+        name = "job-" + std::to_string(job->jobId);
+    } else {
+        // Direct calls are named by tool and time, with a suffix if two land in the same second
+        name = tool + "-" + std::to_string(static_cast<int64_t>(time(nullptr)));
+        std::string base = name;
+        for (int suffix = 2; GetFileAttributesA(UndoJournal::pathFor(databasePath, name).c_str()) != INVALID_FILE_ATTRIBUTES; suffix++) {
+            name = base + "-" + std::to_string(suffix);
+        }
+    }
+
+    if (!journal.open(UndoJournal::pathFor(databasePath, name), error)) {
+        return false;
+    }
+    OutputDebugStringA(("[Library] openUndoJournal: Journaling " + tool + " to " + journal.path() + "\n").c_str());
+    return true;
+}
+
+// Journal names come from the page; keep them inside the journal directory
+static bool isValidUndoJournalName(const std::string& name) {
+    if (name.empty()) {
+        return false;
+    }
+    for (char c : name) {
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<Library::UndoJournalInfo> Library::dbtListUndoJournals() {
+    std::vector<UndoJournalInfo> journals;
+
+    std::string pattern = UndoJournal::directoryFor(config_->getDatabasePath()) + "\\*.undo";
+    WIN32_FIND_DATAA findData;
+    HANDLE find = FindFirstFileA(pattern.c_str(), &findData);
+    if (find == INVALID_HANDLE_VALUE) {
+        return journals;
+    }
+
+    do {
+        std::string fileName = findData.cFileName;
+        UndoJournalInfo info;
+        info.name = fileName.substr(0, fileName.length() - 5);
+        info.sizeBytes = (static_cast<int64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow;
+
+        // FILETIME counts 100ns intervals since 1601
+        ULARGE_INTEGER modified;
+        modified.LowPart = findData.ftLastWriteTime.dwLowDateTime;
+        modified.HighPart = findData.ftLastWriteTime.dwHighDateTime;
+        info.modifiedTime = static_cast<int64_t>((modified.QuadPart - 116444736000000000ULL) / 10000000ULL);
+
+        journals.push_back(info);
+    } while (FindNextFileA(find, &findData));
+    FindClose(find);
+
+    // Newest first
+    std::sort(journals.begin(), journals.end(), [](const UndoJournalInfo& a, const UndoJournalInfo& b) {
+        return a.modifiedTime > b.modifiedTime;
+    });
+    return journals;
+}
+
+Library::UndoResult Library::dbtUndoJournal(const std::string& name) {
+    UndoResult result;
+    result.success = false;
+    result.recordsReplayed = 0;
+    result.rowsRestored = 0;
+    result.rowsDeleted = 0;
+    result.rowsSkipped = 0;
+
+    OutputDebugStringA(("[Library] dbtUndoJournal: Undoing " + name + "\n").c_str());
+
+    if (!isValidUndoJournalName(name)) {
+        result.error = "Invalid undo journal name";
+        return result;
+    }
+
+    // Open database if not already open
+    if (!openDatabase()) {
+        result.error = "Database not available";
+        return result;
+    }
+
+    std::string path = UndoJournal::pathFor(config_->getDatabasePath(), name);
+    UndoJournalReader reader;
+    if (!reader.open(path, result.error)) {
+        return result;
+    }
+
+    sqlite3* db = dbManager_->getDb();
+
+    // === BEGIN TRANSACTION ===
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        result.error = "Failed to begin transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        return result;
+    }
+
+    // Statements per table, prepared on first use
+    struct TableStatements {
+        sqlite3_stmt* restore;
+        sqlite3_stmt* remove;
+        sqlite3_stmt* select;
+    };
+    std::map<std::string, TableStatements> statements;
+    std::set<std::string> tablesTouched;
+    std::set<std::pair<std::string, std::string>> rowsSkipped;
+    bool failed = false;
+
+    // Newest first, so a row written twice ends up with its oldest before-image
+    UndoJournal::Record record;
+    for (size_t i = reader.size(); i-- > 0;) {
+        if (!reader.read(i, record)) {
+            result.error = "Failed to read undo record " + std::to_string(i);
+            failed = true;
+            break;
+        }
+
+        auto it = statements.find(record.tableName);
+        if (it == statements.end()) {
+            if (record.tableName.empty() || record.tableName.find('"') != std::string::npos) {
+                result.error = "Invalid table name in undo journal";
+                failed = true;
+                break;
+            }
+
+            std::string restoreSql = "INSERT OR REPLACE INTO \"" + record.tableName + "\" (id, value) VALUES (?, ?);";
+            std::string deleteSql = "DELETE FROM \"" + record.tableName + "\" WHERE id = ?;";
+            std::string selectSql = "SELECT value FROM \"" + record.tableName + "\" WHERE id = ?;";
+            TableStatements prepared = { nullptr, nullptr, nullptr };
+            if (sqlite3_prepare_v2(db, restoreSql.c_str(), -1, &prepared.restore, nullptr) != SQLITE_OK ||
+                sqlite3_prepare_v2(db, deleteSql.c_str(), -1, &prepared.remove, nullptr) != SQLITE_OK ||
+                sqlite3_prepare_v2(db, selectSql.c_str(), -1, &prepared.select, nullptr) != SQLITE_OK) {
+                result.error = "Failed to prepare statements for " + record.tableName + ": " + std::string(sqlite3_errmsg(db));
+                if (prepared.restore) sqlite3_finalize(prepared.restore);
+                if (prepared.remove) sqlite3_finalize(prepared.remove);
+                failed = true;
+                break;
+            }
+            it = statements.insert({ record.tableName, prepared }).first;
+            tablesTouched.insert(record.tableName);
+        }
+
+        // Only put a row back if it still holds what the run wrote; anything else was changed since
+        if (record.checked) {
+            sqlite3_stmt* select = it->second.select;
+            sqlite3_bind_text(select, 1, record.id.c_str(), -1, SQLITE_TRANSIENT);
+            int rc = sqlite3_step(select);
+            bool exists = (rc == SQLITE_ROW);
+            uint64_t currentHash = 0;
+            if (exists) {
+                const void* value = sqlite3_column_blob(select, 0);
+                currentHash = UndoJournal::hashValue(value, static_cast<size_t>(sqlite3_column_bytes(select, 0)));
+            }
+            sqlite3_reset(select);
+            if (rc != SQLITE_ROW && rc != SQLITE_DONE) {
+                result.error = "Failed to read " + record.id + ": " + std::string(sqlite3_errmsg(db));
+                failed = true;
+                break;
+            }
+
+            bool unchanged = (exists == record.existsAfter) && (!exists || currentHash == record.afterHash);
+            if (!unchanged) {
+                // A row already at its before-image (its write was rolled back) needs nothing
+                bool alreadyUndone = (record.op == UndoJournal::OP_RESTORE)
+                    ? exists && currentHash == UndoJournal::hashValue(record.value.data(), record.value.size())
+                    : !exists;
+                if (!alreadyUndone && rowsSkipped.insert({ record.tableName, record.id }).second) {
+                    result.skippedRows.push_back({ record.tableName, record.id });
+                    OutputDebugStringA(("[Library] dbtUndoJournal: Skipping " + record.tableName + " " + record.id + ", changed since the run\n").c_str());
+                }
+                continue;
+            }
+        }
+
+        sqlite3_stmt* stmt = nullptr;
+        if (record.op == UndoJournal::OP_RESTORE) {
+            stmt = it->second.restore;
+            sqlite3_bind_text(stmt, 1, record.id.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_blob(stmt, 2, record.value.data(), static_cast<int>(record.value.size()), SQLITE_TRANSIENT);
+        } else {
+            stmt = it->second.remove;
+            sqlite3_bind_text(stmt, 1, record.id.c_str(), -1, SQLITE_TRANSIENT);
+        }
+
+        int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        if (rc != SQLITE_DONE) {
+            result.error = "Failed to undo " + record.id + ": " + std::string(sqlite3_errmsg(db));
+            failed = true;
+            break;
+        }
+
+        result.recordsReplayed++;
+        if (record.op == UndoJournal::OP_RESTORE) {
+            result.rowsRestored++;
+        } else {
+            result.rowsDeleted++;
+        }
+    }
+
+    for (auto& pair : statements) {
+        sqlite3_finalize(pair.second.restore);
+        sqlite3_finalize(pair.second.remove);
+        sqlite3_finalize(pair.second.select);
+    }
+    result.rowsSkipped = static_cast<int64_t>(result.skippedRows.size());
+
+    if (failed) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        OutputDebugStringA(("[Library] dbtUndoJournal: " + result.error + " (rolled back)\n").c_str());
+        return result;
+    }
+
+    // === COMMIT TRANSACTION ===
+    if (sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        result.error = "Failed to commit transaction: " + std::string(errMsg ? errMsg : "unknown error");
+        if (errMsg) sqlite3_free(errMsg);
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return result;
+    }
+
+    // A journal is only replayed once
+    reader.close();
+    DeleteFileA(path.c_str());
+
+    // Restored rows can bring back field paths, so built schema catalogs are rebuilt
+    for (const auto& tableName : tablesTouched) {
+        if (isSchemaCatalogBuilt(db, tableName)) {
+            std::string error;
+            if (!buildSchemaCatalog(tableName, error)) {
+                OutputDebugStringA(("[Library] dbtUndoJournal: Schema catalog rebuild failed for " + tableName + ": " + error + "\n").c_str());
+            }
+        }
+    }
+
+    result.success = true;
+    OutputDebugStringA(("[Library] dbtUndoJournal: Replayed " + std::to_string(result.recordsReplayed) + " records (" +
+        std::to_string(result.rowsRestored) + " restored, " + std::to_string(result.rowsDeleted) + " deleted, " +
+        std::to_string(result.rowsSkipped) + " skipped as changed)\n").c_str());
+    return result;
+}
+
+Library::UndoResult Library::dbtUndoJob(int jobId) {
+    return dbtUndoJournal("job-" + std::to_string(jobId));
+}
+
+bool Library::dbtDeleteUndoJournal(const std::string& name) {
+    if (!isValidUndoJournalName(name)) {
+        return false;
+    }
+    return DeleteFileA(UndoJournal::pathFor(config_->getDatabasePath(), name).c_str()) != 0;
+}
+
+// Helper function to hash a blob (FNV-1a, 64-bit) for cheap equality checks
+static uint64_t blobContentHash(const void* data, int size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 1469598103934665603ULL;
+    for (int i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Helper function to check whether a table exists in an arbitrary database handle
+static bool diffTableExists(sqlite3* db, const std::string& tableName) {
+    sqlite3_stmt* stmt = nullptr;
+    bool exists = false;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE type='table' AND name=?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, tableName.c_str(), -1, SQLITE_TRANSIENT);
+        exists = (sqlite3_step(stmt) == SQLITE_ROW);
+        sqlite3_finalize(stmt);
+    }
+    return exists;
+}
+
+// Helper function to count rows of a table in an arbitrary database handle
+static int64_t diffCountRows(sqlite3* db, const std::string& tableName) {
+    if (!diffTableExists(db, tableName)) {
+        return 0;
+    }
+
+    int64_t count = 0;
+    sqlite3_stmt* stmt = nullptr;
+    std::string sql = "SELECT COUNT(*) FROM \"" + tableName + "\";";
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            count = sqlite3_column_int64(stmt, 0);
+        }
+        sqlite3_finalize(stmt);
+    }
+    return count;
+}
+
+// Helper function to flatten a KeyValues tree into path -> value pairs
+void Library::diffFieldsRecursive(ArcadeKeyValues* node, const std::string& currentPath, std::map<std::string, std::string>& fields) {
+    if (!node) {
+        return;
+    }
+
+    for (ArcadeKeyValues* child = node->GetFirstSubKey(); child; child = child->GetNextKey()) {
+        std::string childPath = currentPath.empty() ? child->GetName() : currentPath + "." + child->GetName();
+
+        switch (child->GetValueType()) {
+            case ArcadeKeyValues::TYPE_SUBSECTION:
+                if (child->GetChildCount() == 0) {
+                    fields[childPath] = "{}";
+                } else {
+                    diffFieldsRecursive(child, childPath, fields);
+                }
+                break;
+            case ArcadeKeyValues::TYPE_INT:
+                fields[childPath] = std::to_string(child->GetInt());
+                break;
+            case ArcadeKeyValues::TYPE_FLOAT:
+                fields[childPath] = std::to_string(child->GetFloat());
+                break;
+            default:
+                fields[childPath] = child->GetString();
+                break;
+        }
+    }
+}
+
+void Library::diffFinalizeStatements() {
+    if (diff_.stmtA) {
+        sqlite3_finalize(diff_.stmtA);
+        diff_.stmtA = nullptr;
+    }
+    if (diff_.stmtB) {
+        sqlite3_finalize(diff_.stmtB);
+        diff_.stmtB = nullptr;
+    }
+    diff_.hasRowA = false;
+    diff_.hasRowB = false;
+}
+
+// Prepare ordered cursors for the current table on both sides.
+// Returns false once every requested table has been consumed.
+bool Library::diffOpenTable() {
+    diffFinalizeStatements();
+
+    while (diff_.tableIndex < diff_.tableNames.size()) {
+        const std::string& tableName = diff_.tableNames[diff_.tableIndex];
+        std::string sql = "SELECT id, value FROM \"" + tableName + "\" ORDER BY id;";
+
+        // A table missing from one side is treated as empty on that side
+        if (diffTableExists(diff_.dbA, tableName)) {
+            if (sqlite3_prepare_v2(diff_.dbA, sql.c_str(), -1, &diff_.stmtA, nullptr) == SQLITE_OK) {
+                diff_.hasRowA = (sqlite3_step(diff_.stmtA) == SQLITE_ROW);
+            }
+        }
+        if (diffTableExists(diff_.dbB, tableName)) {
+            if (sqlite3_prepare_v2(diff_.dbB, sql.c_str(), -1, &diff_.stmtB, nullptr) == SQLITE_OK) {
+                diff_.hasRowB = (sqlite3_step(diff_.stmtB) == SQLITE_ROW);
+            }
+        }
+
+        diff_.totals.currentTable = tableName;
+        OutputDebugStringA(("[Library] dbtDiffDatabases: Comparing table " + tableName + "\n").c_str());
+
+        if (diff_.hasRowA || diff_.hasRowB) {
+            return true;
+        }
+
+        // Both sides empty - move on to the next table
+        diffFinalizeStatements();
+        diff_.tableIndex++;
+    }
+
+    return false;
+}
+
+Library::DiffPage Library::dbtDiffDatabases(const std::string& pathA, const std::string& pathB, const std::vector<std::string>& tableNames, int pageSize) {
+    OutputDebugStringA(("[Library] dbtDiffDatabases: Comparing " + pathA + " against " + pathB + "\n").c_str());
+
+    // Only one diff can be in progress at a time
+    dbtCloseDiff();
+
+    DiffPage& totals = diff_.totals;
+    totals.success = false;
+    totals.error = "";
+    totals.finished = false;
+    totals.currentTable = "";
+    totals.rowsScanned = 0;
+    totals.rowsTotal = 0;
+    totals.bytesScanned = 0;
+    totals.identicalCount = 0;
+    totals.changedCount = 0;
+    totals.onlyInACount = 0;
+    totals.onlyInBCount = 0;
+    totals.entries.clear();
+
+    // Open both files read-only so the diff can never modify either side
+    int rc = sqlite3_open_v2(pathA.c_str(), &diff_.dbA, SQLITE_OPEN_READONLY, nullptr);
+    if (rc != SQLITE_OK) {
+        totals.error = "Cannot open database A: " + std::string(sqlite3_errmsg(diff_.dbA));
+        OutputDebugStringA(("[Library] dbtDiffDatabases: " + totals.error + "\n").c_str());
+        DiffPage page = totals;
+        dbtCloseDiff();
+        return page;
+    }
+
+    rc = sqlite3_open_v2(pathB.c_str(), &diff_.dbB, SQLITE_OPEN_READONLY, nullptr);
+    if (rc != SQLITE_OK) {
+        totals.error = "Cannot open database B: " + std::string(sqlite3_errmsg(diff_.dbB));
+        OutputDebugStringA(("[Library] dbtDiffDatabases: " + totals.error + "\n").c_str());
+        DiffPage page = totals;
+        dbtCloseDiff();
+        return page;
+    }
+
+    // Default to every supported entry type; the names end up in SQL, so nothing else is accepted
+    std::vector<std::string> supportedTypes = getSupportedEntryTypes();
+    for (const auto& tableName : tableNames) {
+        if (std::find(supportedTypes.begin(), supportedTypes.end(), tableName) == supportedTypes.end()) {
+            totals.error = "Unsupported table: " + tableName;
+            OutputDebugStringA(("[Library] dbtDiffDatabases: " + totals.error + "\n").c_str());
+            DiffPage page = totals;
+            dbtCloseDiff();
+            return page;
+        }
+    }
+    diff_.tableNames = tableNames.empty() ? supportedTypes : tableNames;
+    diff_.tableIndex = 0;
+
+    // Count rows up front so progress can be reported
+    for (const auto& tableName : diff_.tableNames) {
+        totals.rowsTotal += diffCountRows(diff_.dbA, tableName);
+        totals.rowsTotal += diffCountRows(diff_.dbB, tableName);
+    }
+
+    OutputDebugStringA(("[Library] dbtDiffDatabases: " + std::to_string(totals.rowsTotal) + " rows to compare across " +
+                       std::to_string(diff_.tableNames.size()) + " tables\n").c_str());
+
+    diff_.active = true;
+    if (!diffOpenTable()) {
+        totals.finished = true;
+    }
+
+    return dbtGetNextDiffResults(pageSize);
+}
+
+Library::DiffPage Library::dbtGetNextDiffResults(int pageSize) {
+    DiffPage page = diff_.totals;
+    page.entries.clear();
+
+    if (!diff_.active) {
+        if (!page.finished && page.error.empty()) {
+            page.error = "No diff in progress";
+        }
+        return page;
+    }
+
+    if (pageSize <= 0) {
+        pageSize = 100;
+    }
+
+    DiffPage& totals = diff_.totals;
+
+    // A call also returns once it has read this much, so two large, nearly identical files
+    // don't hold the UI thread for the whole scan; the page simply has fewer entries
+    const int64_t MAX_ROWS_PER_CALL = 20000;
+    const int64_t MAX_BYTES_PER_CALL = 64LL * 1024 * 1024;
+    int64_t rowsAtStart = totals.rowsScanned;
+    int64_t bytesAtStart = totals.bytesScanned;
+
+    while (!totals.finished && static_cast<int>(page.entries.size()) < pageSize &&
+           totals.rowsScanned - rowsAtStart < MAX_ROWS_PER_CALL &&
+           totals.bytesScanned - bytesAtStart < MAX_BYTES_PER_CALL) {
+        // Current table exhausted on both sides - advance
+        if (!diff_.hasRowA && !diff_.hasRowB) {
+            diff_.tableIndex++;
+            if (!diffOpenTable()) {
+                totals.finished = true;
+            }
+            continue;
+        }
+
+        const std::string& tableName = diff_.tableNames[diff_.tableIndex];
+
+        const char* idA = diff_.hasRowA ? reinterpret_cast<const char*>(sqlite3_column_text(diff_.stmtA, 0)) : nullptr;
+        const char* idB = diff_.hasRowB ? reinterpret_cast<const char*>(sqlite3_column_text(diff_.stmtB, 0)) : nullptr;
+
+        // Merge-join on id (BINARY collation, same ordering as std::string)
+        int cmp;
+        if (!diff_.hasRowA) {
+            cmp = 1;
+        } else if (!diff_.hasRowB) {
+            cmp = -1;
+        } else {
+            cmp = std::string(idA ? idA : "").compare(idB ? idB : "");
+        }
+
+        if (cmp < 0) {
+            DiffEntry entry;
+            entry.tableName = tableName;
+            entry.id = idA ? idA : "";
+            entry.status = "onlyInA";
+            entry.sizeA = sqlite3_column_bytes(diff_.stmtA, 1);
+            entry.sizeB = 0;
+            page.entries.push_back(entry);
+
+            totals.onlyInACount++;
+            totals.rowsScanned++;
+            totals.bytesScanned += entry.sizeA;
+            diff_.hasRowA = (sqlite3_step(diff_.stmtA) == SQLITE_ROW);
+        } else if (cmp > 0) {
+            DiffEntry entry;
+            entry.tableName = tableName;
+            entry.id = idB ? idB : "";
+            entry.status = "onlyInB";
+            entry.sizeA = 0;
+            entry.sizeB = sqlite3_column_bytes(diff_.stmtB, 1);
+            page.entries.push_back(entry);
+
+            totals.onlyInBCount++;
+            totals.rowsScanned++;
+            totals.bytesScanned += entry.sizeB;
+            diff_.hasRowB = (sqlite3_step(diff_.stmtB) == SQLITE_ROW);
+        } else {
+            const void* blobA = sqlite3_column_blob(diff_.stmtA, 1);
+            int sizeA = sqlite3_column_bytes(diff_.stmtA, 1);
+            const void* blobB = sqlite3_column_blob(diff_.stmtB, 1);
+            int sizeB = sqlite3_column_bytes(diff_.stmtB, 1);
+
+            // Cheap checks first: size, then content hash; equal hashes are confirmed byte for byte
+            bool identical = (sizeA == sizeB) &&
+                (sizeA == 0 || (blobContentHash(blobA, sizeA) == blobContentHash(blobB, sizeB) &&
+                                memcmp(blobA, blobB, sizeA) == 0));
+
+            if (!identical) {
+                // Only rows that differ pay for a per-field KeyValues diff
+                std::map<std::string, std::string> fieldsA;
+                std::map<std::string, std::string> fieldsB;
+                if (blobA && sizeA > 0) {
+                    auto kvA = ArcadeKeyValues::ParseFromBinary(blobA, sizeA);
+                    diffFieldsRecursive(kvA.get(), "", fieldsA);
+                }
+                if (blobB && sizeB > 0) {
+                    auto kvB = ArcadeKeyValues::ParseFromBinary(blobB, sizeB);
+                    diffFieldsRecursive(kvB.get(), "", fieldsB);
+                }
+
+                DiffEntry entry;
+                entry.tableName = tableName;
+                entry.id = idA ? idA : "";
+                entry.status = "changed";
+                entry.sizeA = sizeA;
+                entry.sizeB = sizeB;
+
+                auto itA = fieldsA.begin();
+                auto itB = fieldsB.begin();
+                while (itA != fieldsA.end() || itB != fieldsB.end()) {
+                    FieldDiff field;
+                    if (itB == fieldsB.end() || (itA != fieldsA.end() && itA->first < itB->first)) {
+                        field.path = itA->first;
+                        field.change = "removed";
+                        field.valueA = itA->second;
+                        entry.fields.push_back(field);
+                        ++itA;
+                    } else if (itA == fieldsA.end() || itB->first < itA->first) {
+                        field.path = itB->first;
+                        field.change = "added";
+                        field.valueB = itB->second;
+                        entry.fields.push_back(field);
+                        ++itB;
+                    } else {
+                        if (itA->second != itB->second) {
+                            field.path = itA->first;
+                            field.change = "changed";
+                            field.valueA = itA->second;
+                            field.valueB = itB->second;
+                            entry.fields.push_back(field);
+                        }
+                        ++itA;
+                        ++itB;
+                    }
+                }
+
+                // Blobs that differ only in key order are logically identical
+                if (entry.fields.empty()) {
+                    identical = true;
+                } else {
+                    page.entries.push_back(entry);
+                    totals.changedCount++;
+                }
+            }
+
+            if (identical) {
+                totals.identicalCount++;
+            }
+
+            totals.rowsScanned += 2;
+            totals.bytesScanned += sizeA + sizeB;
+            diff_.hasRowA = (sqlite3_step(diff_.stmtA) == SQLITE_ROW);
+            diff_.hasRowB = (sqlite3_step(diff_.stmtB) == SQLITE_ROW);
+        }
+    }
+
+    totals.success = true;
+
+    // Copy running counters into the page
+    page.success = totals.success;
+    page.finished = totals.finished;
+    page.currentTable = totals.currentTable;
+    page.rowsScanned = totals.rowsScanned;
+    page.rowsTotal = totals.rowsTotal;
+    page.bytesScanned = totals.bytesScanned;
+    page.identicalCount = totals.identicalCount;
+    page.changedCount = totals.changedCount;
+    page.onlyInACount = totals.onlyInACount;
+    page.onlyInBCount = totals.onlyInBCount;
+
+    OutputDebugStringA(("[Library] dbtGetNextDiffResults: " + std::to_string(page.entries.size()) + " differences, " +
+                       std::to_string(page.rowsScanned) + "/" + std::to_string(page.rowsTotal) + " rows scanned\n").c_str());
+
+    if (totals.finished) {
+        OutputDebugStringA(("[Library] dbtDiffDatabases: Completed! Identical=" + std::to_string(totals.identicalCount) +
+                           ", Changed=" + std::to_string(totals.changedCount) +
+                           ", OnlyInA=" + std::to_string(totals.onlyInACount) +
+                           ", OnlyInB=" + std::to_string(totals.onlyInBCount) + "\n").c_str());
+        dbtCloseDiff();
+    }
+
+    return page;
+}
+
+void Library::dbtCloseDiff() {
+    diffFinalizeStatements();
+
+    if (diff_.dbA) {
+        sqlite3_close(diff_.dbA);
+        diff_.dbA = nullptr;
+    }
+    if (diff_.dbB) {
+        sqlite3_close(diff_.dbB);
+        diff_.dbB = nullptr;
+    }
+
+    diff_.tableNames.clear();
+    diff_.tableIndex = 0;
+    diff_.active = false;
+}
@@ -5,11 +5,20 @@
 #include "Config.h"
 #include "ArcadeKeyValues.h"
 #include "ImageLoader.h"
+#include "JobContext.h"
+#include "HealthChecks.h"
+#include "FieldSketches.h"
+#include "CleanupRules.h"
+#include "InstanceMigrations.h"
+#include "UndoJournal.h"
 #include <vector>
 #include <string>
 #include <utility>
 #include <functional>
 #include <set>
+#include <map>
+#include <thread>
+#include <mutex>
 
 /**
  * Library class - Manages the arcade library functionality
@@ -28,9 +37,21 @@ private:
     SQLiteManager* dbManager_;
     ArcadeConfig* config_;
     ImageLoader* imageLoader_;
+    InstanceMigrator instanceMigrator_;
+    std::string browseEntryType_;  // Entry type of the active browse / search, for upgrade-on-read
+    std::string searchEntryType_;
+    std::set<std::string> pendingInstanceUpgrades_;  // Instances upgraded on read, not yet written back
 
-    // Helper method for recursive schema construction
-    void collectFieldPathsRecursive(ArcadeKeyValues* node, const std::string& currentPath, std::set<std::string>& fieldSet, bool isInstanceData, int depth);
+    // Field paths of one entry, as (path, value type) pairs
+    typedef std::set<std::pair<std::string, std::string>> SchemaFieldSet;
+
+    // Called with each field's dotted path and node
+    typedef std::function<void(const std::string&, ArcadeKeyValues*)> FieldPathVisitor;
+
+    // Helper methods for recursive schema construction
+    void visitFieldPathsRecursive(ArcadeKeyValues* node, const std::string& currentPath, const FieldPathVisitor& visit, bool isInstanceData, int depth);
+    void visitEntryFields(ArcadeKeyValues* root, const std::string& entryType, const FieldPathVisitor& visit);
+    void collectSchemaFields(ArcadeKeyValues* root, const std::string& entryType, SchemaFieldSet& fieldSet);
 
 public:
     // Constructor - takes references to required managers
@@ -50,16 +71,72 @@ public:
     std::vector<std::pair<std::string, std::string>> getFirstSearchResults(const std::string& entryType, const std::string& searchTerm, int count);
     std::vector<std::pair<std::string, std::string>> getNextSearchResults(int count);
 
-    // Image caching methods
-    void cacheImage(const std::string& url, std::function<void(const ImageLoadResult&)> callback);
+    // Image caching methods. cacheImage(s) return the request handle cancelImages takes (0 without a loader).
+    uint64_t cacheImage(const std::string& url, std::function<void(const ImageLoadResult&)> callback,
+                        int priority = IMAGE_PRIORITY_VISIBLE);
+    uint64_t cacheImages(const std::vector<std::string>& urls, std::function<void(size_t, const ImageLoadResult&)> callback,
+                         int priority = IMAGE_PRIORITY_VISIBLE);
+    int reprioritizeImages(const std::vector<std::string>& urls, int priority);
+    int cancelImages(const std::vector<std::string>& urls, uint64_t requestId);
+    int clearImageFailures(const std::vector<std::string>& urls);
     void processImageCompletions();
 
     // Utility methods
     std::vector<std::string> getSupportedEntryTypes() const;
     bool openDatabase();
 
-    // Schema construction
-    std::vector<std::string> constructSchema(const std::string& entryType);
+    // Sampling: the analysis tools below can look at a uniform random sample of
+    // sampleSize rows (rowid probing) instead of the whole table, for quick first answers
+    struct SampleInfo {
+        bool sampled = false;
+        int64_t sampledRows = 0;
+        int64_t estimatedTotalRows = 0;
+        double coverage = 0.0;  // sampledRows / estimatedTotalRows
+    };
+
+    // Schema construction, served from the persistent schema_catalog table.
+    // The catalog is built by a parallel scan the first time a type is requested
+    // (or when rebuild is set) and kept current by the write paths afterwards.
+    struct SchemaField {
+        std::string path;
+        std::string valueType;  // "string", "int", "float", "section", "none"
+        int64_t occurrences;    // Entries containing this path with this type
+        double frequency;       // occurrences / entries of this type
+        int64_t firstSeen;      // Unix timestamps
+        int64_t lastSeen;       // Last time a write added this path to an entry
+    };
+
+    std::vector<SchemaField> constructSchema(const std::string& entryType, bool rebuild = false, int sampleSize = 0, SampleInfo* sampleInfo = nullptr);
+    bool dbtBuildSchemaCatalog(const std::string& entryType, std::string& error);
+
+    // Approximate per-field statistics for huge tables: HyperLogLog distinct count,
+    // Misra-Gries top values and a value length histogram per KV path (FieldSketches.h).
+    // Computed over the parallel table scan and persisted in field_statistics.
+    // Run as the "computeFieldStatistics" job for progress and cancel; each field then streams through the job.
+    struct FieldTopValue {
+        std::string value;
+        int64_t count;  // Lower bound
+    };
+
+    struct FieldStatistics {
+        std::string path;
+        int64_t count;             // Values seen at this path
+        int64_t distinctEstimate;
+        int64_t maxLength;
+        std::vector<FieldTopValue> topValues;
+        std::vector<int64_t> lengthHistogram;  // Buckets 0, 1, 2-3, 4-7, ..., 32768+
+    };
+
+    struct FieldStatisticsResult {
+        bool success;
+        std::string error;
+        int64_t entries;
+        int64_t computedAt;  // Unix timestamp, 0 if never computed
+        std::vector<FieldStatistics> fields;
+    };
+
+    FieldStatisticsResult dbtComputeFieldStatistics(const std::string& entryType, JobContext* job = nullptr);
+    FieldStatisticsResult dbtGetFieldStatistics(const std::string& entryType);  // Last persisted result
 
     // Database tools: Large BLOB detection
     struct LargeBlobEntry {
@@ -68,7 +145,7 @@ public:
         int sizeBytes;
     };
 
-    std::vector<LargeBlobEntry> dbtFindLargeEntriesInTable(const std::string& tableName, int minSizeBytes);
+    std::vector<LargeBlobEntry> dbtFindLargeEntriesInTable(const std::string& tableName, int minSizeBytes, int sampleSize = 0, SampleInfo* sampleInfo = nullptr);
 
     // Trim text fields for specified entries
     struct TrimResult {
@@ -77,7 +154,7 @@ public:
         std::string error;
     };
 
-    std::vector<TrimResult> dbtTrimTextFields(const std::string& tableName, const std::vector<std::string>& entryIds, int maxLength);
+    std::vector<TrimResult> dbtTrimTextFields(const std::string& tableName, const std::vector<std::string>& entryIds, int maxLength, JobContext* job = nullptr);
 
     // Database maintenance
     struct DatabaseStats {
@@ -87,6 +164,9 @@ public:
         int64_t pageSize;
         int64_t freePages;
         double fragmentationPercent;
+        std::string autoVacuumMode;  // "none", "full", "incremental"
+        int64_t reclaimedPages;      // Freed by incremental vacuum steps this session
+        int64_t reclaimedBytes;
     };
 
     struct CompactResult {
@@ -98,7 +178,68 @@ public:
     };
 
     DatabaseStats dbtGetDatabaseStats();
-    CompactResult dbtCompactDatabase();
+    CompactResult dbtCompactDatabase(JobContext* job = nullptr);
+
+    // Storage breakdown per table/index plus BLOB size percentiles per entry type
+    typedef SQLiteManager::StorageObjectStats StorageObjectStats;
+    typedef SQLiteManager::BlobHistogram BlobHistogram;
+    typedef SQLiteManager::StorageAnalysis StorageAnalysis;
+
+    StorageAnalysis dbtAnalyzeStorage();
+
+    // Online compaction: VACUUM INTO a temp file on a background connection while
+    // triggers log every write, then replay the log and swap the files
+    struct OnlineCompactionStatus {
+        bool running;        // Copy in progress
+        bool readyToSwap;    // Copy finished, waiting for dbtFinishOnlineCompaction
+        bool success;
+        std::string error;
+        int64_t beforeSizeBytes;
+        int64_t copySizeBytes;
+        int64_t changesLogged;  // Rows written since the copy started
+    };
+
+    bool dbtStartOnlineCompaction(std::string& error);
+    OnlineCompactionStatus dbtGetOnlineCompactionStatus();
+    CompactResult dbtFinishOnlineCompaction();
+    void dbtCancelOnlineCompaction();
+
+    // Online backup with sqlite3_backup_step, a few pages per step with a sleep in between so other
+    // connections keep reading and writing. Incremental mode refreshes a copy of an existing snapshot,
+    // writing only the pages that differ, and skips it entirely if the header change counter matches.
+    // Either way the result is built in "<path>.partial" and moved over the previous snapshot when done.
+    struct BackupResult {
+        bool success;
+        std::string error;
+        bool incremental;      // Existing snapshot refreshed page by page
+        bool unchanged;        // Change counter matched the last snapshot; nothing copied
+        int64_t pagesTotal;
+        int64_t pagesWritten;
+        int64_t bytesWritten;
+        int64_t restarts;      // Copies restarted because the library changed mid-way
+    };
+
+    BackupResult dbtBackupTo(const std::string& path, int pagesPerStep = 256, int sleepMs = 10, bool compress = false,
+        bool incremental = false, JobContext* job = nullptr);
+
+    // Lighter alternative: auto_vacuum=INCREMENTAL plus periodic incremental_vacuum(N) steps
+    struct AutoVacuumResult {
+        bool success;
+        std::string error;
+        std::string mode;
+        bool requiresCompaction;  // Switching from/to "none" only applies after a full compaction
+    };
+
+    struct IncrementalVacuumResult {
+        bool success;
+        std::string error;
+        int64_t pagesReclaimed;
+        int64_t bytesReclaimed;
+        int64_t freePagesRemaining;
+    };
+
+    AutoVacuumResult dbtSetAutoVacuumMode(const std::string& mode);
+    IncrementalVacuumResult dbtIncrementalVacuum(int maxPages);
 
     // Anomalous instances detection
     struct AnomalousInstanceEntry {
@@ -109,7 +250,7 @@ public:
         int legacy;  // -1 = not found, otherwise displays the actual integer value
     };
 
-    std::vector<AnomalousInstanceEntry> dbtFindAnomalousInstances();
+    std::vector<AnomalousInstanceEntry> dbtFindAnomalousInstances(int sampleSize = 0, SampleInfo* sampleInfo = nullptr);
     std::string dbtGetInstanceKeyValues(const std::string& instanceId);
 
     // Library Inspector - Generic entry viewer
@@ -130,7 +271,7 @@ public:
         bool hasObjectsKey;  // false if "objects" key is missing
     };
 
-    std::vector<EmptyInstanceEntry> dbtFindEmptyInstances();
+    std::vector<EmptyInstanceEntry> dbtFindEmptyInstances(int sampleSize = 0, SampleInfo* sampleInfo = nullptr);
 
     struct PurgeResult {
         std::string id;
@@ -138,7 +279,7 @@ public:
         std::string error;
     };
 
-    std::vector<PurgeResult> dbtPurgeEmptyInstances(const std::vector<std::string>& instanceIds);
+    std::vector<PurgeResult> dbtPurgeEmptyInstances(const std::vector<std::string>& instanceIds, JobContext* job = nullptr);
 
     // Database merge tool
     struct MergeEntry {
@@ -159,9 +300,334 @@ public:
         std::vector<MergeEntry> entries;  // Detailed log of all operations
     };
 
-    MergeResult dbtMergeDatabase(const std::string& sourcePath, const std::string& tableName, bool skipExisting, bool overwriteIfLarger);
+    MergeResult dbtMergeDatabase(const std::string& sourcePath, const std::string& tableName, bool skipExisting, bool overwriteIfLarger, JobContext* job = nullptr);
+
+    // Library health scan: one pass over every table running all HealthChecks,
+    // findings persisted in health_findings so the tool pages can load them instantly
+    struct HealthScanResult {
+        bool success;
+        std::string error;
+        int64_t rowsScanned;
+        int64_t findingsCount;
+    };
+
+    struct HealthScanTable {
+        std::string tableName;
+        int64_t rowsScanned;
+        int64_t startedAt;    // Unix timestamp
+        int64_t completedAt;  // 0 if the scan of this table has not finished
+        int64_t findingsCount;
+    };
+
+    HealthScanResult dbtRunHealthScan(const std::string& tableName, int minSizeBytes, JobContext* job = nullptr);
+    std::vector<HealthFinding> dbtGetHealthFindings(const std::string& checkName, const std::string& tableName);
+    std::vector<HealthScanTable> dbtGetHealthScanSummary();
+
+    // Duplicate detection: one parallel pass hashing normalized blocking keys
+    // (any field of the data section, or "content" for the whole section) per row.
+    // Rows sharing a key hash are joined into clusters, so no pairs are compared.
+    // Run as the "findDuplicates" job for progress and cancel; clusters then stream through the job.
+    struct DuplicateMember {
+        std::string id;
+        std::string title;
+        int sizeBytes;
+        double similarity;  // Fraction of the blocking keys shared with the first member
+    };
+
+    struct DuplicateCluster {
+        std::vector<DuplicateMember> members;  // Largest blob first: the suggested entry to keep
+        std::vector<std::string> matchedKeys;  // Keys on which at least two members agree
+        double similarity;                     // Average similarity of the other members
+    };
+
+    struct DuplicateResult {
+        bool success;
+        std::string error;
+        int64_t rowsScanned;
+        int64_t clusterCount;
+        int64_t duplicateCount;  // Rows that would be removed by keeping one entry per cluster
+        std::vector<DuplicateCluster> clusters;  // Most similar first, at most maxClusters
+    };
+
+    DuplicateResult dbtFindDuplicates(const std::string& tableName, const std::vector<std::string>& keys, int maxClusters = 5000, JobContext* job = nullptr);
+
+    // Collapse duplicates: delete removeIds, keeping keepId, and point every reference to a removed
+    // entry (instance objects, item app/platform/type) at keepId. All or nothing, in one transaction.
+    struct DuplicateCollapse {
+        std::string keepId;
+        std::vector<std::string> removeIds;
+    };
+
+    struct CollapseResult {
+        std::string id;
+        std::string keptId;
+        bool success;
+        std::string error;
+        int64_t referencesMoved;  // References to id rewritten to keptId
+    };
+
+    std::vector<CollapseResult> dbtCollapseDuplicates(const std::string& tableName, const std::vector<DuplicateCollapse>& collapses);
+
+    // Reference integrity: instances point at items and models from objects.[object_id],
+    // items at apps, platforms and types. The id sets of every table are loaded in parallel,
+    // then instance and item blobs are streamed once; findings go to reference_findings.
+    // Run as the "checkReferences" job for progress and cancel; findings then stream through the job.
+    struct ReferenceFinding {
+        std::string tableName;    // Table of the entry holding the reference, or of the unreferenced entry
+        std::string id;
+        std::string kind;         // "dangling" or "unreferenced"
+        std::string field;        // e.g. "objects.<object id>.item", empty for unreferenced entries
+        std::string targetTable;
+        std::string targetId;     // Missing id, empty for unreferenced entries
+    };
+
+    struct ReferenceCheckResult {
+        bool success;
+        std::string error;
+        int64_t rowsScanned;
+        int64_t danglingCount;
+        int64_t unreferencedCount;
+    };
+
+    ReferenceCheckResult dbtCheckReferences(JobContext* job = nullptr);
+    std::vector<ReferenceFinding> dbtGetReferenceFindings(const std::string& kind, const std::string& tableName);  // Empty filters match everything
+
+    // Remove the references of the given entries whose target no longer exists
+    std::vector<PurgeResult> dbtFixDanglingReferences(const std::string& tableName, const std::vector<std::string>& entryIds);
+    // Delete items or models that no instance references. Re-checked in the transaction; entries referenced since are skipped.
+    std::vector<PurgeResult> dbtPurgeUnreferenced(const std::string& tableName, const std::vector<std::string>& entryIds);
+
+    // Rule-based cleanup (rule language in CleanupRules.h). Matching rows are found by the
+    // parallel scan; unless dryRun, they are re-checked and changed in batched transactions.
+    // Run as the "runCleanupRules" job for progress, pause and cancel; results then stream through the job.
+    struct CleanupRuleReport {
+        std::string rule;
+        std::string tableName;
+        int64_t matched;    // Entries matching when scanned
+        int64_t applied;    // Entries changed or deleted by this rule (0 on a dry run)
+        int64_t failed;
+        std::vector<std::string> sampleIds;  // First matching ids, for review
+    };
+
+    struct CleanupResult {
+        bool success;
+        std::string error;
+        bool dryRun;
+        int64_t rowsScanned;
+        int64_t entriesChanged;
+        int64_t entriesDeleted;
+        std::vector<CleanupRuleReport> rules;
+    };
+
+    CleanupResult dbtRunCleanupRules(const std::string& rulesText, bool dryRun, int maxSampleIds = 20, JobContext* job = nullptr);
+
+    // Find and replace inside string fields whose path matches pathGlob ("screen,marquee,file",
+    // "*" = any one level, "**" = any depth). Only blobs that actually change are re-serialized.
+    struct ReplaceFieldCount {
+        std::string path;
+        int64_t rowsChanged;
+    };
+
+    struct ReplaceResult {
+        bool success;
+        std::string error;
+        int64_t rowsScanned;
+        int64_t rowsChanged;
+        std::vector<ReplaceFieldCount> fields;
+    };
+
+    ReplaceResult dbtReplaceInFields(const std::string& tableName, const std::string& pathGlob, const std::string& find,
+        const std::string& replace, bool useRegex, JobContext* job = nullptr);
+
+    // Instance generation migrations (InstanceMigrations.h). The whole table is upgraded by
+    // rewriteTableBatched, then verified by a parallel census of the generations left.
+    struct GenerationCount {
+        int generation;  // -1 = no generation key
+        int64_t count;
+    };
+
+    struct GenerationCensus {
+        bool success;
+        std::string error;
+        int targetGeneration;  // -1 when no migrations are registered
+        int64_t rowsScanned;
+        int64_t pendingRows;   // Instances below the target generation
+        std::vector<GenerationCount> generations;
+        std::vector<std::pair<int, std::string>> migrations;  // (source generation, name)
+    };
+
+    struct MigrationResult {
+        bool success;
+        std::string error;
+        int targetGeneration;
+        int64_t rowsScanned;
+        int64_t rowsUpgraded;
+        int64_t rowsFailed;
+        int64_t pendingRows;   // From the verification pass
+    };
+
+    GenerationCensus dbtGetInstanceGenerations();
+    MigrationResult dbtMigrateInstances(JobContext* job = nullptr);
+    // Upgrade only these instances, in batched transactions (no verification census)
+    MigrationResult dbtMigrateInstances(const std::vector<std::string>& instanceIds, JobContext* job = nullptr);
+
+    // Ids of the instances upgrade-on-read returned upgraded since the last call; the caller
+    // writes them back with a "migrateInstances" job
+    std::vector<std::string> takePendingInstanceUpgrades();
+
+    // Undo journals (UndoJournal.h) written by dbtTrimTextFields, dbtRemoveAnomalousKeys,
+    // dbtPurgeEmptyInstances and dbtMergeDatabase
+    struct UndoJournalInfo {
+        std::string name;      // "job-<id>" or "<tool>-<time>"
+        int64_t sizeBytes;
+        int64_t modifiedTime;  // Unix time
+    };
+
+    struct UndoSkippedRow {
+        std::string tableName;
+        std::string id;
+    };
+
+    struct UndoResult {
+        bool success;
+        std::string error;
+        int64_t recordsReplayed;
+        int64_t rowsRestored;
+        int64_t rowsDeleted;
+        int64_t rowsSkipped;                     // Changed after the run, so left as they are
+        std::vector<UndoSkippedRow> skippedRows;
+    };
+
+    std::vector<UndoJournalInfo> dbtListUndoJournals();
+    UndoResult dbtUndoJournal(const std::string& name);  // One transaction; the journal is deleted once it commits
+    UndoResult dbtUndoJob(int jobId);
+    bool dbtDeleteUndoJournal(const std::string& name);
+
+    // Database diff tool (streamed in pages, one sequential pass over both files)
+    struct FieldDiff {
+        std::string path;
+        std::string change;  // "added", "removed", "changed"
+        std::string valueA;
+        std::string valueB;
+    };
+
+    struct DiffEntry {
+        std::string tableName;
+        std::string id;
+        std::string status;  // "onlyInA", "onlyInB", "changed"
+        int sizeA;
+        int sizeB;
+        std::vector<FieldDiff> fields;  // Only populated for "changed" entries
+    };
+
+    struct DiffPage {
+        bool success;
+        std::string error;
+        bool finished;
+        std::string currentTable;
+        int64_t rowsScanned;   // Rows consumed from both files so far
+        int64_t rowsTotal;     // Rows in both files across all requested tables
+        int64_t bytesScanned;
+        int identicalCount;
+        int changedCount;
+        int onlyInACount;
+        int onlyInBCount;
+        std::vector<DiffEntry> entries;  // Differences found since the previous page
+    };
+
+    DiffPage dbtDiffDatabases(const std::string& pathA, const std::string& pathB, const std::vector<std::string>& tableNames, int pageSize);
+    DiffPage dbtGetNextDiffResults(int pageSize);
+    void dbtCloseDiff();
 
 private:
+    // State for an in-progress database diff
+    struct DiffSession {
+        sqlite3* dbA;
+        sqlite3* dbB;
+        sqlite3_stmt* stmtA;
+        sqlite3_stmt* stmtB;
+        bool hasRowA;
+        bool hasRowB;
+        std::vector<std::string> tableNames;
+        size_t tableIndex;
+        bool active;
+        DiffPage totals;  // Running counters, entries vector is unused
+    };
+
+    DiffSession diff_;
+
+    // State for an in-progress online compaction
+    struct OnlineCompaction {
+        std::thread thread;
+        std::mutex mutex;
+        sqlite3* copyDb;         // Background connection, used to interrupt the copy
+        std::string tempPath;
+        std::string journalMode;  // Mode to restore once the library leaves WAL ("" if it never switched)
+        OnlineCompactionStatus status;
+    };
+
+    OnlineCompaction compaction_;
+    int pendingAutoVacuumMode_;  // Set by dbtSetAutoVacuumMode until a compaction rebuilds the file; -1 = none
+
+    // Open the undo journal of a destructive tool run ("job-<id>" for jobs, "<tool>-<time>" otherwise)
+    bool openUndoJournal(const std::string& tool, JobContext* job, UndoJournal& journal, std::string& error);
+
+    // Upgrade an instance read for browsing when lazy migration is enabled. Only the returned copy
+    // changes; the id is queued for takePendingInstanceUpgrades instead of written from the read path
+    void upgradeOnRead(const std::string& entryType, std::pair<std::string, std::string>& entry);
+
+    bool createHealthTables(sqlite3* db);
+    bool createReferenceTables(sqlite3* db);
+
+    // Rows (by rowid, per source table) whose reference fields point at one of ids in targetTable,
+    // and which of the ids are referenced at all. Reads on parallel connections, so call it after
+    // BEGIN IMMEDIATE and before writing: other writers are locked out and every commit is visible.
+    bool findReferencingRows(const std::string& targetTable, const std::set<std::string>& ids,
+        std::map<std::string, std::set<int64_t>>& rows, std::set<std::string>& referencedIds, std::string& error);
+
+    // Split an entry table into rowid ranges parsed in parallel on read-only connections.
+    // visit(worker, rowId, root) runs on the scan threads; worker < workerCount indexes per-thread state.
+    // Returns the number of rows scanned, or -1 on error.
+    static int parallelScanWorkerCount();
+    int64_t scanTableParallel(const std::string& entryType, int workerCount, const std::function<void(int, int64_t, ArcadeKeyValues*)>& visit, std::string& error);
+
+    // One row handed to rewriteTableBatched
+    struct RewriteRow {
+        std::string id;
+        std::vector<uint8_t> blob;  // Replaced by the transform when it sets changed
+        bool changed;
+        std::string detail;         // Tool specific, reported with the written row
+    };
+
+    typedef std::function<bool(const uint8_t*, int)> RewriteFilter;  // Cheap test on the raw blob; false skips the row
+    typedef std::function<void(RewriteRow&)> RewriteTransform;      // Runs on worker threads
+
+    // Read a table in id order one batch at a time, transform candidate rows in parallel and write the
+    // changed ones from this thread, committing (and checkpointing the job) after every batch.
+    // Returns false on error (a failed BEGIN/COMMIT is retried while the database is busy, then rolls back
+    // the batch and leaves the job checkpoint at the last committed id); unchanged rows are never rewritten.
+    bool rewriteTableBatched(const std::string& tableName, const RewriteFilter& filter, const RewriteTransform& transform,
+        const std::function<void(const RewriteRow&)>& written, JobContext* job, int64_t& rowsScanned, bool& cancelled, std::string& error);
+
+    // Rows for an analysis tool: a random sample when sampleSize > 0, otherwise the first maxRows
+    std::vector<std::pair<std::string, std::string>> getAnalysisEntries(const std::string& tableName, int maxRows, int sampleSize, SampleInfo* sampleInfo);
+
+    bool createSchemaCatalogTables(sqlite3* db);
+    bool createFieldStatisticsTables(sqlite3* db);
+    bool buildSchemaCatalog(const std::string& entryType, std::string& error);
+    bool isSchemaCatalogBuilt(sqlite3* db, const std::string& entryType);
+    // Apply the difference between an entry's old and new field sets (null = entry absent)
+    void updateSchemaCatalog(sqlite3* db, const std::string& entryType, const SchemaFieldSet* before, const SchemaFieldSet* after);
+
+    bool installCompactionChangeLog(sqlite3* db, std::string& error);
+    void removeCompactionChangeLog(sqlite3* db, const std::string& schema);
+    void compactionCopyThread(std::string dbPath, std::string tempPath, int autoVacuumMode);
+    void restoreCompactionJournalMode();
+
+    bool diffOpenTable();
+    void diffFinalizeStatements();
+    void diffFieldsRecursive(ArcadeKeyValues* node, const std::string& currentPath, std::map<std::string, std::string>& fields);
+
     // Helper function for converting KeyValues to plain text
     std::string keyValuesToPlainText(ArcadeKeyValues* kv, int indent);
 
@@ -1,7 +1,7 @@
 #include "MainApp.h"
 #include <windows.h>
 
-MainApp::MainApp() : library_(&dbManager_, &config_), jsBridge_(&dbManager_, &config_, &library_) {
+MainApp::MainApp() : library_(&dbManager_, &config_), jsBridge_(&dbManager_, &config_, &library_), jobManager_(&config_) {
     ///
     /// Debug: Show current working directory
     ///
@@ -15,12 +15,25 @@ MainApp::MainApp() : library_(&dbManager_, &config_), jsBridge_(&dbManager_, &co
     ///
     config_.loadFromFile("config.ini");
 
+    ///
+    /// Start the background job manager (recovers interrupted jobs from the last session)
+    ///
+    jobManager_.initialize();
+    jsBridge_.setJobManager(&jobManager_);
+
     ///
     /// Create our main App instance with proper settings
     ///
     Settings settings;
     settings.file_system_path = "./";  // Set filesystem base path to current directory
 
+    ///
+    /// Serve recently cached images from memory (the file system must be set before App::Create)
+    ///
+    bitmapCache_ = std::make_unique<BitmapCache>(static_cast<int64_t>(config_.getImageMemoryCacheMB()) * 1024 * 1024);
+    cacheFileSystem_ = std::make_unique<CacheFileSystem>(settings.file_system_path.utf8().data(), "cache\\urls", bitmapCache_.get());
+    Platform::instance().set_file_system(cacheFileSystem_.get());
+
     app_ = App::Create(settings);
 
     ///
@@ -29,16 +42,21 @@ MainApp::MainApp() : library_(&dbManager_, &config_), jsBridge_(&dbManager_, &co
     jsBridge_.setApp(app_);
 
     ///
-    /// Initialize ImageLoader with the renderer and JSBridge
+    /// Initialize ImageLoader with the renderer, JSBridge, its pool of views and its decode threads
     ///
-    imageLoader_ = std::make_unique<ImageLoader>(app_->renderer(), &jsBridge_);
+    imageLoader_ = std::make_unique<ImageLoader>(app_->renderer(), &jsBridge_, config_.getImageLoaderViews(),
+                                                 config_.getNativeDecodeThreads());
 
     // Set the image loader reference in both JSBridge and Library
     jsBridge_.setImageLoader(imageLoader_.get());
     library_.setImageLoader(imageLoader_.get());
+    imageLoader_->setBitmapCache(bitmapCache_.get());
 
-    // Set cache directory
+    // Set cache directory, its layout and its size budget
     imageLoader_->setCacheDirectory(".\\cache\\urls");
+    imageLoader_->setCacheLayout(ImageCacheIndex::layoutFromName(config_.getImageCacheLayout()));
+    imageLoader_->setCacheBudget(static_cast<int64_t>(config_.getImageCacheBudgetMB()) * 1024 * 1024,
+                                 ImageCacheIndex::policyFromName(config_.getImageCacheEviction()));
 
     // Note: JS bridge will be set up automatically when image-loader.html DOM is ready
     OutputDebugStringA("[MainApp] ImageLoader initialized\n");
@@ -71,8 +89,21 @@ MainApp::MainApp() : library_(&dbManager_, &config_), jsBridge_(&dbManager_, &co
     overlay_->view()->set_view_listener(consoleLogger_.get());  // Use ConsoleLogger for main view
     overlay_->view()->set_load_listener(this);
 
-    // Also set ConsoleLogger for ImageLoader view
-    imageLoader_->getView()->set_view_listener(consoleLogger_.get());
+    // Also set ConsoleLogger for the ImageLoader views
+    for (size_t i = 0; i < imageLoader_->getViewCount(); i++) {
+        imageLoader_->getView(i)->set_view_listener(consoleLogger_.get());
+    }
+
+    ///
+    /// Push finished images to the page as they complete (the page polls in "poll" mode).
+    /// Their promise callbacks call into the overlay's JS context, so it is locked around them.
+    ///
+    if (config_.getImageCompletionDelivery() != "poll") {
+        imageLoader_->setCompletionDispatcher([this]() {
+            auto scoped_context = overlay_->view()->LockJSContext();
+            imageLoader_->processCompletions();
+        });
+    }
 
     ///
     /// Load a local HTML file into our overlay's View
@@ -9,11 +9,17 @@
 #include "Library.h"
 #include "JSBridge.h"
 #include "ImageLoader.h"
+#include "BitmapCache.h"
+#include "CacheFileSystem.h"
 #include "ConsoleLogger.h"
+#include "JobManager.h"
 
 using namespace ultralight;
 
 class MainApp : public WindowListener, public ViewListener, public LoadListener {
+    // Declared before app_ so they outlive it
+    std::unique_ptr<BitmapCache> bitmapCache_;
+    std::unique_ptr<CacheFileSystem> cacheFileSystem_;
     RefPtr<App> app_;
     RefPtr<Window> window_;
     RefPtr<Overlay> overlay_;
@@ -21,6 +27,7 @@ class MainApp : public WindowListener, public ViewListener, public LoadListener
     ArcadeConfig config_;
     Library library_;
     JSBridge jsBridge_;
+    JobManager jobManager_;
     std::unique_ptr<ImageLoader> imageLoader_;
     std::unique_ptr<ConsoleLogger> consoleLogger_;
 
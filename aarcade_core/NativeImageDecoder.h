@@ -0,0 +1,526 @@
+#ifndef NATIVE_IMAGE_DECODER_H
+#define NATIVE_IMAGE_DECODER_H
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <windows.h>
+#include <wincodec.h>
+#include "PngEncoder.h"
+
+#pragma comment(lib, "windowscodecs.lib")
+
+/**
+ * NativeImageDecoder - Worker threads that write cache images off the main thread
+ *
+ * Local files (file:// URLs and plain paths) are decoded on a pool of worker threads with
+ * the Windows Imaging Component, which ships codecs for PNG, JPEG, GIF, BMP, TIFF and ICO.
+ * TGA, which neither WIC nor the views can read, is parsed here (see readTga).
+ * The image is fitted into the same 512x512 box image-loader.html uses (scaled down to fit,
+ * never up), resized with WIC's Fant filter (an area-averaging box filter), flattened onto
+ * black like the view's background and written to the same cache file as the view path.
+ *
+ * A file WIC cannot decode is reported as a failure with fallback set, so the caller can
+ * send it through the view path instead.
+ *
+ * The same threads encode images the views rendered: the main thread copies the cropped
+ * pixels into a pooled buffer and moves on to the next job. PNGs are written by
+ * PngEncoder (Sub filter, fast deflate), which needs no WIC, then flushed to disk before
+ * the result is reported.
+ *
+ * An optional pixels callback sees the BGRA pixels of every image written, before the
+ * result is reported, so they can be kept in memory without decoding the PNG again.
+ */
+class NativeImageDecoder {
+public:
+    struct Task {
+        std::string url;
+        std::string filePath;    // Local file to decode, empty for an encode task
+        std::string outputPath;  // Cache file to write
+
+        // Encode tasks: BGRA pixels (width * 4 bytes per row) and where they sat in the view
+        std::vector<uint8_t> pixels;
+        int width;
+        int height;
+        int rectX;
+        int rectY;
+
+        Task() : width(0), height(0), rectX(0), rectY(0) {}
+        Task(const std::string& url, const std::string& filePath, const std::string& outputPath)
+            : url(url), filePath(filePath), outputPath(outputPath), width(0), height(0), rectX(0), rectY(0) {}
+    };
+
+    struct Result {
+        bool success;
+        bool fallback;  // Not decodable here; the view path may still manage
+        std::string url;
+        std::string outputPath;
+        int rectX;
+        int rectY;
+        int rectWidth;
+        int rectHeight;
+        std::string error;  // Why it failed, when it did not succeed
+    };
+
+    static const int BOX_SIZE = 512;  // Size of the image-loader.html view
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<Task> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_;
+    std::function<void(const Result&)> onResult_;  // Called on a worker thread
+    std::function<void(const std::string& url, const std::vector<uint8_t>& pixels, int width, int height)> onPixels_;  // Optional, worker thread
+
+    std::vector<std::vector<uint8_t>> freeBuffers_;  // Pixel buffers for reuse by encode tasks
+    std::mutex bufferMutex_;
+
+    static void debugOutput(const std::string& message) {
+        std::string debugMsg = "[NativeImageDecoder] " + message;
+        OutputDebugStringA((debugMsg + "\n").c_str());
+    }
+
+    static std::wstring widen(const std::string& text) {
+        int length = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, nullptr, 0);
+        if (length <= 0) {
+            return std::wstring();
+        }
+        std::wstring wide(length - 1, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, &wide[0], length);
+        return wide;
+    }
+
+    template <typename T>
+    static void release(T*& object) {
+        if (object) {
+            object->Release();
+            object = nullptr;
+        }
+    }
+
+    // Write data to path through a flushed partial file, so a reader never sees half a PNG and
+    // the file survives a crash once this returns. The cache folders above path (up to two levels)
+    // are created on the first write into them.
+    static bool writeFileDurably(const std::string& path, const void* data, DWORD size) {
+        std::string partialPath = path + ".partial";
+        HANDLE file = CreateFileA(partialPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE && GetLastError() == ERROR_PATH_NOT_FOUND) {
+            std::string folder = path.substr(0, path.find_last_of('\\'));
+            CreateDirectoryA(folder.substr(0, folder.find_last_of('\\')).c_str(), NULL);
+            CreateDirectoryA(folder.c_str(), NULL);
+            file = CreateFileA(partialPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        }
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        DWORD written = 0;
+        bool ok = WriteFile(file, data, size, &written, nullptr) && written == size && FlushFileBuffers(file);
+        CloseHandle(file);
+
+        if (!ok || !MoveFileExA(partialPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+            DeleteFileA(partialPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Encode BGRA pixels as a PNG at path
+    static bool writePNG(const std::string& path, UINT width, UINT height,
+                         const std::vector<uint8_t>& pixels, std::string& error) {
+        std::vector<uint8_t> png;
+        PngEncoder::encode(pixels.data(), static_cast<int>(width), static_cast<int>(height), static_cast<int>(width * 4), png);
+
+        if (!writeFileDurably(path, png.data(), static_cast<DWORD>(png.size()))) {
+            error = "write failed (error " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+        return true;
+    }
+
+    static Result encode(Task& task) {
+        Result result = { false, false, task.url, task.outputPath, task.rectX, task.rectY, task.width, task.height, "" };
+
+        if (!writePNG(task.outputPath, task.width, task.height, task.pixels, result.error)) {
+            debugOutput("Failed to write " + task.outputPath + ": " + result.error);
+            return result;
+        }
+
+        result.success = true;
+        return result;
+    }
+
+    static bool isTgaPath(const std::string& path) {
+        if (path.length() < 4) {
+            return false;
+        }
+        std::string extension = path.substr(path.length() - 4);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        return extension == ".tga";
+    }
+
+    // Read a true-color or grayscale TGA (8, 24 or 32 bits, raw or RLE) into top-down BGRA pixels.
+    // Color-mapped and 16-bit images are not supported.
+    static bool readTga(const std::string& path, int& width, int& height, std::vector<uint8_t>& pixels, std::string& error) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            error = "open failed (error " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+        LARGE_INTEGER fileSize = {};
+        GetFileSizeEx(file, &fileSize);
+        std::vector<uint8_t> data(static_cast<size_t>(fileSize.QuadPart));
+        DWORD bytesRead = 0;
+        bool readOk = data.empty() || (ReadFile(file, data.data(), static_cast<DWORD>(data.size()), &bytesRead, nullptr) &&
+                                       bytesRead == data.size());
+        CloseHandle(file);
+        if (!readOk || data.size() < 18) {
+            error = "read failed or file too short";
+            return false;
+        }
+
+        int idLength = data[0];
+        int colorMapType = data[1];
+        int imageType = data[2];
+        int colorMapLength = data[5] | (data[6] << 8);
+        int colorMapEntryBits = data[7];
+        width = data[12] | (data[13] << 8);
+        height = data[14] | (data[15] << 8);
+        int bitsPerPixel = data[16];
+        bool topDown = (data[17] & 0x20) != 0;
+
+        bool rle = (imageType == 10 || imageType == 11);
+        bool gray = (imageType == 3 || imageType == 11);
+        if (imageType != 2 && imageType != 3 && imageType != 10 && imageType != 11) {
+            error = "unsupported TGA image type " + std::to_string(imageType);
+            return false;
+        }
+        if ((gray && bitsPerPixel != 8) || (!gray && bitsPerPixel != 24 && bitsPerPixel != 32)) {
+            error = "unsupported TGA depth " + std::to_string(bitsPerPixel);
+            return false;
+        }
+        if (width <= 0 || height <= 0) {
+            error = "empty TGA";
+            return false;
+        }
+
+        size_t position = 18 + idLength + (colorMapType == 1 ? colorMapLength * ((colorMapEntryBits + 7) / 8) : 0);
+        int bytesPerPixel = bitsPerPixel / 8;
+        size_t pixelCount = static_cast<size_t>(width) * height;
+        pixels.assign(pixelCount * 4, 255);
+
+        // Pixels in file order; rows are flipped afterwards for bottom-up images
+        auto storePixel = [&](size_t index, const uint8_t* source) {
+            uint8_t* target = &pixels[index * 4];
+            if (gray) {
+                target[0] = target[1] = target[2] = source[0];
+            } else {
+                target[0] = source[0];
+                target[1] = source[1];
+                target[2] = source[2];
+                if (bytesPerPixel == 4) {
+                    target[3] = source[3];
+                }
+            }
+        };
+
+        size_t index = 0;
+        while (index < pixelCount) {
+            int count = 1;
+            bool repeat = false;
+            if (rle) {
+                if (position >= data.size()) {
+                    break;
+                }
+                uint8_t packet = data[position++];
+                count = (packet & 0x7f) + 1;
+                repeat = (packet & 0x80) != 0;
+            }
+            for (int i = 0; i < count && index < pixelCount; i++) {
+                if (position + bytesPerPixel > data.size()) {
+                    error = "truncated TGA";
+                    return false;
+                }
+                storePixel(index++, &data[position]);
+                if (!repeat || i == count - 1) {
+                    position += bytesPerPixel;
+                }
+            }
+        }
+        if (index < pixelCount) {
+            error = "truncated TGA";
+            return false;
+        }
+
+        if (!topDown) {
+            size_t rowBytes = static_cast<size_t>(width) * 4;
+            for (int top = 0, bottom = height - 1; top < bottom; top++, bottom--) {
+                std::swap_ranges(pixels.begin() + top * rowBytes, pixels.begin() + (top + 1) * rowBytes,
+                                 pixels.begin() + bottom * rowBytes);
+            }
+        }
+        return true;
+    }
+
+    // Decode into pixels (the fitted image, width * 4 bytes per row)
+    static Result decode(IWICImagingFactory* factory, const Task& task, std::vector<uint8_t>& pixels) {
+        Result result = { false, false, task.url, task.outputPath, 0, 0, 0, 0, "" };
+
+        IWICBitmapDecoder* decoder = nullptr;
+        IWICBitmapFrameDecode* frame = nullptr;
+        IWICBitmap* tgaBitmap = nullptr;
+        IWICBitmapScaler* scaler = nullptr;
+        IWICFormatConverter* converter = nullptr;
+        IWICBitmapSource* image = nullptr;  // The decoded frame, or the TGA pixels
+        std::vector<uint8_t> tgaPixels;
+
+        HRESULT hr;
+        if (isTgaPath(task.filePath)) {
+            // WIC has no TGA codec, and neither does the view, so a TGA that cannot be read fails here
+            int tgaWidth = 0;
+            int tgaHeight = 0;
+            if (!readTga(task.filePath, tgaWidth, tgaHeight, tgaPixels, result.error)) {
+                debugOutput("Failed to read " + task.filePath + ": " + result.error);
+                return result;
+            }
+            hr = factory->CreateBitmapFromMemory(tgaWidth, tgaHeight, GUID_WICPixelFormat32bppBGRA, tgaWidth * 4,
+                                                 static_cast<UINT>(tgaPixels.size()), tgaPixels.data(), &tgaBitmap);
+            image = tgaBitmap;
+        } else {
+            std::wstring inputPath = widen(task.filePath);
+            hr = factory->CreateDecoderFromFilename(inputPath.c_str(), nullptr, GENERIC_READ,
+                                                    WICDecodeMetadataCacheOnDemand, &decoder);
+            if (FAILED(hr)) {
+                // Missing file or a format without a WIC codec
+                result.fallback = true;
+                result.error = "No decoder";
+                debugOutput("No decoder for " + task.filePath);
+                return result;
+            }
+            hr = decoder->GetFrame(0, &frame);
+            image = frame;
+        }
+
+        UINT width = 0;
+        UINT height = 0;
+        if (SUCCEEDED(hr)) hr = image->GetSize(&width, &height);
+
+        // Fit into the box like "max-width: 100%; max-height: 100%; object-fit: contain"
+        UINT fitWidth = width;
+        UINT fitHeight = height;
+        if (SUCCEEDED(hr) && (width > BOX_SIZE || height > BOX_SIZE)) {
+            double scale = (std::min)(static_cast<double>(BOX_SIZE) / width, static_cast<double>(BOX_SIZE) / height);
+            fitWidth = (std::max)(1u, static_cast<UINT>(width * scale + 0.5));
+            fitHeight = (std::max)(1u, static_cast<UINT>(height * scale + 0.5));
+        }
+
+        IWICBitmapSource* source = image;
+        if (SUCCEEDED(hr) && (fitWidth != width || fitHeight != height)) {
+            hr = factory->CreateBitmapScaler(&scaler);
+            if (SUCCEEDED(hr)) hr = scaler->Initialize(image, fitWidth, fitHeight, WICBitmapInterpolationModeFant);
+            source = scaler;
+        }
+
+        // Premultiplied BGRA with the alpha then forced to opaque is the image over black
+        if (SUCCEEDED(hr)) hr = factory->CreateFormatConverter(&converter);
+        if (SUCCEEDED(hr)) hr = converter->Initialize(source, GUID_WICPixelFormat32bppPBGRA,
+                                                      WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+
+        if (SUCCEEDED(hr)) {
+            pixels.resize(static_cast<size_t>(fitWidth) * fitHeight * 4);
+            hr = converter->CopyPixels(nullptr, fitWidth * 4, static_cast<UINT>(pixels.size()), pixels.data());
+        }
+
+        release(converter);
+        release(scaler);
+        release(tgaBitmap);
+        release(frame);
+        release(decoder);
+
+        if (FAILED(hr)) {
+            result.fallback = true;
+            result.error = "Decode failed (hr " + std::to_string(static_cast<long>(hr)) + ")";
+            debugOutput("Decode failed for " + task.filePath + " (hr " + std::to_string(static_cast<long>(hr)) + ")");
+            return result;
+        }
+
+        for (size_t i = 3; i < pixels.size(); i += 4) {
+            pixels[i] = 255;
+        }
+
+        if (!writePNG(task.outputPath, fitWidth, fitHeight, pixels, result.error)) {
+            debugOutput("Failed to write " + task.outputPath + ": " + result.error);
+            return result;
+        }
+
+        // Where the image sits in the view, as image-loader.html would report it
+        result.success = true;
+        result.rectX = (BOX_SIZE - static_cast<int>(fitWidth)) / 2;
+        result.rectY = (BOX_SIZE - static_cast<int>(fitHeight)) / 2;
+        result.rectWidth = static_cast<int>(fitWidth);
+        result.rectHeight = static_cast<int>(fitHeight);
+        return result;
+    }
+
+    void workerLoop() {
+        HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        IWICImagingFactory* factory = nullptr;
+        if (FAILED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER,
+                                    IID_PPV_ARGS(&factory)))) {
+            debugOutput("ERROR: Could not create the WIC factory");
+        }
+
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_) {
+                    break;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+
+            Result result = { false, true, task.url, task.outputPath, 0, 0, 0, 0, "WIC is not available" };
+            if (!task.filePath.empty()) {
+                std::vector<uint8_t> pixels;
+                if (factory) {
+                    result = decode(factory, task, pixels);
+                }
+                if (result.success && onPixels_) {
+                    onPixels_(result.url, pixels, result.rectWidth, result.rectHeight);
+                }
+            } else {
+                result = encode(task);
+                if (result.success && onPixels_) {
+                    onPixels_(result.url, task.pixels, task.width, task.height);
+                }
+                releaseBuffer(task.pixels);
+            }
+            onResult_(result);
+        }
+
+        release(factory);
+        if (SUCCEEDED(comResult)) {
+            CoUninitialize();
+        }
+    }
+
+public:
+    NativeImageDecoder(int threadCount, std::function<void(const Result&)> onResult,
+                       std::function<void(const std::string&, const std::vector<uint8_t>&, int, int)> onPixels = nullptr)
+        : stopping_(false), onResult_(onResult), onPixels_(onPixels) {
+        for (int i = 0; i < threadCount; i++) {
+            workers_.emplace_back(&NativeImageDecoder::workerLoop, this);
+        }
+        debugOutput("Started " + std::to_string(threadCount) + " decode threads");
+    }
+
+    // Queued tasks that have not started are dropped
+    ~NativeImageDecoder() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    NativeImageDecoder(const NativeImageDecoder&) = delete;
+    NativeImageDecoder& operator=(const NativeImageDecoder&) = delete;
+
+    void submit(Task&& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push(std::move(task));
+        }
+        condition_.notify_one();
+    }
+
+    // A pixel buffer of size bytes, reused from a finished encode task when one is free
+    std::vector<uint8_t> acquireBuffer(size_t size) {
+        std::vector<uint8_t> buffer;
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex_);
+            if (!freeBuffers_.empty()) {
+                buffer = std::move(freeBuffers_.back());
+                freeBuffers_.pop_back();
+            }
+        }
+        buffer.resize(size);
+        return buffer;
+    }
+
+    void releaseBuffer(std::vector<uint8_t>& buffer) {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        if (freeBuffers_.size() < 8) {
+            freeBuffers_.push_back(std::move(buffer));
+        }
+        buffer = std::vector<uint8_t>();
+    }
+
+    // Folder of the executable, with a trailing backslash. The views' file system (and so every
+    // file:///assets/... URL) is rooted there.
+    static std::string executableDirectory() {
+        char modulePath[MAX_PATH];
+        DWORD length = GetModuleFileNameA(NULL, modulePath, MAX_PATH);
+        std::string directory(modulePath, length);
+        return directory.substr(0, directory.find_last_of('\\') + 1);
+    }
+
+    // Local file for a file:// URL or a plain path, or "" if the URL is not local. Relative file
+    // URLs ("file:///assets/x.png") resolve against the executable's folder, like the views do.
+    static std::string localPathFor(const std::string& url) {
+        std::string path;
+        if (url.compare(0, 8, "file:///") == 0) {
+            // Percent-decode the rest of the URL
+            for (size_t i = 8; i < url.length(); i++) {
+                if (url[i] == '%' && i + 2 < url.length() && isxdigit(static_cast<unsigned char>(url[i + 1])) &&
+                    isxdigit(static_cast<unsigned char>(url[i + 2]))) {
+                    path += static_cast<char>(std::stoi(url.substr(i + 1, 2), nullptr, 16));
+                    i += 2;
+                } else if (url[i] == '?' || url[i] == '#') {
+                    break;
+                } else {
+                    path += url[i];
+                }
+            }
+        } else if (url.length() > 2 && isalpha(static_cast<unsigned char>(url[0])) && url[1] == ':' &&
+                   (url[2] == '\\' || url[2] == '/')) {
+            path = url;  // Drive path
+        } else if (url.compare(0, 2, "\\\\") == 0) {
+            path = url;  // UNC path
+        } else {
+            return "";
+        }
+
+        for (char& c : path) {
+            if (c == '/') {
+                c = '\\';
+            }
+        }
+
+        bool absolute = (path.length() > 1 && path[1] == ':') || path.compare(0, 2, "\\\\") == 0;
+        if (!absolute) {
+            while (path.compare(0, 2, ".\\") == 0) {
+                path.erase(0, 2);
+            }
+            path = executableDirectory() + path;
+        }
+        return path;
+    }
+};
+
+#endif // NATIVE_IMAGE_DECODER_H
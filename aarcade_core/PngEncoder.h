@@ -0,0 +1,301 @@
+#ifndef PNG_ENCODER_H
+#define PNG_ENCODER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * PngEncoder - Fast PNG encoder for cache images
+ *
+ * Writes 8-bit RGBA PNGs from BGRA pixels, tuned for encode speed over file size:
+ * - Every row uses the Sub filter (no per-row filter search). Flat areas and gradients
+ *   become runs of zeros, which deflate shrinks well.
+ * - The IDAT stream is a single deflate block with the fixed Huffman codes, so no code
+ *   tables are built or stored. Matches are found greedily with one hash probe per
+ *   position, in the manner of zlib's level 1.
+ *
+ * Files are typically somewhat larger than a zlib level 6 encode, but any PNG decoder
+ * reads them. No platform code, so it can be timed outside the app.
+ */
+class PngEncoder {
+private:
+    // Deflate output, least significant bit first
+    struct BitWriter {
+        std::vector<uint8_t>& out;
+        uint64_t bits;
+        int count;
+
+        explicit BitWriter(std::vector<uint8_t>& target) : out(target), bits(0), count(0) {}
+
+        void put(uint32_t value, int length) {
+            bits |= static_cast<uint64_t>(value) << count;
+            count += length;
+            while (count >= 8) {
+                out.push_back(static_cast<uint8_t>(bits));
+                bits >>= 8;
+                count -= 8;
+            }
+        }
+
+        void flush() {
+            if (count > 0) {
+                out.push_back(static_cast<uint8_t>(bits));
+            }
+            bits = 0;
+            count = 0;
+        }
+    };
+
+    // Huffman codes are sent most significant bit first
+    static uint32_t reverseBits(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; i++) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        return reversed;
+    }
+
+    struct FixedCode {
+        uint16_t code;  // Already bit-reversed
+        uint8_t length;
+    };
+
+    struct LiteralTable {
+        FixedCode codes[288];
+        LiteralTable();
+    };
+
+    struct CrcTable {
+        uint32_t entries[256];
+        CrcTable();
+    };
+
+    // Fixed literal/length codes (RFC 1951 3.2.6). Built once; function statics are thread safe.
+    static const FixedCode* literalCodes() {
+        static const LiteralTable table;
+        return table.codes;
+    }
+
+    static void buildLiteralCodes(FixedCode* codes) {
+        for (int symbol = 0; symbol < 288; symbol++) {
+            uint32_t code;
+            int length;
+            if (symbol < 144) {
+                code = 0x30 + symbol;
+                length = 8;
+            } else if (symbol < 256) {
+                code = 0x190 + (symbol - 144);
+                length = 9;
+            } else if (symbol < 280) {
+                code = symbol - 256;
+                length = 7;
+            } else {
+                code = 0xC0 + (symbol - 280);
+                length = 8;
+            }
+            codes[symbol] = { static_cast<uint16_t>(reverseBits(code, length)), static_cast<uint8_t>(length) };
+        }
+    }
+
+    static void putLength(BitWriter& writer, const FixedCode* codes, int length) {
+        static const uint16_t bases[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const uint8_t extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                           3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        int index = 28;
+        while (bases[index] > length) {
+            index--;
+        }
+        const FixedCode& code = codes[257 + index];
+        writer.put(code.code, code.length);
+        if (extra[index]) {
+            writer.put(length - bases[index], extra[index]);
+        }
+    }
+
+    static void putDistance(BitWriter& writer, int distance) {
+        static const uint16_t bases[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                            8193, 12289, 16385, 24577 };
+        static const uint8_t extra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                           7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+        int index = 29;
+        while (bases[index] > distance) {
+            index--;
+        }
+        writer.put(reverseBits(index, 5), 5);
+        if (extra[index]) {
+            writer.put(distance - bases[index], extra[index]);
+        }
+    }
+
+    // zlib stream of data: one final fixed-Huffman block and the Adler-32 trailer
+    static void deflate(const std::vector<uint8_t>& data, std::vector<uint8_t>& out) {
+        const int WINDOW = 32768;
+        const int MIN_MATCH = 3;
+        const int MAX_MATCH = 258;
+        const int HASH_BITS = 15;
+
+        out.push_back(0x78);  // 32K window, deflate
+        out.push_back(0x01);  // Fastest compression
+
+        BitWriter writer(out);
+        writer.put(1, 1);  // Final block
+        writer.put(1, 2);  // Fixed Huffman codes
+
+        const FixedCode* codes = literalCodes();
+        std::vector<int32_t> head(static_cast<size_t>(1) << HASH_BITS, -1);
+        const uint8_t* bytes = data.data();
+        int size = static_cast<int>(data.size());
+
+        int position = 0;
+        while (position < size) {
+            int matchLength = 0;
+            int matchDistance = 0;
+            if (position + MIN_MATCH <= size) {
+                uint32_t hash = ((bytes[position] << 16) | (bytes[position + 1] << 8) | bytes[position + 2]) * 2654435761u
+                                >> (32 - HASH_BITS);
+                int candidate = head[hash];
+                head[hash] = position;
+                if (candidate >= 0 && position - candidate <= WINDOW) {
+                    int limit = (size - position < MAX_MATCH) ? size - position : MAX_MATCH;
+                    int length = 0;
+                    while (length < limit && bytes[candidate + length] == bytes[position + length]) {
+                        length++;
+                    }
+                    if (length >= MIN_MATCH) {
+                        matchLength = length;
+                        matchDistance = position - candidate;
+                    }
+                }
+            }
+
+            if (matchLength) {
+                putLength(writer, codes, matchLength);
+                putDistance(writer, matchDistance);
+                position += matchLength;
+            } else {
+                const FixedCode& code = codes[bytes[position]];
+                writer.put(code.code, code.length);
+                position++;
+            }
+        }
+
+        const FixedCode& end = codes[256];
+        writer.put(end.code, end.length);
+        writer.flush();
+
+        // Adler-32 of the uncompressed data
+        uint32_t a = 1;
+        uint32_t b = 0;
+        size_t index = 0;
+        while (index < data.size()) {
+            size_t chunkEnd = (data.size() - index > 5552) ? index + 5552 : data.size();
+            for (; index < chunkEnd; index++) {
+                a += bytes[index];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        uint32_t adler = (b << 16) | a;
+        putBigEndian(out, adler);
+    }
+
+    static void buildCrcTable(uint32_t* table) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+    }
+
+    static uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+        static const CrcTable crcTable;
+        const uint32_t* table = crcTable.entries;
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) {
+            crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    static void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static void putChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+        putBigEndian(out, static_cast<uint32_t>(data.size()));
+        size_t typeStart = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        putBigEndian(out, crc32(&out[typeStart], out.size() - typeStart));
+    }
+
+public:
+    // Encode BGRA pixels (stride bytes per row) as a PNG into png
+    static void encode(const uint8_t* bgra, int width, int height, int stride, std::vector<uint8_t>& png) {
+        // Sub-filtered RGBA rows, each led by its filter type byte
+        size_t rowBytes = static_cast<size_t>(width) * 4;
+        std::vector<uint8_t> filtered((rowBytes + 1) * height);
+        uint8_t* target = filtered.data();
+        for (int y = 0; y < height; y++) {
+            const uint8_t* row = bgra + static_cast<size_t>(y) * stride;
+            *target++ = 1;  // Sub
+            uint8_t previous[4] = { 0, 0, 0, 0 };
+            for (int x = 0; x < width; x++) {
+                const uint8_t* pixel = row + x * 4;
+                uint8_t rgba[4] = { pixel[2], pixel[1], pixel[0], pixel[3] };
+                for (int c = 0; c < 4; c++) {
+                    *target++ = static_cast<uint8_t>(rgba[c] - previous[c]);
+                    previous[c] = rgba[c];
+                }
+            }
+        }
+
+        std::vector<uint8_t> header(13);
+        header[0] = static_cast<uint8_t>(width >> 24);
+        header[1] = static_cast<uint8_t>(width >> 16);
+        header[2] = static_cast<uint8_t>(width >> 8);
+        header[3] = static_cast<uint8_t>(width);
+        header[4] = static_cast<uint8_t>(height >> 24);
+        header[5] = static_cast<uint8_t>(height >> 16);
+        header[6] = static_cast<uint8_t>(height >> 8);
+        header[7] = static_cast<uint8_t>(height);
+        header[8] = 8;  // Bit depth
+        header[9] = 6;  // RGBA
+        header[10] = 0;
+        header[11] = 0;
+        header[12] = 0;
+
+        std::vector<uint8_t> compressed;
+        compressed.reserve(filtered.size() / 2);
+        deflate(filtered, compressed);
+
+        static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+        png.clear();
+        png.reserve(compressed.size() + 64);
+        png.insert(png.end(), signature, signature + 8);
+        putChunk(png, "IHDR", header);
+        putChunk(png, "IDAT", compressed);
+        putChunk(png, "IEND", std::vector<uint8_t>());
+    }
+};
+
+inline PngEncoder::LiteralTable::LiteralTable() {
+    buildLiteralCodes(codes);
+}
+
+inline PngEncoder::CrcTable::CrcTable() {
+    buildCrcTable(entries);
+}
+
+#endif // PNG_ENCODER_H
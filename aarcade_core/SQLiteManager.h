@@ -4,12 +4,20 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <map>
+#include <set>
+#include <fstream>
+#include <random>
 #include <windows.h>
 #include "sqlite/sqlite3.h"
 
 class SQLiteManager {
 private:
     sqlite3* db;
+    std::string currentDbPath;
+
+    // Pages returned to the filesystem by incremental_vacuum this session
+    int64_t reclaimedPagesTotal;
 
     // Entry browsing state
     sqlite3_stmt* activeEntryStmt;
@@ -118,7 +126,7 @@ private:
     }
 
 public:
-    SQLiteManager() : db(nullptr), activeEntryStmt(nullptr), hasActiveQuery(false),
+    SQLiteManager() : db(nullptr), reclaimedPagesTotal(0), activeEntryStmt(nullptr), hasActiveQuery(false),
         activeSearchStmt(nullptr), hasActiveSearchQuery(false), searchOffset(0) {
     }
 
@@ -132,17 +140,47 @@ public:
     }
 
     bool openDatabase(const std::string& dbPath) {
+        // Reuse the existing connection (callers invoke this before every operation)
+        if (db && dbPath == currentDbPath) {
+            return true;
+        }
+
+        if (db) {
+            resetEntryQuery();
+            resetSearchQuery();
+            sqlite3_close(db);
+            db = nullptr;
+        }
+
         int rc = sqlite3_open(dbPath.c_str(), &db);
 
         if (rc != SQLITE_OK) {
             debugOutput("Cannot open database: " + std::string(sqlite3_errmsg(db)));
+            sqlite3_close(db);
+            db = nullptr;
             return false;
         }
 
+        // Background jobs use their own connection to the same file, so wait on locks instead of failing
+        sqlite3_busy_timeout(db, 5000);
+
+        currentDbPath = dbPath;
         debugOutput("Database opened successfully: " + dbPath);
         return true;
     }
 
+    // Close the connection (e.g. before the database file is swapped on disk)
+    void closeDatabase() {
+        resetEntryQuery();
+        resetSearchQuery();
+        if (db) {
+            sqlite3_close(db);
+            db = nullptr;
+            debugOutput("Database connection closed.");
+        }
+        currentDbPath.clear();
+    }
+
     sqlite3* getDb() {
         return db;
     }
@@ -244,6 +282,149 @@ public:
         return true;
     }
 
+    int64_t getTableRowCount(const std::string& tableName) {
+        if (!db) {
+            debugOutput("No database connection available.");
+            return 0;
+        }
+
+        int64_t count = 0;
+        std::string countSql = "SELECT COUNT(*) FROM \"" + tableName + "\";";
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db, countSql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                count = sqlite3_column_int64(stmt, 0);
+            }
+            sqlite3_finalize(stmt);
+        }
+        return count;
+    }
+
+    // Uniform random sample of up to sampleSize rows, returned as (id, hex value) pairs.
+    // Random rowids between MIN(rowid) and MAX(rowid) are probed with exact lookups, so every
+    // row is equally likely without an ORDER BY RANDOM() pass over the table. The probe hit
+    // rate also estimates the row count, avoiding a full COUNT(*). If rowids are too sparse
+    // for exact probes, the remainder is filled with "next rowid" probes (slightly biased
+    // towards rows that follow gaps).
+    std::vector<std::pair<std::string, std::string>> dbtSampleEntries(const std::string& tableName, int sampleSize, int64_t& estimatedTotalRows) {
+        std::vector<std::pair<std::string, std::string>> entries;
+        estimatedTotalRows = 0;
+
+        if (!db) {
+            debugOutput("No database connection available.");
+            return entries;
+        }
+
+        if (sampleSize <= 0) {
+            debugOutput("Invalid sample size: " + std::to_string(sampleSize));
+            return entries;
+        }
+
+        int64_t minRowId = 0;
+        int64_t maxRowId = -1;
+        std::string rangeSql = "SELECT MIN(rowid), MAX(rowid) FROM \"" + tableName + "\";";
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db, rangeSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            debugOutput("Failed to prepare rowid range query for " + tableName + ": " + std::string(sqlite3_errmsg(db)));
+            return entries;
+        }
+        if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
+            minRowId = sqlite3_column_int64(stmt, 0);
+            maxRowId = sqlite3_column_int64(stmt, 1);
+        }
+        sqlite3_finalize(stmt);
+
+        if (maxRowId < minRowId) {
+            return entries;
+        }
+
+        auto appendRow = [&entries](sqlite3_stmt* rowStmt) {
+            const char* id = (const char*)sqlite3_column_text(rowStmt, 1);
+            const void* valueBlob = sqlite3_column_blob(rowStmt, 2);
+            int valueSize = sqlite3_column_bytes(rowStmt, 2);
+
+            std::string hexString;
+            if (valueBlob && valueSize > 0) {
+                const unsigned char* bytes = static_cast<const unsigned char*>(valueBlob);
+                hexString.reserve(valueSize * 2);
+                for (int i = 0; i < valueSize; i++) {
+                    char hexByte[3];
+                    sprintf_s(hexByte, sizeof(hexByte), "%02x", bytes[i]);
+                    hexString += hexByte;
+                }
+            }
+            entries.push_back({ id ? std::string(id) : "", hexString });
+        };
+
+        // Small tables: the "sample" is simply every row
+        int64_t span = maxRowId - minRowId + 1;
+        if (span <= static_cast<int64_t>(sampleSize)) {
+            std::string allSql = "SELECT rowid, id, value FROM \"" + tableName + "\";";
+            if (sqlite3_prepare_v2(db, allSql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+                while (sqlite3_step(stmt) == SQLITE_ROW) {
+                    appendRow(stmt);
+                }
+                sqlite3_finalize(stmt);
+            }
+            estimatedTotalRows = static_cast<int64_t>(entries.size());
+            return entries;
+        }
+
+        std::mt19937_64 random(std::random_device{}());
+        std::uniform_int_distribution<int64_t> pickRowId(minRowId, maxRowId);
+        std::set<int64_t> sampledRowIds;
+
+        // Exact probes
+        std::string exactSql = "SELECT rowid, id, value FROM \"" + tableName + "\" WHERE rowid = ?;";
+        int64_t probes = 0;
+        int64_t hits = 0;
+        const int64_t maxProbes = static_cast<int64_t>(sampleSize) * 20;
+        if (sqlite3_prepare_v2(db, exactSql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+            while (static_cast<int>(entries.size()) < sampleSize && probes < maxProbes) {
+                int64_t rowId = pickRowId(random);
+                probes++;
+                sqlite3_bind_int64(stmt, 1, rowId);
+                if (sqlite3_step(stmt) == SQLITE_ROW) {
+                    hits++;
+                    if (sampledRowIds.insert(rowId).second) {
+                        appendRow(stmt);
+                    }
+                }
+                sqlite3_reset(stmt);
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        // Sparse rowids: fill up with the next row after each random point
+        std::string nextSql = "SELECT rowid, id, value FROM \"" + tableName + "\" WHERE rowid >= ? ORDER BY rowid LIMIT 1;";
+        int64_t fillProbes = 0;
+        if (static_cast<int>(entries.size()) < sampleSize &&
+            sqlite3_prepare_v2(db, nextSql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+            while (static_cast<int>(entries.size()) < sampleSize && fillProbes < static_cast<int64_t>(sampleSize) * 4) {
+                fillProbes++;
+                sqlite3_bind_int64(stmt, 1, pickRowId(random));
+                if (sqlite3_step(stmt) == SQLITE_ROW && sampledRowIds.insert(sqlite3_column_int64(stmt, 0)).second) {
+                    appendRow(stmt);
+                }
+                sqlite3_reset(stmt);
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        // Rows per rowid slot, scaled to the whole range
+        if (hits > 0) {
+            estimatedTotalRows = static_cast<int64_t>(static_cast<double>(span) * hits / probes);
+        }
+        else {
+            estimatedTotalRows = getTableRowCount(tableName);
+        }
+        estimatedTotalRows = std::max(estimatedTotalRows, static_cast<int64_t>(entries.size()));
+
+        debugOutput("Sampled " + std::to_string(entries.size()) + " rows from " + tableName + " (" + std::to_string(hits) + "/" +
+                   std::to_string(probes) + " exact probes, ~" + std::to_string(estimatedTotalRows) + " rows)");
+        return entries;
+    }
+
     bool getTableInfo(const std::string& tableName) {
         if (!db) {
             debugOutput("No database connection available.");
@@ -440,6 +621,8 @@ public:
         int64_t pageSize;
         int64_t freePages;
         double fragmentationPercent;
+        int autoVacuumMode;      // 0 = NONE, 1 = FULL, 2 = INCREMENTAL
+        int64_t reclaimedPages;  // Freed by incremental_vacuum this session
     };
 
     DatabaseStats dbtGetDatabaseStats() {
@@ -449,6 +632,8 @@ public:
         stats.pageSize = 0;
         stats.freePages = 0;
         stats.fragmentationPercent = 0.0;
+        stats.autoVacuumMode = 0;
+        stats.reclaimedPages = reclaimedPagesTotal;
 
         if (!db) {
             debugOutput("No database connection available.");
@@ -495,6 +680,14 @@ public:
             sqlite3_finalize(stmt);
         }
 
+        // Get auto_vacuum mode
+        if (sqlite3_prepare_v2(db, "PRAGMA auto_vacuum;", -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                stats.autoVacuumMode = sqlite3_column_int(stmt, 0);
+            }
+            sqlite3_finalize(stmt);
+        }
+
         // Calculate fragmentation percentage
         if (stats.pageCount > 0) {
             stats.fragmentationPercent = (static_cast<double>(stats.freePages) / static_cast<double>(stats.pageCount)) * 100.0;
@@ -540,6 +733,442 @@ public:
         return true;
     }
 
+    // Database tools: Set auto_vacuum mode (0 = NONE, 1 = FULL, 2 = INCREMENTAL).
+    // Switching to or from NONE only takes effect after the next full compaction.
+    bool dbtSetAutoVacuumMode(int mode) {
+        if (!db) {
+            debugOutput("No database connection available.");
+            return false;
+        }
+
+        std::string sql = "PRAGMA auto_vacuum=" + std::to_string(mode) + ";";
+        char* errMsg = nullptr;
+        if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+            debugOutput("Failed to set auto_vacuum: " + std::string(errMsg ? errMsg : "unknown error"));
+            if (errMsg) sqlite3_free(errMsg);
+            return false;
+        }
+
+        debugOutput("auto_vacuum set to " + std::to_string(mode));
+        return true;
+    }
+
+    // Database tools: Release up to maxPages free pages (incremental_vacuum).
+    // Only has an effect when auto_vacuum=INCREMENTAL. Returns pages reclaimed.
+    int64_t dbtIncrementalVacuum(int maxPages) {
+        if (!db) {
+            debugOutput("No database connection available.");
+            return 0;
+        }
+
+        int64_t freeBefore = 0;
+        int64_t freeAfter = 0;
+        sqlite3_stmt* stmt;
+
+        if (sqlite3_prepare_v2(db, "PRAGMA freelist_count;", -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                freeBefore = sqlite3_column_int64(stmt, 0);
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        // incremental_vacuum returns one row per freed page, so step until done
+        std::string sql = "PRAGMA incremental_vacuum(" + std::to_string(maxPages > 0 ? maxPages : 0) + ");";
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        if (sqlite3_prepare_v2(db, "PRAGMA freelist_count;", -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                freeAfter = sqlite3_column_int64(stmt, 0);
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        int64_t reclaimed = freeBefore > freeAfter ? freeBefore - freeAfter : 0;
+        reclaimedPagesTotal += reclaimed;
+
+        debugOutput("incremental_vacuum reclaimed " + std::to_string(reclaimed) + " pages (" +
+                   std::to_string(freeAfter) + " free pages remain)");
+        return reclaimed;
+    }
+
+    // Database tools: Storage breakdown per table and index
+    struct StorageObjectStats {
+        std::string name;
+        std::string tableName;   // Owning table (same as name for tables)
+        std::string type;        // "table" or "index"
+        int64_t pages;
+        int64_t leafPages;
+        int64_t interiorPages;
+        int64_t overflowPages;
+        int64_t cells;           // Rows (leaf cells)
+        int64_t payloadBytes;
+        int64_t unusedBytes;
+        int64_t totalBytes;
+        double averageFill;      // Percent of page bytes in use
+    };
+
+    struct BlobHistogram {
+        std::string tableName;
+        int64_t count;
+        int64_t totalBytes;
+        int64_t p50;
+        int64_t p90;
+        int64_t p99;
+        int64_t max;
+    };
+
+    struct StorageAnalysis {
+        bool success;
+        std::string error;
+        std::string source;  // "dbstat" or "pagewalk"
+        int64_t pageSize;
+        std::vector<StorageObjectStats> objects;  // Largest first
+        std::vector<BlobHistogram> blobHistograms;
+    };
+
+private:
+    // Native B-tree walker, used when SQLite was built without SQLITE_ENABLE_DBSTAT_VTAB.
+    // Reads the main file directly while a read transaction keeps writers out.
+    struct PageWalker {
+        std::ifstream file;
+        int64_t pageSize;
+        int64_t usableSize;
+        int64_t pageCount;
+        std::set<int64_t> visited;
+        std::vector<uint8_t> page;
+    };
+
+    static uint32_t readBigEndian(const uint8_t* p, int bytes) {
+        uint32_t value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value = (value << 8) | p[i];
+        }
+        return value;
+    }
+
+    // SQLite varint: up to 9 bytes, 7 bits each except the last
+    static int readVarint(const uint8_t* p, const uint8_t* end, int64_t& value) {
+        value = 0;
+        for (int i = 0; i < 9; i++) {
+            if (p + i >= end) {
+                return i;
+            }
+            if (i == 8) {
+                value = (value << 8) | p[i];
+                return 9;
+            }
+            value = (value << 7) | (p[i] & 0x7F);
+            if (!(p[i] & 0x80)) {
+                return i + 1;
+            }
+        }
+        return 9;
+    }
+
+    bool walkerReadPage(PageWalker& walker, int64_t pgno) {
+        if (pgno < 1 || pgno > walker.pageCount) {
+            return false;
+        }
+        walker.page.resize((size_t)walker.pageSize);
+        walker.file.seekg((pgno - 1) * walker.pageSize);
+        walker.file.read((char*)walker.page.data(), walker.pageSize);
+        return walker.file.gcount() == walker.pageSize;
+    }
+
+    // Bytes of a cell's payload stored on the B-tree page itself (the rest spills to overflow pages)
+    int64_t localPayloadSize(const PageWalker& walker, int64_t payload, bool isTable) {
+        int64_t maxLocal = isTable ? walker.usableSize - 35 : ((walker.usableSize - 12) * 64 / 255) - 23;
+        int64_t minLocal = ((walker.usableSize - 12) * 32 / 255) - 23;
+        if (payload <= maxLocal) {
+            return payload;
+        }
+        int64_t k = minLocal + ((payload - minLocal) % (walker.usableSize - 4));
+        return k <= maxLocal ? k : minLocal;
+    }
+
+    void walkOverflowChain(PageWalker& walker, int64_t pgno, int64_t remaining, StorageObjectStats& stats) {
+        uint8_t next[4];
+        while (pgno != 0 && remaining > 0 && pgno <= walker.pageCount && walker.visited.insert(pgno).second) {
+            walker.file.seekg((pgno - 1) * walker.pageSize);
+            walker.file.read((char*)next, 4);
+            if (walker.file.gcount() != 4) {
+                break;
+            }
+
+            int64_t chunk = std::min(remaining, walker.usableSize - 4);
+            stats.pages++;
+            stats.overflowPages++;
+            stats.unusedBytes += (walker.usableSize - 4) - chunk;
+            remaining -= chunk;
+            pgno = readBigEndian(next, 4);
+        }
+    }
+
+    void walkBTreePage(PageWalker& walker, int64_t pgno, StorageObjectStats& stats, int depth) {
+        if (depth > 64 || !walker.visited.insert(pgno).second || !walkerReadPage(walker, pgno)) {
+            return;
+        }
+
+        // Copy: recursion below reuses walker.page
+        std::vector<uint8_t> page = walker.page;
+        const uint8_t* end = page.data() + walker.usableSize;
+        int hdr = (pgno == 1) ? 100 : 0;
+        uint8_t pageType = page[hdr];
+        bool interior = (pageType == 2 || pageType == 5);
+        bool isTable = (pageType == 5 || pageType == 13);
+        if (pageType != 2 && pageType != 5 && pageType != 10 && pageType != 13) {
+            return;
+        }
+
+        int hdrSize = interior ? 12 : 8;
+        int64_t cellCount = readBigEndian(&page[hdr + 3], 2);
+        int64_t contentStart = readBigEndian(&page[hdr + 5], 2);
+        if (contentStart == 0) {
+            contentStart = 65536;
+        }
+
+        stats.pages++;
+        if (interior) {
+            stats.interiorPages++;
+        }
+        else {
+            stats.leafPages++;
+            stats.cells += cellCount;
+        }
+
+        // Unused = gap between cell pointers and cell content + freeblocks + fragmented bytes
+        int64_t unused = contentStart - (hdr + hdrSize + 2 * cellCount) + page[hdr + 7];
+        int64_t freeblock = readBigEndian(&page[hdr + 1], 2);
+        for (int guard = 0; freeblock != 0 && freeblock + 4 <= walker.usableSize && guard < 10000; guard++) {
+            unused += readBigEndian(&page[(size_t)freeblock + 2], 2);
+            freeblock = readBigEndian(&page[(size_t)freeblock], 2);
+        }
+        stats.unusedBytes += std::max<int64_t>(unused, 0);
+
+        std::vector<int64_t> children;
+        for (int64_t i = 0; i < cellCount; i++) {
+            size_t ptrOffset = hdr + hdrSize + 2 * (size_t)i;
+            if (ptrOffset + 2 > (size_t)walker.usableSize) {
+                break;
+            }
+            const uint8_t* cell = page.data() + readBigEndian(&page[ptrOffset], 2);
+            if (cell >= end) {
+                continue;
+            }
+
+            if (pageType == 5) {
+                // Table interior: child pointer + rowid, no payload
+                children.push_back(readBigEndian(cell, 4));
+                continue;
+            }
+            if (pageType == 2) {
+                children.push_back(readBigEndian(cell, 4));
+                cell += 4;
+            }
+
+            int64_t payload = 0;
+            cell += readVarint(cell, end, payload);
+            if (pageType == 13) {
+                int64_t rowid = 0;
+                cell += readVarint(cell, end, rowid);
+            }
+
+            stats.payloadBytes += payload;
+            int64_t local = localPayloadSize(walker, payload, isTable);
+            if (local < payload && cell + local + 4 <= end) {
+                walkOverflowChain(walker, readBigEndian(cell + local, 4), payload - local, stats);
+            }
+        }
+
+        if (interior) {
+            children.push_back(readBigEndian(&page[hdr + 8], 4));
+            for (int64_t child : children) {
+                walkBTreePage(walker, child, stats, depth + 1);
+            }
+        }
+    }
+
+    bool analyzeWithDbstat(StorageAnalysis& analysis) {
+        const char* sql =
+            "SELECT name, COUNT(*), SUM(pagetype = 'leaf'), SUM(pagetype = 'internal'), SUM(pagetype = 'overflow'), "
+            "SUM(CASE WHEN pagetype = 'leaf' THEN ncell ELSE 0 END), SUM(payload), SUM(unused), SUM(pgsize) "
+            "FROM dbstat GROUP BY name;";
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            debugOutput("dbstat not available: " + std::string(sqlite3_errmsg(db)));
+            return false;
+        }
+
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            StorageObjectStats stats;
+            const char* name = (const char*)sqlite3_column_text(stmt, 0);
+            stats.name = name ? name : "";
+            stats.pages = sqlite3_column_int64(stmt, 1);
+            stats.leafPages = sqlite3_column_int64(stmt, 2);
+            stats.interiorPages = sqlite3_column_int64(stmt, 3);
+            stats.overflowPages = sqlite3_column_int64(stmt, 4);
+            stats.cells = sqlite3_column_int64(stmt, 5);
+            stats.payloadBytes = sqlite3_column_int64(stmt, 6);
+            stats.unusedBytes = sqlite3_column_int64(stmt, 7);
+            stats.totalBytes = sqlite3_column_int64(stmt, 8);
+            analysis.objects.push_back(stats);
+        }
+        sqlite3_finalize(stmt);
+
+        analysis.source = "dbstat";
+        return true;
+    }
+
+    bool analyzeWithPageWalker(StorageAnalysis& analysis, const std::map<std::string, int64_t>& rootPages) {
+        PageWalker walker;
+        walker.file.open(currentDbPath, std::ios::binary);
+        if (!walker.file.is_open()) {
+            analysis.error = "Failed to open database file for reading";
+            return false;
+        }
+
+        uint8_t header[100];
+        walker.file.read((char*)header, 100);
+        if (walker.file.gcount() != 100) {
+            analysis.error = "Failed to read database header";
+            return false;
+        }
+
+        walker.pageSize = readBigEndian(&header[16], 2);
+        if (walker.pageSize == 1) {
+            walker.pageSize = 65536;
+        }
+        walker.usableSize = walker.pageSize - header[20];
+        walker.pageCount = readBigEndian(&header[28], 4);
+
+        for (const auto& root : rootPages) {
+            StorageObjectStats stats = {};
+            stats.name = root.first;
+            walkBTreePage(walker, root.second, stats, 0);
+            stats.totalBytes = stats.pages * walker.pageSize;
+            analysis.objects.push_back(stats);
+        }
+
+        analysis.source = "pagewalk";
+        return true;
+    }
+
+public:
+    StorageAnalysis dbtAnalyzeStorage() {
+        StorageAnalysis analysis;
+        analysis.success = false;
+        analysis.pageSize = 0;
+
+        if (!db) {
+            analysis.error = "No database connection available";
+            debugOutput("No database connection available.");
+            return analysis;
+        }
+
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, "PRAGMA page_size;", -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                analysis.pageSize = sqlite3_column_int64(stmt, 0);
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        // The page walker reads the main file, so fold any WAL content into it first
+        sqlite3_exec(db, "PRAGMA wal_checkpoint(PASSIVE);", nullptr, nullptr, nullptr);
+
+        // Hold a read transaction for the whole scan so the file can't change underneath us
+        sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+
+        // Object names, types and root pages
+        std::map<std::string, std::pair<std::string, std::string>> objectInfo;  // name -> (type, tbl_name)
+        std::map<std::string, int64_t> rootPages;
+        rootPages["sqlite_schema"] = 1;
+        objectInfo["sqlite_schema"] = { "table", "sqlite_schema" };
+        if (sqlite3_prepare_v2(db, "SELECT type, name, tbl_name, rootpage FROM sqlite_master WHERE rootpage > 0;", -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* type = (const char*)sqlite3_column_text(stmt, 0);
+                const char* name = (const char*)sqlite3_column_text(stmt, 1);
+                const char* tblName = (const char*)sqlite3_column_text(stmt, 2);
+                if (!name) {
+                    continue;
+                }
+                objectInfo[name] = { type ? type : "", tblName ? tblName : "" };
+                rootPages[name] = sqlite3_column_int64(stmt, 3);
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        bool analyzed = analyzeWithDbstat(analysis) || analyzeWithPageWalker(analysis, rootPages);
+
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+
+        if (!analyzed) {
+            debugOutput("Storage analysis failed: " + analysis.error);
+            return analysis;
+        }
+
+        for (auto& stats : analysis.objects) {
+            auto it = objectInfo.find(stats.name);
+            if (it != objectInfo.end()) {
+                stats.type = it->second.first;
+                stats.tableName = it->second.second;
+            }
+            else {
+                stats.type = "table";
+                stats.tableName = stats.name;
+            }
+            stats.averageFill = stats.totalBytes > 0 ?
+                (static_cast<double>(stats.totalBytes - stats.unusedBytes) / stats.totalBytes) * 100.0 : 0.0;
+        }
+
+        std::sort(analysis.objects.begin(), analysis.objects.end(),
+            [](const StorageObjectStats& a, const StorageObjectStats& b) { return a.totalBytes > b.totalBytes; });
+
+        // BLOB size histograms per entry type
+        for (const auto& tableName : getSupportedEntryTypes()) {
+            if (objectInfo.find(tableName) == objectInfo.end()) {
+                continue;
+            }
+
+            std::vector<int64_t> sizes;
+            std::string sql = "SELECT LENGTH(value) FROM \"" + tableName + "\";";
+            if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                continue;
+            }
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                sizes.push_back(sqlite3_column_int64(stmt, 0));
+            }
+            sqlite3_finalize(stmt);
+
+            BlobHistogram histogram = {};
+            histogram.tableName = tableName;
+            histogram.count = static_cast<int64_t>(sizes.size());
+            if (!sizes.empty()) {
+                std::sort(sizes.begin(), sizes.end());
+                auto percentile = [&sizes](double p) {
+                    size_t index = static_cast<size_t>(p * (sizes.size() - 1) + 0.5);
+                    return sizes[index];
+                };
+                for (int64_t size : sizes) {
+                    histogram.totalBytes += size;
+                }
+                histogram.p50 = percentile(0.50);
+                histogram.p90 = percentile(0.90);
+                histogram.p99 = percentile(0.99);
+                histogram.max = sizes.back();
+            }
+            analysis.blobHistograms.push_back(histogram);
+        }
+
+        analysis.success = true;
+        debugOutput("Storage analysis (" + analysis.source + "): " + std::to_string(analysis.objects.size()) + " objects");
+        return analysis;
+    }
+
     // Database tools: Find large BLOBs in a table
     std::vector<std::pair<std::string, int>> dbtFindLargeBlobsInTable(const std::string& tableName, int minSizeBytes) {
         if (!db) {
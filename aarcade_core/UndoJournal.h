@@ -0,0 +1,317 @@
+#ifndef UNDO_JOURNAL_H
+#define UNDO_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <windows.h>
+
+/**
+ * UndoJournal - Before-images of the rows a destructive tool overwrote or deleted
+ *
+ * Tools append a record before each write, in the order the writes happen, and flush
+ * the journal before every COMMIT, so each committed change has its before-image on
+ * disk. Each record also keeps a hash of the value the write left behind, so replay can
+ * tell a row the run left alone since from one edited after it. Replaying the records
+ * newest first puts every touched row back the way it was before the run.
+ *
+ * Journals live in "<database path>.undo\<name>.undo", one per job ("job-<id>") or per
+ * direct tool call ("<tool>-<time>"). Layout: "AAUNDO2\n" followed by records of
+ *   [u8 op][u32 table length][table][u32 id length][id][u32 value length][value]
+ *   [u32 after length][after]
+ * where op 1 restores the value and op 2 deletes a row the run inserted, and after is the
+ * 8-byte hashValue() of the written value, or empty if the write deleted the row.
+ * "AAUNDO1\n" journals have no after field; their records are replayed unchecked.
+ */
+class UndoJournal {
+public:
+    enum Op : uint8_t {
+        OP_RESTORE = 1,
+        OP_DELETE = 2
+    };
+
+    struct Record {
+        uint8_t op;
+        std::string tableName;
+        std::string id;
+        std::vector<uint8_t> value;
+        bool checked;        // False for version 1 records, which carry no after-state
+        bool existsAfter;    // The write left the row in place (false when it deleted it)
+        uint64_t afterHash;  // hashValue() of the written value when existsAfter
+    };
+
+private:
+    HANDLE file_;
+    std::string path_;
+    int64_t recordCount_;
+    int version_;  // Format of the open file; a resumed version 1 journal stays version 1
+
+    bool writeBytes(const void* data, DWORD size) {
+        DWORD written = 0;
+        return WriteFile(file_, data, size, &written, nullptr) && written == size;
+    }
+
+    bool writeField(const void* data, uint32_t size) {
+        return writeBytes(&size, sizeof(size)) && (size == 0 || writeBytes(data, size));
+    }
+
+public:
+    static const char* header() { return "AAUNDO2\n"; }
+    static const char* headerV1() { return "AAUNDO1\n"; }
+
+    // FNV-1a over the row value as stored
+    static uint64_t hashValue(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    static std::vector<uint8_t> decodeHex(const std::string& hex) {
+        std::vector<uint8_t> value;
+        value.reserve(hex.length() / 2);
+        for (size_t i = 0; i + 1 < hex.length(); i += 2) {
+            value.push_back(static_cast<uint8_t>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+        }
+        return value;
+    }
+
+    static std::string directoryFor(const std::string& databasePath) {
+        return databasePath + ".undo";
+    }
+
+    static std::string pathFor(const std::string& databasePath, const std::string& name) {
+        return directoryFor(databasePath) + "\\" + name + ".undo";
+    }
+
+    UndoJournal() : file_(INVALID_HANDLE_VALUE), recordCount_(0), version_(2) {}
+    ~UndoJournal() { close(); }
+
+    UndoJournal(const UndoJournal&) = delete;
+    UndoJournal& operator=(const UndoJournal&) = delete;
+
+    // Open for appending, creating the directory and header as needed (a resumed job appends)
+    bool open(const std::string& path, std::string& error) {
+        close();
+
+        std::string directory = path.substr(0, path.find_last_of("\\/"));
+        CreateDirectoryA(directory.c_str(), NULL);
+
+        file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            error = "Failed to open undo journal " + path + " (error " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size)) {
+            size.QuadPart = 0;
+        }
+
+        // Keep appending in the format the journal was started in
+        version_ = 2;
+        char magic[8];
+        DWORD read = 0;
+        if (size.QuadPart >= 8 && ReadFile(file_, magic, 8, &read, nullptr) && read == 8 &&
+            memcmp(magic, headerV1(), 8) == 0) {
+            version_ = 1;
+        }
+
+        LARGE_INTEGER end;
+        end.QuadPart = 0;
+        SetFilePointerEx(file_, end, nullptr, FILE_END);
+        if (size.QuadPart == 0 && !writeBytes(header(), 8)) {
+            error = "Failed to write undo journal header";
+            close();
+            return false;
+        }
+
+        path_ = path;
+        recordCount_ = 0;
+        return true;
+    }
+
+    bool isOpen() const { return file_ != INVALID_HANDLE_VALUE; }
+    const std::string& path() const { return path_; }
+    int64_t recordCount() const { return recordCount_; }
+
+    bool append(uint8_t op, const std::string& tableName, const std::string& id, const void* value, uint32_t valueSize,
+                bool existsAfter, uint64_t afterHash) {
+        if (!isOpen()) {
+            return false;
+        }
+        bool ok = writeBytes(&op, 1) &&
+            writeField(tableName.data(), static_cast<uint32_t>(tableName.size())) &&
+            writeField(id.data(), static_cast<uint32_t>(id.size())) &&
+            writeField(value, valueSize) &&
+            (version_ < 2 || writeField(&afterHash, existsAfter ? sizeof(afterHash) : 0));
+        if (ok) {
+            recordCount_++;
+        }
+        return ok;
+    }
+
+    // Record the value a row had before it is written or deleted, and the value the write
+    // leaves. Empty oldHex means the row did not exist, so undo deletes it; empty newHex
+    // means the write deletes the row.
+    bool recordBefore(const std::string& tableName, const std::string& id, const std::string& oldHex, const std::string& newHex) {
+        std::vector<uint8_t> after = decodeHex(newHex);
+        uint64_t afterHash = hashValue(after.data(), after.size());
+        bool existsAfter = !newHex.empty();
+
+        if (oldHex.empty()) {
+            return append(OP_DELETE, tableName, id, nullptr, 0, existsAfter, afterHash);
+        }
+
+        std::vector<uint8_t> value = decodeHex(oldHex);
+        return append(OP_RESTORE, tableName, id, value.data(), static_cast<uint32_t>(value.size()), existsAfter, afterHash);
+    }
+
+    // Must be called before the transaction holding the recorded writes commits
+    bool flush() {
+        return !isOpen() || FlushFileBuffers(file_) != 0;
+    }
+
+    void close() {
+        if (isOpen()) {
+            FlushFileBuffers(file_);
+            CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+    }
+};
+
+/**
+ * UndoJournalReader - Random access to the records of a journal, for replay newest first
+ *
+ * Only record offsets are held in memory. A record cut short by a crash is ignored; its
+ * write can never have committed.
+ */
+class UndoJournalReader {
+private:
+    HANDLE file_;
+    std::vector<int64_t> offsets_;
+    int version_;
+
+    bool readBytes(void* data, DWORD size) {
+        DWORD read = 0;
+        return ReadFile(file_, data, size, &read, nullptr) && read == size;
+    }
+
+    bool seek(int64_t offset) {
+        LARGE_INTEGER position;
+        position.QuadPart = offset;
+        return SetFilePointerEx(file_, position, nullptr, FILE_BEGIN) != 0;
+    }
+
+public:
+    UndoJournalReader() : file_(INVALID_HANDLE_VALUE), version_(2) {}
+    ~UndoJournalReader() { close(); }
+
+    UndoJournalReader(const UndoJournalReader&) = delete;
+    UndoJournalReader& operator=(const UndoJournalReader&) = delete;
+
+    bool open(const std::string& path, std::string& error) {
+        close();
+
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            error = "Undo journal not found: " + path;
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(file_, &size);
+
+        char magic[8];
+        if (!readBytes(magic, 8)) {
+            magic[0] = 0;
+        }
+        if (memcmp(magic, UndoJournal::header(), 8) == 0) {
+            version_ = 2;
+        } else if (memcmp(magic, UndoJournal::headerV1(), 8) == 0) {
+            version_ = 1;
+        } else {
+            error = "Not an undo journal: " + path;
+            close();
+            return false;
+        }
+
+        // Index the records by walking the length prefixes
+        int fields = (version_ < 2) ? 3 : 4;
+        int64_t offset = 8;
+        while (offset < size.QuadPart) {
+            int64_t next = offset + 1;
+            bool complete = true;
+            for (int field = 0; field < fields && complete; field++) {
+                uint32_t length = 0;
+                complete = seek(next) && readBytes(&length, sizeof(length));
+                next += sizeof(length) + length;
+            }
+            if (!complete || next > size.QuadPart) {
+                break;
+            }
+            offsets_.push_back(offset);
+            offset = next;
+        }
+        return true;
+    }
+
+    size_t size() const { return offsets_.size(); }
+
+    bool read(size_t index, UndoJournal::Record& record) {
+        if (index >= offsets_.size() || !seek(offsets_[index])) {
+            return false;
+        }
+
+        uint32_t length = 0;
+        if (!readBytes(&record.op, 1) || !readBytes(&length, sizeof(length))) {
+            return false;
+        }
+        record.tableName.resize(length);
+        if (length > 0 && !readBytes(&record.tableName[0], length)) {
+            return false;
+        }
+        if (!readBytes(&length, sizeof(length))) {
+            return false;
+        }
+        record.id.resize(length);
+        if (length > 0 && !readBytes(&record.id[0], length)) {
+            return false;
+        }
+        if (!readBytes(&length, sizeof(length))) {
+            return false;
+        }
+        record.value.resize(length);
+        if (length > 0 && !readBytes(record.value.data(), length)) {
+            return false;
+        }
+
+        record.checked = version_ >= 2;
+        record.existsAfter = false;
+        record.afterHash = 0;
+        if (record.checked) {
+            if (!readBytes(&length, sizeof(length)) || (length != 0 && length != sizeof(record.afterHash))) {
+                return false;
+            }
+            record.existsAfter = length != 0;
+            if (record.existsAfter && !readBytes(&record.afterHash, sizeof(record.afterHash))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void close() {
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+        offsets_.clear();
+    }
+};
+
+#endif // UNDO_JOURNAL_H
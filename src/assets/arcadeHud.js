@@ -11,6 +11,7 @@ const arcadeHud = (function() {
     // Private state
     let imageCompletionInterval = null;
     let isInitialized = false;
+    let cacheLayout = 'v2';  // Layout of the image cache, from aapi.getImageCacheLayout()
 
     // CRC32 lookup table (same as C++ ImageLoader)
     const crc32Table = new Uint32Array([
@@ -85,14 +86,41 @@ const arcadeHud = (function() {
     }
 
     /**
-     * Predict the cache file path for a URL
+     * Calculate the 64-bit FNV-1a hash of the UTF-8 bytes (same as C++ calculateHash64)
+     * Works on 32-bit halves: h * 0x100000001b3 = h * 0x1b3 + (h << 40)
      * @private
      */
+    function calculateHash64(normalizedUrl) {
+        const bytes = unescape(encodeURIComponent(normalizedUrl));
+        let hi = 0xcbf29ce4;
+        let lo = 0x84222325;
+
+        for (let i = 0; i < bytes.length; i++) {
+            lo = (lo ^ bytes.charCodeAt(i)) >>> 0;
+            const loProduct = lo * 0x1b3;
+            hi = (Math.imul(hi, 0x1b3) + Math.floor(loProduct / 0x100000000) + (lo << 8)) >>> 0;
+            lo = loProduct >>> 0;
+        }
+
+        return hi.toString(16).padStart(8, '0') + lo.toString(16).padStart(8, '0');
+    }
+
+    /**
+     * Predict the cache file path for a URL
+     * @param {string} url - Image URL
+     * @returns {string} file:/// URL the image is cached at
+     */
     function predictCachePath(url) {
-        const normalized = normalizeUrl(url);
-        const hash = calculateKodiHash(normalized);
-        const subfolder = hash.charAt(0);
-        return `file:///./cache/urls/${subfolder}/${hash}.png`;
+        if (cacheLayout === 'kodi') {
+            const hash = calculateKodiHash(normalizeUrl(url));
+            const subfolder = hash.charAt(0);
+            return `file:///./cache/urls/${subfolder}/${hash}.png`;
+        }
+
+        // C++ lowercases ASCII only
+        const normalized = url.replace(/[A-Z]/g, c => c.toLowerCase()).replace(/\\/g, '/');
+        const hash = calculateHash64(normalized);
+        return `file:///./cache/urls/${hash.substr(0, 2)}/${hash.substr(2, 2)}/${hash}.png`;
     }
 
     /**
@@ -113,8 +141,17 @@ const arcadeHud = (function() {
             return false;
         }
 
-        // Start polling for image completions if the method exists
-        if (typeof aapi.processImageCompletions === 'function') {
+        // Predict cache paths in the layout the cache is written in
+        if (typeof aapi.getImageCacheLayout === 'function') {
+            cacheLayout = aapi.getImageCacheLayout();
+        }
+
+        // C++ pushes image completions as they happen; poll only when it does not
+        // (image_completion_delivery = poll, or a build without push)
+        const completionStats = getImageCompletionStats();
+        if (completionStats && completionStats.delivery === 'push') {
+            console.log('[arcadeHud] Image completions are pushed, no polling needed');
+        } else if (typeof aapi.processImageCompletions === 'function') {
             startImageCompletionPolling();
         } else {
             console.warn('[arcadeHud] aapi.processImageCompletions not available');
@@ -144,6 +181,33 @@ const arcadeHud = (function() {
         }, 50); // Poll every 50ms
     }
 
+    /**
+     * Get image completion delivery statistics
+     * Latency is measured from C++ queueing a completion to its callback running.
+     * @returns {Object|null} { delivery: 'push'|'poll', delivered, batches, averageLatencyMs, maxLatencyMs },
+     *   or null when not available
+     */
+    function getImageCompletionStats() {
+        if (typeof aapi === 'undefined' || typeof aapi.getImageCompletionStats !== 'function') {
+            return null;
+        }
+
+        return aapi.getImageCompletionStats();
+    }
+
+    /**
+     * Get statistics of the decoded image memory cache
+     * Hits are cached images the page was served from memory, misses ones read from disk.
+     * @returns {Object|null} { hits, misses, evictions, entries, bytes, budgetBytes }, or null when not available
+     */
+    function getImageMemoryCacheStats() {
+        if (typeof aapi === 'undefined' || typeof aapi.getImageMemoryCacheStats !== 'function') {
+            return null;
+        }
+
+        return aapi.getImageMemoryCacheStats();
+    }
+
     /**
      * Stop polling for image completions
      * @private
@@ -168,6 +232,9 @@ const arcadeHud = (function() {
      * actual image pixels, eliminating transparent borders.
      *
      * @param {string} url - The image URL to download and cache
+     * @param {string|Function} [priority='visible'] - 'visible', 'near' or 'prefetch', or a function
+     *   returning one, read when the request reaches C++. A function returning 'cancel' rejects
+     *   with 'Cancelled' instead of requesting the image.
      * @returns {Promise<Object>} Promise that resolves with image details:
      *   - filePath: Local file:// URL to the cached PNG
      *   - downloaderName: Name of the downloader used (e.g., "ImageLoader")
@@ -178,8 +245,12 @@ const arcadeHud = (function() {
      *
      * Note: The saved PNG file is cropped to rectWidth x rectHeight, maintaining the
      * original image's aspect ratio.
+     *
+     * Requests that have not started can be moved with reprioritizeImages. The returned promise
+     * has a cancel() method that cancels this request only (other callers of the same URL keep
+     * waiting); a cancelled request rejects with 'Cancelled'.
      */
-    function loadImage(url) {
+    function loadImage(url, priority) {
         if (!isInitialized) {
             console.warn('[arcadeHud] Not initialized, auto-initializing...');
             initialize();
@@ -192,8 +263,12 @@ const arcadeHud = (function() {
         // Predict the cache file path
         const predictedPath = predictCachePath(url);
 
+        // Handle of the C++ request once it is made; cancel() before then stops it being made
+        let requestId = null;
+        let cancelled = false;
+
         // Try to load from predicted cache location first
-        return new Promise((resolve, reject) => {
+        const promise = new Promise((resolve, reject) => {
             const testImg = new Image();
 
             testImg.onload = function() {
@@ -210,8 +285,17 @@ const arcadeHud = (function() {
                 // Cache miss - need to download through C++
                 console.log('[arcadeHud] Cache miss, requesting download:', url);
 
+                // The caller may have moved on while the cache was probed
+                const currentPriority = (typeof priority === 'function' ? priority() : priority) || 'visible';
+                if (cancelled || currentPriority === 'cancel') {
+                    reject('Cancelled');
+                    return;
+                }
+
                 // Call C++ to download and cache
-                aapi.getCacheImage(url)
+                const request = aapi.getCacheImage(url, currentPriority);
+                requestId = request.requestId;
+                request
                     .then(result => {
                         resolve(result);
                     })
@@ -223,6 +307,96 @@ const arcadeHud = (function() {
             // Trigger the test load
             testImg.src = predictedPath;
         });
+
+        promise.cancel = function() {
+            if (requestId === null) {
+                cancelled = true;
+                return 0;
+            }
+            return cancelImages([url], requestId);
+        };
+        return promise;
+    }
+
+    /**
+     * Load and cache a batch of images in one call to C++
+     *
+     * Cache hits are found in C++ against the cache index in one pass, so no path is probed from
+     * JavaScript. The rest are queued at the given priority.
+     *
+     * @param {Array<string>} urls - Image URLs to download and cache
+     * @param {string} [priority='visible'] - 'visible', 'near' or 'prefetch' for the URLs not cached yet
+     * @param {Function} [onProgress] - Called as each URL completes with
+     *   ({ url, success, filePath, error }, completed, total). error is 'Cancelled' for a cancelled URL.
+     * @returns {Promise<Array<Object>>} Resolves with the results in request order once all have
+     *   completed (failed URLs included). Its requestId is the handle cancelImages takes for the
+     *   URLs of this batch.
+     */
+    function loadImages(urls, priority, onProgress) {
+        if (!isInitialized) {
+            console.warn('[arcadeHud] Not initialized, auto-initializing...');
+            initialize();
+        }
+
+        if (typeof aapi === 'undefined' || typeof aapi.getCacheImages !== 'function') {
+            return Promise.reject(new Error('Batch image caching not available'));
+        }
+
+        const batch = aapi.getCacheImages(urls, priority || 'visible');
+        const promise = new Promise(resolve => {
+            if (onProgress) {
+                batch.progress(onProgress);
+            }
+            batch.then(results => resolve(results));
+        });
+        promise.requestId = batch.requestId;
+        return promise;
+    }
+
+    /**
+     * Change the priority of queued image requests
+     * Only requests that C++ has not started yet are affected. Use cancelImages to cancel.
+     * @param {Array<string>} urls - Image URLs passed to loadImage
+     * @param {string} priority - 'visible', 'near' or 'prefetch'
+     * @returns {number} Number of requests changed
+     */
+    function reprioritizeImages(urls, priority) {
+        if (typeof aapi === 'undefined' || typeof aapi.reprioritizeImages !== 'function' || urls.length === 0) {
+            return 0;
+        }
+
+        return aapi.reprioritizeImages(urls, priority);
+    }
+
+    /**
+     * Cancel one request for these image URLs
+     * Only the callers of that request are rejected with 'Cancelled'; a URL another request still
+     * waits on keeps loading. A URL is dropped from the queue once nobody waits on it.
+     * @param {Array<string>} urls - Image URLs of the request
+     * @param {number} requestId - requestId of the loadImages promise (loadImage promises have cancel())
+     * @returns {number} Number of callbacks cancelled
+     */
+    function cancelImages(urls, requestId) {
+        if (typeof aapi === 'undefined' || typeof aapi.reprioritizeImages !== 'function' ||
+            urls.length === 0 || typeof requestId !== 'number') {
+            return 0;
+        }
+
+        return aapi.reprioritizeImages(urls, 'cancel', requestId);
+    }
+
+    /**
+     * Let image URLs that failed to load be tried again at once
+     * Failed URLs are otherwise refused for a while, from a minute after the first failure up to a day.
+     * @param {Array<string>} [urls] - URLs to clear; all failing URLs when omitted
+     * @returns {number} Number of failure records cleared
+     */
+    function clearImageFailures(urls) {
+        if (typeof aapi === 'undefined' || typeof aapi.clearImageFailures !== 'function') {
+            return 0;
+        }
+
+        return urls ? aapi.clearImageFailures(urls) : aapi.clearImageFailures();
     }
 
     /**
@@ -270,6 +444,8 @@ const arcadeHud = (function() {
             case 'imageCache':
                 return typeof aapi.getCacheImage === 'function' &&
                        typeof aapi.processImageCompletions === 'function';
+            case 'imageBatch':
+                return typeof aapi.getCacheImages === 'function';
             case 'database':
                 return typeof aapi.getFirstEntries === 'function';
             case 'search':
@@ -288,6 +464,13 @@ const arcadeHud = (function() {
 
         // Image loading
         loadImage: loadImage,
+        loadImages: loadImages,
+        reprioritizeImages: reprioritizeImages,
+        cancelImages: cancelImages,
+        clearImageFailures: clearImageFailures,
+        getImageCompletionStats: getImageCompletionStats,
+        getImageMemoryCacheStats: getImageMemoryCacheStats,
+        predictCachePath: predictCachePath,
 
         // Database
         getSupportedEntryTypes: getSupportedEntryTypes,
@@ -12,9 +12,12 @@ class LibraryBrowser {
         this.searchDebounceTimer = null;
 
         // Image cache state
-        // Map of url -> {status: 'pending'|'loading'|'cached'|'error', filePath: string, elements: Set<HTMLImageElement>}
+        // Map of url -> {status: 'pending'|'loading'|'cached'|'error', filePath: string, elements: Set<HTMLImageElement>,
+        //                priority: 'visible'|'near'|'prefetch'|'cancel', cancel: function cancelling its request}
         this.imageCache = new Map();
         this.placeholderImage = 'media-loading.jpg';
+        this.priorityUpdatePending = false;
+        this.pendingImageUrls = [];  // Queued while rendering, requested as one batch afterwards
 
         this.initializeElements();
         this.bindEvents();
@@ -55,6 +58,10 @@ class LibraryBrowser {
         this.elements.entryType.addEventListener('change', () => this.clearSearch());
         this.elements.pageSize.addEventListener('change', () => this.clearSearch());
         
+        // Loading images follow the viewport: on-screen tiles are fetched first
+        window.addEventListener('scroll', () => this.scheduleImagePriorityUpdate(), true);
+        window.addEventListener('resize', () => this.scheduleImagePriorityUpdate());
+
         // Keyboard shortcuts
         document.addEventListener('keydown', (e) => {
             if (e.key === 'Escape') {
@@ -285,11 +292,98 @@ class LibraryBrowser {
             const card = this.createEntryCard(entry, index);
             this.elements.libraryGrid.appendChild(card);
         });
+
+        // Requests for tiles that were replaced are dropped, the rest follow the new layout
+        this.cancelDetachedImages();
+        this.requestPendingImages();
+        this.updateImagePriorities();
         
         // Update entry count after rendering
         this.updateEntryCount();
     }
 
+    // Priority of an image element relative to the viewport
+    getImagePriority(imgElement) {
+        if (!imgElement.isConnected) {
+            return 'prefetch';
+        }
+
+        const rect = imgElement.getBoundingClientRect();
+        const viewportHeight = window.innerHeight;
+        if (rect.bottom >= 0 && rect.top <= viewportHeight) {
+            return 'visible';
+        }
+        if (rect.bottom >= -viewportHeight && rect.top <= viewportHeight * 2) {
+            return 'near';
+        }
+        return 'prefetch';
+    }
+
+    // The most urgent of the elements showing a URL wins
+    getEntryPriority(cacheEntry) {
+        let priority = 'prefetch';
+        cacheEntry.elements.forEach(el => {
+            const elementPriority = this.getImagePriority(el);
+            if (elementPriority === 'visible' || (elementPriority === 'near' && priority === 'prefetch')) {
+                priority = elementPriority;
+            }
+        });
+        return priority;
+    }
+
+    scheduleImagePriorityUpdate() {
+        if (this.priorityUpdatePending) return;
+
+        this.priorityUpdatePending = true;
+        setTimeout(() => {
+            this.priorityUpdatePending = false;
+            this.updateImagePriorities();
+        }, 100);
+    }
+
+    // Re-rank the images still loading by where their elements are now
+    updateImagePriorities() {
+        const changes = { visible: [], near: [], prefetch: [] };
+
+        this.imageCache.forEach((cacheEntry, url) => {
+            if (cacheEntry.status !== 'loading' || cacheEntry.priority === 'cancel') return;
+
+            const priority = this.getEntryPriority(cacheEntry);
+            if (priority !== cacheEntry.priority) {
+                cacheEntry.priority = priority;
+                changes[priority].push(url);
+            }
+        });
+
+        if (typeof arcadeHud === 'undefined' || !arcadeHud.reprioritizeImages) return;
+        Object.keys(changes).forEach(priority => {
+            arcadeHud.reprioritizeImages(changes[priority], priority);
+        });
+    }
+
+    // Cancel loading images that no element in the document is waiting for any more. Each entry
+    // cancels only its own request, so another page loading the same URL is not affected.
+    cancelDetachedImages() {
+        this.imageCache.forEach((cacheEntry, url) => {
+            if (cacheEntry.status !== 'loading') return;
+
+            cacheEntry.elements.forEach(el => {
+                if (!el.isConnected) {
+                    cacheEntry.elements.delete(el);
+                }
+            });
+
+            if (cacheEntry.elements.size === 0) {
+                cacheEntry.priority = 'cancel';
+                this.imageCache.delete(url);
+                // Entries still pending are skipped when the batch is requested
+                if (cacheEntry.cancel) {
+                    cacheEntry.cancel();
+                }
+            }
+        });
+    }
+
     createEntryCard(entry) {
         const card = document.createElement('div');
         card.className = 'entry-card';
@@ -316,11 +410,11 @@ class LibraryBrowser {
             </div>
         `;
 
-        // Trigger image loading if URL exists
+        // Queue image loading if URL exists (renderEntries requests the whole page at once)
         if (imageUrl) {
             const imgElement = card.querySelector('img[data-url]');
             if (imgElement) {
-                this.loadImageWithCache(imageUrl, imgElement);
+                this.loadImageWithCache(imageUrl, imgElement, true);
             }
         }
 
@@ -382,7 +476,57 @@ class LibraryBrowser {
         return tags.join('');
     }
 
-    loadImageWithCache(url, imgElement) {
+    // Request the images queued while rendering: one batch per priority instead of a call per tile
+    requestPendingImages() {
+        const urls = this.pendingImageUrls;
+        this.pendingImageUrls = [];
+        if (urls.length === 0) return;
+
+        if (typeof arcadeHud === 'undefined' || !arcadeHud.hasFeature('imageBatch')) {
+            // Older builds: one request per image
+            urls.forEach(url => {
+                const cacheEntry = this.imageCache.get(url);
+                if (cacheEntry && cacheEntry.status === 'loading') {
+                    this.requestImage(url, cacheEntry);
+                }
+            });
+            return;
+        }
+
+        const batches = { visible: [], near: [], prefetch: [] };
+        urls.forEach(url => {
+            // Entries cancelled since they were queued are gone from the cache
+            const cacheEntry = this.imageCache.get(url);
+            if (!cacheEntry || cacheEntry.status !== 'loading') return;
+
+            cacheEntry.priority = this.getEntryPriority(cacheEntry);
+            batches[cacheEntry.priority].push(url);
+        });
+
+        Object.keys(batches).forEach(priority => {
+            if (batches[priority].length === 0) return;
+
+            const batch = arcadeHud.loadImages(batches[priority], priority, (result) => {
+                const cacheEntry = this.imageCache.get(result.url);
+                if (!cacheEntry) return;
+
+                if (result.success) {
+                    this.onImageCached(result.url, cacheEntry, result.filePath);
+                } else {
+                    this.onImageFailed(result.url, cacheEntry, result.error);
+                }
+            });
+
+            batches[priority].forEach(url => {
+                const cacheEntry = this.imageCache.get(url);
+                if (cacheEntry) {
+                    cacheEntry.cancel = () => arcadeHud.cancelImages([url], batch.requestId);
+                }
+            });
+        });
+    }
+
+    loadImageWithCache(url, imgElement, deferred = false) {
         // Check if already in cache
         if (this.imageCache.has(url)) {
             const cacheEntry = this.imageCache.get(url);
@@ -408,41 +552,69 @@ class LibraryBrowser {
         const cacheEntry = {
             status: 'loading',
             filePath: null,
-            elements: new Set([imgElement])
+            elements: new Set([imgElement]),
+            priority: this.getImagePriority(imgElement)
         };
         this.imageCache.set(url, cacheEntry);
 
-        // Start loading through arcadeHud
+        if (deferred) {
+            this.pendingImageUrls.push(url);
+            return;
+        }
+
+        this.requestImage(url, cacheEntry);
+    }
+
+    // Start loading one image through arcadeHud
+    requestImage(url, cacheEntry) {
         if (typeof arcadeHud === 'undefined' || !arcadeHud.loadImage) {
             console.error('arcadeHud.loadImage not available, falling back to direct URL');
-            this.updateImageElement(imgElement, url, 'error');
+            cacheEntry.elements.forEach(el => {
+                this.updateImageElement(el, url, 'error');
+            });
             cacheEntry.status = 'error';
             return;
         }
 
-        arcadeHud.loadImage(url)
-            .then(result => {
-                cacheEntry.status = 'cached';
-                cacheEntry.filePath = result.filePath;
+        const request = arcadeHud.loadImage(url, () => cacheEntry.priority);
+        if (request.cancel) {
+            cacheEntry.cancel = () => request.cancel();
+        }
+        request
+            .then(result => this.onImageCached(url, cacheEntry, result.filePath))
+            .catch(error => this.onImageFailed(url, cacheEntry, error));
+    }
 
-                // Update all elements waiting for this image
-                if (cacheEntry.elements) {
-                    cacheEntry.elements.forEach(el => {
-                        this.updateImageElement(el, result.filePath, 'loaded');
-                    });
-                }
-            })
-            .catch(error => {
-                console.error(`Failed to load image ${url}:`, error);
-                cacheEntry.status = 'error';
-
-                // Update all elements waiting for this image
-                if (cacheEntry.elements) {
-                    cacheEntry.elements.forEach(el => {
-                        this.updateImageElement(el, null, 'error');
-                    });
-                }
+    onImageCached(url, cacheEntry, filePath) {
+        cacheEntry.status = 'cached';
+        cacheEntry.filePath = filePath;
+
+        // Update all elements waiting for this image
+        if (cacheEntry.elements) {
+            cacheEntry.elements.forEach(el => {
+                this.updateImageElement(el, filePath, 'loaded');
+            });
+        }
+    }
+
+    onImageFailed(url, cacheEntry, error) {
+        // Nothing is waiting for a cancelled image (its cache entry is already gone)
+        if (error === 'Cancelled') {
+            if (this.imageCache.get(url) === cacheEntry) {
+                this.imageCache.delete(url);
+            }
+            return;
+        }
+
+        console.error(`Failed to load image ${url}:`, error);
+        cacheEntry.status = 'error';
+
+        // Update all elements waiting for this image
+        if (cacheEntry.elements) {
+            cacheEntry.elements.forEach(el => {
+                this.updateImageElement(el, null, 'error');
             });
+        }
     }
 
     updateImageElement(imgElement, filePath, className) {